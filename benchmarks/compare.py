@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+#
+# Compare two JSON result files from sparse_benchmark, for instance a
+# baseline from a previous release and a new run. Runs are matched by
+# ordering and compression. Exits with a non-zero status when any
+# time, or the number of factor nonzeros, increased by more than the
+# given tolerance.
+#
+#   usage: compare.py baseline.json new.json [tolerance, default 0.1]
+
+import json
+import sys
+
+
+def load(fname):
+    with open(fname) as f:
+        d = json.load(f)
+    runs = {(r['ordering'], r['compression']): r for r in d['runs']}
+    return d, runs
+
+
+def main():
+    if len(sys.argv) < 3:
+        print(__doc__ or 'usage: compare.py baseline.json new.json [tol]')
+        return 2
+    tol = float(sys.argv[3]) if len(sys.argv) > 3 else 0.1
+    base, base_runs = load(sys.argv[1])
+    new, new_runs = load(sys.argv[2])
+    for k in ['problem', 'n', 'threads']:
+        if base[k] != new[k]:
+            print('# warning: different %s: %s vs %s' % (k, base[k], new[k]))
+    keys = ['reorder_time', 'factor_time', 'solve_time', 'factor_nonzeros']
+    regressions = 0
+    print('%-12s %-10s %-16s %12s %12s %8s' %
+          ('ordering', 'compression', 'metric', 'baseline', 'new', 'ratio'))
+    for run, b in sorted(base_runs.items()):
+        if run not in new_runs:
+            print('%-12s %-10s missing in %s' % (run + (sys.argv[2],)))
+            continue
+        n = new_runs[run]
+        if b['status'] != 'ok' or n['status'] != 'ok':
+            if b['status'] != n['status']:
+                print('%-12s %-10s status %s -> %s' %
+                      (run + (b['status'], n['status'])))
+                regressions += n['status'] != 'ok'
+            continue
+        for k in keys:
+            ratio = n[k] / b[k] if b[k] > 0 else 1.
+            flag = ''
+            if ratio > 1 + tol:
+                flag = '  <-- regression'
+                regressions += 1
+            print('%-12s %-10s %-16s %12.4g %12.4g %8.3f%s' %
+                  (run + (k, b[k], n[k], ratio, flag)))
+    print('# %d regression(s), tolerance %g' % (regressions, tol))
+    return 1 if regressions else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
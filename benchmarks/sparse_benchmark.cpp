@@ -0,0 +1,365 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <complex>
+#include <algorithm>
+#include <limits>
+#include <cctype>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include "StrumpackSparseSolver.hpp"
+#include "StrumpackFortranCInterface.h"
+#include "sparse/CSRMatrix.hpp"
+#include "misc/TaskTimer.hpp"
+
+using namespace strumpack;
+
+extern "C" {
+  void STRUMPACK_FC_GLOBAL_(genmatrix3d_anal,GENMATRIX3D_ANAL)
+    (void*,void*,void*,void*,void*,void*,void*,void*,void*,void*);
+  void STRUMPACK_FC_GLOBAL(genmatrix3d,GENMATRIX3D)
+    (void*,void*,void*,void*,void*,void*,void*,void*,
+     void*,void*,void*,void*,void*);
+}
+
+/**
+ * Finite difference discretization of -Laplace(u) + c (u_x + u_y +
+ * u_z) on an nx x ny x nz grid, with first order upwinding for the
+ * convection term. With c = 0 this is the standard 5 (nz == 1) or 7
+ * point Poisson problem.
+ */
+template<typename scalar_t> CSRMatrix<scalar_t,int>
+convection_diffusion(int nx, int ny, int nz, double c) {
+  int dim = (nz > 1) ? 3 : 2;
+  int N = nx * ny * nz;
+  std::vector<int> ptr(N+1), ind;
+  std::vector<scalar_t> val;
+  ind.reserve((2*dim+1)*N);
+  val.reserve((2*dim+1)*N);
+  for (int z=0; z<nz; z++)
+    for (int y=0; y<ny; y++)
+      for (int x=0; x<nx; x++) {
+        int i = x + y*nx + z*nx*ny;
+        auto add = [&](int j, double v) {
+          ind.push_back(j);
+          val.push_back(scalar_t(v));
+        };
+        if (z > 0)    add(i-nx*ny, -1.-c);
+        if (y > 0)    add(i-nx, -1.-c);
+        if (x > 0)    add(i-1, -1.-c);
+        add(i, 2.*dim + c*dim);
+        if (x < nx-1) add(i+1, -1.);
+        if (y < ny-1) add(i+nx, -1.);
+        if (z < nz-1) add(i+nx*ny, -1.);
+        ptr[i+1] = ind.size();
+      }
+  CSRMatrix<scalar_t,int> A
+    (N, ptr.data(), ind.data(), val.data(), c == 0.);
+  return A;
+}
+
+/**
+ * 3D Helmholtz problem, 27 point stencil with PML boundary layers,
+ * from genmatrix3D_core.f. The grid is n x n x n, including the PML.
+ */
+template<typename scalar_t> CSRMatrix<scalar_t,int>
+Helmholtz3D(int n) {
+  char datafile[] = "void";
+  std::int64_t fromfile = 0, npml = 8, nnz, N, rank = 0;
+  std::int64_t nx = std::max(std::int64_t(1), std::int64_t(n) - 2*npml);
+  std::int64_t n_ex = nx + 2*npml, low = 1, high = n_ex;
+  STRUMPACK_FC_GLOBAL_(genmatrix3d_anal,GENMATRIX3D_ANAL)
+    (&nx, &nx, &nx, &n_ex, &npml, &N, &nnz, &fromfile, datafile, &rank);
+  std::vector<std::int64_t> rowind(nnz), colind(nnz);
+  std::vector<std::complex<float>> v(nnz);
+  STRUMPACK_FC_GLOBAL(genmatrix3d,GENMATRIX3D)
+    (rowind.data(), colind.data(), v.data(), &nx, &nx, &nx,
+     &low, &high, &npml, &nnz, &fromfile, datafile, &rank);
+  int rows = n_ex * n_ex * n_ex;
+  std::vector<int> ptr(rows+1), ind(nnz);
+  std::vector<scalar_t> val(nnz);
+  // entries are sorted by row, 1-based
+  for (std::int64_t i=0; i<nnz; i++) {
+    ind[i] = colind[i] - 1;
+    val[i] = scalar_t(v[i]);
+    ptr[rowind[i]] = i + 1;
+  }
+  for (int r=1; r<=rows; r++)
+    ptr[r] = std::max(ptr[r], ptr[r-1]);
+  return CSRMatrix<scalar_t,int>
+    (rows, ptr.data(), ind.data(), val.data(), false);
+}
+
+std::vector<std::string> split(const std::string& s) {
+  std::vector<std::string> l;
+  std::istringstream iss(s);
+  std::string t;
+  while (std::getline(iss, t, ','))
+    if (!t.empty()) l.push_back(t);
+  return l;
+}
+
+bool same_name(std::string a, std::string b) {
+  auto lower = [](std::string& s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return std::tolower(c); }); };
+  lower(a); lower(b);
+  return a == b;
+}
+
+long long max_rss() {
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage u;
+  getrusage(RUSAGE_SELF, &u);
+#if defined(__APPLE__)
+  return u.ru_maxrss;
+#else
+  return u.ru_maxrss * 1024LL;
+#endif
+#else
+  return -1;
+#endif
+}
+
+struct Run {
+  std::string ordering, compression, status = "ok";
+  double reorder_time = std::numeric_limits<double>::max(),
+    factor_time = std::numeric_limits<double>::max(),
+    solve_time = std::numeric_limits<double>::max(),
+    flops = 0., residual = 0.;
+  long long factor_nonzeros = 0, peak_memory = -1, max_rss = -1;
+  int Krylov_iterations = 0;
+};
+
+/**
+ * Reorder, factor and solve with A, reps times, for the given
+ * ordering and compression. The minimum time over the repetitions is
+ * reported.
+ */
+template<typename scalar_t> Run
+run(const CSRMatrix<scalar_t,int>& A, int nx, int ny, int nz,
+    ReorderingStrategy ordering, CompressionType compression,
+    int reps, int argc, char* argv[]) {
+  Run r;
+  r.ordering = get_name(ordering);
+  r.compression = get_name(compression);
+  int N = A.size();
+  DenseMatrix<scalar_t> b(N, 1), x(N, 1), x_exact(N, 1);
+  x_exact.fill(scalar_t(1.));
+  A.spmv(x_exact, b);
+  for (int rep=0; rep<reps; rep++) {
+    SparseSolver<scalar_t,int> sp(false, true);
+    sp.options().set_from_command_line(argc, argv);
+    sp.options().set_reordering_method(ordering);
+    sp.options().set_compression(compression);
+#if defined(STRUMPACK_COUNT_FLOPS)
+    params::peak_memory = params::memory.load();
+    long long f0 = params::flops;
+#endif
+    sp.set_matrix(A);
+    TaskTimer t_reorder("reorder"), t_factor("factor"), t_solve("solve");
+    t_reorder.start();
+    auto e = sp.reorder(nx, ny, nz);
+    t_reorder.stop();
+    if (e != ReturnCode::SUCCESS) { r.status = "reordering_error"; break; }
+    t_factor.start();
+    e = sp.factor();
+    t_factor.stop();
+    if (e != ReturnCode::SUCCESS) r.status = "factor_error";
+    t_solve.start();
+    e = sp.solve(b, x);
+    t_solve.stop();
+    if (e != ReturnCode::SUCCESS && r.status == "ok")
+      r.status = "no_convergence";
+    r.reorder_time = std::min(r.reorder_time, t_reorder.elapsed());
+    r.factor_time = std::min(r.factor_time, t_factor.elapsed());
+    r.solve_time = std::min(r.solve_time, t_solve.elapsed());
+    r.factor_nonzeros = sp.factor_nonzeros();
+    r.Krylov_iterations = sp.Krylov_iterations();
+#if defined(STRUMPACK_COUNT_FLOPS)
+    r.flops = params::flops - f0;
+    r.peak_memory = params::peak_memory;
+#else
+    // without flop counting, only dense fronts report their flops
+    r.flops = 0.;
+    for (auto& f : sp.front_statistics()) r.flops += f.flops;
+#endif
+    r.residual = A.max_scaled_residual(x.data(), b.data());
+  }
+  r.max_rss = max_rss();
+  if (r.status == "reordering_error")
+    r.reorder_time = r.factor_time = r.solve_time = 0.;
+  return r;
+}
+
+int main(int argc, char* argv[]) {
+  std::string problem = "poisson3d", out = "benchmark.json";
+  int n = 30, reps = 3;
+  double c = 10.;
+  std::vector<ReorderingStrategy> orderings =
+    {ReorderingStrategy::METIS, ReorderingStrategy::GEOMETRIC,
+     ReorderingStrategy::AMD, ReorderingStrategy::MMD,
+     ReorderingStrategy::AND,
+#if defined(STRUMPACK_USE_SCOTCH)
+     ReorderingStrategy::SCOTCH,
+#endif
+    };
+  std::vector<CompressionType> compressions =
+    {CompressionType::NONE, CompressionType::BLR, CompressionType::HSS,
+#if defined(STRUMPACK_USE_BPACK)
+     CompressionType::HODLR, CompressionType::BLR_HODLR,
+#endif
+#if defined(STRUMPACK_USE_ZFP)
+     CompressionType::LOSSY, CompressionType::LOSSLESS,
+#endif
+    };
+  const std::vector<ReorderingStrategy> all_orderings =
+    {ReorderingStrategy::NATURAL, ReorderingStrategy::METIS,
+     ReorderingStrategy::SCOTCH, ReorderingStrategy::RCM,
+     ReorderingStrategy::GEOMETRIC, ReorderingStrategy::AMD,
+     ReorderingStrategy::MMD, ReorderingStrategy::AND};
+  const std::vector<CompressionType> all_compressions =
+    {CompressionType::NONE, CompressionType::HSS, CompressionType::BLR,
+     CompressionType::HODLR, CompressionType::BLR_HODLR,
+     CompressionType::ZFP_BLR_HODLR, CompressionType::LOSSY,
+     CompressionType::LOSSLESS};
+
+  for (int i=1; i<argc-1; i++) {
+    std::string a(argv[i]), v(argv[i+1]);
+    if (a == "--bench_problem") problem = v;
+    else if (a == "--bench_n") n = std::stoi(v);
+    else if (a == "--bench_reps") reps = std::max(1, std::stoi(v));
+    else if (a == "--bench_convection") c = std::stod(v);
+    else if (a == "--bench_out") out = v;
+    else if (a == "--bench_orderings") {
+      orderings.clear();
+      for (auto& s : split(v))
+        for (auto o : all_orderings)
+          if (same_name(s, get_name(o))) orderings.push_back(o);
+    } else if (a == "--bench_compressions") {
+      compressions.clear();
+      for (auto& s : split(v))
+        for (auto o : all_compressions)
+          if (same_name(s, get_name(o))) compressions.push_back(o);
+    } else continue;
+    i++;
+  }
+  std::cout << "# usage: ./sparse_benchmark"
+            << " --bench_problem [poisson2d|poisson3d|convdiff2d|"
+            << "convdiff3d|helmholtz3d]" << std::endl
+            << "#   --bench_n n --bench_reps r --bench_convection c"
+            << " --bench_out file.json" << std::endl
+            << "#   --bench_orderings Metis,Geometric,..."
+            << " --bench_compressions none,blr,..." << std::endl
+            << "#   and any of the solver options, see --help" << std::endl;
+
+  std::vector<Run> runs;
+  long long N = 0, nnz = 0;
+  auto bench = [&](auto& A, int nx, int ny, int nz) {
+    N = A.size();
+    nnz = A.nnz();
+    std::cout << "# " << problem << ", n = " << n << ", N = " << N
+              << ", nnz = " << nnz << std::endl;
+    for (auto o : orderings)
+      for (auto cmp : compressions) {
+        auto r = run(A, nx, ny, nz, o, cmp, reps, argc, argv);
+        std::cout << "#   " << r.ordering << " / " << r.compression
+                  << ": " << r.status
+                  << ", reorder " << r.reorder_time
+                  << " s, factor " << r.factor_time
+                  << " s, solve " << r.solve_time
+                  << " s, nnz(LU) " << r.factor_nonzeros
+                  << ", its " << r.Krylov_iterations << std::endl;
+        runs.push_back(r);
+      }
+  };
+  if (problem == "poisson2d") {
+    auto A = convection_diffusion<double>(n, n, 1, 0.);
+    bench(A, n, n, 1);
+  } else if (problem == "poisson3d") {
+    auto A = convection_diffusion<double>(n, n, n, 0.);
+    bench(A, n, n, n);
+  } else if (problem == "convdiff2d") {
+    auto A = convection_diffusion<double>(n, n, 1, c / (n+1));
+    bench(A, n, n, 1);
+  } else if (problem == "convdiff3d") {
+    auto A = convection_diffusion<double>(n, n, n, c / (n+1));
+    bench(A, n, n, n);
+  } else if (problem == "helmholtz3d") {
+    auto A = Helmholtz3D<std::complex<double>>(n);
+    int ne = std::max(1, n - 16) + 16;
+    bench(A, ne, ne, ne);
+  } else {
+    std::cerr << "# unknown problem " << problem << std::endl;
+    return 1;
+  }
+
+  int threads = 1;
+#if defined(_OPENMP)
+  threads = omp_get_max_threads();
+#endif
+  std::ofstream f(out);
+  f << "{\n  \"strumpack_version\": \"" << STRUMPACK_VERSION_MAJOR << "."
+    << STRUMPACK_VERSION_MINOR << "." << STRUMPACK_VERSION_PATCH << "\",\n"
+    << "  \"threads\": " << threads << ",\n"
+    << "  \"problem\": \"" << problem << "\",\n"
+    << "  \"n\": " << n << ",\n"
+    << "  \"N\": " << N << ",\n"
+    << "  \"nnz\": " << nnz << ",\n"
+    << "  \"reps\": " << reps << ",\n"
+    << "  \"runs\": [\n";
+  f.precision(6);
+  for (std::size_t i=0; i<runs.size(); i++) {
+    auto& r = runs[i];
+    f << "    {\"ordering\": \"" << r.ordering << "\", "
+      << "\"compression\": \"" << r.compression << "\", "
+      << "\"status\": \"" << r.status << "\",\n"
+      << "     \"reorder_time\": " << r.reorder_time << ", "
+      << "\"factor_time\": " << r.factor_time << ", "
+      << "\"solve_time\": " << r.solve_time << ",\n"
+      << "     \"factor_nonzeros\": " << r.factor_nonzeros << ", "
+      << "\"peak_memory\": " << r.peak_memory << ", "
+      << "\"max_rss\": " << r.max_rss << ",\n"
+      << "     \"Krylov_iterations\": " << r.Krylov_iterations << ", "
+      << "\"flops\": " << r.flops << ", "
+      << "\"GFlops\": "
+      << (r.factor_time > 0 ? r.flops / r.factor_time / 1e9 : 0.) << ", "
+      << "\"residual\": " << r.residual << "}"
+      << (i+1 < runs.size() ? ",\n" : "\n");
+  }
+  f << "  ]\n}" << std::endl;
+  std::cout << "# results written to " << out << std::endl;
+  return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "clustering/NeighborSearch.hpp"
+#include "kernel/Metrics.hpp"
+#include "misc/TaskTimer.hpp"
+
+using namespace std;
+using namespace strumpack;
+
+template<typename scalar_t> vector<scalar_t>
+read_from_file(string filename) {
+  vector<scalar_t> data;
+  ifstream f(filename);
+  string l;
+  while (getline(f, l)) {
+    istringstream sl(l);
+    string s;
+    while (getline(sl, s, ','))
+      data.push_back(stod(s));
+  }
+  data.shrink_to_fit();
+  return data;
+}
+
+/**
+ * Approximate nearest neighbor search, accuracy versus time. For a
+ * number of randomized projection tree iterations, this reports the
+ * time of find_approximate_neighbors, and the recall with respect to
+ * the exact k nearest neighbors, computed for a random sample of the
+ * points.
+ */
+int main(int argc, char *argv[]) {
+  using scalar_t = double;
+  string filename("./data/susy_10Kn_train.csv");
+  size_t d = 8, k = 64, max_iters = 10, nr_samples = 200;
+
+  cout << "# usage: ./ANNBenchmark file d k max_iters" << endl;
+  if (argc > 1) filename = string(argv[1]);
+  if (argc > 2) d = stoi(argv[2]);
+  if (argc > 3) k = stoi(argv[3]);
+  if (argc > 4) max_iters = stoi(argv[4]);
+
+  auto points = read_from_file<scalar_t>(filename);
+  size_t n = points.size() / d;
+  if (!n) {
+    cerr << "# could not read " << filename << endl;
+    return 1;
+  }
+  k = std::min(k, n);
+  cout << "# dataset = " << n << " x " << d
+       << ", k = " << k << endl;
+  DenseMatrixWrapper<scalar_t> data(d, n, points.data(), d);
+
+  // exact neighbors for a random sample of the points
+  mt19937 gen(0);
+  uniform_int_distribution<size_t> uni(0, n-1);
+  vector<size_t> samples(nr_samples);
+  for (auto& s : samples) s = uni(gen);
+  vector<vector<uint32_t>> exact(nr_samples);
+  {
+    vector<scalar_t> dist(n);
+    vector<uint32_t> idx(n);
+    for (size_t s=0; s<nr_samples; s++) {
+      for (size_t j=0; j<n; j++)
+        dist[j] = Euclidean_distance_squared
+          (d, &data(0, samples[s]), &data(0, j));
+      iota(idx.begin(), idx.end(), 0);
+      nth_element
+        (idx.begin(), idx.begin()+k-1, idx.end(),
+         [&](uint32_t a, uint32_t b) {
+           return dist[a] < dist[b] || (dist[a] == dist[b] && a < b); });
+      exact[s].assign(idx.begin(), idx.begin()+k);
+      sort(exact[s].begin(), exact[s].end());
+    }
+  }
+
+  cout << "# iters  time(s)  recall" << endl;
+  for (size_t it=0; it<=max_iters; it++) {
+    DenseMatrix<uint32_t> neighbors;
+    DenseMatrix<scalar_t> scores;
+    TaskTimer timer("ANN");
+    timer.start();
+    find_approximate_neighbors(data, it, k, neighbors, scores);
+    auto t = timer.elapsed();
+    size_t found = 0;
+    vector<uint32_t> approx(k);
+    for (size_t s=0; s<nr_samples; s++) {
+      for (size_t j=0; j<k; j++)
+        approx[j] = neighbors(j, samples[s]);
+      sort(approx.begin(), approx.end());
+      vector<uint32_t> common;
+      set_intersection(approx.begin(), approx.end(),
+                       exact[s].begin(), exact[s].end(),
+                       back_inserter(common));
+      found += common.size();
+    }
+    cout << "  " << it << "  " << t << "  "
+         << double(found) / (k * nr_samples) << endl;
+  }
+  return 0;
+}
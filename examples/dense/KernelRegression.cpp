@@ -122,6 +122,15 @@ int main(int argc, char *argv[]) {
   auto prediction = K->predict(test_points, weights);
   cout << "# prediction took " << timer.elapsed() << endl;
 
+  timer.start();
+  auto prediction_tc = K->predict(test_points, weights, scalar_t(1e-4));
+  cout << "# tree code prediction (tol=1e-4) took "
+       << timer.elapsed() << endl;
+  scalar_t err_tc(0.);
+  for (size_t i=0; i<m; i++)
+    err_tc = std::max(err_tc, std::abs(prediction[i] - prediction_tc[i]));
+  cout << "# max |prediction - tree code prediction| = " << err_tc << endl;
+
   // compute accuracy score of prediction
   size_t incorrect_quant = 0;
   for (size_t i=0; i<m; i++)
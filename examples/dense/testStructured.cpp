@@ -254,10 +254,12 @@ int main(int argc, char* argv[]) {
   std::vector<structured::Type> types =
     {structured::Type::BLR,
      structured::Type::HSS,
+     structured::Type::HODLR,
      structured::Type::LOSSY,
      structured::Type::LOSSLESS
     };
-  // the HODLR, HODBF, Butterfly and LR types require MPI support, see
+  // without MPI, HODLR uses a native (low-rank only) implementation,
+  // the HODBF, Butterfly and LR types require MPI support, see
   // testStructuredMPI
 
 
@@ -36,6 +36,7 @@
 
 #include "misc/Tools.hpp"
 #include "BLRTileBLAS.hpp"
+#include "BLRBatchCPU.hpp"
 #if defined(STRUMPACK_USE_MAGMA)
 #include "dense/MAGMAWrapper.hpp"
 #endif
@@ -68,55 +69,6 @@ namespace strumpack {
     };
 
 
-    template<typename scalar_t> void
-    multiply_inc_work_size(const BLRTile<scalar_t>& A,
-                           const BLRTile<scalar_t>& B,
-                           std::size_t& temp1, std::size_t& temp2) {
-      if (A.is_low_rank()) {
-        if (B.is_low_rank()) {
-          temp1 += A.rank() * B.rank();
-          temp2 += (B.rank() < A.rank()) ?
-            A.rows() * B.rank() : A.rank() * B.cols();
-        } else temp1 += A.rank() * B.cols();
-      } else if (B.is_low_rank())
-        temp1 += A.rows() * B.rank();
-    }
-
-    template<typename scalar_t> void
-    add_tile_mult(BLRTile<scalar_t>& A, BLRTile<scalar_t>& B,
-                  DenseMatrix<scalar_t>& C, VBatchedGEMM<scalar_t>& b1,
-                  VBatchedGEMM<scalar_t>& b2, VBatchedGEMM<scalar_t>& b3,
-                  scalar_t*& d1, scalar_t*& d2) {
-      auto m = A.rows(), n = B.cols(), k = A.cols(),
-        r1 = A.rank(), r2 = B.rank();
-      if (A.is_low_rank()) {
-        if (B.is_low_rank()) {
-          b1.add(r1, r2, k, A.V().data(), B.U().data(), d1);
-          if (r2 < r1) {
-            b2.add(m, r2, r1, A.U().data(), d1, d2);
-            b3.add(m, n, r2, d2, B.V().data(), C.data(), C.ld());
-            d2 += m * r2;
-          } else {
-            b2.add(r1, n, r2, d1, B.V().data(), d2);
-            b3.add(m, n, r1, A.U().data(), d2, C.data(), C.ld());
-            d2 += r1 * n;
-          }
-          d1 += r1 * r2;
-        } else {
-          b1.add(r1, n, k, A.V().data(), B.D().data(), d1);
-          b3.add(m, n, r1, A.U().data(), d1, C.data(), C.ld());
-          d1 += r1 * n;
-        }
-      } else {
-        if (B.is_low_rank()) {
-          b1.add(m, r2, k, A.D().data(), B.U().data(), d1);
-          b3.add(m, n, r2, d1, B.V().data(), C.data(), C.ld());
-          d1 += m * r2;
-        } else
-          b3.add(m, n, k, A.D().data(), B.D().data(), C.data(), C.ld());
-      }
-    }
-
     template<typename scalar_t> class VBatchedTRSMLeftRight {
       using DenseM_t = DenseMatrix<scalar_t>;
     public:
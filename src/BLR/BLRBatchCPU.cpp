@@ -0,0 +1,166 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+#include <algorithm>
+#include <numeric>
+
+#include "BLRBatchCPU.hpp"
+
+namespace strumpack {
+  namespace BLR {
+
+    template<typename scalar_t> void
+    BatchedGEMM<scalar_t>::add(int m, int n, int k,
+                               scalar_t* A, scalar_t* B, scalar_t* C) {
+      add(m, n, k, A, m, B, k, C, m);
+    }
+
+    template<typename scalar_t> void
+    BatchedGEMM<scalar_t>::add(int m, int n, int k,
+                               scalar_t* A, scalar_t* B,
+                               scalar_t* C, int ldC) {
+      add(m, n, k, A, m, B, k, C, ldC);
+    }
+
+    template<typename scalar_t> void
+    BatchedGEMM<scalar_t>::add(int m, int n, int k,
+                               const scalar_t* A, int ldA,
+                               const scalar_t* B, int ldB,
+                               scalar_t* C, int ldC) {
+      add(Trans::N, Trans::N, m, n, k, A, ldA, B, ldB, C, ldC);
+    }
+
+    template<typename scalar_t> void
+    BatchedGEMM<scalar_t>::add(Trans ta, Trans tb, int m, int n, int k,
+                               const scalar_t* A, int ldA,
+                               const scalar_t* B, int ldB,
+                               scalar_t* C, int ldC) {
+      assert(ldA >= (ta == Trans::N ? m : k));
+      assert(ldB >= (tb == Trans::N ? k : n));
+      assert(ldC >= m);
+      if (m == 0 || n == 0) return;
+      ops_.push_back({ta, tb, m, n, k, std::max(1, ldA), std::max(1, ldB),
+          std::max(1, ldC), A, B, C});
+    }
+
+    template<typename scalar_t> void
+    BatchedGEMM<scalar_t>::add(Trans ta, Trans tb,
+                               const DenseMatrix<scalar_t>& A,
+                               const DenseMatrix<scalar_t>& B,
+                               DenseMatrix<scalar_t>& C) {
+      int k = (ta == Trans::N) ? A.cols() : A.rows();
+      assert(k == int((tb == Trans::N) ? B.rows() : B.cols()));
+      add(ta, tb, C.rows(), C.cols(), k, A.data(), A.ld(),
+          B.data(), B.ld(), C.data(), C.ld());
+    }
+
+    template<typename scalar_t> void
+    BatchedGEMM<scalar_t>::small_gemm(const GEMMOp& op,
+                                      scalar_t alpha, scalar_t beta) {
+      // element l of column j of op(B)
+      auto opB = [&op](int l, int j) {
+        switch (op.tb) {
+        case Trans::T: return op.B[j+l*op.ldB];
+        case Trans::C: return blas::my_conj(op.B[j+l*op.ldB]);
+        default: return op.B[l+j*op.ldB];
+        }
+      };
+      for (int j=0; j<op.n; j++) {
+        auto c = op.C + j*op.ldC;
+        if (beta == scalar_t(0.)) {
+#pragma omp simd
+          for (int i=0; i<op.m; i++) c[i] = scalar_t(0.);
+        } else if (beta != scalar_t(1.)) {
+#pragma omp simd
+          for (int i=0; i<op.m; i++) c[i] *= beta;
+        }
+        for (int l=0; l<op.k; l++) {
+          auto a = op.A + l*op.ldA;
+          auto b = alpha * opB(l, j);
+#pragma omp simd
+          for (int i=0; i<op.m; i++) c[i] += a[i] * b;
+        }
+      }
+    }
+
+    template<typename scalar_t> long long int
+    BatchedGEMM<scalar_t>::run(scalar_t alpha, scalar_t beta,
+                               int task_depth) {
+      std::size_t batchcount = ops_.size();
+      if (!batchcount) return 0;
+      // sort by shape, largest first, so that operations with the
+      // same size are executed together, and the expensive ones are
+      // not left for the end
+      std::vector<std::size_t> idx(batchcount);
+      std::iota(idx.begin(), idx.end(), 0);
+      std::sort(idx.begin(), idx.end(),
+                [&](std::size_t a, std::size_t b) {
+                  const auto& oa = ops_[a];
+                  const auto& ob = ops_[b];
+                  auto fa = std::size_t(oa.m)*oa.n*oa.k,
+                    fb = std::size_t(ob.m)*ob.n*ob.k;
+                  if (fa != fb) return fa > fb;
+                  if (oa.m != ob.m) return oa.m < ob.m;
+                  if (oa.n != ob.n) return oa.n < ob.n;
+                  return oa.k < ob.k;
+                });
+      long long flops = 0, bytes = 0;
+      for (auto& op : ops_) {
+        flops += (is_complex<scalar_t>()?4:1) *
+          blas::gemm_flops(op.m, op.n, op.k, alpha, beta);
+        bytes += sizeof(scalar_t) * blas::gemm_moves(op.m, op.n, op.k);
+      }
+#if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
+#pragma omp taskloop default(shared) grainsize(1)       \
+  if(task_depth < params::task_recursion_cutoff_level)
+#endif
+      for (std::size_t b=0; b<batchcount; b++) {
+        const auto& op = ops_[idx[b]];
+        // the simple loops are only faster than BLAS when A is not
+        // transposed
+        if (op.ta == Trans::N &&
+            std::size_t(op.m)*op.n*op.k <= small_gemm_max)
+          small_gemm(op, alpha, beta);
+        else
+          blas::gemm(char(op.ta), char(op.tb), op.m, op.n, op.k,
+                     alpha, op.A, op.ldA, op.B, op.ldB, beta,
+                     op.C, op.ldC);
+      }
+      STRUMPACK_FLOPS(flops);
+      STRUMPACK_BYTES(bytes);
+      return flops;
+    }
+
+    // explicit template instantiations
+    template class BatchedGEMM<float>;
+    template class BatchedGEMM<double>;
+    template class BatchedGEMM<std::complex<float>>;
+    template class BatchedGEMM<std::complex<double>>;
+
+  } // end namespace BLR
+} // end namespace strumpack
@@ -0,0 +1,181 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+/*! \file BLRBatchCPU.hpp
+ * \brief Contains batched routines on BLRTiles, executed on the CPU.
+ */
+#ifndef BLR_BATCH_CPU_HPP
+#define BLR_BATCH_CPU_HPP
+
+#include <cassert>
+#include <vector>
+
+#include "misc/Tools.hpp"
+#include "BLRTileBLAS.hpp"
+
+namespace strumpack {
+  namespace BLR {
+
+    /**
+     * \class BatchedGEMM
+     *
+     * \brief Batch of independent, variable size, small GEMM
+     * operations C_i = alpha A_i B_i + beta C_i, on the CPU.
+     *
+     * The operations are sorted by shape when the batch is run, so
+     * that operations of the same size are executed together, the
+     * most expensive first. Very small products use a simple SIMD
+     * kernel instead of calling BLAS, to avoid the BLAS call
+     * overhead which dominates for tiles with small rank. The C_i
+     * should not overlap, since the operations are executed
+     * concurrently. Each operation can (conjugate) transpose A_i
+     * and/or B_i, C_i = alpha op(A_i) op(B_i) + beta C_i.
+     *
+     * This is the CPU counterpart of VBatchedGEMM.
+     *
+     * \tparam scalar_t float, double, std::complex<float> or
+     * std::complex<double>
+     */
+    template<typename scalar_t> class BatchedGEMM {
+    public:
+      BatchedGEMM() = default;
+      BatchedGEMM(std::size_t B) { ops_.reserve(B); }
+
+      void add(int m, int n, int k,
+               scalar_t* A, scalar_t* B, scalar_t* C);
+      void add(int m, int n, int k,
+               scalar_t* A, scalar_t* B, scalar_t* C, int ldC);
+      void add(int m, int n, int k, const scalar_t* A, int ldA,
+               const scalar_t* B, int ldB, scalar_t* C, int ldC);
+      void add(Trans ta, Trans tb, int m, int n, int k,
+               const scalar_t* A, int ldA, const scalar_t* B, int ldB,
+               scalar_t* C, int ldC);
+      void add(Trans ta, Trans tb, const DenseMatrix<scalar_t>& A,
+               const DenseMatrix<scalar_t>& B, DenseMatrix<scalar_t>& C);
+
+      std::size_t size() const { return ops_.size(); }
+
+      /**
+       * Execute all operations in the batch, with the same alpha
+       * and beta.
+       *
+       * \return number of flops performed
+       */
+      long long int run(scalar_t alpha, scalar_t beta, int task_depth);
+
+      /**
+       * Products with op(A) = A and m*n*k up to this size are
+       * computed with the small GEMM kernel, the others call BLAS.
+       */
+      static const std::size_t small_gemm_max = 32*32*32;
+
+    private:
+      struct GEMMOp {
+        Trans ta, tb;
+        int m, n, k, ldA, ldB, ldC;
+        const scalar_t *A, *B;
+        scalar_t *C;
+      };
+      std::vector<GEMMOp> ops_;
+
+      static void small_gemm(const GEMMOp& op,
+                             scalar_t alpha, scalar_t beta);
+    };
+
+
+    template<typename scalar_t> void
+    multiply_inc_work_size(const BLRTile<scalar_t>& A,
+                           const BLRTile<scalar_t>& B,
+                           std::size_t& temp1, std::size_t& temp2) {
+      if (A.is_low_rank()) {
+        if (B.is_low_rank()) {
+          temp1 += A.rank() * B.rank();
+          temp2 += (B.rank() < A.rank()) ?
+            A.rows() * B.rank() : A.rank() * B.cols();
+        } else temp1 += A.rank() * B.cols();
+      } else if (B.is_low_rank())
+        temp1 += A.rows() * B.rank();
+    }
+
+    /**
+     * Add the operations to compute C -= A*B, for BLR tiles A and B,
+     * to 3 batches. Batch b1 and b2 compute temporary products,
+     * stored in d1 and d2, and b3 does the final update of C. So b1
+     * should be executed before b2, and b2 before b3. The pointers
+     * d1 and d2 are advanced, the required sizes can be computed
+     * with multiply_inc_work_size.
+     *
+     * \tparam batch_t VBatchedGEMM or BatchedGEMM
+     */
+    template<typename scalar_t, typename batch_t> void
+    add_tile_mult(BLRTile<scalar_t>& A, BLRTile<scalar_t>& B,
+                  DenseMatrix<scalar_t>& C, batch_t& b1,
+                  batch_t& b2, batch_t& b3,
+                  scalar_t*& d1, scalar_t*& d2) {
+      auto m = A.rows(), n = B.cols(), k = A.cols(),
+        r1 = A.rank(), r2 = B.rank();
+      if (A.is_low_rank()) {
+        auto& AU = A.U(); auto& AV = A.V();
+        if (B.is_low_rank()) {
+          auto& BU = B.U(); auto& BV = B.V();
+          b1.add(r1, r2, k, AV.data(), AV.ld(), BU.data(), BU.ld(), d1, r1);
+          if (r2 < r1) {
+            b2.add(m, r2, r1, AU.data(), AU.ld(), d1, r1, d2, m);
+            b3.add(m, n, r2, d2, m, BV.data(), BV.ld(), C.data(), C.ld());
+            d2 += m * r2;
+          } else {
+            b2.add(r1, n, r2, d1, r1, BV.data(), BV.ld(), d2, r1);
+            b3.add(m, n, r1, AU.data(), AU.ld(), d2, r1, C.data(), C.ld());
+            d2 += r1 * n;
+          }
+          d1 += r1 * r2;
+        } else {
+          auto& BD = B.D();
+          b1.add(r1, n, k, AV.data(), AV.ld(), BD.data(), BD.ld(), d1, r1);
+          b3.add(m, n, r1, AU.data(), AU.ld(), d1, r1, C.data(), C.ld());
+          d1 += r1 * n;
+        }
+      } else {
+        auto& AD = A.D();
+        if (B.is_low_rank()) {
+          auto& BU = B.U(); auto& BV = B.V();
+          b1.add(m, r2, k, AD.data(), AD.ld(), BU.data(), BU.ld(), d1, m);
+          b3.add(m, n, r2, d1, m, BV.data(), BV.ld(), C.data(), C.ld());
+          d1 += m * r2;
+        } else {
+          auto& BD = B.D();
+          b3.add(m, n, k, AD.data(), AD.ld(), BD.data(), BD.ld(),
+                 C.data(), C.ld());
+        }
+      }
+    }
+
+  } // end namespace BLR
+} // end namespace strumpack
+
+#endif // BLR_BATCH_CPU_HPP
@@ -127,6 +127,90 @@ namespace strumpack {
           sbuf[pr[r]+pcc].push_back(CB(r,c));
     }
 
+    template<typename scalar_t,typename integer_t> void
+    BLRExtendAdd<scalar_t,integer_t>::copy_to_buffers_compressed
+    (const BLRMPI_t& CB, VVS_t& sbuf, const FBLRMPI_t* pa, const VI_t& I,
+     const Opts_t& opts) {
+      if (!CB.active()) return;
+      const int lrows = CB.lrows();
+      const int lcols = CB.lcols();
+      const std::size_t pa_sep = pa->dim_sep();
+      const int nprows = pa->grid2d().nprows();
+      const int npcols = pa->grid2d().npcols();
+      // process row/column in the parent for each local row/column
+      std::vector<int> pr(lrows), pc(lcols);
+      for (int r=0; r<lrows; r++) {
+        auto t = I[CB.rl2g(r)];
+        pr[r] = (t < pa_sep) ? pa->sep_rg2p(t) : pa->upd_rg2p(t-pa_sep);
+      }
+      for (int c=0; c<lcols; c++) {
+        auto t = I[CB.cl2g(c)];
+        pc[c] = (t < pa_sep) ? pa->sep_cg2p(t) : pa->upd_cg2p(t-pa_sep);
+      }
+      const auto g = CB.grid();
+      const std::size_t lbr = CB.rowblockslocal(), lbc = CB.colblockslocal();
+      auto tr = [&](std::size_t i) { return g->prow() + i * g->nprows(); };
+      auto tc = [&](std::size_t j) { return g->pcol() + j * g->npcols(); };
+      // compress the off-diagonal tiles, only keep the ones that pay off
+      std::vector<std::unique_ptr<LRTile<scalar_t>>> LR(lbr*lbc);
+#pragma omp parallel
+#pragma omp single nowait
+      for (std::size_t j=0; j<lbc; j++)
+        for (std::size_t i=0; i<lbr; i++)
+          if (tr(i) != tc(j))
+#pragma omp task default(shared) firstprivate(i,j)
+            {
+              auto t = CB.ltile(i, j).compress
+                (opts, tr(i) + tc(j) * CB.rowblocks());
+              if (t->rank()*(t->rows() + t->cols()) < t->rows()*t->cols())
+                LR[i+j*lbr] = std::move(t);
+            }
+      // for each tile, and each destination process, send a header
+      // (the rank, or -1 for dense), followed by the selected rows of
+      // U and columns of V, or by the dense sub-block
+      std::vector<std::vector<int>> R(nprows), C(npcols);
+      for (std::size_t j=0, c0=0; j<lbc; j++) {
+        const int n = CB.tilecols(tc(j));
+        for (auto& Cp : C) Cp.clear();
+        for (int c=0; c<n; c++) C[pc[c0+c]].push_back(c);
+        for (std::size_t i=0, r0=0; i<lbr; i++) {
+          const int m = CB.tilerows(tr(i));
+          for (auto& Rp : R) Rp.clear();
+          for (int r=0; r<m; r++) R[pr[r0+r]].push_back(r);
+          const auto& T = CB.ltile(i, j);
+          const auto& L = LR[i+j*lbr];
+          const std::size_t k = L ? L->rank() : 0;
+          for (int qc=0; qc<npcols; qc++) {
+            const auto& Cp = C[qc];
+            if (Cp.empty()) continue;
+            for (int qr=0; qr<nprows; qr++) {
+              const auto& Rp = R[qr];
+              if (Rp.empty()) continue;
+              auto& buf = sbuf[qr+qc*nprows];
+              if (L && k*(Rp.size()+Cp.size()) < Rp.size()*Cp.size()) {
+                const auto& U = L->U();
+                const auto& V = L->V();
+                buf.push_back(scalar_t(k));
+                for (std::size_t l=0; l<k; l++)
+                  for (auto r : Rp)
+                    buf.push_back(U(r, l));
+                for (auto c : Cp)
+                  for (std::size_t l=0; l<k; l++)
+                    buf.push_back(V(l, c));
+              } else {
+                buf.push_back(scalar_t(-1));
+                for (auto c : Cp)
+                  for (auto r : Rp)
+                    buf.push_back(T(r, c));
+              }
+            }
+          }
+          r0 += m;
+        }
+        c0 += n;
+      }
+    }
+
     template<typename scalar_t,typename integer_t> void
     BLRExtendAdd<scalar_t,integer_t>::copy_to_buffers_col
     (const DistM_t& CB, VVS_t& sbuf, const FBLRMPI_t* pa, const VI_t& I,
@@ -602,6 +686,94 @@ namespace strumpack {
       }
     }
 
+    template<typename scalar_t,typename integer_t> void
+    BLRExtendAdd<scalar_t,integer_t>::copy_from_buffers_compressed
+    (BLRMPI_t& F11, BLRMPI_t& F12, BLRMPI_t& F21, BLRMPI_t& F22,
+     scalar_t** pbuf, const FBLRMPI_t* pa, const FBLRMPI_t* ch) {
+      assert(pa != nullptr);
+      if (!pa->grid2d().active()) return;
+      const std::size_t ch_dim_upd = ch->dim_upd();
+      const std::size_t leaf = ch->leaf_;
+      if (!ch_dim_upd || !leaf) return;
+      const int chprows = ch->grid2d().nprows();
+      const int chpcols = ch->grid2d().npcols();
+      const auto& ch_upd = ch->upd();
+      const auto& pa_upd = pa->upd();
+      const auto pa_sep = pa->sep_begin();
+      const int r1 = F11.lrows(), c1 = F11.lcols();
+      // local row/column in the parent, for each row/column of the
+      // child CB, or -1 if not local. Rows/columns of F22 are
+      // numbered after those of F11.
+      std::vector<int> rmap(ch_dim_upd, -1), cmap(ch_dim_upd, -1);
+      for (std::size_t r=0, ur=0; r<F11.lrows(); r++) {
+        integer_t fgr = F11.rl2g(r) + pa_sep;
+        while (ur < ch_dim_upd && ch_upd[ur] < fgr) ur++;
+        if (ur == ch_dim_upd) break;
+        if (ch_upd[ur] == fgr) rmap[ur] = r;
+      }
+      for (std::size_t c=0, uc=0; c<F11.lcols(); c++) {
+        integer_t fgc = F11.cl2g(c) + pa_sep;
+        while (uc < ch_dim_upd && ch_upd[uc] < fgc) uc++;
+        if (uc == ch_dim_upd) break;
+        if (ch_upd[uc] == fgc) cmap[uc] = c;
+      }
+      for (std::size_t r=0, ur=0; r<F22.lrows(); r++) {
+        auto fgr = pa_upd[F22.rl2g(r)];
+        while (ur < ch_dim_upd && ch_upd[ur] < fgr) ur++;
+        if (ur == ch_dim_upd) break;
+        if (ch_upd[ur] == fgr) rmap[ur] = r1 + r;
+      }
+      for (std::size_t c=0, uc=0; c<F22.lcols(); c++) {
+        auto fgc = pa_upd[F22.cl2g(c)];
+        while (uc < ch_dim_upd && ch_upd[uc] < fgc) uc++;
+        if (uc == ch_dim_upd) break;
+        if (ch_upd[uc] == fgc) cmap[uc] = c1 + c;
+      }
+      auto add = [&](int r, int c, scalar_t v) {
+        if (r < r1) {
+          if (c < c1) F11(r, c) += v;
+          else F12(r, c-c1) += v;
+        } else {
+          if (c < c1) F21(r-r1, c) += v;
+          else F22(r-r1, c-c1) += v;
+        }
+      };
+      std::vector<int> R, C;
+      DenseM_t D;
+      // same order as in copy_to_buffers_compressed: loop over the
+      // tiles of the child CB owned by each source process
+      for (int q=0; q<chprows*chpcols; q++) {
+        auto& b = pbuf[q];
+        for (std::size_t tc=q/chprows; tc*leaf<ch_dim_upd; tc+=chpcols) {
+          C.clear();
+          for (auto uc=tc*leaf; uc<std::min((tc+1)*leaf, ch_dim_upd); uc++)
+            if (cmap[uc] >= 0) C.push_back(cmap[uc]);
+          if (C.empty()) continue;
+          for (std::size_t tr=q%chprows; tr*leaf<ch_dim_upd; tr+=chprows) {
+            R.clear();
+            for (auto ur=tr*leaf; ur<std::min((tr+1)*leaf, ch_dim_upd); ur++)
+              if (rmap[ur] >= 0) R.push_back(rmap[ur]);
+            if (R.empty()) continue;
+            const std::size_t m = R.size(), n = C.size();
+            const int k = int(std::real(*b++));
+            if (k < 0) {
+              for (std::size_t c=0; c<n; c++)
+                for (std::size_t r=0; r<m; r++)
+                  add(R[r], C[c], *b++);
+            } else if (k > 0) {
+              DenseMW_t U(m, k, b, m), V(k, n, b+m*k, k);
+              b += k*(m+n);
+              D = DenseM_t(m, n);
+              gemm(Trans::N, Trans::N, scalar_t(1.), U, V, scalar_t(0.), D);
+              for (std::size_t c=0; c<n; c++)
+                for (std::size_t r=0; r<m; r++)
+                  add(R[r], C[c], D(r, c));
+            }
+          }
+        }
+      }
+    }
+
     template<typename scalar_t,typename integer_t> void
     BLRExtendAdd<scalar_t,integer_t>::seq_copy_to_buffers
     (const DenseM_t& CB, VVS_t& sbuf, const FBLRMPI_t* pa, const F_t* ch) {
@@ -43,6 +43,7 @@ namespace strumpack {
 
     template<typename scalar_t,typename integer_t> class BLRExtendAdd {
       using DenseM_t = DenseMatrix<scalar_t>;
+      using DenseMW_t = DenseMatrixWrapper<scalar_t>;
       using DistM_t = DistributedMatrix<scalar_t>;
       using BLR_t = BLRMatrix<scalar_t>;
       using BLRMPI_t = BLRMatrixMPI<scalar_t>;
@@ -51,6 +52,7 @@ namespace strumpack {
       using FBLRMPI_t = FrontBLRMPI<scalar_t,integer_t>;
       using VI_t = std::vector<std::size_t>;
       using VVS_t = std::vector<std::vector<scalar_t>>;
+      using Opts_t = BLROptions<scalar_t>;
 
     public:
       static void
@@ -68,6 +70,18 @@ namespace strumpack {
                           const FBLRMPI_t* pa, const VI_t& I,
                           integer_t begin_col, integer_t end_col);
 
+      /**
+       * Same as copy_to_buffers, but the off-diagonal tiles of CB
+       * are compressed first. For each destination process, only
+       * the rows of U and the columns of V mapping to that process
+       * are sent, unless the dense sub-block is smaller. Needs to be
+       * matched with copy_from_buffers_compressed.
+       */
+      static void
+      copy_to_buffers_compressed(const BLRMPI_t& CB, VVS_t& sbuf,
+                                 const FBLRMPI_t* pa, const VI_t& I,
+                                 const Opts_t& opts);
+
       static void
       copy_from_buffers(BLRMPI_t& F11, BLRMPI_t& F12,
                         BLRMPI_t& F21, BLRMPI_t& F22, scalar_t** pbuf,
@@ -86,6 +100,11 @@ namespace strumpack {
                             BLRMPI_t& F21, BLRMPI_t& F22, scalar_t** pbuf,
                             const FBLRMPI_t* pa, const FBLRMPI_t* ch,
                             integer_t begin_col, integer_t end_col);
+      static void
+      copy_from_buffers_compressed(BLRMPI_t& F11, BLRMPI_t& F12,
+                                   BLRMPI_t& F21, BLRMPI_t& F22,
+                                   scalar_t** pbuf, const FBLRMPI_t* pa,
+                                   const FBLRMPI_t* ch);
 
       static void
       seq_copy_to_buffers(const DenseM_t& CB, VVS_t& sbuf,
@@ -33,6 +33,8 @@
 
 #include "BLRMatrix.hpp"
 #include "BLRTileBLAS.hpp"
+#include "BLRBatchCPU.hpp"
+#include "LRTileMP.hpp"
 
 namespace strumpack {
   namespace BLR {
@@ -116,6 +118,18 @@ namespace strumpack {
                                              const Opts_t& opts) {
       auto A = A_;
       assert(rowblocks() == colblocks());
+      if (opts.batched_update() &&
+          opts.BLR_factor_algorithm() == BLRFactorAlgorithm::RL) {
+        std::vector<std::size_t> tiles(rowblocks()), tiles2;
+        for (std::size_t i=0; i<rowblocks(); i++)
+          tiles[i] = tilerows(i);
+        DenseM_t A12(rows(), 0), A21(0, cols()), A22;
+        BLRM_t B12, B21;
+        construct_and_partial_factor_batched
+          (A, A12, A21, A22, *this, B12, B21,
+           tiles, tiles2, admissible, opts);
+        return;
+      }
       piv_.resize(rows());
       auto rb = rowblocks();
 #if defined(STRUMPACK_USE_OPENMP_TASK_DEPEND)
@@ -276,7 +290,7 @@ namespace strumpack {
     BLRMatrix<scalar_t>::memory() const {
       std::size_t mem = 0;
       for (auto& b : blocks_) mem += b->memory();
-      return mem;
+      return mem + storage_.memory();
     }
 
     template<typename scalar_t> std::size_t
@@ -367,6 +381,105 @@ namespace strumpack {
       roff_.clear(); roff_.shrink_to_fit();
       coff_.clear(); coff_.shrink_to_fit();
       blocks_.clear(); blocks_.shrink_to_fit();
+      storage_ = DenseM_t();
+    }
+
+    template<typename scalar_t> void
+    BLRMatrix<scalar_t>::convert_to_mixed_precision(const Opts_t& opts) {
+      auto B = blocks_.size();
+#if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
+#pragma omp taskloop default(shared)
+#endif
+      for (std::size_t b=0; b<B; b++) {
+        auto lr = dynamic_cast<LRTile<scalar_t>*>(blocks_[b].get());
+        if (!lr) continue;
+        auto t = LRTileMP<scalar_t>::create(*lr, opts);
+        if (t) blocks_[b] = std::move(t);
+      }
+    }
+
+    template<typename scalar_t> void
+    BLRMatrix<scalar_t>::reset_keep_ranks
+    (BLRM_t& B, std::size_t m, const std::vector<std::size_t>& rowtiles,
+     std::size_t n, const std::vector<std::size_t>& coltiles) {
+      std::vector<int> ranks;
+      if (B.rowblocks() == rowtiles.size() &&
+          B.colblocks() == coltiles.size() &&
+          std::all_of(B.blocks_.begin(), B.blocks_.end(),
+                      [](const std::unique_ptr<BLRTile<scalar_t>>& b) {
+                        return bool(b); }))
+        ranks = B.tile_ranks();
+      else if (B.rank_hint_.size() == rowtiles.size()*coltiles.size())
+        ranks = std::move(B.rank_hint_);
+      B = BLRM_t(m, rowtiles, n, coltiles);
+      B.rank_hint_ = std::move(ranks);
+    }
+
+    template<typename scalar_t> std::vector<int>
+    BLRMatrix<scalar_t>::tile_ranks() const {
+      std::vector<int> ranks(blocks_.size());
+      for (std::size_t b=0; b<blocks_.size(); b++) {
+        assert(blocks_[b]);
+        ranks[b] = blocks_[b]->is_low_rank() ? blocks_[b]->rank() : -1;
+      }
+      return ranks;
+    }
+
+    template<typename scalar_t> std::size_t
+    BLRMatrix<scalar_t>::packed_size(const std::vector<int>& ranks) const {
+      assert(ranks.size() == nbrows_*nbcols_);
+      std::size_t s = 0;
+      for (std::size_t j=0, b=0; j<nbcols_; j++)
+        for (std::size_t i=0; i<nbrows_; i++, b++)
+          s += (ranks[b] == -1) ? tilerows(i)*tilecols(j) :
+            ranks[b]*(tilerows(i)+tilecols(j));
+      return s;
+    }
+
+    template<typename scalar_t> void BLRMatrix<scalar_t>::pack() {
+      if (packed() || blocks_.empty()) return;
+      auto ranks = tile_ranks();
+      std::vector<std::size_t> offset(blocks_.size()+1);
+      for (std::size_t j=0, b=0; j<nbcols_; j++)
+        for (std::size_t i=0; i<nbrows_; i++, b++)
+          offset[b+1] = offset[b] + ((ranks[b] == -1) ?
+                                     tilerows(i)*tilecols(j) :
+                                     ranks[b]*(tilerows(i)+tilecols(j)));
+      if (!offset.back()) return;
+      DenseM_t storage(offset.back(), 1);
+      auto B = blocks_.size();
+#if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
+#pragma omp taskloop default(shared)
+#endif
+      for (std::size_t b=0; b<B; b++) {
+        auto ptr = storage.data() + offset[b];
+        auto& t = blocks_[b];
+        t->copy_to(ptr);
+        if (ranks[b] == -1)
+          t = DenseTile<scalar_t>::create_as_wrapper
+            (storage.data() + offset[b], t->rows(), t->cols());
+        else
+          t = LRTile<scalar_t>::create_as_wrapper
+            (storage.data() + offset[b], t->rows(), t->cols(), ranks[b]);
+      }
+      storage_ = std::move(storage);
+    }
+
+    template<typename scalar_t> void BLRMatrix<scalar_t>::pack
+    (const std::vector<int>& ranks, const scalar_t* data) {
+      storage_ = DenseM_t(packed_size(ranks), 1);
+      std::copy(data, data+storage_.rows(), storage_.data());
+      blocks_.resize(nbrows_*nbcols_);
+      auto ptr = storage_.data();
+      for (std::size_t j=0, b=0; j<nbcols_; j++)
+        for (std::size_t i=0; i<nbrows_; i++, b++) {
+          if (ranks[b] == -1)
+            blocks_[b] = DenseTile<scalar_t>::create_as_wrapper_adv
+              (ptr, tilerows(i), tilecols(j));
+          else
+            blocks_[b] = LRTile<scalar_t>::create_as_wrapper_adv
+              (ptr, tilerows(i), tilecols(j), ranks[b]);
+        }
     }
 
     template<typename scalar_t> std::size_t
@@ -561,9 +674,13 @@ namespace strumpack {
 
     template<typename scalar_t> void
     BLRMatrix<scalar_t>::create_LR_tile(std::size_t i, std::size_t j,
-                                        DenseM_t& A, const Opts_t& opts) {
+                                        DenseM_t& A, const Opts_t& opts,
+                                        int rank_guess) {
+      if (!rank_hint_.empty() && rank_hint_[i+j*rowblocks()] >= 0)
+        rank_guess = rank_hint_[i+j*rowblocks()];
       block(i, j) = std::unique_ptr<LRTile<scalar_t>>
-        (new LRTile<scalar_t>(tile(A, i, j), opts));
+        (new LRTile<scalar_t>
+         (tile(A, i, j), opts, rank_guess, i+j*rowblocks()));
       auto& t = tile(i, j);
       if (t.rank()*(t.rows() + t.cols()) > t.rows()*t.cols())
         create_dense_tile(i, j, A);
@@ -709,7 +826,7 @@ namespace strumpack {
     template<typename scalar_t> void
     BLRMatrix<scalar_t>::compress_tile
     (std::size_t i, std::size_t j, const Opts_t& opts) {
-      auto t = tile(i, j).compress(opts);
+      auto t = tile(i, j).compress(opts, i+j*rowblocks());
       if (t->rank()*(t->rows() + t->cols()) < t->rows()*t->cols())
         block(i, j) = std::move(t);
     }
@@ -746,9 +863,16 @@ namespace strumpack {
      const std::vector<std::size_t>& tiles2,
      const DenseMatrix<bool>& admissible,
      const Opts_t& opts) {
-      B11 = BLRMatrix<scalar_t>(A11.rows(), tiles1, A11.cols(), tiles1);
-      B12 = BLRMatrix<scalar_t>(A12.rows(), tiles1, A12.cols(), tiles2);
-      B21 = BLRMatrix<scalar_t>(A21.rows(), tiles2, A21.cols(), tiles1);
+      if (opts.batched_update() &&
+          opts.BLR_factor_algorithm() == BLRFactorAlgorithm::RL) {
+        construct_and_partial_factor_batched
+          (A11, A12, A21, A22, B11, B12, B21,
+           tiles1, tiles2, admissible, opts);
+        return;
+      }
+      reset_keep_ranks(B11, A11.rows(), tiles1, A11.cols(), tiles1);
+      reset_keep_ranks(B12, A12.rows(), tiles1, A12.cols(), tiles2);
+      reset_keep_ranks(B21, A21.rows(), tiles2, A21.cols(), tiles1);
       B11.piv_.resize(B11.rows());
       auto rb = B11.rowblocks();
       auto rb2 = B21.rowblocks();
@@ -1036,6 +1160,131 @@ namespace strumpack {
       A21.clear();
     }
 
+    /*
+     * Right-looking variant, where at each step, after factoring the
+     * diagonal tile and compressing the corresponding block row and
+     * column, all tile products for the Schur complement update are
+     * collected and executed as batches (see BatchedGEMM), instead of
+     * as one task per tile product.
+     */
+    template<typename scalar_t> void
+    BLRMatrix<scalar_t>::construct_and_partial_factor_batched
+    (DenseMatrix<scalar_t>& A11, DenseMatrix<scalar_t>& A12,
+     DenseMatrix<scalar_t>& A21, DenseMatrix<scalar_t>& A22,
+     BLRMatrix<scalar_t>& B11, BLRMatrix<scalar_t>& B12,
+     BLRMatrix<scalar_t>& B21,
+     const std::vector<std::size_t>& tiles1,
+     const std::vector<std::size_t>& tiles2,
+     const DenseMatrix<bool>& admissible,
+     const Opts_t& opts) {
+      reset_keep_ranks(B11, A11.rows(), tiles1, A11.cols(), tiles1);
+      reset_keep_ranks(B12, A12.rows(), tiles1, A12.cols(), tiles2);
+      reset_keep_ranks(B21, A21.rows(), tiles2, A21.cols(), tiles1);
+      B11.piv_.resize(B11.rows());
+      auto rb = B11.rowblocks();
+      auto rb2 = B21.rowblocks();
+      // predict the rank of a tile from its neighbor in the
+      // previous block row/column, which is already compressed
+      auto guess = [](const BLRM_t& B, std::size_t i, std::size_t j) {
+        auto& t = B.tile(i, j);
+        return t.is_low_rank() ? int(t.rank()) : -1;
+      };
+      std::vector<scalar_t,NoInit<scalar_t>> work;
+      for (std::size_t i=0; i<rb; i++) {
+        B11.create_dense_tile(i, i, A11);
+        auto tpiv = B11.tile(i, i).LU(opts.pivot_threshold());
+        std::copy(tpiv.begin(), tpiv.end(),
+                  B11.piv_.begin()+B11.tileroff(i));
+        // compress the block row and column, and solve with L and U
+#if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
+#pragma omp taskloop default(shared) grainsize(1)
+#endif
+        for (std::size_t j=i+1; j<rb+rb2; j++) {
+          if (j < rb) {
+            if (admissible(i, j))
+              B11.create_LR_tile
+                (i, j, A11, opts, i ? guess(B11, i-1, j) : -1);
+            else B11.create_dense_tile(i, j, A11);
+            B11.tile(i, j).laswp(tpiv, true);
+            trsm(Side::L, UpLo::L, Trans::N, Diag::U,
+                 scalar_t(1.), B11.tile(i, i), B11.tile(i, j));
+            if (admissible(j, i))
+              B11.create_LR_tile
+                (j, i, A11, opts, i ? guess(B11, j, i-1) : -1);
+            else B11.create_dense_tile(j, i, A11);
+            trsm(Side::R, UpLo::U, Trans::N, Diag::N,
+                 scalar_t(1.), B11.tile(i, i), B11.tile(j, i));
+          } else {
+            auto j2 = j - rb;
+            B12.create_LR_tile
+              (i, j2, A12, opts, i ? guess(B12, i-1, j2) : -1);
+            B12.tile(i, j2).laswp(tpiv, true);
+            trsm(Side::L, UpLo::L, Trans::N, Diag::U,
+                 scalar_t(1.), B11.tile(i, i), B12.tile(i, j2));
+            B21.create_LR_tile
+              (j2, i, A21, opts, i ? guess(B21, j2, i-1) : -1);
+            trsm(Side::R, UpLo::U, Trans::N, Diag::N,
+                 scalar_t(1.), B11.tile(i, i), B21.tile(j2, i));
+          }
+        }
+        // Schur complement update, always into full rank
+        std::size_t sVU = 0, sUVU = 0;
+        for (std::size_t j=i+1; j<rb; j++) {
+          for (std::size_t k=i+1; k<rb; k++)
+            multiply_inc_work_size
+              (B11.tile(k, i), B11.tile(i, j), sVU, sUVU);
+          for (std::size_t k=0; k<rb2; k++) {
+            multiply_inc_work_size
+              (B11.tile(j, i), B12.tile(i, k), sVU, sUVU);
+            multiply_inc_work_size
+              (B21.tile(k, i), B11.tile(i, j), sVU, sUVU);
+          }
+        }
+        for (std::size_t j=0; j<rb2; j++)
+          for (std::size_t k=0; k<rb2; k++)
+            multiply_inc_work_size
+              (B21.tile(k, i), B12.tile(i, j), sVU, sUVU);
+        work.resize(sVU+sUVU);
+        auto dVU = work.data();
+        auto dUVU = dVU + sVU;
+        std::size_t batchcount = (rb-(i+1)+rb2) * (rb-(i+1)+rb2);
+        BatchedGEMM<scalar_t> b1(batchcount), b2(batchcount),
+          b3(batchcount);
+        for (std::size_t j=i+1; j<rb; j++) {
+          for (std::size_t k=i+1; k<rb; k++) {
+            auto Akj = B11.tile(A11, k, j);
+            add_tile_mult(B11.tile(k, i), B11.tile(i, j), Akj,
+                          b1, b2, b3, dVU, dUVU);
+          }
+          for (std::size_t k=0; k<rb2; k++) {
+            auto Ajk = B12.tile(A12, j, k);
+            add_tile_mult(B11.tile(j, i), B12.tile(i, k), Ajk,
+                          b1, b2, b3, dVU, dUVU);
+            auto Akj = B21.tile(A21, k, j);
+            add_tile_mult(B21.tile(k, i), B11.tile(i, j), Akj,
+                          b1, b2, b3, dVU, dUVU);
+          }
+        }
+        for (std::size_t j=0; j<rb2; j++)
+          for (std::size_t k=0; k<rb2; k++) {
+            DenseMatrixWrapper<scalar_t> Akj
+              (B21.tilerows(k), B12.tilecols(j), A22,
+               B21.tileroff(k), B12.tilecoff(j));
+            add_tile_mult(B21.tile(k, i), B12.tile(i, j), Akj,
+                          b1, b2, b3, dVU, dUVU);
+          }
+        b1.run(scalar_t(1.), scalar_t(0.), 0);
+        b2.run(scalar_t(1.), scalar_t(0.), 0);
+        b3.run(scalar_t(-1.), scalar_t(1.), 0);
+      }
+      for (std::size_t i=0; i<rb; i++)
+        for (std::size_t l=B11.tileroff(i); l<B11.tileroff(i+1); l++)
+          B11.piv_[l] += B11.tileroff(i);
+      A11.clear();
+      A12.clear();
+      A21.clear();
+    }
+
     template<typename scalar_t> void
     LUAR(const std::vector<BLRTile<scalar_t>*>& Ti,
          const std::vector<BLRTile<scalar_t>*>& Tj,
@@ -115,6 +115,70 @@ namespace strumpack {
 
       void clear();
 
+      /**
+       * Move all tiles to a single contiguous buffer, owned by this
+       * BLRMatrix, to serialize or communicate the (factored) matrix
+       * with a single copy, see tile_ranks(), packed_data() and
+       * pack(ranks, data). This is not a storage format for the
+       * factorization: the tiles are allocated separately during
+       * compression and factorization, and packing copies all of
+       * them once more. The tiles are stored in column-major tile
+       * order, dense tiles as m x n, low-rank tiles with U (m x r)
+       * followed by V (r x n). After packing, the tiles are wrappers
+       * around this buffer, so they should no longer be resized or
+       * recompressed. Packing an already packed matrix does nothing.
+       */
+      void pack();
+
+      /**
+       * Create packed tiles from a buffer with the layout described
+       * in pack(). The tile sizes should already be set (see the
+       * BLRMatrix(m, rowtiles, n, coltiles) constructor) and the
+       * ranks are as returned from tile_ranks(). The data is copied
+       * with a single copy.
+       *
+       * \param ranks rank of each tile, -1 for dense tiles, in
+       * column-major tile order
+       * \param data buffer of size packed_size(ranks)
+       */
+      void pack(const std::vector<int>& ranks, const scalar_t* data);
+
+      /**
+       * Check whether the tiles are stored in a contiguous buffer.
+       */
+      bool packed() const { return storage_.rows() != 0; }
+
+      /**
+       * Rank of each tile, in column-major tile order, with -1 for
+       * dense tiles.
+       */
+      std::vector<int> tile_ranks() const;
+
+      /**
+       * Number of scalars required to store all tiles in the packed
+       * format, given the ranks of the tiles, see tile_ranks().
+       */
+      std::size_t packed_size(const std::vector<int>& ranks) const;
+
+      /**
+       * Pointer to the packed tile storage, or nullptr if not
+       * packed().
+       */
+      const scalar_t* packed_data() const {
+        return packed() ? storage_.data() : nullptr;
+      }
+
+      /**
+       * Store the low-rank tiles in mixed precision, see
+       * LRTileMP. This should only be called after the
+       * factorization, and should not be combined with pack().
+       *
+       * \param opts the relative tolerance from opts determines
+       * which precision to use for every component of the low-rank
+       * tiles
+       */
+      void convert_to_mixed_precision(const Opts_t& opts);
+
       void solve(DenseM_t& x) const override {
         x.laswp(piv_, true);
         trsm(Side::L, UpLo::L, Trans::N, Diag::U, scalar_t(1.), *this, x, 0);
@@ -243,6 +307,10 @@ namespace strumpack {
       std::vector<std::size_t> roff_, coff_, cl2l_, rl2l_;
       std::vector<std::unique_ptr<BLRTile<scalar_t>>> blocks_;
       std::vector<int> piv_;
+      DenseM_t storage_;
+      // ranks of the tiles from a previous compression of a matrix
+      // with the same tiling, used as rank prediction
+      std::vector<int> rank_hint_;
 
       void create_dense_tile(std::size_t i, std::size_t j, DenseM_t& A);
       void create_dense_tile(std::size_t i, std::size_t j,
@@ -255,7 +323,8 @@ namespace strumpack {
                                           const BLRM_t& B21,
                                           const BLRM_t& B12);
       void create_LR_tile(std::size_t i, std::size_t j,
-                          DenseM_t& A, const Opts_t& opts);
+                          DenseM_t& A, const Opts_t& opts,
+                          int rank_guess=-1);
       void create_LR_tile(std::size_t i, std::size_t j,
                           const extract_t& A, const Opts_t& opts);
 
@@ -272,6 +341,24 @@ namespace strumpack {
                                        const extract_t& Aelem,
                                        const BLRM_t& B21, const BLRM_t& B12,
                                        const Opts_t& opts);
+      /**
+       * Reinitialize B with the given tiling, but keep the ranks of
+       * the current tiles of B as rank prediction for the next
+       * compression.
+       */
+      static void
+      reset_keep_ranks(BLRM_t& B, std::size_t m,
+                       const std::vector<std::size_t>& rowtiles,
+                       std::size_t n,
+                       const std::vector<std::size_t>& coltiles);
+      static void
+      construct_and_partial_factor_batched
+      (DenseM_t& A11, DenseM_t& A12, DenseM_t& A21, DenseM_t& A22,
+       BLRM_t& B11, BLRM_t& B12, BLRM_t& B21,
+       const std::vector<std::size_t>& tiles1,
+       const std::vector<std::size_t>& tiles2,
+       const adm_t& admissible, const Opts_t& opts);
+
       void LUAR_B11(std::size_t i, std::size_t j, std::size_t kmax,
                     DenseM_t& A11, const Opts_t& opts, int* B);
       void LUAR_B12(std::size_t i, std::size_t j, std::size_t kmax,
@@ -1208,7 +1208,7 @@ namespace strumpack {
     template<typename scalar_t> void
     BLRMatrixMPI<scalar_t>::compress_tile
     (std::size_t i, std::size_t j, const Opts_t& opts) {
-      auto t = tile(i, j).compress(opts);
+      auto t = tile(i, j).compress(opts, i+j*rowblocks());
       if (t->rank()*(t->rows() + t->cols()) < t->rows()*t->cols())
         block(i, j) = std::move(t);
     }
@@ -1806,6 +1806,9 @@ namespace strumpack {
                                            BLRMPI_t& A21, BLRMPI_t& A22,
                                            const adm_t& adm,
                                            const Opts_t& opts) {
+      if (opts.BLR_factor_algorithm() == BLRFactorAlgorithm::RL &&
+          opts.lookahead() > 0)
+        return partial_factor_lookahead(A11, A12, A21, A22, adm, opts);
       auto B1 = A11.rowblocks();
       auto B2 = A22.rowblocks();
       auto g = A11.grid();
@@ -2121,6 +2124,173 @@ namespace strumpack {
       return piv;
     }
 
+    /**
+     * Right-looking distributed BLR factorization with a lookahead
+     * of one panel. In step i, the tiles of panel i+1 are updated
+     * first. Then the master thread factors, compresses and
+     * broadcasts panel i+1 (all MPI communication is done by the
+     * master thread), while the other threads perform the remaining
+     * trailing update with panel i. Tasks for the panel get a higher
+     * priority than the trailing update tasks.
+     */
+    template<typename scalar_t> std::vector<int>
+    BLRMatrixMPI<scalar_t>::partial_factor_lookahead
+    (BLRMPI_t& A11, BLRMPI_t& A12, BLRMPI_t& A21, BLRMPI_t& A22,
+     const adm_t& adm, const Opts_t& opts) {
+      using Tiles_t = std::vector<std::unique_ptr<BLRTile<scalar_t>>>;
+      auto B1 = A11.rowblocks();
+      auto B2 = A22.rowblocks();
+      auto g = A11.grid();
+      std::vector<int> piv;
+      if (!g->active()) return piv;
+      // the factored and compressed tiles of a panel, broadcast to
+      // the processes that need them for the trailing update
+      struct Panel { Tiles_t Tij, Tij2, Tki, Tk2i; };
+      // must be called by the master thread only
+      auto factor_panel = [&](std::size_t i, Panel& p) {
+        std::vector<int> piv_tile;
+        DenseTile<scalar_t> Tii;
+        if (g->is_local_row(i)) {
+          if (g->is_local_col(i))
+            // LU factorization of diagonal tile
+            piv_tile = A11.tile(i, i).LU(opts.pivot_threshold());
+          else piv_tile.resize(A11.tilerows(i));
+          g->row_comm().broadcast_from(piv_tile, i % g->npcols());
+          int r0 = A11.tileroff(i);
+          std::transform
+            (piv_tile.begin(), piv_tile.end(), std::back_inserter(piv),
+             [r0](int p) -> int { return p + r0; });
+          Tii = A11.bcast_dense_tile_along_row(i, i);
+        }
+        if (g->is_local_col(i))
+          Tii = A11.bcast_dense_tile_along_col(i, i);
+#pragma omp taskgroup
+        {
+          if (g->is_local_row(i)) {
+            for (std::size_t j=i+1; j<B1; j++)
+              if (g->is_local_col(j))
+#pragma omp task default(shared) firstprivate(i,j) priority(1)
+                {
+                  if (adm(i, j)) A11.compress_tile(i, j, opts);
+                  A11.tile(i, j).laswp(piv_tile, true);
+                  trsm(Side::L, UpLo::L, Trans::N, Diag::U,
+                       scalar_t(1.), Tii, A11.tile(i, j));
+                }
+            for (std::size_t j=0; j<B2; j++)
+              if (g->is_local_col(j))
+#pragma omp task default(shared) firstprivate(i,j) priority(1)
+                {
+                  A12.compress_tile(i, j, opts);
+                  A12.tile(i, j).laswp(piv_tile, true);
+                  trsm(Side::L, UpLo::L, Trans::N, Diag::U,
+                       scalar_t(1.), Tii, A12.tile(i, j));
+                }
+          }
+          if (g->is_local_col(i)) {
+            for (std::size_t j=i+1; j<B1; j++)
+              if (g->is_local_row(j))
+#pragma omp task default(shared) firstprivate(i,j) priority(1)
+                {
+                  if (adm(j, i)) A11.compress_tile(j, i, opts);
+                  trsm(Side::R, UpLo::U, Trans::N, Diag::N,
+                       scalar_t(1.), Tii, A11.tile(j, i));
+                }
+            for (std::size_t j=0; j<B2; j++)
+              if (g->is_local_row(j))
+#pragma omp task default(shared) firstprivate(i,j) priority(1)
+                {
+                  A21.compress_tile(j, i, opts);
+                  trsm(Side::R, UpLo::U, Trans::N, Diag::N,
+                       scalar_t(1.), Tii, A21.tile(j, i));
+                }
+          }
+        }
+        p.Tij = A11.bcast_row_of_tiles_along_cols(i, i+1, B1);
+        p.Tij2 = A12.bcast_row_of_tiles_along_cols(i, 0, B2);
+        p.Tki = A11.bcast_col_of_tiles_along_rows(i+1, B1, i);
+        p.Tk2i = A21.bcast_col_of_tiles_along_rows(0, B2, i);
+      };
+      // Schur complement update with panel i, either only of the
+      // tiles in panel i+1 (next == true), or of all other tiles
+      auto update = [&](std::size_t i, const Panel& p, bool next) {
+        const std::size_t n = i + 1;
+        const int prio = next ? 1 : 0;
+        for (std::size_t k=i+1, lk=0; k<B1; k++) {
+          if (!g->is_local_row(k)) continue;
+          for (std::size_t j=i+1, lj=0; j<B1; j++) {
+            if (!g->is_local_col(j)) continue;
+            if ((k == n || j == n) == next)
+#pragma omp task default(shared) firstprivate(j,k,lk,lj) priority(prio)
+              gemm(Trans::N, Trans::N, scalar_t(-1.),
+                   *(p.Tki[lk]), *(p.Tij[lj]), scalar_t(1.),
+                   A11.tile_dense(k, j).D());
+            lj++;
+          }
+          lk++;
+        }
+        for (std::size_t k=0, lk=0; k<B2; k++) {
+          if (!g->is_local_row(k)) continue;
+          for (std::size_t j=i+1, lj=0; j<B1; j++) {
+            if (!g->is_local_col(j)) continue;
+            if ((j == n) == next)
+#pragma omp task default(shared) firstprivate(j,k,lk,lj) priority(prio)
+              gemm(Trans::N, Trans::N, scalar_t(-1.),
+                   *(p.Tk2i[lk]), *(p.Tij[lj]), scalar_t(1.),
+                   A21.tile_dense(k, j).D());
+            lj++;
+          }
+          lk++;
+        }
+        for (std::size_t k=i+1, lk=0; k<B1; k++) {
+          if (!g->is_local_row(k)) continue;
+          for (std::size_t j=0, lj=0; j<B2; j++) {
+            if (!g->is_local_col(j)) continue;
+            if ((k == n) == next)
+#pragma omp task default(shared) firstprivate(j,k,lk,lj) priority(prio)
+              gemm(Trans::N, Trans::N, scalar_t(-1.),
+                   *(p.Tki[lk]), *(p.Tij2[lj]), scalar_t(1.),
+                   A12.tile_dense(k, j).D());
+            lj++;
+          }
+          lk++;
+        }
+        if (next) return;
+        for (std::size_t k=0, lk=0; k<B2; k++) {
+          if (!g->is_local_row(k)) continue;
+          for (std::size_t j=0, lj=0; j<B2; j++) {
+            if (!g->is_local_col(j)) continue;
+#pragma omp task default(shared) firstprivate(j,k,lk,lj)
+            gemm(Trans::N, Trans::N, scalar_t(-1.),
+                 *(p.Tk2i[lk]), *(p.Tij2[lj]), scalar_t(1.),
+                 A22.tile_dense(k, j).D());
+            lj++;
+          }
+          lk++;
+        }
+      };
+      Panel cur;
+      if (B1) {
+#pragma omp parallel
+#pragma omp master
+        factor_panel(0, cur);
+      }
+      for (std::size_t i=0; i<B1; i++) {
+        Panel next;
+#pragma omp parallel
+#pragma omp master
+        {
+          if (i+1 < B1) {
+#pragma omp taskgroup
+            update(i, cur, true);
+          }
+          update(i, cur, false);
+          if (i+1 < B1) factor_panel(i+1, next);
+        }
+        cur = std::move(next);
+      }
+      return piv;
+    }
+
     template<typename scalar_t> void
     LUAR(std::size_t kmax, std::size_t lk,
          std::vector<std::unique_ptr<BLRTile<scalar_t>>>& Ti,
@@ -2389,12 +2559,17 @@ namespace strumpack {
 
     template<typename scalar_t> void
     BLRMatrixMPI<scalar_t>::compress(const Opts_t& opts) {
-      for (auto& b : blocks_) {
-        if (b->is_low_rank()) continue;
-        auto t = b->compress(opts);
-        if (t->rank()*(t->rows() + t->cols()) < t->rows()*t->cols())
-          b = std::move(t);
-      }
+      for (std::size_t j=0; j<colblockslocal(); j++)
+        for (std::size_t i=0; i<rowblockslocal(); i++) {
+          auto& b = blocks_[i+j*rowblockslocal()];
+          if (b->is_low_rank()) continue;
+          // seed with the global tile index
+          auto t = b->compress
+            (opts, grid()->prow() + i * grid()->nprows() +
+             (grid()->pcol() + j * grid()->npcols()) * rowblocks());
+          if (t->rank()*(t->rows() + t->cols()) < t->rows()*t->cols())
+            b = std::move(t);
+        }
     }
 
     template<typename scalar_t> BLRMatrixMPI<scalar_t>
@@ -2423,7 +2598,9 @@ namespace strumpack {
         assert(A.fixed());
         const auto lm = A.lrows();
         const auto ln = A.lcols();
-        const auto nprows = A.nprows();
+        // destination rank in the BLR grid, which can have a
+        // different layout than the BLACS grid of A
+        const auto nprows = B.grid()->nprows();
         std::unique_ptr<int[]> work(new int[lm+ln]);
         auto pr = work.get();
         auto pc = pr + lm;
@@ -2552,7 +2729,8 @@ namespace strumpack {
       if (A.active()) {
         const auto lm = A.lrows();
         const auto ln = A.lcols();
-        const auto nprows = A.nprows();
+        // source rank in the BLR grid of this matrix
+        const auto nprows = grid()->nprows();
         std::unique_ptr<int[]> work(new int[lm+ln]);
         auto pr = work.get();
         auto pc = pr + lm;
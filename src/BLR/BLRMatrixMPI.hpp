@@ -311,6 +311,11 @@ namespace strumpack {
 
       void compress_tile(std::size_t i, std::size_t j, const Opts_t& opts);
 
+      static std::vector<int>
+      partial_factor_lookahead(BLRMPI_t& A11, BLRMPI_t& A12,
+                               BLRMPI_t& A21, BLRMPI_t& A22,
+                               const adm_t& adm, const Opts_t& opts);
+
       DenseTile<scalar_t>
       bcast_dense_tile_along_col(std::size_t i, std::size_t j) const;
       DenseTile<scalar_t>
@@ -44,6 +44,7 @@ namespace strumpack {
       case LowRankAlgorithm::RRQR: return "RRQR";
       case LowRankAlgorithm::ACA: return "ACA";
       case LowRankAlgorithm::BACA: return "BACA";
+      case LowRankAlgorithm::RANDOMIZED: return "RANDOMIZED";
       default: return "unknown";
       }
     }
@@ -96,6 +97,14 @@ namespace strumpack {
          {"blr_BACA_blocksize",        required_argument, 0, 7},
          {"blr_factor_algorithm",      required_argument, 0, 8},
          {"blr_compression_kernel",    required_argument, 0, 9},
+         {"blr_enable_batched_update", no_argument, 0, 10},
+         {"blr_disable_batched_update", no_argument, 0, 11},
+         {"blr_enable_mixed_precision", no_argument, 0, 14},
+         {"blr_disable_mixed_precision", no_argument, 0, 15},
+         {"blr_randomized_blocksize",  required_argument, 0, 16},
+         {"blr_lookahead",             required_argument, 0, 17},
+         {"blr_enable_compressed_cb",  no_argument, 0, 18},
+         {"blr_disable_compressed_cb", no_argument, 0, 19},
          {"blr_verbose",               no_argument, 0, 'v'},
          {"blr_quiet",                 no_argument, 0, 'q'},
          {"help",                      no_argument, 0, 'h'},
@@ -135,9 +144,12 @@ namespace strumpack {
             set_low_rank_algorithm(LowRankAlgorithm::ACA);
           else if (s == "BACA")
             set_low_rank_algorithm(LowRankAlgorithm::BACA);
+          else if (s == "RANDOMIZED")
+            set_low_rank_algorithm(LowRankAlgorithm::RANDOMIZED);
           else
             std::cerr << "# WARNING: low-rank algorithm not"
-                      << " recognized, use 'RRQR', 'ACA' or 'BACA'."
+                      << " recognized, use 'RRQR', 'ACA', 'BACA'"
+                      << " or 'RANDOMIZED'."
                       << std::endl;
         } break;
         case 6: {
@@ -187,6 +199,22 @@ namespace strumpack {
                       << " recognized, use 'full' or 'half'."
                       << std::endl;
         } break;
+        case 10: set_batched_update(true); break;
+        case 11: set_batched_update(false); break;
+        case 14: set_mixed_precision(true); break;
+        case 15: set_mixed_precision(false); break;
+        case 16: {
+          std::istringstream iss(optarg);
+          iss >> rand_blocksize_;
+          set_randomized_blocksize(rand_blocksize_);
+        } break;
+        case 17: {
+          std::istringstream iss(optarg);
+          iss >> lookahead_;
+          set_lookahead(lookahead_);
+        } break;
+        case 18: set_compressed_CB(true); break;
+        case 19: set_compressed_CB(false); break;
         case 'v': this->set_verbose(true); break;
         case 'q': this->set_verbose(false); break;
         case 'h': describe_options(); break;
@@ -213,7 +241,7 @@ namespace strumpack {
                 << this->max_rank() << ")" << std::endl
                 << "#   --blr_low_rank_algorithm (default "
                 << get_name(lr_algo_) << ")" << std::endl
-                << "#      should be [RRQR|ACA|BACA]" << std::endl
+                << "#      should be [RRQR|ACA|BACA|RANDOMIZED]" << std::endl
                 << "#   --blr_admissibility (default "
                 << get_name(adm_) << ")" << std::endl
                 << "#      should be one of [weak|strong]" << std::endl
@@ -223,8 +251,24 @@ namespace strumpack {
                 << "#   --blr_compression_kernel (default "
                 << get_name(crn_krnl_) << ")" << std::endl
                 << "#      should be [full|half]" << std::endl
+                << "#   --blr_enable_batched_update (default "
+                << batched_update() << ")" << std::endl
+                << "#   --blr_disable_batched_update (default "
+                << !batched_update() << ")" << std::endl
+                << "#   --blr_enable_mixed_precision (default "
+                << mixed_precision() << ")" << std::endl
+                << "#   --blr_disable_mixed_precision (default "
+                << !mixed_precision() << ")" << std::endl
                 << "#   --blr_BACA_blocksize int (default "
                 << BACA_blocksize() << ")" << std::endl
+                << "#   --blr_randomized_blocksize int (default "
+                << randomized_blocksize() << ")" << std::endl
+                << "#   --blr_lookahead int (default "
+                << lookahead() << ")" << std::endl
+                << "#   --blr_enable_compressed_cb (default "
+                << compressed_CB() << ")" << std::endl
+                << "#   --blr_disable_compressed_cb (default "
+                << !compressed_CB() << ")" << std::endl
                 << "#   --blr_verbose or -v (default "
                 << this->verbose() << ")" << std::endl
                 << "#   --blr_quiet or -q (default "
@@ -56,7 +56,7 @@ namespace strumpack {
       return 1e-6;
     }
 
-    enum class LowRankAlgorithm { RRQR, ACA, BACA };
+    enum class LowRankAlgorithm { RRQR, ACA, BACA, RANDOMIZED };
     std::string get_name(LowRankAlgorithm a);
 
     enum class Admissibility { STRONG, WEAK };
@@ -107,18 +107,73 @@ namespace strumpack {
         assert(B > 0);
         BACA_blocksize_ = B;
       }
+      /**
+       * Number of random samples added in each step of the adaptive
+       * randomized compression (LowRankAlgorithm::RANDOMIZED), when
+       * the rank of a tile is not known in advance.
+       */
+      void set_randomized_blocksize(int B) {
+        assert(B > 0);
+        rand_blocksize_ = B;
+      }
       void set_BLR_factor_algorithm(BLRFactorAlgorithm a) {
         blr_algo_ = a;
       }
       void set_compression_kernel(CompressionKernel a) {
         crn_krnl_ = a;
       }
+      /**
+       * Use the CPU batched Schur complement update in the
+       * right-looking (RL) BLR factorization. All tile products of
+       * a step are collected, grouped by shape and executed as a
+       * batch, using a small GEMM kernel for small products, instead
+       * of as one task per tile product.
+       */
+      void set_batched_update(bool b) { batched_update_ = b; }
+
+      /**
+       * After factorization, store the components of the low-rank
+       * tiles in working, single or bfloat16 precision, depending
+       * on their magnitude relative to the tolerance, see
+       * LRTileMP.
+       */
+      void set_mixed_precision(bool b) { mixed_precision_ = b; }
+
+      /**
+       * Lookahead depth for the distributed memory right-looking
+       * (RL) BLR factorization, see BLRMatrixMPI::partial_factor. 0
+       * disables lookahead. With lookahead, the next panel is
+       * updated first, and then factored, compressed and broadcast
+       * while the remaining trailing update of the current panel is
+       * still running. Currently only a depth of 1 is implemented,
+       * larger values are treated as 1.
+       */
+      void set_lookahead(int d) {
+        assert(d >= 0);
+        lookahead_ = d;
+      }
+
+      /**
+       * In the distributed memory multifrontal solver, compress the
+       * tiles of the contribution block of a BLR front before the
+       * extend-add to a BLR parent, and send the low-rank factors
+       * instead of the dense entries, see BLRExtendAdd. This
+       * reduces the communication volume of the extend-add, at the
+       * cost of compressing the contribution block. Not used with
+       * the COLWISE factorization algorithm.
+       */
+      void set_compressed_CB(bool b) { compressed_CB_ = b; }
 
       LowRankAlgorithm low_rank_algorithm() const { return lr_algo_; }
       Admissibility admissibility() const { return adm_; }
       int BACA_blocksize() const { return BACA_blocksize_; }
+      int randomized_blocksize() const { return rand_blocksize_; }
       BLRFactorAlgorithm BLR_factor_algorithm() const { return blr_algo_; }
       CompressionKernel compression_kernel() const { return crn_krnl_; }
+      bool batched_update() const { return batched_update_; }
+      bool mixed_precision() const { return mixed_precision_; }
+      int lookahead() const { return lookahead_; }
+      bool compressed_CB() const { return compressed_CB_; }
 
       void set_from_command_line(int argc, const char* const* cargv) override;
 
@@ -128,9 +183,14 @@ namespace strumpack {
       bool verbose_ = true;
       LowRankAlgorithm lr_algo_ = LowRankAlgorithm::RRQR;
       int BACA_blocksize_ = 4;
+      int rand_blocksize_ = 16;
       Admissibility adm_ = Admissibility::WEAK;
       BLRFactorAlgorithm blr_algo_ = BLRFactorAlgorithm::RL;
       CompressionKernel crn_krnl_ = CompressionKernel::HALF;
+      bool batched_update_ = false;
+      bool mixed_precision_ = false;
+      int lookahead_ = 0;
+      bool compressed_CB_ = false;
 
       void set_defaults() {
         this->rel_tol_ = default_BLR_rel_tol<real_t>();
@@ -75,8 +75,13 @@ namespace strumpack {
 
       virtual std::unique_ptr<BLRTile<scalar_t>> clone() const = 0;
 
+      /**
+       * Compress this tile with the low-rank algorithm from opts. The
+       * seed (for instance the index of the tile) selects the random
+       * numbers for the randomized algorithm.
+       */
       virtual std::unique_ptr<LRTile<scalar_t>>
-      compress(const Opts_t& opts) const = 0;
+      compress(const Opts_t& opts, std::size_t seed) const = 0;
 
       virtual void draw(std::ostream& of,
                         std::size_t roff,
@@ -42,9 +42,10 @@ namespace strumpack {
     }
 
     template<typename scalar_t> std::unique_ptr<LRTile<scalar_t>>
-    DenseTile<scalar_t>::compress(const Opts_t& opts) const {
+    DenseTile<scalar_t>::compress(const Opts_t& opts,
+                                  std::size_t seed) const {
       return std::unique_ptr<LRTile<scalar_t>>
-        (new LRTile<scalar_t>(D(), opts));
+        (new LRTile<scalar_t>(D(), opts, -1, seed));
     }
 
     template<typename scalar_t> void
@@ -105,7 +105,7 @@ namespace strumpack {
       std::unique_ptr<BLRTile<scalar_t>> clone() const override;
 
       std::unique_ptr<LRTile<scalar_t>>
-      compress(const Opts_t& opts) const override;
+      compress(const Opts_t& opts, std::size_t seed) const override;
 
       void draw(std::ostream& of, std::size_t roff,
                 std::size_t coff) const override;
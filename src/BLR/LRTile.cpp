@@ -37,6 +37,7 @@
 #include "dense/ACA.hpp"
 #include "dense/BACA.hpp"
 #include "dense/GPUWrapper.hpp"
+#include "misc/RandomWrapper.hpp"
 
 namespace strumpack {
   namespace BLR {
@@ -52,9 +53,82 @@ namespace strumpack {
       V_.reset(new DenseM_t(r, n));
     }
 
+    /**
+     * Adaptive randomized range finder. T is sampled with blocks of
+     * Gaussian random vectors, until ||T - Q Q^* T||_F is below the
+     * tolerance. The residual E = T - Q Q^* T is updated explicitly
+     * after each block, so its norm does not suffer from the
+     * cancellation in ||T||_F^2 - ||Q^* T||_F^2. The sampled basis is
+     * then recompressed using RRQR on Q^* T, which removes the
+     * oversampling.
+     */
+    template<typename scalar_t> void
+    randomized_low_rank(const DenseMatrix<scalar_t>& T,
+                        DenseMatrix<scalar_t>& U, DenseMatrix<scalar_t>& V,
+                        const BLROptions<scalar_t>& opts, int rank_guess,
+                        std::size_t seed) {
+      using real_t = typename RealType<scalar_t>::value_type;
+      using DenseM_t = DenseMatrix<scalar_t>;
+      using DenseMW_t = DenseMatrixWrapper<scalar_t>;
+      const int depth = params::task_recursion_cutoff_level;
+      const std::size_t m = T.rows(), n = T.cols(),
+        rmax = std::min(std::min(m, n), std::size_t(opts.max_rank())),
+        d = opts.randomized_blocksize();
+      const real_t nT = T.normF(),
+        tol = std::max(opts.rel_tol() * nT, opts.abs_tol());
+      auto rgen = random::make_random_generator<real_t>
+        (seed, random::RandomEngine::PHILOX,
+         random::RandomDistribution::NORMAL);
+      DenseM_t Q(m, rmax), B(rmax, n), E;
+      std::size_t r = 0, b = (rank_guess >= 0) ? rank_guess + d/2 : d;
+      if (r < rmax && nT > tol) E = T;
+      while (r < rmax && nT > tol) {
+        b = std::min(b, rmax - r);
+        DenseM_t Omega(n, b);
+        Omega.random(*rgen);
+        DenseMW_t Y(m, b, Q, 0, r);
+        gemm(Trans::N, Trans::N, scalar_t(1.), E, Omega,
+             scalar_t(0.), Y, depth);
+        if (r) {
+          // re-orthogonalize against the current basis
+          DenseMW_t Q0(m, r, Q, 0, 0);
+          DenseM_t QY(r, b);
+          gemm(Trans::C, Trans::N, scalar_t(1.), Q0, Y,
+               scalar_t(0.), QY, depth);
+          gemm(Trans::N, Trans::N, scalar_t(-1.), Q0, QY,
+               scalar_t(1.), Y, depth);
+        }
+        scalar_t rmaxY, rminY;
+        Y.orthogonalize(rmaxY, rminY, depth);
+        // Y^* T = Y^* E, since Y is orthogonal to the current basis
+        DenseMW_t Bb(b, n, B, r, 0);
+        gemm(Trans::C, Trans::N, scalar_t(1.), Y, E,
+             scalar_t(0.), Bb, depth);
+        gemm(Trans::N, Trans::N, scalar_t(-1.), Y, Bb,
+             scalar_t(1.), E, depth);
+        r += b;
+        b = d;
+        if (E.normF() <= tol) break;
+      }
+      if (!r) {
+        U = DenseM_t(m, 0);
+        V = DenseM_t(0, n);
+        return;
+      }
+      DenseMW_t Qr(m, r, Q, 0, 0), Br(r, n, B, 0, 0);
+      DenseM_t Ur;
+      Br.low_rank(Ur, V, opts.rel_tol(), opts.abs_tol(),
+                  opts.max_rank(), depth);
+      U = DenseM_t(m, Ur.cols());
+      gemm(Trans::N, Trans::N, scalar_t(1.), Qr, Ur, scalar_t(0.), U, depth);
+    }
+
     template<typename scalar_t> LRTile<scalar_t>::LRTile
-    (const DenseM_t& T, const Opts_t& opts):LRTile<scalar_t>() {
-      if (opts.low_rank_algorithm() == LowRankAlgorithm::RRQR) {
+    (const DenseM_t& T, const Opts_t& opts, int rank_guess,
+     std::size_t seed) : LRTile<scalar_t>() {
+      if (opts.low_rank_algorithm() == LowRankAlgorithm::RANDOMIZED) {
+        randomized_low_rank(T, U(), V(), opts, rank_guess, seed);
+      } else if (opts.low_rank_algorithm() == LowRankAlgorithm::RRQR) {
         if (T.rows() == 0 || T.cols() == 0) {
           U_.reset(new DenseM_t(T.rows(), 0));
           V_.reset(new DenseM_t(0, T.cols()));
@@ -58,7 +58,19 @@ namespace strumpack {
 
       LRTile(std::size_t m, std::size_t n, std::size_t r);
 
-      LRTile(const DenseM_t& T, const Opts_t& opts);
+      /**
+       * .. by compressing the dense tile T, with the low-rank
+       * algorithm from opts
+       *
+       * \param rank_guess expected rank of the tile, for instance
+       * from a neighboring tile or from a previous factorization,
+       * used as initial sample size by the randomized algorithm, -1
+       * if not known
+       * \param seed seed for the random numbers of the randomized
+       * algorithm, for instance the index of the tile
+       */
+      LRTile(const DenseM_t& T, const Opts_t& opts, int rank_guess=-1,
+             std::size_t seed=0);
 
       /**
        * .. by extracting individual elements
@@ -148,7 +160,7 @@ namespace strumpack {
       std::unique_ptr<BLRTile<scalar_t>> clone() const override;
 
       std::unique_ptr<LRTile<scalar_t>>
-      compress(const Opts_t& opts) const override {
+      compress(const Opts_t& opts, std::size_t seed) const override {
         assert(false);
         return nullptr;
       };
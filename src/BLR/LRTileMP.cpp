@@ -0,0 +1,444 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+#include <cstring>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "LRTileMP.hpp"
+
+namespace strumpack {
+  namespace BLR {
+
+    namespace {
+      // bfloat16: the upper 16 bits of an IEEE single precision
+      // number, rounded to nearest even
+      inline std::uint16_t float_to_bf16(float f) {
+        std::uint32_t u;
+        std::memcpy(&u, &f, sizeof(float));
+        if ((u & 0x7fffffff) > 0x7f800000) // NaN, keep it quiet
+          return (u >> 16) | 0x40;
+        u += 0x7fff + ((u >> 16) & 1);
+        return u >> 16;
+      }
+      inline float bf16_to_float(std::uint16_t h) {
+        std::uint32_t u = std::uint32_t(h) << 16;
+        float f;
+        std::memcpy(&f, &u, sizeof(float));
+        return f;
+      }
+
+      template<typename T> void to_bf16(const T& v, std::uint16_t*& p) {
+        *p++ = float_to_bf16(float(v));
+      }
+      template<typename T> void
+      to_bf16(const std::complex<T>& v, std::uint16_t*& p) {
+        *p++ = float_to_bf16(float(v.real()));
+        *p++ = float_to_bf16(float(v.imag()));
+      }
+      template<typename T> void from_bf16(T& v, const std::uint16_t*& p) {
+        v = T(bf16_to_float(*p++));
+      }
+      template<typename T> void
+      from_bf16(std::complex<T>& v, const std::uint16_t*& p) {
+        T re = T(bf16_to_float(*p++));
+        T im = T(bf16_to_float(*p++));
+        v = std::complex<T>(re, im);
+      }
+
+      template<typename scalar_t> std::vector<std::uint16_t>
+      to_bf16(const DenseMatrix<scalar_t>& A) {
+        std::vector<std::uint16_t> B
+          (A.rows()*A.cols()*(is_complex<scalar_t>() ? 2 : 1));
+        auto p = B.data();
+        for (std::size_t j=0; j<A.cols(); j++)
+          for (std::size_t i=0; i<A.rows(); i++)
+            to_bf16(A(i, j), p);
+        return B;
+      }
+      // columns of A from/to bfloat16 storage B, with leading
+      // dimension ldb (in elements, c values each)
+      template<typename scalar_t> void
+      from_bf16(const std::uint16_t* B, std::size_t ldb,
+                DenseMatrix<scalar_t>& A) {
+        const int c = is_complex<scalar_t>() ? 2 : 1;
+        for (std::size_t j=0; j<A.cols(); j++) {
+          const std::uint16_t* p = B + c*j*ldb;
+          for (std::size_t i=0; i<A.rows(); i++)
+            from_bf16(A(i, j), p);
+        }
+      }
+      template<typename scalar_t> void
+      to_bf16(const DenseMatrix<scalar_t>& A, std::uint16_t* B,
+              std::size_t ldb) {
+        const int c = is_complex<scalar_t>() ? 2 : 1;
+        for (std::size_t j=0; j<A.cols(); j++) {
+          std::uint16_t* p = B + c*j*ldb;
+          for (std::size_t i=0; i<A.rows(); i++)
+            to_bf16(A(i, j), p);
+        }
+      }
+
+      // number of components of the lower precision parts converted
+      // to working precision at once
+      const std::size_t convert_block = 32;
+
+      // number of elements (c values each) with all values zero,
+      // respectively with no normal values
+      inline std::size_t
+      bf16_zeros(const std::vector<std::uint16_t>& B, int c) {
+        std::size_t nz = 0;
+        for (std::size_t i=0; i<B.size(); i+=c)
+          if (std::all_of(B.begin()+i, B.begin()+i+c,
+                          [](std::uint16_t h) {
+                            return !(h & 0x7fff); }))
+            nz++;
+        return nz;
+      }
+      inline std::size_t
+      bf16_subnormals(const std::vector<std::uint16_t>& B, int c) {
+        std::size_t ns = 0;
+        for (std::size_t i=0; i<B.size(); i+=c)
+          if (std::all_of(B.begin()+i, B.begin()+i+c,
+                          [](std::uint16_t h) {
+                            auto e = h & 0x7f80;
+                            return !e || e == 0x7f80; }))
+            ns++;
+        return ns;
+      }
+    }
+
+    template<typename scalar_t> std::unique_ptr<LRTileMP<scalar_t>>
+    LRTileMP<scalar_t>::create(const LRTile<scalar_t>& t,
+                               const Opts_t& opts) {
+      using single_real_t = typename RealType<single_t>::value_type;
+      auto m = t.rows(), n = t.cols(), r = t.rank();
+      if (!r) return nullptr;
+      std::vector<real_t> s(r);
+      real_t smax = 0.;
+      for (std::size_t k=0; k<r; k++) {
+        s[k] = blas::nrm2(m, t.U().ptr(0, k), 1) *
+          blas::nrm2(n, t.V().ptr(k, 0), t.V().ld());
+        smax = std::max(smax, s[k]);
+      }
+      const real_t tol = opts.rel_tol() * smax,
+        u1 = std::numeric_limits<single_real_t>::epsilon() / 2,
+        u2 = std::ldexp(real_t(1.), -8);
+      const bool use_single = !std::is_same<single_t,scalar_t>::value;
+      std::vector<std::size_t> idx[3];
+      for (std::size_t k=0; k<r; k++) {
+        if (s[k] * u2 <= tol) idx[2].push_back(k);
+        else if (use_single && s[k] * u1 <= tol) idx[1].push_back(k);
+        else idx[0].push_back(k);
+      }
+      if (idx[0].size() == r) return nullptr;
+      std::unique_ptr<LRTileMP<scalar_t>> T(new LRTileMP<scalar_t>());
+      T->U0_ = t.U().extract_cols(idx[0]);
+      T->V0_ = t.V().extract_rows(idx[0]);
+      for (int l=1; l<3; l++)
+        if (!idx[l].empty())
+          T->set(l, t.U().extract_cols(idx[l]), t.V().extract_rows(idx[l]));
+      return T;
+    }
+
+    template<typename scalar_t> void
+    LRTileMP<scalar_t>::get_cols(int l, std::size_t k, DenseM_t& U) const {
+      if (l == 1) copy(rows(), U.cols(), U1_, 0, k, U, 0, 0);
+      else from_bf16(U2_.data() + c()*k*rows(), rows(), U);
+    }
+    template<typename scalar_t> void
+    LRTileMP<scalar_t>::get_rows(int l, std::size_t k, DenseM_t& V) const {
+      if (l == 1) copy(V.rows(), cols(), V1_, k, 0, V, 0, 0);
+      else from_bf16(V2_.data() + c()*k, r2_, V);
+    }
+    template<typename scalar_t> void
+    LRTileMP<scalar_t>::set_cols(int l, std::size_t k, const DenseM_t& U) {
+      if (l == 1) copy(rows(), U.cols(), U, 0, 0, U1_, 0, k);
+      else to_bf16(U, U2_.data() + c()*k*rows(), rows());
+    }
+    template<typename scalar_t> void
+    LRTileMP<scalar_t>::set_rows(int l, std::size_t k, const DenseM_t& V) {
+      if (l == 1) copy(V.rows(), cols(), V, 0, 0, V1_, k, 0);
+      else to_bf16(V, V2_.data() + c()*k, r2_);
+    }
+
+    template<typename scalar_t> std::size_t
+    LRTileMP<scalar_t>::block_size() const {
+      return std::min(convert_block, std::max(rank(1), rank(2)));
+    }
+
+    template<typename scalar_t> void
+    LRTileMP<scalar_t>::set(int l, const DenseM_t& U, const DenseM_t& V) {
+      if (l == 1) {
+        U1_ = DenseMS_t(U.rows(), U.cols());
+        V1_ = DenseMS_t(V.rows(), V.cols());
+        copy(U, U1_);
+        copy(V, V1_);
+      } else {
+        r2_ = U.cols();
+        U2_ = to_bf16(U);
+        V2_ = to_bf16(V);
+      }
+    }
+
+    template<typename scalar_t> LRTile<scalar_t>
+    LRTileMP<scalar_t>::full() const {
+      LRTile<scalar_t> t(rows(), cols(), rank());
+      std::size_t k = 0;
+      for_each_part([&](const DenseM_t& U, const DenseM_t& V) {
+        copy(U, t.U(), 0, k);
+        copy(V, t.V(), k, 0);
+        k += U.cols();
+      });
+      return t;
+    }
+
+    template<typename scalar_t> void
+    LRTileMP<scalar_t>::to_working_precision() {
+      if (rank(1) || rank(2)) {
+        auto t = full();
+        U0_ = std::move(t.U());
+        V0_ = std::move(t.V());
+        U1_ = DenseMS_t();
+        V1_ = DenseMS_t();
+        U2_.clear();  U2_.shrink_to_fit();
+        V2_.clear();  V2_.shrink_to_fit();
+        r2_ = 0;
+      }
+    }
+
+    template<typename scalar_t> std::size_t
+    LRTileMP<scalar_t>::subnormals() const {
+      return U0_.subnormals() + V0_.subnormals() + U1_.subnormals()
+        + V1_.subnormals() + bf16_subnormals(U2_, c())
+        + bf16_subnormals(V2_, c());
+    }
+
+    template<typename scalar_t> std::size_t
+    LRTileMP<scalar_t>::zeros() const {
+      return U0_.zeros() + V0_.zeros() + U1_.zeros() + V1_.zeros()
+        + bf16_zeros(U2_, c()) + bf16_zeros(V2_, c());
+    }
+
+    template<typename scalar_t> void
+    LRTileMP<scalar_t>::dense(DenseM_t& A) const {
+      assert(A.rows() == rows() && A.cols() == cols());
+      A.zero();
+      for_each_part([&](const DenseM_t& U, const DenseM_t& V) {
+        gemm(Trans::N, Trans::N, scalar_t(1.), U, V, scalar_t(1.), A,
+             params::task_recursion_cutoff_level);
+      });
+    }
+
+    template<typename scalar_t> DenseMatrix<scalar_t>
+    LRTileMP<scalar_t>::dense() const {
+      DenseM_t A(rows(), cols());
+      dense(A);
+      return A;
+    }
+
+    template<typename scalar_t> void LRTileMP<scalar_t>::draw
+    (std::ostream& of, std::size_t roff, std::size_t coff) const {
+      char prev = std::cout.fill('0');
+      int maxrank = rows() * cols() / (rows() + cols());
+      int red = std::floor(255.0 * rank() / maxrank);
+      int blue = 255 - red;
+      of << "set obj rect from "
+         << roff << ", " << coff << " to "
+         << roff+rows() << ", " << coff+cols()
+         << " fc rgb '#"
+         << std::hex << std::setw(2) << std::setfill('0') << red
+         << "00" << std::setw(2)  << std::setfill('0') << blue
+         << "'" << std::dec << std::endl;
+      std::cout.fill(prev);
+    }
+
+    template<typename scalar_t> void
+    LRTileMP<scalar_t>::copy_to(scalar_t*& ptr) const {
+      // same layout as LRTile::copy_to, U (rows() x rank()) followed
+      // by V (rank() x cols())
+      const auto m = rows(), n = cols(), r = rank();
+      std::size_t k = 0;
+      for_each_part([&](const DenseM_t& U, const DenseM_t& V) {
+        for (std::size_t j=0; j<U.cols(); j++)
+          std::copy(U.ptr(0, j), U.ptr(0, j)+m, ptr+(k+j)*m);
+        for (std::size_t j=0; j<n; j++)
+          std::copy(V.ptr(0, j), V.ptr(0, j)+V.rows(), ptr+m*r+j*r+k);
+        k += U.cols();
+      });
+      ptr += (m + n) * r;
+    }
+
+    template<typename scalar_t> void
+    LRTileMP<scalar_t>::extract(const std::vector<std::size_t>& I,
+                                const std::vector<std::size_t>& J,
+                                DenseM_t& B) const {
+      B.zero();
+      for_each_part([&](const DenseM_t& U, const DenseM_t& V) {
+        gemm(Trans::N, Trans::N, scalar_t(1.), U.extract_rows(I),
+             V.extract_cols(J), scalar_t(1.), B,
+             params::task_recursion_cutoff_level);
+      });
+    }
+
+    template<typename scalar_t> void LRTileMP<scalar_t>::for_each_part
+    (const std::function<void(const DenseM_t&, const DenseM_t&)>& op) const {
+      if (rank(0)) op(U0_, V0_);
+      const auto kb = block_size();
+      if (!kb) return;
+      // scratch space, reused for all blocks of both parts
+      DenseM_t Uw(rows(), kb), Vw(kb, cols());
+      for (int l=1; l<3; l++)
+        for (std::size_t k=0; k<rank(l); k+=kb) {
+          auto b = std::min(kb, rank(l)-k);
+          DenseMW_t U(rows(), b, Uw, 0, 0), V(b, cols(), Vw, 0, 0);
+          get_cols(l, k, U);
+          get_rows(l, k, V);
+          op(U, V);
+        }
+    }
+
+    template<typename scalar_t> scalar_t
+    LRTileMP<scalar_t>::operator()(std::size_t i, std::size_t j) const {
+      scalar_t v = blas::dotu
+        (rank(0), U0_.ptr(i, 0), U0_.ld(), V0_.ptr(0, j), 1);
+      for (std::size_t k=0; k<rank(1); k++)
+        v += scalar_t(U1_(i, k)) * scalar_t(V1_(k, j));
+      for (std::size_t k=0; k<r2_; k++) {
+        scalar_t u, w;
+        const std::uint16_t *pu = U2_.data() + c()*(i+k*rows()),
+          *pw = V2_.data() + c()*(k+j*r2_);
+        from_bf16(u, pu);
+        from_bf16(w, pw);
+        v += u * w;
+      }
+      return v;
+    }
+
+    template<typename scalar_t> void
+    LRTileMP<scalar_t>::laswp(const std::vector<int>& piv, bool fwd) {
+      U0_.laswp(piv, fwd);
+      if (rank(1)) U1_.laswp(piv, fwd);
+      if (rank(2)) {
+        const auto kb = block_size();
+        DenseM_t Uw(rows(), kb);
+        for (std::size_t k=0; k<r2_; k+=kb) {
+          DenseMW_t U(rows(), std::min(kb, r2_-k), Uw, 0, 0);
+          get_cols(2, k, U);
+          U.laswp(piv, fwd);
+          set_cols(2, k, U);
+        }
+      }
+    }
+
+    template<typename scalar_t> void
+    LRTileMP<scalar_t>::trsm_b(Side s, UpLo ul, Trans ta, Diag d,
+                               scalar_t alpha, const DenseM_t& a) {
+      if (rank(0))
+        strumpack::trsm
+          (s, ul, ta, d, alpha, a, (s == Side::L) ? U0_ : V0_,
+           params::task_recursion_cutoff_level);
+      const auto kb = block_size();
+      if (!kb) return;
+      // the columns of U, or the rows of V, are independent
+      DenseM_t W = (s == Side::L) ?
+        DenseM_t(rows(), kb) : DenseM_t(kb, cols());
+      for (int l=1; l<3; l++)
+        for (std::size_t k=0; k<rank(l); k+=kb) {
+          auto b = std::min(kb, rank(l)-k);
+          if (s == Side::L) {
+            DenseMW_t U(rows(), b, W, 0, 0);
+            get_cols(l, k, U);
+            strumpack::trsm(s, ul, ta, d, alpha, a, U,
+                            params::task_recursion_cutoff_level);
+            set_cols(l, k, U);
+          } else {
+            DenseMW_t V(b, cols(), W, 0, 0);
+            get_rows(l, k, V);
+            strumpack::trsm(s, ul, ta, d, alpha, a, V,
+                            params::task_recursion_cutoff_level);
+            set_rows(l, k, V);
+          }
+        }
+    }
+
+    template<typename scalar_t> void
+    LRTileMP<scalar_t>::gemv_a(Trans ta, scalar_t alpha, const DenseM_t& x,
+                               scalar_t beta, DenseM_t& y) const {
+      scalar_t b = beta;
+      for_each_part([&](const DenseM_t& U, const DenseM_t& V) {
+        DenseM_t tmp(U.cols(), x.cols());
+        gemv(ta, scalar_t(1.), ta==Trans::N ? V : U, x, scalar_t(0.), tmp,
+             params::task_recursion_cutoff_level);
+        gemv(ta, alpha, ta==Trans::N ? U : V, tmp, b, y,
+             params::task_recursion_cutoff_level);
+        b = scalar_t(1.);
+      });
+    }
+
+    template<typename scalar_t> void
+    LRTileMP<scalar_t>::gemm_a(Trans ta, Trans tb, scalar_t alpha,
+                               const DenseM_t& b, scalar_t beta,
+                               DenseM_t& c, int task_depth) const {
+      scalar_t bt = beta;
+      for_each_part([&](const DenseM_t& U, const DenseM_t& V) {
+        DenseM_t tmp(U.cols(), c.cols());
+        gemm(ta, tb, scalar_t(1.), ta==Trans::N ? V : U, b,
+             scalar_t(0.), tmp, task_depth);
+        gemm(ta, Trans::N, alpha, ta==Trans::N ? U : V, tmp,
+             bt, c, task_depth);
+        bt = scalar_t(1.);
+      });
+    }
+
+    template<typename scalar_t> void
+    LRTileMP<scalar_t>::gemm_b(Trans ta, Trans tb, scalar_t alpha,
+                               const DenseM_t& a, scalar_t beta,
+                               DenseM_t& c, int task_depth) const {
+      scalar_t bt = beta;
+      for_each_part([&](const DenseM_t& U, const DenseM_t& V) {
+        DenseM_t tmp(c.rows(), U.cols());
+        gemm(ta, tb, scalar_t(1.), a, tb==Trans::N ? U : V,
+             scalar_t(0.), tmp, task_depth);
+        gemm(Trans::N, tb, alpha, tmp, tb==Trans::N ? V : U,
+             bt, c, task_depth);
+        bt = scalar_t(1.);
+      });
+    }
+
+    // explicit template instantiations
+    template class LRTileMP<float>;
+    template class LRTileMP<double>;
+    template class LRTileMP<std::complex<float>>;
+    template class LRTileMP<std::complex<double>>;
+
+  } // end namespace BLR
+} // end namespace strumpack
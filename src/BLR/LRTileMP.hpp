@@ -0,0 +1,378 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+/*! \file LRTileMP.hpp
+ * \brief Contains the LRTileMP class, a low-rank tile stored in mixed
+ * precision, subclass of BLRTile.
+ */
+#ifndef LR_TILE_MP_HPP
+#define LR_TILE_MP_HPP
+
+#include <cstdint>
+
+#include "LRTile.hpp"
+#include "DenseTile.hpp"
+
+namespace strumpack {
+  namespace BLR {
+
+    /**
+     * Single precision type corresponding to scalar_t, the same as
+     * scalar_t for float and std::complex<float>.
+     */
+    template<typename scalar_t> struct SinglePrecision {
+      using type = scalar_t;
+    };
+    template<> struct SinglePrecision<double> { using type = float; };
+    template<> struct SinglePrecision<std::complex<double>> {
+      using type = std::complex<float>;
+    };
+
+    /**
+     * Low rank U*V tile, with the rank-1 components U(:,k)*V(k,:)
+     * stored in working, single or bfloat16 precision, depending on
+     * their magnitude. A component with norm s_k is stored in a
+     * precision with unit roundoff u if s_k * u <= rel_tol * s_max,
+     * where s_max is the norm of the largest component in the
+     * tile. The lower precision parts are converted to the working
+     * precision on the fly when applying the tile, in blocks of a few
+     * components at a time, so this never needs a working precision
+     * copy of the whole tile.
+     *
+     * This is meant to store the factors after the factorization,
+     * the operations used in the solve phase (gemm/gemv with a
+     * DenseMatrix) and the queries (zeros, dense, extract, ..) are
+     * implemented directly on the stored parts. The products with
+     * other tiles, which are only used during the factorization,
+     * work on a working precision copy of the tile. Accessing the
+     * factors through U(), V() or D() converts the tile to working
+     * precision.
+     */
+    template<typename scalar_t> class LRTileMP
+      : public BLRTile<scalar_t> {
+      using real_t = typename RealType<scalar_t>::value_type;
+      using single_t = typename SinglePrecision<scalar_t>::type;
+      using DenseM_t = DenseMatrix<scalar_t>;
+      using DenseMW_t = DenseMatrixWrapper<scalar_t>;
+      using DenseMS_t = DenseMatrix<single_t>;
+      using Opts_t = BLROptions<scalar_t>;
+
+    public:
+      /**
+       * Create a mixed precision copy of low-rank tile t. Returns
+       * nullptr if none of the components of t can be stored in
+       * lower precision.
+       */
+      static std::unique_ptr<LRTileMP<scalar_t>>
+      create(const LRTile<scalar_t>& t, const Opts_t& opts);
+
+      std::size_t rows() const override { return U0_.rows(); }
+      std::size_t cols() const override { return V0_.cols(); }
+      std::size_t rank() const override { return rank(0)+rank(1)+rank(2); }
+      int rank_1() const override { return rank(); }
+      bool is_low_rank() const override { return true; };
+
+      /**
+       * Rank of the part stored in working (l = 0), single (l = 1) or
+       * bfloat16 (l = 2) precision.
+       */
+      std::size_t rank(int l) const {
+        return l == 0 ? U0_.cols() : (l == 1 ? U1_.cols() : r2_);
+      }
+
+      std::size_t memory() const override {
+        return U0_.memory() + V0_.memory() + U1_.memory() + V1_.memory()
+          + (U2_.size() + V2_.size()) * sizeof(std::uint16_t);
+      }
+      std::size_t nonzeros() const override {
+        return (rows()+cols())*rank();
+      }
+      std::size_t maximum_rank() const override { return rank(); }
+
+      std::size_t subnormals() const override;
+      std::size_t zeros() const override;
+
+      void dense(DenseM_t& A) const override;
+      DenseM_t dense() const override;
+
+      real_t normF() const override {
+        std::cerr << "WARNING: normF of compressed BLR matrix is not supported."
+                  << std::endl;
+        assert(false);
+        return 0.;
+      }
+
+      std::unique_ptr<BLRTile<scalar_t>> clone() const override {
+        return std::unique_ptr<BLRTile<scalar_t>>
+          (new LRTileMP<scalar_t>(*this));
+      }
+
+      /**
+       * The tile is already compressed, this returns a working
+       * precision copy.
+       */
+      std::unique_ptr<LRTile<scalar_t>>
+      compress(const Opts_t& opts, std::size_t seed) const override {
+        return std::unique_ptr<LRTile<scalar_t>>
+          (new LRTile<scalar_t>(full()));
+      };
+
+      void draw(std::ostream& of, std::size_t roff,
+                std::size_t coff) const override;
+
+      /**
+       * The factors in working precision. The lower precision parts
+       * are first converted to working precision (this is exact), and
+       * the tile then keeps all rank() components in working
+       * precision, as an LRTile. Like for LRTile, D() is the same as
+       * U(). Converting is not thread safe, and the const versions
+       * also convert the tile.
+       */
+      DenseM_t& D() override { return U(); }
+      DenseM_t& U() override { to_working_precision(); return U0_; }
+      DenseM_t& V() override { to_working_precision(); return V0_; }
+      const DenseM_t& D() const override { return U(); }
+      const DenseM_t& U() const override {
+        const_cast<LRTileMP<scalar_t>*>(this)->to_working_precision();
+        return U0_;
+      }
+      const DenseM_t& V() const override {
+        const_cast<LRTileMP<scalar_t>*>(this)->to_working_precision();
+        return V0_;
+      }
+
+      void copy_to(scalar_t*& ptr) const override;
+
+      LRTile<scalar_t>
+      multiply(const BLRTile<scalar_t>& a) const override {
+        return full().multiply(a);
+      }
+      LRTile<scalar_t>
+      left_multiply(const LRTile<scalar_t>& a) const override {
+        return full().left_multiply(a);
+      }
+      LRTile<scalar_t>
+      left_multiply(const DenseTile<scalar_t>& a) const override {
+        return full().left_multiply(a);
+      }
+
+      void multiply(const BLRTile<scalar_t>& a,
+                    DenseM_t& b, DenseM_t& c) const override {
+        full().multiply(a, b, c);
+      }
+      void left_multiply(const LRTile<scalar_t>& a,
+                         DenseM_t& b, DenseM_t& c) const override {
+        full().left_multiply(a, b, c);
+      }
+      void left_multiply(const DenseTile<scalar_t>& a,
+                         DenseM_t& b, DenseM_t& c) const override {
+        full().left_multiply(a, b, c);
+      }
+
+      scalar_t operator()(std::size_t i, std::size_t j) const override;
+
+      void extract(const std::vector<std::size_t>& I,
+                   const std::vector<std::size_t>& J,
+                   DenseM_t& B) const override;
+
+      void laswp(const std::vector<int>& piv, bool fwd) override;
+#if defined(STRUMPACK_USE_GPU)
+      // mixed precision tiles are only created on the host
+      void laswp(gpu::Handle& h, int* dpiv, bool fwd) override {
+        assert(false);
+      }
+      void move_to_cpu(gpu::Stream& s, scalar_t* pinned=nullptr) override {
+        assert(false);
+      }
+      void move_to_gpu(gpu::Stream& s, scalar_t* dptr,
+                       scalar_t* pinned=nullptr) override {
+        assert(false);
+      }
+      void copy_from_device_to(scalar_t*& ptr) const override {
+        assert(false);
+      }
+#endif
+
+      void trsm_b(Side s, UpLo ul, Trans ta, Diag d,
+                  scalar_t alpha, const DenseM_t& a) override;
+#if defined(STRUMPACK_USE_GPU)
+      void trsm_b(gpu::Handle& handle, Side s, UpLo ul,
+                  Trans ta, Diag d, scalar_t alpha,
+                  DenseM_t& a) override {
+        assert(false);
+      }
+#endif
+
+      void gemv_a(Trans ta, scalar_t alpha, const DenseM_t& x,
+                  scalar_t beta, DenseM_t& y) const override;
+
+      void gemm_a(Trans ta, Trans tb, scalar_t alpha,
+                  const BLRTile<scalar_t>& b,
+                  scalar_t beta, DenseM_t& c) const override {
+        b.gemm_b(ta, tb, alpha, full(), beta, c);
+      }
+
+      void gemm_a(Trans ta, Trans tb, scalar_t alpha,
+                  const DenseM_t& b, scalar_t beta,
+                  DenseM_t& c, int task_depth) const override;
+
+      void gemm_b(Trans ta, Trans tb, scalar_t alpha,
+                  const LRTile<scalar_t>& a, scalar_t beta,
+                  DenseM_t& c) const override {
+        full().gemm_b(ta, tb, alpha, a, beta, c);
+      }
+
+      void gemm_b(Trans ta, Trans tb, scalar_t alpha,
+                  const DenseTile<scalar_t>& a, scalar_t beta,
+                  DenseM_t& c) const override {
+        gemm_b(ta, tb, alpha, a.D(), beta, c,
+               params::task_recursion_cutoff_level);
+      }
+
+      void gemm_b(Trans ta, Trans tb, scalar_t alpha,
+                  const DenseM_t& a, scalar_t beta,
+                  DenseM_t& c, int task_depth) const override;
+
+      void Schur_update_col_a(std::size_t i, const BLRTile<scalar_t>& b,
+                              scalar_t* c, scalar_t* work) const override {
+        b.Schur_update_col_b(i, full(), c, work);
+      }
+      void Schur_update_row_a(std::size_t i, const BLRTile<scalar_t>& b,
+                              scalar_t* c, scalar_t* work) const override {
+        b.Schur_update_row_b(i, full(), c, work);
+      }
+      void Schur_update_col_b(std::size_t i, const LRTile<scalar_t>& a,
+                              scalar_t* c, scalar_t* work) const override {
+        full().Schur_update_col_b(i, a, c, work);
+      }
+      void Schur_update_col_b(std::size_t i, const DenseTile<scalar_t>& a,
+                              scalar_t* c, scalar_t* work) const override {
+        full().Schur_update_col_b(i, a, c, work);
+      }
+      void Schur_update_row_b(std::size_t i, const LRTile<scalar_t>& a,
+                              scalar_t* c, scalar_t* work) const override {
+        full().Schur_update_row_b(i, a, c, work);
+      }
+      void Schur_update_row_b(std::size_t i, const DenseTile<scalar_t>& a,
+                              scalar_t* c, scalar_t* work) const override {
+        full().Schur_update_row_b(i, a, c, work);
+      }
+      void Schur_update_cols_a(const std::vector<std::size_t>& cols,
+                               const BLRTile<scalar_t>& b,
+                               DenseMatrix<scalar_t>& c,
+                               scalar_t* work) const override {
+        b.Schur_update_cols_b(cols, full(), c, work);
+      }
+      void Schur_update_rows_a(const std::vector<std::size_t>& rows,
+                               const BLRTile<scalar_t>& b,
+                               DenseMatrix<scalar_t>& c,
+                               scalar_t* work) const override {
+        b.Schur_update_rows_b(rows, full(), c, work);
+      }
+      void Schur_update_cols_b(const std::vector<std::size_t>& cols,
+                               const LRTile<scalar_t>& a,
+                               DenseMatrix<scalar_t>& c,
+                               scalar_t* work) const override {
+        full().Schur_update_cols_b(cols, a, c, work);
+      }
+      void Schur_update_cols_b(const std::vector<std::size_t>& cols,
+                               const DenseTile<scalar_t>& a,
+                               DenseMatrix<scalar_t>& c,
+                               scalar_t* work) const override {
+        full().Schur_update_cols_b(cols, a, c, work);
+      }
+      void Schur_update_rows_b(const std::vector<std::size_t>& rows,
+                               const LRTile<scalar_t>& a,
+                               DenseMatrix<scalar_t>& c,
+                               scalar_t* work) const override {
+        full().Schur_update_rows_b(rows, a, c, work);
+      }
+      void Schur_update_rows_b(const std::vector<std::size_t>& rows,
+                               const DenseTile<scalar_t>& a,
+                               DenseMatrix<scalar_t>& c,
+                               scalar_t* work) const override {
+        full().Schur_update_rows_b(rows, a, c, work);
+      }
+
+    private:
+      // working precision part
+      DenseM_t U0_, V0_;
+      // single precision part, empty if single_t == scalar_t
+      DenseMS_t U1_, V1_;
+      // bfloat16 part, real and imaginary parts interleaved
+      std::vector<std::uint16_t> U2_, V2_;
+      std::size_t r2_ = 0;
+
+      LRTileMP() = default;
+
+      // number of values per element in the bfloat16 storage
+      static int c() { return is_complex<scalar_t>() ? 2 : 1; }
+
+      /**
+       * Convert the lower precision parts to working precision and
+       * store them with the working precision part.
+       */
+      void to_working_precision();
+
+      /**
+       * Convert the columns k, .., k+U.cols()-1 of the U factor,
+       * respectively the rows k, .., k+V.rows()-1 of the V factor, of
+       * the part stored in precision l (1 or 2) to working precision,
+       * or back.
+       */
+      void get_cols(int l, std::size_t k, DenseM_t& U) const;
+      void get_rows(int l, std::size_t k, DenseM_t& V) const;
+      void set_cols(int l, std::size_t k, const DenseM_t& U);
+      void set_rows(int l, std::size_t k, const DenseM_t& V);
+      void set(int l, const DenseM_t& U, const DenseM_t& V);
+
+      /**
+       * Number of components converted at once, with the lower
+       * precision parts.
+       */
+      std::size_t block_size() const;
+
+      /**
+       * Working precision copy of the whole tile.
+       */
+      LRTile<scalar_t> full() const;
+
+      /**
+       * Call op(U, V) for the working precision part, and for blocks
+       * of block_size() components of the lower precision parts,
+       * converted to working precision in a scratch buffer. The
+       * products U*V of all calls add up to the tile.
+       */
+      void for_each_part
+      (const std::function<void(const DenseM_t&, const DenseM_t&)>& op) const;
+    };
+
+  } // end namespace BLR
+} // end namespace strumpack
+
+#endif // LR_TILE_MP_HPP
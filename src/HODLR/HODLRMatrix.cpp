@@ -167,11 +167,13 @@ namespace strumpack {
     (const MPIComm& c, kernel::Kernel<real_t>& K, const opts_t& opts) {
       rows_ = cols_ = K.n();
       structured::ClusterTree tree(rows_);
-      if (opts.geo() == 1)
+      if (opts.geo() == 1) {
         tree = binary_tree_clustering
           (opts.clustering_algorithm(), K.data(),
            K.permutation(), opts.leaf_size());
-      else tree.refine(opts.leaf_size());
+        K.tree() = tree;
+        K.update_norms();
+      } else tree.refine(opts.leaf_size());
       int min_lvl = 2 + std::ceil(std::log2(c.size()));
       lvls_ = std::max(min_lvl, tree.levels());
       tree.expand_complete_levels(lvls_);
@@ -0,0 +1,563 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+#include <algorithm>
+#include <numeric>
+
+#include "NativeHODLRMatrix.hpp"
+#include "dense/ACA.hpp"
+#include "misc/RandomWrapper.hpp"
+
+namespace strumpack {
+  namespace HODLR {
+
+    template<typename scalar_t> NativeHODLRMatrix<scalar_t>::NativeHODLRMatrix
+    (std::size_t n, const opts_t& opts)
+      : NativeHODLRMatrix
+        (structured::ClusterTree(n).refine(opts.leaf_size())) {}
+
+    template<typename scalar_t> NativeHODLRMatrix<scalar_t>::NativeHODLRMatrix
+    (const structured::ClusterTree& t) : rows_(t.size) {
+      if (!t.c.empty()) {
+        ch_.reserve(2);
+        ch_.emplace_back(t.c[0]);
+        ch_.emplace_back(t.c[1]);
+      }
+    }
+
+    template<typename scalar_t> std::size_t
+    NativeHODLRMatrix<scalar_t>::memory() const {
+      std::size_t mem = sizeof(*this) + D_.memory() + U01_.memory() +
+        V01_.memory() + U10_.memory() + V10_.memory() + Y0_.memory() +
+        Y1_.memory() + F_.memory() + piv_.size()*sizeof(int);
+      for (auto& c : ch_) mem += c.memory();
+      return mem;
+    }
+
+    template<typename scalar_t> std::size_t
+    NativeHODLRMatrix<scalar_t>::nonzeros() const {
+      std::size_t nnz = D_.nonzeros() + U01_.nonzeros() +
+        V01_.nonzeros() + U10_.nonzeros() + V10_.nonzeros() +
+        Y0_.nonzeros() + Y1_.nonzeros() + F_.nonzeros();
+      for (auto& c : ch_) nnz += c.nonzeros();
+      return nnz;
+    }
+
+    template<typename scalar_t> std::size_t
+    NativeHODLRMatrix<scalar_t>::rank() const {
+      std::size_t r = std::max(U01_.cols(), U10_.cols());
+      for (auto& c : ch_) r = std::max(r, c.rank());
+      return r;
+    }
+
+    template<typename scalar_t> int
+    NativeHODLRMatrix<scalar_t>::levels() const {
+      int lvls = 0;
+      for (auto& c : ch_) lvls = std::max(lvls, c.levels());
+      return lvls + 1;
+    }
+
+    template<typename scalar_t> void
+    NativeHODLRMatrix<scalar_t>::truncate_rank(int max_rank) {
+      // the columns of U (rows of V) come out of a (pivoted) QR or
+      // ACA in order of decreasing importance
+      auto trunc = [max_rank](DenseM_t& U, DenseM_t& V) {
+        if (int(U.cols()) <= max_rank) return;
+        U = DenseM_t(U.rows(), max_rank, U, 0, 0);
+        V = DenseM_t(max_rank, V.cols(), V, 0, 0);
+      };
+      trunc(U01_, V01_);
+      trunc(U10_, V10_);
+    }
+
+    template<typename scalar_t> void
+    NativeHODLRMatrix<scalar_t>::compress
+    (const DenseM_t& A, const opts_t& opts, int task_depth) {
+      assert(A.rows() == rows() && A.cols() == cols());
+      if (task_depth == 0) {
+#pragma omp parallel if(!omp_in_parallel())
+#pragma omp single nowait
+        compress_dense(A, opts, task_depth);
+      } else compress_dense(A, opts, task_depth);
+    }
+
+    template<typename scalar_t> void
+    NativeHODLRMatrix<scalar_t>::compress_dense
+    (const DenseM_t& A, const opts_t& opts, int task_depth) {
+      if (leaf()) {
+        D_ = DenseM_t(rows_, rows_, A, 0, 0);
+        return;
+      }
+      auto m0 = ch_[0].rows(), m1 = ch_[1].rows();
+      auto A00 = ConstDenseMatrixWrapperPtr(m0, m0, A, 0, 0);
+      auto A11 = ConstDenseMatrixWrapperPtr(m1, m1, A, m0, m0);
+      auto A01 = ConstDenseMatrixWrapperPtr(m0, m1, A, 0, m0);
+      auto A10 = ConstDenseMatrixWrapperPtr(m1, m0, A, m0, 0);
+      bool tasked = task_depth < params::task_recursion_cutoff_level;
+      if (tasked) {
+#pragma omp task default(shared)                                        \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+        ch_[0].compress_dense(*A00, opts, task_depth+1);
+#pragma omp task default(shared)                                        \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+        ch_[1].compress_dense(*A11, opts, task_depth+1);
+#pragma omp task default(shared)                                        \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+        A01->low_rank(U01_, V01_, opts.rel_tol(), opts.abs_tol(),
+                      opts.max_rank(), task_depth+1);
+#pragma omp task default(shared)                                        \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+        A10->low_rank(U10_, V10_, opts.rel_tol(), opts.abs_tol(),
+                      opts.max_rank(), task_depth+1);
+#pragma omp taskwait
+      } else {
+        ch_[0].compress_dense(*A00, opts, task_depth);
+        ch_[1].compress_dense(*A11, opts, task_depth);
+        A01->low_rank(U01_, V01_, opts.rel_tol(), opts.abs_tol(),
+                      opts.max_rank(), task_depth);
+        A10->low_rank(U10_, V10_, opts.rel_tol(), opts.abs_tol(),
+                      opts.max_rank(), task_depth);
+      }
+      truncate_rank(opts.max_rank());
+    }
+
+    template<typename scalar_t> void
+    NativeHODLRMatrix<scalar_t>::compress
+    (const elem_t& Aelem, const opts_t& opts) {
+#pragma omp parallel if(!omp_in_parallel())
+#pragma omp single nowait
+      compress_elements(Aelem, opts, 0, 0);
+    }
+
+    template<typename scalar_t> void
+    NativeHODLRMatrix<scalar_t>::compress_elements
+    (const elem_t& Aelem, const opts_t& opts,
+     std::size_t offset, int task_depth) {
+      if (leaf()) {
+        std::vector<std::size_t> I(rows_);
+        std::iota(I.begin(), I.end(), offset);
+        D_ = DenseM_t(rows_, rows_);
+        Aelem(I, I, D_);
+        return;
+      }
+      auto m0 = ch_[0].rows(), m1 = ch_[1].rows();
+      auto aca = [&](std::size_t r0, std::size_t m, std::size_t c0,
+                     std::size_t n, DenseM_t& U, DenseM_t& V) {
+        std::vector<std::size_t> I(m), J(n), i(1);
+        std::iota(I.begin(), I.end(), r0);
+        std::iota(J.begin(), J.end(), c0);
+        auto Arow = [&](std::size_t r, scalar_t* row) {
+          i[0] = r0 + r;
+          DenseMW_t B(1, n, row, 1);
+          Aelem(i, J, B);
+        };
+        auto Acol = [&](std::size_t c, scalar_t* col) {
+          i[0] = c0 + c;
+          DenseMW_t B(m, 1, col, m);
+          Aelem(I, i, B);
+        };
+        adaptive_cross_approximation<scalar_t>
+          (U, V, m, n, Arow, Acol, opts.rel_tol(), opts.abs_tol(),
+           opts.max_rank());
+      };
+      bool tasked = task_depth < params::task_recursion_cutoff_level;
+      if (tasked) {
+#pragma omp task default(shared)                                        \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+        ch_[0].compress_elements(Aelem, opts, offset, task_depth+1);
+#pragma omp task default(shared)                                        \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+        ch_[1].compress_elements(Aelem, opts, offset+m0, task_depth+1);
+#pragma omp task default(shared)                                        \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+        aca(offset, m0, offset+m0, m1, U01_, V01_);
+        aca(offset+m0, m1, offset, m0, U10_, V10_);
+#pragma omp taskwait
+      } else {
+        ch_[0].compress_elements(Aelem, opts, offset, task_depth);
+        ch_[1].compress_elements(Aelem, opts, offset+m0, task_depth);
+        aca(offset, m0, offset+m0, m1, U01_, V01_);
+        aca(offset+m0, m1, offset, m0, U10_, V10_);
+      }
+    }
+
+    template<typename scalar_t> void
+    NativeHODLRMatrix<scalar_t>::internal_nodes
+    (int lvl, std::size_t offset,
+     std::vector<std::pair<NativeHODLRMatrix<scalar_t>*,
+     std::size_t>>& nodes) {
+      if (leaf()) return;
+      if (lvl == 0) nodes.emplace_back(this, offset);
+      else {
+        ch_[0].internal_nodes(lvl-1, offset, nodes);
+        ch_[1].internal_nodes(lvl-1, offset+ch_[0].rows(), nodes);
+      }
+    }
+
+    template<typename scalar_t> void
+    NativeHODLRMatrix<scalar_t>::leaf_nodes
+    (std::size_t offset, std::vector<std::pair<NativeHODLRMatrix<scalar_t>*,
+     std::size_t>>& nodes) {
+      if (leaf()) nodes.emplace_back(this, offset);
+      else {
+        ch_[0].leaf_nodes(offset, nodes);
+        ch_[1].leaf_nodes(offset+ch_[0].rows(), nodes);
+      }
+    }
+
+    template<typename scalar_t> void
+    NativeHODLRMatrix<scalar_t>::compress
+    (const mult_t& Amult, const opts_t& opts) {
+      const int p = 10; // oversampling
+      const auto n = rows_;
+      auto rgen = random::make_default_random_generator<real_t>();
+      std::vector<std::pair<NativeHODLRMatrix<scalar_t>*,
+                            std::size_t>> nodes;
+      for (int l=0, lvls=levels(); l<lvls-1; l++) {
+        nodes.clear();
+        internal_nodes(l, 0, nodes);
+        if (nodes.empty()) continue;
+        std::size_t mmax = 0;
+        for (auto& H : nodes)
+          mmax = std::max
+            (mmax, std::max(H.first->ch_[0].rows(), H.first->ch_[1].rows()));
+        std::size_t dmax = std::min(mmax, std::size_t(opts.max_rank() + p)),
+          d = std::min(dmax, std::size_t(opts.rank_guess() + p));
+        std::vector<DenseM_t> Q01(nodes.size()), Q10(nodes.size());
+        while (true) {
+          // sample A01 with random vectors supported on the second
+          // child, A10 with vectors supported on the first child
+          DenseM_t R0(n, d), R1(n, d), S0(n, d), S1(n, d);
+          R0.zero();
+          R1.zero();
+          for (auto& H : nodes) {
+            auto m0 = H.first->ch_[0].rows(), m1 = H.first->ch_[1].rows();
+            DenseMW_t(m1, d, R0, H.second+m0, 0).random(*rgen);
+            DenseMW_t(m0, d, R1, H.second, 0).random(*rgen);
+          }
+          Amult(Trans::N, R0, S0);
+          Amult(Trans::N, R1, S1);
+          // peel off the coarser levels
+          offdiag_add_levels(Trans::N, scalar_t(-1.), R0, S0, l);
+          offdiag_add_levels(Trans::N, scalar_t(-1.), R1, S1, l);
+          bool saturated = false;
+          for (std::size_t i=0; i<nodes.size(); i++) {
+            auto H = nodes[i].first;
+            auto o = nodes[i].second;
+            auto m0 = H->ch_[0].rows(), m1 = H->ch_[1].rows();
+            DenseM_t B;
+            DenseMW_t(m0, d, S0, o, 0).low_rank
+              (Q01[i], B, opts.rel_tol(), opts.abs_tol(), opts.max_rank(),
+               params::task_recursion_cutoff_level);
+            DenseMW_t(m1, d, S1, o+m0, 0).low_rank
+              (Q10[i], B, opts.rel_tol(), opts.abs_tol(), opts.max_rank(),
+               params::task_recursion_cutoff_level);
+            if ((Q01[i].cols() + p > d && d < m1) ||
+                (Q10[i].cols() + p > d && d < m0))
+              saturated = true;
+          }
+          if (!saturated || d >= dmax) break;
+          d = std::min(dmax, 2 * d);
+        }
+        // project: V01 = Q01^* A01, V10 = Q10^* A10
+        std::size_t r0 = 0, r1 = 0;
+        for (std::size_t i=0; i<nodes.size(); i++) {
+          r0 = std::max(r0, Q01[i].cols());
+          r1 = std::max(r1, Q10[i].cols());
+        }
+        DenseM_t W0(n, r0), W1(n, r1), T0(n, r0), T1(n, r1);
+        W0.zero();
+        W1.zero();
+        for (std::size_t i=0; i<nodes.size(); i++) {
+          auto o = nodes[i].second;
+          auto m0 = nodes[i].first->ch_[0].rows();
+          DenseMW_t(Q01[i].rows(), Q01[i].cols(), W0, o, 0).copy(Q01[i]);
+          DenseMW_t(Q10[i].rows(), Q10[i].cols(), W1, o+m0, 0).copy(Q10[i]);
+        }
+        Amult(Trans::C, W0, T0);
+        Amult(Trans::C, W1, T1);
+        offdiag_add_levels(Trans::C, scalar_t(-1.), W0, T0, l);
+        offdiag_add_levels(Trans::C, scalar_t(-1.), W1, T1, l);
+        for (std::size_t i=0; i<nodes.size(); i++) {
+          auto H = nodes[i].first;
+          auto o = nodes[i].second;
+          auto m0 = H->ch_[0].rows(), m1 = H->ch_[1].rows();
+          H->U01_ = std::move(Q01[i]);
+          H->U10_ = std::move(Q10[i]);
+          H->V01_ = DenseMW_t(m1, H->U01_.cols(), T0, o+m0, 0).conj_transpose();
+          H->V10_ = DenseMW_t(m0, H->U10_.cols(), T1, o, 0).conj_transpose();
+        }
+      }
+      // the dense leafs, using identity blocks: everything outside
+      // the diagonal leaf blocks is low-rank and known by now
+      nodes.clear();
+      leaf_nodes(0, nodes);
+      std::size_t mmax = 0;
+      for (auto& H : nodes) mmax = std::max(mmax, H.first->rows());
+      DenseM_t E(n, mmax), S(n, mmax);
+      E.zero();
+      for (auto& H : nodes)
+        for (std::size_t i=0; i<H.first->rows(); i++)
+          E(H.second+i, i) = scalar_t(1.);
+      Amult(Trans::N, E, S);
+      offdiag_add_levels(Trans::N, scalar_t(-1.), E, S, levels());
+      for (auto& H : nodes) {
+        auto m = H.first->rows();
+        H.first->D_ = DenseM_t(m, m, S, H.second, 0);
+      }
+    }
+
+    template<typename scalar_t> void
+    NativeHODLRMatrix<scalar_t>::offdiag_add
+    (Trans op, scalar_t a, const DenseM_t& x, DenseM_t& y,
+     int task_depth) const {
+      auto m0 = ch_[0].rows(), m1 = ch_[1].rows(), nc = x.cols();
+      auto x0 = ConstDenseMatrixWrapperPtr(m0, nc, x, 0, 0);
+      auto x1 = ConstDenseMatrixWrapperPtr(m1, nc, x, m0, 0);
+      DenseMW_t y0(m0, nc, y, 0, 0), y1(m1, nc, y, m0, 0);
+      if (op == Trans::N) {
+        if (U01_.cols()) {
+          DenseM_t t(V01_.rows(), nc);
+          gemm(Trans::N, Trans::N, scalar_t(1.), V01_, *x1,
+               scalar_t(0.), t, task_depth);
+          gemm(Trans::N, Trans::N, a, U01_, t,
+               scalar_t(1.), y0, task_depth);
+        }
+        if (U10_.cols()) {
+          DenseM_t t(V10_.rows(), nc);
+          gemm(Trans::N, Trans::N, scalar_t(1.), V10_, *x0,
+               scalar_t(0.), t, task_depth);
+          gemm(Trans::N, Trans::N, a, U10_, t,
+               scalar_t(1.), y1, task_depth);
+        }
+      } else {
+        // op(A)_01 = op(V10) op(U10), op(A)_10 = op(V01) op(U01)
+        if (U10_.cols()) {
+          DenseM_t t(U10_.cols(), nc);
+          gemm(op, Trans::N, scalar_t(1.), U10_, *x1,
+               scalar_t(0.), t, task_depth);
+          gemm(op, Trans::N, a, V10_, t, scalar_t(1.), y0, task_depth);
+        }
+        if (U01_.cols()) {
+          DenseM_t t(U01_.cols(), nc);
+          gemm(op, Trans::N, scalar_t(1.), U01_, *x0,
+               scalar_t(0.), t, task_depth);
+          gemm(op, Trans::N, a, V01_, t, scalar_t(1.), y1, task_depth);
+        }
+      }
+    }
+
+    template<typename scalar_t> void
+    NativeHODLRMatrix<scalar_t>::offdiag_add_levels
+    (Trans op, scalar_t a, const DenseM_t& x, DenseM_t& y, int lvls) const {
+      if (leaf() || lvls <= 0) return;
+      offdiag_add(op, a, x, y, params::task_recursion_cutoff_level);
+      auto m0 = ch_[0].rows(), m1 = ch_[1].rows(), nc = x.cols();
+      DenseMW_t y0(m0, nc, y, 0, 0), y1(m1, nc, y, m0, 0);
+      ch_[0].offdiag_add_levels
+        (op, a, *ConstDenseMatrixWrapperPtr(m0, nc, x, 0, 0), y0, lvls-1);
+      ch_[1].offdiag_add_levels
+        (op, a, *ConstDenseMatrixWrapperPtr(m1, nc, x, m0, 0), y1, lvls-1);
+    }
+
+    template<typename scalar_t> void
+    NativeHODLRMatrix<scalar_t>::mult
+    (Trans op, const DenseM_t& x, DenseM_t& y) const {
+      assert(x.rows() == cols() && y.rows() == rows() &&
+             x.cols() == y.cols());
+#pragma omp parallel if(!omp_in_parallel())
+#pragma omp single nowait
+      mult_recursive(op, x, y, 0);
+    }
+
+    template<typename scalar_t> void
+    NativeHODLRMatrix<scalar_t>::mult_recursive
+    (Trans op, const DenseM_t& x, DenseM_t& y, int task_depth) const {
+      if (leaf()) {
+        gemm(op, Trans::N, scalar_t(1.), D_, x, scalar_t(0.), y, task_depth);
+        return;
+      }
+      auto m0 = ch_[0].rows(), m1 = ch_[1].rows(), nc = x.cols();
+      auto x0 = ConstDenseMatrixWrapperPtr(m0, nc, x, 0, 0);
+      auto x1 = ConstDenseMatrixWrapperPtr(m1, nc, x, m0, 0);
+      DenseMW_t y0(m0, nc, y, 0, 0), y1(m1, nc, y, m0, 0);
+      if (task_depth < params::task_recursion_cutoff_level) {
+#pragma omp task default(shared)                                        \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+        ch_[0].mult_recursive(op, *x0, y0, task_depth+1);
+#pragma omp task default(shared)                                        \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+        ch_[1].mult_recursive(op, *x1, y1, task_depth+1);
+#pragma omp taskwait
+      } else {
+        ch_[0].mult_recursive(op, *x0, y0, task_depth);
+        ch_[1].mult_recursive(op, *x1, y1, task_depth);
+      }
+      offdiag_add(op, scalar_t(1.), x, y, task_depth);
+    }
+
+    template<typename scalar_t> void
+    NativeHODLRMatrix<scalar_t>::factor() {
+#pragma omp parallel if(!omp_in_parallel())
+#pragma omp single nowait
+      factor(0);
+    }
+
+    template<typename scalar_t> int
+    NativeHODLRMatrix<scalar_t>::factor(int task_depth) {
+      if (leaf()) {
+        F_ = D_;
+        return F_.LU(piv_, task_depth);
+      }
+      int i0 = 0, i1 = 0;
+      bool tasked = task_depth < params::task_recursion_cutoff_level;
+      if (tasked) {
+#pragma omp task default(shared)                                        \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+        {
+          i0 = ch_[0].factor(task_depth+1);
+          Y0_ = U01_;
+          ch_[0].solve(Y0_, task_depth+1);
+        }
+#pragma omp task default(shared)                                        \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+        {
+          i1 = ch_[1].factor(task_depth+1);
+          Y1_ = U10_;
+          ch_[1].solve(Y1_, task_depth+1);
+        }
+#pragma omp taskwait
+      } else {
+        i0 = ch_[0].factor(task_depth);
+        Y0_ = U01_;
+        ch_[0].solve(Y0_, task_depth);
+        i1 = ch_[1].factor(task_depth);
+        Y1_ = U10_;
+        ch_[1].solve(Y1_, task_depth);
+      }
+      // capacitance matrix K = I + [0 V01; V10 0] diag(Y0, Y1)
+      auto r0 = U01_.cols(), r1 = U10_.cols();
+      F_ = DenseM_t(r0+r1, r0+r1);
+      F_.eye();
+      if (r0 && r1) {
+        DenseMW_t K01(r0, r1, F_, 0, r0), K10(r1, r0, F_, r0, 0);
+        gemm(Trans::N, Trans::N, scalar_t(1.), V01_, Y1_,
+             scalar_t(0.), K01, task_depth);
+        gemm(Trans::N, Trans::N, scalar_t(1.), V10_, Y0_,
+             scalar_t(0.), K10, task_depth);
+      }
+      int info = F_.LU(piv_, task_depth);
+      return i0 ? i0 : (i1 ? i1 : info);
+    }
+
+    template<typename scalar_t> void
+    NativeHODLRMatrix<scalar_t>::solve(DenseM_t& b) const {
+      assert(b.rows() == rows());
+#pragma omp parallel if(!omp_in_parallel())
+#pragma omp single nowait
+      solve(b, 0);
+    }
+
+    template<typename scalar_t> void
+    NativeHODLRMatrix<scalar_t>::solve(DenseM_t& b, int task_depth) const {
+      if (leaf()) {
+        F_.solve_LU_in_place(b, piv_, task_depth);
+        return;
+      }
+      auto m0 = ch_[0].rows(), m1 = ch_[1].rows(), nc = b.cols();
+      DenseMW_t b0(m0, nc, b, 0, 0), b1(m1, nc, b, m0, 0);
+      if (task_depth < params::task_recursion_cutoff_level) {
+#pragma omp task default(shared)                                        \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+        ch_[0].solve(b0, task_depth+1);
+#pragma omp task default(shared)                                        \
+  final(task_depth >= params::task_recursion_cutoff_level-1) mergeable
+        ch_[1].solve(b1, task_depth+1);
+#pragma omp taskwait
+      } else {
+        ch_[0].solve(b0, task_depth);
+        ch_[1].solve(b1, task_depth);
+      }
+      auto r0 = U01_.cols(), r1 = U10_.cols();
+      if (!(r0 + r1)) return;
+      // x = D^{-1} b - diag(Y0, Y1) K^{-1} [V01 x1; V10 x0]
+      DenseM_t t(r0+r1, nc);
+      DenseMW_t t0(r0, nc, t, 0, 0), t1(r1, nc, t, r0, 0);
+      gemm(Trans::N, Trans::N, scalar_t(1.), V01_, b1,
+           scalar_t(0.), t0, task_depth);
+      gemm(Trans::N, Trans::N, scalar_t(1.), V10_, b0,
+           scalar_t(0.), t1, task_depth);
+      F_.solve_LU_in_place(t, piv_, task_depth);
+      gemm(Trans::N, Trans::N, scalar_t(-1.), Y0_, t0,
+           scalar_t(1.), b0, task_depth);
+      gemm(Trans::N, Trans::N, scalar_t(-1.), Y1_, t1,
+           scalar_t(1.), b1, task_depth);
+    }
+
+    template<typename scalar_t> void
+    NativeHODLRMatrix<scalar_t>::shift(scalar_t s) {
+      if (leaf()) D_.shift(s);
+      else for (auto& c : ch_) c.shift(s);
+    }
+
+    template<typename scalar_t> DenseMatrix<scalar_t>
+    NativeHODLRMatrix<scalar_t>::dense() const {
+      DenseM_t A(rows(), cols());
+      dense_recursive(A);
+      return A;
+    }
+
+    template<typename scalar_t> void
+    NativeHODLRMatrix<scalar_t>::dense_recursive(DenseM_t& A) const {
+      if (leaf()) {
+        A.copy(D_);
+        return;
+      }
+      auto m0 = ch_[0].rows(), m1 = ch_[1].rows();
+      DenseMW_t A00(m0, m0, A, 0, 0), A11(m1, m1, A, m0, m0),
+        A01(m0, m1, A, 0, m0), A10(m1, m0, A, m0, 0);
+      ch_[0].dense_recursive(A00);
+      ch_[1].dense_recursive(A11);
+      if (U01_.cols())
+        gemm(Trans::N, Trans::N, scalar_t(1.), U01_, V01_,
+             scalar_t(0.), A01);
+      else A01.zero();
+      if (U10_.cols())
+        gemm(Trans::N, Trans::N, scalar_t(1.), U10_, V10_,
+             scalar_t(0.), A10);
+      else A10.zero();
+    }
+
+    // explicit template instantiations
+    template class NativeHODLRMatrix<float>;
+    template class NativeHODLRMatrix<double>;
+    template class NativeHODLRMatrix<std::complex<float>>;
+    template class NativeHODLRMatrix<std::complex<double>>;
+
+  } // end namespace HODLR
+} // end namespace strumpack
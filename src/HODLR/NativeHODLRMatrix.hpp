@@ -0,0 +1,264 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+/**
+ * \file NativeHODLRMatrix.hpp
+ * \brief Contains the NativeHODLRMatrix class, a shared-memory HODLR
+ * matrix which does not depend on ButterflyPACK.
+ */
+#ifndef STRUMPACK_NATIVE_HODLR_MATRIX_HPP
+#define STRUMPACK_NATIVE_HODLR_MATRIX_HPP
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+#include "HODLROptions.hpp"
+#include "dense/DenseMatrix.hpp"
+#include "structured/StructuredMatrix.hpp"
+#include "structured/ClusterTree.hpp"
+
+namespace strumpack {
+
+  namespace HODLR {
+
+    /**
+     * \class NativeHODLRMatrix
+     *
+     * \brief Sequential/threaded Hierarchically Off-Diagonal Low-Rank
+     * matrix, implemented directly on top of DenseMatrix.
+     *
+     * The matrix is represented recursively as
+     *
+     *   A = [ A00       U01*V01 ]
+     *       [ U10*V10   A11     ],
+     *
+     * where A00 and A11 are again NativeHODLRMatrix objects, and the
+     * leafs store a dense diagonal block. The tree is a (not
+     * necessarily complete) binary tree, given by a
+     * structured::ClusterTree. Unlike HODLRMatrix, this class does not
+     * require MPI or ButterflyPACK, and it only supports low-rank
+     * (not butterfly) off-diagonal blocks.
+     *
+     * The factorization applies the Sherman-Morrison-Woodbury formula
+     * recursively: with D = diag(A00, A11), the off-diagonal blocks
+     * are written as a rank-(r01+r10) update of D, and only a small
+     * (r01+r10)x(r01+r10) system needs to be factored per node.
+     *
+     * \tparam scalar_t Can be float, double, std:complex<float> or
+     * std::complex<double>.
+     *
+     * \see HODLRMatrix, structured::StructuredMatrix
+     */
+    template<typename scalar_t> class NativeHODLRMatrix
+      : public structured::StructuredMatrix<scalar_t> {
+      using real_t = typename RealType<scalar_t>::value_type;
+      using DenseM_t = DenseMatrix<scalar_t>;
+      using DenseMW_t = DenseMatrixWrapper<scalar_t>;
+      using opts_t = HODLROptions<scalar_t>;
+      using mult_t = structured::mult_t<scalar_t>;
+      using elem_t = structured::extract_block_t<scalar_t>;
+
+    public:
+      /**
+       * Default constructor, constructs an empty 0x0 matrix.
+       */
+      NativeHODLRMatrix() = default;
+
+      /**
+       * Construct the hierarchical structure of an n x n matrix,
+       * using an even refinement of [0,n) down to
+       * opts.leaf_size(). This does not compress the matrix, use one
+       * of the compress routines for that.
+       *
+       * \param n number of rows/columns
+       * \param opts HODLR options, only leaf_size is used here
+       */
+      NativeHODLRMatrix(std::size_t n, const opts_t& opts);
+
+      /**
+       * Construct the hierarchical structure from a cluster tree. The
+       * matrix is not compressed yet.
+       *
+       * \param t cluster tree, for instance from recursive bisection
+       * of the graph of the matrix
+       */
+      NativeHODLRMatrix(const structured::ClusterTree& t);
+
+      NativeHODLRMatrix(const NativeHODLRMatrix<scalar_t>&) = delete;
+      NativeHODLRMatrix(NativeHODLRMatrix<scalar_t>&&) = default;
+      NativeHODLRMatrix<scalar_t>&
+      operator=(const NativeHODLRMatrix<scalar_t>&) = delete;
+      NativeHODLRMatrix<scalar_t>&
+      operator=(NativeHODLRMatrix<scalar_t>&&) = default;
+
+      std::size_t rows() const override { return rows_; }
+      std::size_t cols() const override { return rows_; }
+      std::size_t memory() const override;
+      std::size_t nonzeros() const override;
+      std::size_t rank() const override;
+
+      /**
+       * Number of levels in the tree, 1 for a single leaf.
+       */
+      int levels() const;
+
+      /**
+       * Compress from a dense matrix, using a rank-revealing QR on
+       * every off-diagonal block.
+       *
+       * \param A dense matrix, rows() x cols()
+       * \param opts compression tolerances and maximum rank
+       * \param task_depth current OpenMP task recursion depth
+       */
+      void compress(const DenseM_t& A, const opts_t& opts,
+                    int task_depth=0);
+
+      /**
+       * Compress using only element extraction. The off-diagonal
+       * blocks are compressed with adaptive cross approximation, so
+       * the cost is linear in the size of the blocks times the rank.
+       *
+       * \param Aelem routine to extract a sub-block A(I,J), with I
+       * and J global indices, B is allocated by the caller.
+       * \param opts compression tolerances and maximum rank
+       */
+      void compress(const elem_t& Aelem, const opts_t& opts);
+
+      /**
+       * Matrix-free compression, using only products with the
+       * matrix and its (conjugate) transpose. The off-diagonal blocks
+       * are peeled off level by level with randomized sampling: the
+       * random vectors at a level are supported on the sibling
+       * subtrees only, and the contributions of the already
+       * compressed coarser levels are subtracted from the
+       * samples. The number of samples starts at opts.rank_guess()
+       * and is doubled until it exceeds the numerical rank, up to
+       * opts.max_rank(). Finally, the dense leafs are recovered with
+       * a single block of identity columns.
+       *
+       * \param Amult matrix (multi)vector product routine
+       * \param opts compression tolerances, maximum rank and rank
+       * guess
+       */
+      void compress(const mult_t& Amult, const opts_t& opts);
+
+      /**
+       * Multiply this matrix with a dense matrix: y = op(A)*x.
+       *
+       * \param op take transpose/conjugate or not
+       * \param x matrix, x.rows() == cols()
+       * \param y matrix, y.cols() == x.cols(), y.rows() == rows()
+       */
+      void mult(Trans op, const DenseM_t& x, DenseM_t& y) const override;
+
+      /**
+       * Factor this matrix, see factor(int).
+       */
+      void factor() override;
+
+      /**
+       * Factor this matrix using recursive Sherman-Morrison-Woodbury.
+       * The original (compressed) representation is kept, so mult
+       * can still be used after factorization.
+       *
+       * \param task_depth current OpenMP task recursion depth
+       * \return 0 on success, or the info from the first dense LU
+       * that detected an exact zero pivot
+       */
+      int factor(int task_depth);
+
+      /**
+       * Solve a linear system A*x=b, in-place, after factor().
+       *
+       * \param b right-hand side, on output the solution
+       */
+      void solve(DenseM_t& b) const override;
+
+      /**
+       * Solve a linear system A*x=b, in-place, after factor(),
+       * called from within an OpenMP parallel region.
+       *
+       * \param b right-hand side, on output the solution
+       * \param task_depth current OpenMP task recursion depth
+       */
+      void solve(DenseM_t& b, int task_depth) const;
+
+      /**
+       * Add s to the diagonal. This does not update the
+       * factorization.
+       */
+      void shift(scalar_t s) override;
+
+      /**
+       * Expand to a dense matrix, for testing/debugging.
+       */
+      DenseM_t dense() const;
+
+      using structured::StructuredMatrix<scalar_t>::mult;
+      using structured::StructuredMatrix<scalar_t>::solve;
+
+    private:
+      std::size_t rows_ = 0;
+      std::vector<NativeHODLRMatrix<scalar_t>> ch_;
+      // leaf: dense diagonal block
+      DenseM_t D_;
+      // A01 ~ U01_*V01_ and A10 ~ U10_*V10_
+      DenseM_t U01_, V01_, U10_, V10_;
+      // factors: Y0_ = A00^{-1}*U01_, Y1_ = A11^{-1}*U10_, F_ is the
+      // LU of D_ at a leaf, of the Woodbury capacitance matrix
+      // otherwise
+      DenseM_t Y0_, Y1_, F_;
+      std::vector<int> piv_;
+
+      bool leaf() const { return ch_.empty(); }
+
+      void mult_recursive(Trans op, const DenseM_t& x, DenseM_t& y,
+                          int task_depth) const;
+      void offdiag_add(Trans op, scalar_t a, const DenseM_t& x,
+                       DenseM_t& y, int task_depth) const;
+      void offdiag_add_levels(Trans op, scalar_t a, const DenseM_t& x,
+                              DenseM_t& y, int lvls) const;
+      void compress_dense(const DenseM_t& A, const opts_t& opts,
+                          int task_depth);
+      void compress_elements(const elem_t& Aelem, const opts_t& opts,
+                             std::size_t offset, int task_depth);
+      void truncate_rank(int max_rank);
+      void internal_nodes(int lvl, std::size_t offset,
+                          std::vector<std::pair<NativeHODLRMatrix<scalar_t>*,
+                          std::size_t>>& nodes);
+      void leaf_nodes(std::size_t offset,
+                      std::vector<std::pair<NativeHODLRMatrix<scalar_t>*,
+                      std::size_t>>& nodes);
+      void dense_recursive(DenseM_t& A) const;
+    };
+
+  } // end namespace HODLR
+} // end namespace strumpack
+
+#endif // STRUMPACK_NATIVE_HODLR_MATRIX_HPP
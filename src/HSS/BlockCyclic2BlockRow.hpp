@@ -32,20 +32,35 @@ namespace strumpack {
   namespace HSS {
     namespace BC2BR {
 
+      /**
+       * Redistribute a number of 2D block-cyclic matrices, all with
+       * the same size and on the same grid, to the HSS block-row
+       * layout, using a single all-to-all. The triplets sent for
+       * matrix k have their column index shifted by k*dist[0]->cols().
+       */
       template<typename scalar_t> void block_cyclic_to_block_row
-      (const TreeLocalRanges& ranges, const DistributedMatrix<scalar_t>& dist,
-       DenseMatrix<scalar_t>& sub, DistributedMatrix<scalar_t>& leaf,
+      (const TreeLocalRanges& ranges,
+       const std::vector<const DistributedMatrix<scalar_t>*>& dist,
+       const std::vector<DenseMatrix<scalar_t>*>& sub,
+       const std::vector<DistributedMatrix<scalar_t>*>& leaf,
        const BLACSGrid* lg, const MPIComm& comm) {
-        assert(dist.fixed());
+        const auto nk = dist.size();
+        assert(nk > 0 && sub.size() == nk && leaf.size() == nk);
+        const auto& D = *dist[0];
+        for (std::size_t k=0; k<nk; k++) {
+          assert(dist[k]->fixed());
+          assert(dist[k]->rows() == D.rows() && dist[k]->cols() == D.cols());
+          assert(dist[k]->grid() == D.grid());
+        }
         const auto P = comm.size();
         const auto rank = comm.rank();
         const int MB = DistributedMatrix<scalar_t>::default_MB;
-        const auto d = dist.cols();
+        const auto d = D.cols();
         int maxr = 0;
         for (int p=0; p<P; p++) {
           const DistributedMatrixWrapper<scalar_t> pdist
             (ranges.chi(p) - ranges.clo(p), d,
-             const_cast<DistributedMatrix<scalar_t>&>(dist),
+             const_cast<DistributedMatrix<scalar_t>&>(D),
              ranges.clo(p) - ranges.clo(0), 0);
           int rlo, rhi, clo, chi;
           pdist.lranges(rlo, rhi, clo, chi);
@@ -63,35 +78,38 @@ namespace strumpack {
           const auto leaf_procs = ranges.leaf_procs(p);
           const auto rbegin = ranges.clo(p) - ranges.clo(0);
           const DistributedMatrixWrapper<scalar_t> pdist
-            (m, d, const_cast<DistributedMatrix<scalar_t>&>(dist), rbegin, 0);
+            (m, d, const_cast<DistributedMatrix<scalar_t>&>(D), rbegin, 0);
           int rlo, rhi, clo, chi;
           pdist.lranges(rlo, rhi, clo, chi);
           if (leaf_procs == 1) {
             if (p == rank) {
-              sub = DenseMatrix<scalar_t>(m, d);
-              if (dist.active()) {
+              for (std::size_t k=0; k<nk; k++)
+                *sub[k] = DenseMatrix<scalar_t>(m, d);
+              if (D.active()) {
                 for (int r=rlo; r<rhi; r++)
-                  destr[r-rlo] = dist.rowl2g_fixed(r) - rbegin;
-                for (int c=clo; c<chi; c++)
-                  for (int r=rlo, gc=dist.coll2g_fixed(c); r<rhi; r++)
-                    sub(destr[r-rlo], gc) = dist(r,c);
+                  destr[r-rlo] = D.rowl2g_fixed(r) - rbegin;
+                for (std::size_t k=0; k<nk; k++)
+                  for (int c=clo; c<chi; c++)
+                    for (int r=rlo, gc=D.coll2g_fixed(c); r<rhi; r++)
+                      (*sub[k])(destr[r-rlo], gc) = (*dist[k])(r,c);
               }
-            } else if (dist.active())
-              ssize[p] += (chi-clo) * (rhi-rlo);
+            } else if (D.active())
+              ssize[p] += nk * (chi-clo) * (rhi-rlo);
           } else {
             if (p <= rank && rank < p+leaf_procs)
-              leaf = DistributedMatrix<scalar_t>(lg, m, d);
-            if (dist.active()) {
+              for (std::size_t k=0; k<nk; k++)
+                *leaf[k] = DistributedMatrix<scalar_t>(lg, m, d);
+            if (D.active()) {
               int leaf_prows, leaf_pcols;
               BLACSGrid::layout(leaf_procs, leaf_prows, leaf_pcols);
               for (int r=rlo; r<rhi; r++)
                 destr[r-rlo] = p
-                  + (((dist.rowl2g_fixed(r) - rbegin) / MB) % leaf_prows);
+                  + (((D.rowl2g_fixed(r) - rbegin) / MB) % leaf_prows);
               for (int c=clo; c<chi; c++) {
                 const auto destc =
-                  (((dist.coll2g_fixed(c)) / MB) % leaf_pcols) * leaf_prows;
+                  (((D.coll2g_fixed(c)) / MB) % leaf_pcols) * leaf_prows;
                 for (int r=rlo; r<rhi; r++)
-                  ssize[destr[r-rlo]+destc]++;
+                  ssize[destr[r-rlo]+destc] += nk;
               }
             }
             p += leaf_procs - 1;
@@ -105,34 +123,37 @@ namespace strumpack {
           const auto leaf_procs = ranges.leaf_procs(p);
           const auto rbegin = ranges.clo(p) - ranges.clo(0);
           const DistributedMatrixWrapper<scalar_t> pdist
-            (m, d, const_cast<DistributedMatrix<scalar_t>&>(dist), rbegin, 0);
+            (m, d, const_cast<DistributedMatrix<scalar_t>&>(D), rbegin, 0);
           int rlo, rhi, clo, chi;
           pdist.lranges(rlo, rhi, clo, chi);
           if (leaf_procs == 1) {
-            if (p != rank && dist.active()) {
+            if (p != rank && D.active()) {
               for (int r=rlo; r<rhi; r++) {
-                gr[r-rlo] = dist.rowl2g_fixed(r) - rbegin;
+                gr[r-rlo] = D.rowl2g_fixed(r) - rbegin;
                 assert(int(gr[r-rlo]) < m);
               }
-              for (int c=clo; c<chi; c++)
-                for (int r=rlo, gc=dist.coll2g_fixed(c); r<rhi; r++)
-                  sbuf[p].emplace_back(gr[r-rlo], gc, dist(r,c));
+              for (std::size_t k=0; k<nk; k++)
+                for (int c=clo; c<chi; c++)
+                  for (int r=rlo, gc=D.coll2g_fixed(c); r<rhi; r++)
+                    sbuf[p].emplace_back
+                      (gr[r-rlo], gc+k*d, (*dist[k])(r,c));
             }
           } else {
-            if (dist.active()) {
+            if (D.active()) {
               int leaf_prows, leaf_pcols;
               BLACSGrid::layout(leaf_procs, leaf_prows, leaf_pcols);
               for (int r=rlo; r<rhi; r++) {
-                gr[r-rlo] = dist.rowl2g_fixed(r) - rbegin;
+                gr[r-rlo] = D.rowl2g_fixed(r) - rbegin;
                 destr[r-rlo] = p + ((gr[r-rlo] / MB) % leaf_prows);
               }
-              for (int c=clo; c<chi; c++) {
-                const auto gc = dist.coll2g_fixed(c);
-                const auto destc = ((gc / MB) % leaf_pcols) * leaf_prows;
-                for (int r=rlo; r<rhi; r++)
-                  sbuf[destr[r-rlo]+destc].emplace_back
-                    (gr[r-rlo], gc, dist(r,c));
-              }
+              for (std::size_t k=0; k<nk; k++)
+                for (int c=clo; c<chi; c++) {
+                  const auto gc = D.coll2g_fixed(c);
+                  const auto destc = ((gc / MB) % leaf_pcols) * leaf_prows;
+                  for (int r=rlo; r<rhi; r++)
+                    sbuf[destr[r-rlo]+destc].emplace_back
+                      (gr[r-rlo], gc+k*d, (*dist[k])(r,c));
+                }
             }
             p += leaf_procs - 1;
           }
@@ -141,24 +162,33 @@ namespace strumpack {
         auto rbuf = comm.all_to_all_v(sbuf);
         Triplet<scalar_t>::free_mpi_type();
         if (ranges.leaf_procs(rank) == 1) {
-          assert((ranges.chi(rank) - ranges.clo(rank)) == int(sub.rows()));
-          assert(int(sub.cols()) == dist.cols());
+          assert((ranges.chi(rank) - ranges.clo(rank)) == int(sub[0]->rows()));
+          assert(int(sub[0]->cols()) == d);
           for (auto& t : rbuf)
-            sub(t.r, t.c) = t.v;
-        } else if (leaf.active()) {
-          const auto rows = leaf.rows();
-          const auto cols = leaf.cols();
-          std::vector<int> lr(rows, -1), lc(cols, -1);
+            (*sub[t.c / d])(t.r, t.c % d) = t.v;
+        } else if (leaf[0]->active()) {
+          const auto& L = *leaf[0];
+          const auto rows = L.rows();
+          std::vector<int> lr(rows, -1), lc(d, -1);
           for (auto& t : rbuf) {
+            const auto k = t.c / d, gc = t.c % d;
             int locr = lr[t.r];
-            if (locr == -1) locr = lr[t.r] = leaf.rowg2l_fixed(t.r);
-            int locc = lc[t.c];
-            if (locc == -1) locc = lc[t.c] = leaf.colg2l_fixed(t.c);
-            leaf(locr, locc) = t.v;
+            if (locr == -1) locr = lr[t.r] = L.rowg2l_fixed(t.r);
+            int locc = lc[gc];
+            if (locc == -1) locc = lc[gc] = L.colg2l_fixed(gc);
+            (*leaf[k])(locr, locc) = t.v;
           }
         }
       }
 
+      template<typename scalar_t> void block_cyclic_to_block_row
+      (const TreeLocalRanges& ranges, const DistributedMatrix<scalar_t>& dist,
+       DenseMatrix<scalar_t>& sub, DistributedMatrix<scalar_t>& leaf,
+       const BLACSGrid* lg, const MPIComm& comm) {
+        block_cyclic_to_block_row<scalar_t>
+          (ranges, {&dist}, {&sub}, {&leaf}, lg, comm);
+      }
+
       template<typename scalar_t> void block_row_to_block_cyclic
       (const TreeLocalRanges& ranges, DistributedMatrix<scalar_t>& dist,
        const DenseMatrix<scalar_t>& sub,
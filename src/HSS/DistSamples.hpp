@@ -29,6 +29,7 @@
 #define DIST_SAMPLES_HPP
 
 #include "HSSOptions.hpp"
+#include "misc/TaskTimer.hpp"
 
 namespace strumpack {
   namespace HSS {
@@ -49,6 +50,16 @@ namespace strumpack {
       const HSSMatrixMPI<scalar_t>& _hss;
       std::unique_ptr<random::RandomGeneratorBase<real_t>> _rgen;
       bool _hard_restart = false;
+      // generate R from the global element indices, directly in
+      // both the 2D and the HSS block-row layouts (opt-in, see
+      // HSSOptions::set_indexed_random). Only R is generated in the
+      // block-row layout, the samples Sr and Sc are computed in 2D,
+      // and redistributed with a single all-to-all.
+      bool _indexed = false;
+      // counter based generator, get(i,j) does not need reseeding
+      bool _counter = false;
+      // last element generated by get_indexed, to continue a run
+      std::size_t _gi = 0, _gj = std::size_t(-1);
     public:
       DistM_t R, Sr, Sc, leaf_R, leaf_Sr, leaf_Sc;
       DenseM_t sub_Rr, sub_Rc, sub_Sr, sub_Sc;
@@ -62,15 +73,23 @@ namespace strumpack {
           _hard_restart(hard_restart),
           R(g, _hss.cols(), d), Sr(g, _hss.cols(), d),
           Sc(g, _hss.cols(), d) {
-        _rgen->seed(R.prow(), R.pcol());
-        R.random(*_rgen);
-        STRUMPACK_RANDOM_FLOPS
-          (_rgen->flops_per_prng() * R.lrows() * R.lcols());
+        _indexed = opts.indexed_random() &&
+          opts.random_engine() != random::RandomEngine::MERSENNE;
+        _counter = opts.random_engine() == random::RandomEngine::PHILOX;
+        if (_indexed) {
+          random_indexed(R, 0);
+          _hss.allocate_block_row(d, sub_Rr, leaf_R);
+          random_block_row(sub_Rr, leaf_R, 0);
+        } else {
+          _rgen->seed(R.prow(), R.pcol());
+          R.random(*_rgen);
+          STRUMPACK_RANDOM_FLOPS
+            (_rgen->flops_per_prng() * R.lrows() * R.lcols());
+        }
         _Amult(R, Sr, Sc);
-        _hss.to_block_row(R,  sub_Rr, leaf_R);
+        if (!_indexed) _hss.to_block_row(R,  sub_Rr, leaf_R);
         sub_Rc = DenseM_t(sub_Rr);
-        _hss.to_block_row(Sr, sub_Sr, leaf_Sr);
-        _hss.to_block_row(Sc, sub_Sc, leaf_Sc);
+        _hss.to_block_row(Sr, sub_Sr, leaf_Sr, Sc, sub_Sc, leaf_Sc);
         if (_hard_restart) { // copies for when doing a hard restart
           sub_R2 = sub_Rr;
           sub_Sr2 = sub_Sr;
@@ -83,20 +102,26 @@ namespace strumpack {
         auto d_old = R.cols();
         auto dd = d-d_old;
         DistM_t Rnew(R.grid(), n, dd);
-        Rnew.random(*_rgen);
-        STRUMPACK_RANDOM_FLOPS
-          (_rgen->flops_per_prng() * Rnew.lrows() * Rnew.lcols());
+        DenseM_t subRnew, subSrnew, subScnew;
+        DistM_t leafRnew, leafSrnew, leafScnew;
+        if (_indexed) {
+          random_indexed(Rnew, d_old);
+          _hss.allocate_block_row(dd, subRnew, leafRnew);
+          random_block_row(subRnew, leafRnew, d_old);
+        } else {
+          Rnew.random(*_rgen);
+          STRUMPACK_RANDOM_FLOPS
+            (_rgen->flops_per_prng() * Rnew.lrows() * Rnew.lcols());
+        }
         DistM_t Srnew(Sr.grid(), n, dd);
         DistM_t Scnew(Sc.grid(), n, dd);
         _Amult(Rnew, Srnew, Scnew);
         R.hconcat(Rnew);
         Sr.hconcat(Srnew);
         Sc.hconcat(Scnew);
-        DenseM_t subRnew, subSrnew, subScnew;
-        DistM_t leafRnew, leafSrnew, leafScnew;
-        _hss.to_block_row(Rnew,  subRnew, leafRnew);
-        _hss.to_block_row(Srnew, subSrnew, leafSrnew);
-        _hss.to_block_row(Scnew, subScnew, leafScnew);
+        if (!_indexed) _hss.to_block_row(Rnew,  subRnew, leafRnew);
+        _hss.to_block_row
+          (Srnew, subSrnew, leafSrnew, Scnew, subScnew, leafScnew);
         if (_hard_restart) {
           sub_Rr = hconcat(sub_R2,  subRnew);
           sub_Rc = hconcat(sub_R2,  subRnew);
@@ -115,6 +140,68 @@ namespace strumpack {
         leaf_Sr.hconcat(leafSrnew);
         leaf_Sc.hconcat(leafScnew);
       }
+
+    private:
+      /**
+       * Element (i,j) of the reproducible random matrix. With a
+       * counter based generator this is simply get(i,j). Otherwise
+       * it is element i%B of the sequence seeded with (i/B,j), with
+       * B=DistM_t::default_MB, so that consecutive rows only reseed
+       * the generator once per row block instead of per element.
+       */
+      real_t get_indexed(std::size_t i, std::size_t j) {
+        if (_counter) return _rgen->get(i, j);
+        const std::size_t B = DistM_t::default_MB;
+        if (j != _gj || i != _gi+1 || i % B == 0) {
+          _rgen->seed(std::uint32_t(i / B), std::uint32_t(j));
+          for (std::size_t k=0; k<i%B; k++) _rgen->get();
+        }
+        _gi = i;
+        _gj = j;
+        return _rgen->get();
+      }
+
+      /**
+       * Fill the 2D block-cyclic A with the reproducible random
+       * elements get(i, c0+j), with i,j the global indices in A.
+       */
+      void random_indexed(DistM_t& A, std::size_t c0) {
+        if (!A.active()) return;
+        TIMER_TIME(TaskType::RANDOM_GENERATE, 1, t_gen);
+        _gj = std::size_t(-1);
+        for (int c=0; c<A.lcols(); c++)
+          for (int r=0, gc=A.coll2g_fixed(c)+c0; r<A.lrows(); r++)
+            A(r,c) = get_indexed(A.rowl2g_fixed(r), gc);
+        STRUMPACK_RANDOM_FLOPS
+          (_rgen->flops_per_prng() * A.lrows() * A.lcols());
+      }
+
+      /**
+       * Fill the HSS block-row distributed sub/leaf with the same
+       * elements as random_indexed, so that the random vectors do
+       * not need to be redistributed from the 2D layout.
+       */
+      void random_block_row(DenseM_t& sub, DistM_t& leaf, std::size_t c0) {
+        if (!_hss.active()) return;
+        TIMER_TIME(TaskType::RANDOM_GENERATE, 1, t_gen);
+        const auto& ranges = _hss.tree_ranges();
+        const auto rank = _hss.Comm().rank();
+        const std::size_t rbegin = ranges.clo(rank) - ranges.clo(0);
+        _gj = std::size_t(-1);
+        if (ranges.leaf_procs(rank) == 1) {
+          for (std::size_t c=0; c<sub.cols(); c++)
+            for (std::size_t r=0; r<sub.rows(); r++)
+              sub(r,c) = get_indexed(rbegin+r, c0+c);
+          STRUMPACK_RANDOM_FLOPS
+            (_rgen->flops_per_prng() * sub.rows() * sub.cols());
+        } else if (leaf.active()) {
+          for (int c=0; c<leaf.lcols(); c++)
+            for (int r=0, gc=leaf.coll2g_fixed(c)+c0; r<leaf.lrows(); r++)
+              leaf(r,c) = get_indexed(rbegin+leaf.rowl2g_fixed(r), gc);
+          STRUMPACK_RANDOM_FLOPS
+            (_rgen->flops_per_prng() * leaf.lrows() * leaf.lcols());
+        }
+      }
     };
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
@@ -0,0 +1,318 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+#include <atomic>
+#include <cassert>
+
+#include "HSSApplyPlan.hpp"
+#include "HSSMatrix.hpp"
+
+namespace strumpack {
+  namespace HSS {
+
+    template<typename scalar_t> HSSApplyPlan<scalar_t>::HSSApplyPlan
+    (const HSSMatrix<scalar_t>& H, std::size_t ncols)
+      : depth_(H.openmp_task_depth_) {
+      // breadth first, so that the nodes of a level, as well as two
+      // siblings, are stored next to each other
+      std::vector<const HSSMatrix<scalar_t>*> h(1, &H);
+      nodes_.resize(1);
+      nodes_[0].m = H.rows();
+      nodes_[0].n = H.cols();
+      lvl_.push_back(0);
+      for (std::size_t b=0; b<h.size(); ) {
+        auto e = h.size();
+        for (std::size_t i=b; i<e; i++) {
+          if (h[i]->leaf()) continue;
+          nodes_[i].leaf = false;
+          nodes_[i].ch = h.size();
+          for (int c=0; c<2; c++) {
+            h.push_back(h[i]->child(c));
+            Node nd;
+            nd.r = nodes_[i].r + (c ? h[i]->child(0)->rows() : 0);
+            nd.c = nodes_[i].c + (c ? h[i]->child(0)->cols() : 0);
+            nd.m = h.back()->rows();
+            nd.n = h.back()->cols();
+            nodes_.push_back(nd);
+          }
+        }
+        lvl_.push_back(e);
+        b = e;
+      }
+      std::size_t isize = 0, ssize = 0;
+      for (auto hi : h)
+        isize += hi->U_.P().size() + hi->V_.P().size();
+      idx_.reserve(isize);
+      for (std::size_t i=0; i<h.size(); i++) {
+        auto& nd = nodes_[i];
+        nd.B[0] = basis(h[i]->U_.P(), h[i]->U_.E());
+        nd.B[1] = basis(h[i]->V_.P(), h[i]->V_.E());
+        for (int u=0; u<2; u++) {
+          nd.off[u] = rank_[u];
+          rank_[u] += nd.B[u].cols;
+        }
+        nd.s = ssize;
+        ssize += std::max(nd.B[0].rows - nd.B[0].cols,
+                          nd.B[1].rows - nd.B[1].cols);
+        if (nd.leaf) nd.D = &h[i]->D_;
+        else {
+          nd.B01 = &h[i]->B01_;
+          nd.B10 = &h[i]->B10_;
+        }
+      }
+      S_ = DenseM_t(ssize, 0);
+      reserve(ncols);
+    }
+
+    template<typename scalar_t> typename HSSApplyPlan<scalar_t>::Basis
+    HSSApplyPlan<scalar_t>::basis
+    (const std::vector<int>& P, const DenseM_t& E) {
+      Basis B;
+      B.rows = E.rows() + E.cols();
+      B.cols = E.cols();
+      assert(P.size() == B.rows);
+      B.E = &E;
+      B.P = idx_.size();
+      // apply the row interchanges to the identity, such that the
+      // rows of P^T x are x[idx_[B.P+i]]
+      idx_.resize(B.P+B.rows);
+      auto p = idx_.data() + B.P;
+      for (std::size_t i=0; i<B.rows; i++) p[i] = i;
+      for (std::size_t i=0; i<B.rows; i++) std::swap(p[i], p[P[i]-1]);
+      return B;
+    }
+
+    template<typename scalar_t> void
+    HSSApplyPlan<scalar_t>::reserve(std::size_t ncols) {
+      if (ncols_ && ncols <= ncols_) return;
+      ncols_ = std::max(ncols, ncols_);
+      for (int c=0; c<2; c++) {
+        T1_[c] = DenseM_t(rank_[!c], ncols_);
+        T2_[c] = DenseM_t(rank_[c], ncols_);
+        fwd_cols_[c] = 0;
+      }
+      S_ = DenseM_t(S_.rows(), ncols_);
+    }
+
+    template<typename scalar_t> std::size_t
+    HSSApplyPlan<scalar_t>::memory() const {
+      return sizeof(int) * idx_.size() +
+        T1_[0].memory() + T1_[1].memory() + T2_[0].memory() +
+        T2_[1].memory() + S_.memory();
+    }
+
+    template<typename scalar_t> long long int
+    HSSApplyPlan<scalar_t>::applyC
+    (const Basis& B, const scalar_t* x, int ldx, const std::size_t* map,
+     DenseM_t& t, std::size_t s, int depth) {
+      auto p = idx_.data() + B.P;
+      auto k = B.cols, e = B.rows - B.cols, n = t.cols();
+      auto row = [&](std::size_t i) { return map ? map[p[i]] : p[i]; };
+      for (std::size_t j=0; j<n; j++)
+        for (std::size_t i=0; i<k; i++)
+          t(i, j) = x[row(i)+j*ldx];
+      if (!e) return 0;
+      DenseMW_t Sx(e, n, S_, s, 0);
+      for (std::size_t j=0; j<n; j++)
+        for (std::size_t i=0; i<e; i++)
+          Sx(i, j) = x[row(k+i)+j*ldx];
+      auto& E = *B.E;
+      gemm(Trans::C, Trans::N, scalar_t(1.), E, Sx,
+           scalar_t(1.), t, depth);
+      return gemm_flops(Trans::C, Trans::N, scalar_t(1.), E, Sx,
+                        scalar_t(1.));
+    }
+
+    template<typename scalar_t> long long int
+    HSSApplyPlan<scalar_t>::apply_add
+    (const Basis& B, const DenseM_t& t, scalar_t* y, int ldy,
+     std::size_t s, int depth) {
+      auto p = idx_.data() + B.P;
+      auto k = B.cols, e = B.rows - B.cols, n = t.cols();
+      for (std::size_t j=0; j<n; j++)
+        for (std::size_t i=0; i<k; i++)
+          y[p[i]+j*ldy] += t(i, j);
+      long long int flops = k * n;
+      if (!e) return flops;
+      DenseMW_t Et(e, n, S_, s, 0);
+      auto& E = *B.E;
+      gemm(Trans::N, Trans::N, scalar_t(1.), E, t, scalar_t(0.), Et, depth);
+      for (std::size_t j=0; j<n; j++)
+        for (std::size_t i=0; i<e; i++)
+          y[p[k+i]+j*ldy] += Et(i, j);
+      return flops + e * n +
+        gemm_flops(Trans::N, Trans::N, scalar_t(1.), E, t, scalar_t(0.));
+    }
+
+    template<typename scalar_t> long long int
+    HSSApplyPlan<scalar_t>::forward_node
+    (Trans op, std::size_t i, const DenseM_t& b,
+     const std::vector<std::size_t>* I, int depth) {
+      // for op == N the upward sweep applies V^*, for op == C, U^*
+      const int c = op != Trans::N, u = !c;
+      auto& nd = nodes_[i];
+      if (!nd.B[u].cols) return 0;
+      DenseMW_t t1(nd.B[u].cols, b.cols(), T1_[c], nd.off[u], 0);
+      if (nd.leaf) {
+        auto r = c ? nd.r : nd.c;
+        if (I)
+          return applyC(nd.B[u], b.data(), b.ld(), I->data()+r,
+                        t1, nd.s, depth);
+        return applyC(nd.B[u], b.ptr(r, 0), b.ld(), nullptr,
+                      t1, nd.s, depth);
+      }
+      // the children's results are stacked in T1_
+      return applyC(nd.B[u], T1_[c].ptr(nodes_[nd.ch].off[u], 0),
+                    T1_[c].ld(), nullptr, t1, nd.s, depth);
+    }
+
+    template<typename scalar_t> long long int
+    HSSApplyPlan<scalar_t>::backward_node
+    (Trans op, std::size_t i, const DenseM_t& b, scalar_t beta,
+     DenseM_t& c, const std::vector<std::size_t>* I, int depth) {
+      const int t = op != Trans::N, u = !t;
+      auto& nd = nodes_[i];
+      auto n = b.cols();
+      long long int flops = 0;
+      if (nd.leaf) {
+        auto& D = *nd.D;
+        auto rb = t ? nd.r : nd.c, rc = t ? nd.c : nd.r;
+        auto mb = t ? nd.m : nd.n, mc = t ? nd.n : nd.m;
+        if (!I) {
+          DenseMW_t lc(mc, n, c, rc, 0);
+          gemm(op, Trans::N, scalar_t(1.), D, b.ptr(rb, 0), b.ld(),
+               beta, lc, depth);
+          flops += gemm_flops(op, Trans::N, scalar_t(1.), D, beta, lc);
+          if (i && nd.B[t].cols) {
+            DenseMW_t t2(nd.B[t].cols, n, T2_[t], nd.off[t], 0);
+            flops += apply_add(nd.B[t], t2, lc.data(), lc.ld(),
+                               nd.s, depth);
+          }
+          return flops;
+        }
+        // only the rows for this leaf are copied, from b and to c
+        DenseM_t lb(mb, n), lc(mc, n);
+        auto Ib = I->data() + rb, Ic = I->data() + rc;
+        for (std::size_t j=0; j<n; j++)
+          for (std::size_t r=0; r<mb; r++)
+            lb(r, j) = b(Ib[r], j);
+        gemm(op, Trans::N, scalar_t(1.), D, lb, scalar_t(0.), lc, depth);
+        flops += gemm_flops(op, Trans::N, scalar_t(1.), D, lb, scalar_t(0.));
+        if (i && nd.B[t].cols) {
+          DenseMW_t t2(nd.B[t].cols, n, T2_[t], nd.off[t], 0);
+          flops += apply_add(nd.B[t], t2, lc.data(), lc.ld(), nd.s, depth);
+        }
+        if (beta == scalar_t(0.))
+          for (std::size_t j=0; j<n; j++)
+            for (std::size_t r=0; r<mc; r++)
+              c(Ic[r], j) = lc(r, j);
+        else
+          for (std::size_t j=0; j<n; j++)
+            for (std::size_t r=0; r<mc; r++)
+              c(Ic[r], j) = beta * c(Ic[r], j) + lc(r, j);
+        return flops + mc * n;
+      }
+      auto& c0 = nodes_[nd.ch];
+      auto& c1 = nodes_[nd.ch+1];
+      DenseMW_t t20(c0.B[t].cols, n, T2_[t], c0.off[t], 0),
+        t21(c1.B[t].cols, n, T2_[t], c1.off[t], 0),
+        t10(c0.B[u].cols, n, T1_[t], c0.off[u], 0),
+        t11(c1.B[u].cols, n, T1_[t], c1.off[u], 0);
+      auto &B01 = *nd.B01, &B10 = *nd.B10;
+      gemm(op, Trans::N, scalar_t(1.), t ? B10 : B01, t11,
+           scalar_t(0.), t20, depth);
+      gemm(op, Trans::N, scalar_t(1.), t ? B01 : B10, t10,
+           scalar_t(0.), t21, depth);
+      flops +=
+        gemm_flops(op, Trans::N, scalar_t(1.), t ? B10 : B01, t11,
+                   scalar_t(0.)) +
+        gemm_flops(op, Trans::N, scalar_t(1.), t ? B01 : B10, t10,
+                   scalar_t(0.));
+      if (i && nd.B[t].cols) {
+        DenseMW_t t2(nd.B[t].cols, n, T2_[t], nd.off[t], 0);
+        flops += apply_add(nd.B[t], t2, T2_[t].ptr(c0.off[t], 0),
+                           T2_[t].ld(), nd.s, depth);
+      }
+      return flops;
+    }
+
+    template<typename scalar_t> long long int
+    HSSApplyPlan<scalar_t>::forward
+    (Trans op, const DenseM_t& b, bool isroot,
+     const std::vector<std::size_t>* I) {
+      assert(b.cols() <= ncols_);
+      std::atomic<long long int> flops(0);
+      const int c = op != Trans::N;
+      fwd_cols_[c] = b.cols();
+#pragma omp parallel if(!omp_in_parallel())
+#pragma omp single nowait
+      for (std::size_t l=lvl_.size()-1; l-->0; ) {
+        if (l == 0 && isroot) break;
+        level_loop(lvl_[l], lvl_[l+1], depth_, [&](std::size_t i, int d) {
+          flops += forward_node(op, i, b, I, d);
+        });
+      }
+      return flops.load();
+    }
+
+    template<typename scalar_t> DenseMatrixWrapper<scalar_t>
+    HSSApplyPlan<scalar_t>::top(Trans op) {
+      const int c = op != Trans::N;
+      return DenseMW_t(nodes_[0].B[!c].cols, fwd_cols_[c], T1_[c], 0, 0);
+    }
+
+    template<typename scalar_t> long long int
+    HSSApplyPlan<scalar_t>::backward
+    (Trans op, const DenseM_t& b, scalar_t beta, DenseM_t& c,
+     const std::vector<std::size_t>* I) {
+      assert(b.cols() == fwd_cols_[op != Trans::N]);
+      std::atomic<long long int> flops(0);
+#pragma omp parallel if(!omp_in_parallel())
+#pragma omp single nowait
+      for (std::size_t l=0; l<lvl_.size()-1; l++)
+        level_loop(lvl_[l], lvl_[l+1], depth_, [&](std::size_t i, int d) {
+          flops += backward_node(op, i, b, beta, c, I, d);
+        });
+      return flops.load();
+    }
+
+    template<typename scalar_t> long long int
+    HSSApplyPlan<scalar_t>::apply
+    (Trans op, const DenseM_t& b, scalar_t beta, DenseM_t& c) {
+      reserve(b.cols());
+      return forward(op, b, true) + backward(op, b, beta, c);
+    }
+
+    // explicit template instantiations
+    template class HSSApplyPlan<float>;
+    template class HSSApplyPlan<double>;
+    template class HSSApplyPlan<std::complex<float>>;
+    template class HSSApplyPlan<std::complex<double>>;
+
+  } // end namespace HSS
+} // end namespace strumpack
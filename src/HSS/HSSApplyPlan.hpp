@@ -0,0 +1,191 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+/**
+ * \file HSSApplyPlan.hpp
+ * \brief Packed, level-by-level multiplication with an HSS matrix.
+ */
+#ifndef HSS_APPLY_PLAN_HPP
+#define HSS_APPLY_PLAN_HPP
+
+#include <vector>
+
+#include "dense/DenseMatrix.hpp"
+#include "HSSExtra.hpp"
+
+namespace strumpack {
+  namespace HSS {
+
+    template<typename scalar_t> class HSSMatrix;
+
+    /**
+     * \class HSSApplyPlan
+     *
+     * \brief Plan for repeated multiplication of an HSS matrix with
+     * blocks of (at most) cols() vectors.
+     *
+     * The HSS tree is flattened, with the nodes of a level stored
+     * next to each other, each referring to the generators of the
+     * corresponding node of the HSS matrix, and with the
+     * permutations of the interpolative bases converted to explicit
+     * index vectors. The workspace for the upward and the downward
+     * sweep is allocated once, for both op == Trans::N and op ==
+     * Trans::C. The sweeps then run level by level, with the nodes
+     * of a level processed in a single (task) loop instead of the
+     * recursive traversal of HSSMatrix::apply.
+     *
+     * The generators are not copied, so the HSS matrix should not be
+     * modified or destroyed while the plan is used.
+     *
+     * \tparam scalar_t Can be float, double, std::complex<float> or
+     * std::complex<double>.
+     */
+    template<typename scalar_t> class HSSApplyPlan {
+      using DenseM_t = DenseMatrix<scalar_t>;
+      using DenseMW_t = DenseMatrixWrapper<scalar_t>;
+
+    public:
+      /**
+       * Construct a plan for the HSS matrix H, with workspace for
+       * ncols vectors.
+       */
+      HSSApplyPlan(const HSSMatrix<scalar_t>& H, std::size_t ncols);
+
+      /**
+       * Maximum number of columns that can be multiplied without
+       * reallocating the workspace.
+       */
+      std::size_t cols() const { return ncols_; }
+
+      /**
+       * Make sure the workspace can hold ncols vectors. This does
+       * not preserve the result of a previous forward sweep.
+       */
+      void reserve(std::size_t ncols);
+
+      /**
+       * Memory, in bytes, used by the index vectors and the
+       * workspace, not including the generators of the HSS matrix.
+       */
+      std::size_t memory() const;
+
+      /**
+       * Compute c = op(H) b + beta c.
+       *
+       * \return number of flops performed
+       */
+      long long int apply(Trans op, const DenseM_t& b,
+                          scalar_t beta, DenseM_t& c);
+
+      /**
+       * Upward sweep of op(H) b. With isroot == false, this also
+       * computes V^* b (U^* b for op == Trans::C) for the root,
+       * which is then available through top(op).
+       *
+       * If I is not null, row i of b is read from row (*I)[i] of the
+       * given matrix b, so b can be a larger matrix, for instance
+       * the random vectors of a parent front, without first
+       * extracting the rows.
+       *
+       * \return number of flops performed
+       */
+      long long int forward(Trans op, const DenseM_t& b,
+                            bool isroot=true,
+                            const std::vector<std::size_t>* I=nullptr);
+
+      /**
+       * Result of the upward sweep at the root, after a call to
+       * forward(op, b, false). The returned wrapper refers to the
+       * workspace of this plan.
+       */
+      DenseMW_t top(Trans op);
+
+      /**
+       * Downward sweep, c = op(H) b + beta c, after a call to
+       * forward(op, b, isroot, I). The root does not contribute its
+       * own basis. If I is not null, both b and c are accessed
+       * through the row map I, see forward.
+       *
+       * \return number of flops performed
+       */
+      long long int backward(Trans op, const DenseM_t& b,
+                             scalar_t beta, DenseM_t& c,
+                             const std::vector<std::size_t>* I=nullptr);
+
+    private:
+      /** basis P [I; E], P stored as gather indices at offset P */
+      struct Basis {
+        std::size_t rows = 0, cols = 0, P = 0;
+        const DenseM_t* E = nullptr;
+      };
+      struct Node {
+        bool leaf = true;
+        /** index of first child, the second child is ch+1 */
+        std::size_t ch = 0;
+        std::size_t r = 0, c = 0, m = 0, n = 0;
+        /** U (0) and V (1) bases, and their offsets in rank space */
+        Basis B[2];
+        std::size_t off[2] = {0, 0};
+        /** offset in the workspace S_ */
+        std::size_t s = 0;
+        /** D for leafs, B01 and B10 otherwise */
+        const DenseM_t *D = nullptr, *B01 = nullptr, *B10 = nullptr;
+      };
+
+      std::size_t ncols_ = 0, fwd_cols_[2] = {0, 0}, rank_[2] = {0, 0};
+      int depth_ = 0;
+      std::vector<Node> nodes_;
+      /** nodes_[lvl_[l]] .. nodes_[lvl_[l+1]-1] are on level l */
+      std::vector<std::size_t> lvl_;
+      std::vector<int> idx_;
+      DenseM_t T1_[2], T2_[2], S_;
+
+      Basis basis(const std::vector<int>& P, const DenseM_t& E);
+
+      long long int applyC(const Basis& B, const scalar_t* x, int ldx,
+                           const std::size_t* map, DenseM_t& t,
+                           std::size_t s, int depth);
+      long long int apply_add(const Basis& B, const DenseM_t& t,
+                              scalar_t* y, int ldy,
+                              std::size_t s, int depth);
+
+      long long int forward_node(Trans op, std::size_t i,
+                                 const DenseM_t& b,
+                                 const std::vector<std::size_t>* I,
+                                 int depth);
+      long long int backward_node(Trans op, std::size_t i,
+                                  const DenseM_t& b, scalar_t beta,
+                                  DenseM_t& c,
+                                  const std::vector<std::size_t>* I,
+                                  int depth);
+    };
+
+  } // end namespace HSS
+} // end namespace strumpack
+
+#endif // HSS_APPLY_PLAN_HPP
@@ -78,7 +78,8 @@ namespace strumpack {
       public WorkCompressBase<scalar_t>  {
     public:
       std::vector<WorkCompress<scalar_t>> c;
-      // only needed in the new compression algorithm
+      // orthonormal bases for the samples, updated incrementally
+      // when adding columns in the adaptive compression algorithms
       DenseMatrix<scalar_t> Qr, Qc;
       void split(const std::pair<std::size_t,std::size_t>& dim) {
         if (c.empty()) {
@@ -223,6 +224,10 @@ namespace strumpack {
       // DO NOT STORE reduced_rhs here!!!
       DenseMatrix<scalar_t> reduced_rhs;
       std::pair<std::size_t,std::size_t> offset;
+
+      // level-by-level solve: for each level, the f = [ft1; y] of
+      // all nodes, stored one after the other
+      std::vector<DenseMatrix<scalar_t>> lvl_f;
     };
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
@@ -250,6 +255,26 @@ namespace strumpack {
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
 
+    /**
+     * Call f(i, depth) for i = b, .., e-1, the independent nodes of
+     * a level of an HSS tree, in parallel if there are enough nodes
+     * to keep all threads busy. The operations for a single node are
+     * then done sequentially, otherwise they can use tasks up to the
+     * given depth.
+     */
+    template<typename F> void
+    level_loop(std::size_t b, std::size_t e, int depth, const F& f) {
+      if (e - b >= std::size_t(params::num_threads)) {
+#if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
+#pragma omp taskloop default(shared) grainsize(1)
+#endif
+        for (std::size_t i=b; i<e; i++)
+          f(i, params::task_recursion_cutoff_level);
+      } else
+        for (std::size_t i=b; i<e; i++)
+          f(i, depth);
+    }
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
     template<typename scalar_t> class WorkDense {
     public:
@@ -54,7 +54,8 @@ namespace strumpack {
       Phi = DenseM_t(ch1->cols(), _phi.cols());
       std::pair<std::size_t,std::size_t> offset;
       std::atomic<long long int> UVflops(0);
-      ch1->apply_UV_big(Theta, _theta, Phi, _phi, offset, depth, UVflops);
+      ch1->apply_UV_big
+        (Theta, _theta, Phi, _phi, offset, nullptr, depth, UVflops);
       STRUMPACK_SCHUR_FLOPS(UVflops.load());
     }
 
@@ -75,65 +76,122 @@ namespace strumpack {
      const DenseM_t& ThetaVhatC_or_VhatCPhiC,
      const DenseM_t& R, DenseM_t& Sr, DenseM_t& Sc) const {
       auto depth = this->openmp_task_depth_;
-      auto ch0 = child(0);
       auto ch1 = child(1);
       WorkApply<scalar_t> wr, wc;
       std::atomic<long long int> flops(0);
       ch1->apply_fwd(R, wr, false, depth, flops);
       ch1->applyT_fwd(R, wc, false, depth, flops);
+      Schur_product_direct_low_rank
+        (Theta, DUB01, Phi, ThetaVhatC_or_VhatCPhiC, R, wr.tmp1, wc.tmp1,
+         Sr, Sc, [&]() {
+           ch1->apply_bwd(R, scalar_t(0.), Sr, wr, true, depth, flops);
+           ch1->applyT_bwd(R, scalar_t(0.), Sc, wc, true, depth, flops);
+         }, [&](Trans op, const DenseM_t& X, const DenseM_t& Y,
+                DenseM_t& S) {
+           gemm(op, Trans::N, scalar_t(-1.), X, Y, scalar_t(1.), S, depth);
+         });
+      STRUMPACK_CB_SAMPLE_FLOPS(flops);
+    }
+
+    /**
+     * Same as above, but the products with H.child(1) are computed
+     * using a plan, which should have been created for H.child(1),
+     * with at least R.cols() columns. R, Sr and Sc are accessed
+     * through the row map I, so that the samples of a parent front
+     * can be used directly, and the result is added to rows I of Sr
+     * and Sc.
+     */
+    template<typename scalar_t> void HSSMatrix<scalar_t>::Schur_product_direct
+    (const DenseM_t& Theta, const DenseM_t& DUB01, const DenseM_t& Phi,
+     const DenseM_t& ThetaVhatC_or_VhatCPhiC, HSSApplyPlan<scalar_t>& plan,
+     const DenseM_t& R, DenseM_t& Sr, DenseM_t& Sc,
+     const std::vector<std::size_t>& I) const {
+      auto depth = this->openmp_task_depth_;
+      long long int flops = plan.forward(Trans::N, R, false, &I) +
+        plan.forward(Trans::C, R, false, &I);
+      Schur_product_direct_low_rank
+        (Theta, DUB01, Phi, ThetaVhatC_or_VhatCPhiC, R,
+         plan.top(Trans::N), plan.top(Trans::C), Sr, Sc, [&]() {
+           flops += plan.backward(Trans::N, R, scalar_t(1.), Sr, &I) +
+             plan.backward(Trans::C, R, scalar_t(1.), Sc, &I);
+         }, [&](Trans op, const DenseM_t& X, const DenseM_t& Y,
+                DenseM_t& S) {
+           // blocks of rows, to avoid a temporary of I.size() rows
+           const std::size_t m = I.size(), n = Y.cols(), B = 256;
+           DenseM_t T(std::min(m, B), n);
+           for (std::size_t r=0; r<m; r+=B) {
+             auto mb = std::min(B, m-r);
+             DenseMW_t Tb(mb, n, T, 0, 0);
+             if (op == Trans::N)
+               gemm(op, Trans::N, scalar_t(-1.),
+                    *ConstDenseMatrixWrapperPtr(mb, X.cols(), X, r, 0),
+                    Y, scalar_t(0.), Tb, depth);
+             else
+               gemm(op, Trans::N, scalar_t(-1.),
+                    *ConstDenseMatrixWrapperPtr(X.rows(), mb, X, 0, r),
+                    Y, scalar_t(0.), Tb, depth);
+             for (std::size_t j=0; j<n; j++)
+               for (std::size_t i=0; i<mb; i++)
+                 S(I[r+i], j) += Tb(i, j);
+           }
+           flops += m * n;
+         });
+      STRUMPACK_CB_SAMPLE_FLOPS(flops);
+    }
 
+    template<typename scalar_t> template<typename BWD, typename ADD> void
+    HSSMatrix<scalar_t>::Schur_product_direct_low_rank
+    (const DenseM_t& Theta, const DenseM_t& DUB01, const DenseM_t& Phi,
+     const DenseM_t& ThetaVhatC_or_VhatCPhiC, const DenseM_t& R,
+     const DenseM_t& VR, const DenseM_t& UR,
+     DenseM_t& Sr, DenseM_t& Sc, const BWD& bwd, const ADD& add) const {
+      auto depth = this->openmp_task_depth_;
+      auto ch0 = child(0);
       if (Theta.cols() < Phi.cols()) {
         DenseM_t VtDUB01(child(0)->ULV_.Vhat().cols(), DUB01.cols());
         gemm(Trans::C, Trans::N, scalar_t(1.), child(0)->ULV_.Vhat(), DUB01,
              scalar_t(0.), VtDUB01, depth);
         DenseM_t tmpr(ch0->V_rank(), R.cols());
-        gemm(Trans::N, Trans::N, scalar_t(1.), VtDUB01, wr.tmp1,
+        gemm(Trans::N, Trans::N, scalar_t(1.), VtDUB01, VR,
              scalar_t(0.), tmpr, depth);
 
         DenseM_t tmpc(B10_.cols(), R.cols());
-        gemm(Trans::C, Trans::N, scalar_t(1.), B10_, wc.tmp1,
+        gemm(Trans::C, Trans::N, scalar_t(1.), B10_, UR,
              scalar_t(0.), tmpc, depth);
 
-        ch1->apply_bwd(R, scalar_t(0.), Sr, wr, true, depth, flops);
-        ch1->applyT_bwd(R, scalar_t(0.), Sc, wc, true, depth, flops);
+        bwd();
 
-        gemm(Trans::N, Trans::N, scalar_t(-1.), Theta, tmpr,
-             scalar_t(1.), Sr, depth);
-        gemm(Trans::C, Trans::N, scalar_t(-1.), ThetaVhatC_or_VhatCPhiC,
-             tmpc, scalar_t(1.), Sc, depth);
+        add(Trans::N, Theta, tmpr, Sr);
+        add(Trans::C, ThetaVhatC_or_VhatCPhiC, tmpc, Sc);
         STRUMPACK_CB_SAMPLE_FLOPS
           (gemm_flops(Trans::C, Trans::N, scalar_t(1.), child(0)->ULV_.Vhat(), DUB01, scalar_t(0.)) +
-           gemm_flops(Trans::N, Trans::N, scalar_t(1.), VtDUB01, wr.tmp1, scalar_t(0.)) +
-           gemm_flops(Trans::C, Trans::N, scalar_t(1.), B10_, wc.tmp1, scalar_t(0.)) +
+           gemm_flops(Trans::N, Trans::N, scalar_t(1.), VtDUB01, VR, scalar_t(0.)) +
+           gemm_flops(Trans::C, Trans::N, scalar_t(1.), B10_, UR, scalar_t(0.)) +
            gemm_flops(Trans::N, Trans::N, scalar_t(-1.), Theta, tmpr, scalar_t(1.)) +
            gemm_flops(Trans::C, Trans::N, scalar_t(-1.), ThetaVhatC_or_VhatCPhiC, tmpc, scalar_t(1.)));
       } else {
         DenseM_t tmpr(DUB01.rows(), R.cols());
-        gemm(Trans::N, Trans::N, scalar_t(1.), DUB01, wr.tmp1,
+        gemm(Trans::N, Trans::N, scalar_t(1.), DUB01, VR,
              scalar_t(0.), tmpr, depth);
 
         DenseM_t VB10t(child(0)->ULV_.Vhat().rows(), B10_.rows());
         gemm(Trans::N, Trans::C, scalar_t(1.), child(0)->ULV_.Vhat(), B10_,
              scalar_t(0.), VB10t, depth);
         DenseM_t tmpc(child(0)->ULV_.Vhat().rows(), R.cols());
-        gemm(Trans::N, Trans::N, scalar_t(1.), VB10t, wc.tmp1,
+        gemm(Trans::N, Trans::N, scalar_t(1.), VB10t, UR,
              scalar_t(0.), tmpc, depth);
 
-        ch1->apply_bwd(R, scalar_t(0.), Sr, wr, true, depth, flops);
-        ch1->applyT_bwd(R, scalar_t(0.), Sc, wc, true, depth, flops);
+        bwd();
 
-        gemm(Trans::N, Trans::N, scalar_t(-1.), ThetaVhatC_or_VhatCPhiC,
-             tmpr, scalar_t(1.), Sr, depth);
-        gemm(Trans::N, Trans::N, scalar_t(-1.), Phi,
-             tmpc, scalar_t(1.), Sc, depth);
+        add(Trans::N, ThetaVhatC_or_VhatCPhiC, tmpr, Sr);
+        add(Trans::N, Phi, tmpc, Sc);
         STRUMPACK_CB_SAMPLE_FLOPS
-          (gemm_flops(Trans::N, Trans::N, scalar_t(1.), DUB01, wr.tmp1, scalar_t(0.)) +
+          (gemm_flops(Trans::N, Trans::N, scalar_t(1.), DUB01, VR, scalar_t(0.)) +
            gemm_flops(Trans::N, Trans::C, scalar_t(1.), child(0)->ULV_.Vhat(), B10_, scalar_t(0.)) +
-           gemm_flops(Trans::N, Trans::N, scalar_t(1.), VB10t, wc.tmp1, scalar_t(0.)) +
+           gemm_flops(Trans::N, Trans::N, scalar_t(1.), VB10t, UR, scalar_t(0.)) +
            gemm_flops(Trans::N, Trans::N, scalar_t(-1.), ThetaVhatC_or_VhatCPhiC, tmpr, scalar_t(1.)) +
            gemm_flops(Trans::N, Trans::N, scalar_t(-1.), Phi, tmpc, scalar_t(1.)));
       }
-      STRUMPACK_CB_SAMPLE_FLOPS(flops);
     }
 
     /**
@@ -144,31 +202,42 @@ namespace strumpack {
      *   Sc = Sc1 - V1big B01^* (U0big^* R0 + (Vhat^* D00^{-1} U0)^* B10^* U1big^* R1)
      *      = Sc1 - V1big (B01^* (U0big^* R0) + B01^* (Vhat^* D00^{-1} U0)^* B10^* (U1big^* R1))
      *      = Sc1 - V1big (B01^* (U0big^* R0) + (B10 Vhat^* DU0B01)^* (U1big^* R1))
+     *
+     * If I is not null, R1 holds (at least) the first R0.cols()
+     * columns of the parent's random vectors, only the rows I of R1
+     * are used, and Sr and Sc should be the parent's samples, to
+     * which the result is added, in rows I. This avoids copying the
+     * rows I of R1 and of the result.
      */
     template<typename scalar_t> void
     HSSMatrix<scalar_t>::Schur_product_indirect
     (const DenseM_t& DUB01, const DenseM_t& R0, const DenseM_t& R1,
      const DenseM_t& Sr1, const DenseM_t& Sc1,
-     DenseM_t& Sr, DenseM_t& Sc) const {
+     DenseM_t& Sr, DenseM_t& Sc, const std::vector<std::size_t>* I) const {
       if (this->leaf()) return;
       auto depth = this->openmp_task_depth_;
       auto ch0 = child(0);
       auto ch1 = child(1);
+      auto map = I ? I->data() : nullptr;
 
-      auto c = R1.cols();
-      assert(R0.cols() == R1.cols());
+      auto c = R0.cols();
+      assert(I || R0.cols() == R1.cols());
       assert(Sr1.cols() == Sc1.cols());
 
       DenseM_t V0tR0(ch0->V_rank(), c);
       DenseM_t U0tR0(ch0->U_rank(), c);
       std::pair<std::size_t,std::size_t> off0;
       std::atomic<long long int> flops;
-      ch0->apply_UtVt_big(R0, U0tR0, V0tR0, off0, depth, flops);
+      ch0->apply_UtVt_big(R0, U0tR0, V0tR0, off0, nullptr, depth, flops);
 
       DenseM_t V1tR1(ch1->V_rank(), c);
       DenseM_t U1tR1(ch1->U_rank(), c);
       std::pair<std::size_t,std::size_t> off1;
-      ch1->apply_UtVt_big(R1, U1tR1, V1tR1, off1, depth, flops);
+      if (map) {
+        auto R1c = ConstDenseMatrixWrapperPtr(R1.rows(), c, R1, 0, 0);
+        ch1->apply_UtVt_big(*R1c, U1tR1, V1tR1, off1, map, depth, flops);
+      } else
+        ch1->apply_UtVt_big(R1, U1tR1, V1tR1, off1, nullptr, depth, flops);
 
       DenseM_t VtDUB01(this->ULV_.Vhat().cols(), DUB01.cols());
       gemm(Trans::C, Trans::N, scalar_t(1.), this->ULV_.Vhat(), DUB01,
@@ -203,10 +272,23 @@ namespace strumpack {
       B10VtDUB01.clear(); V1tR1.clear();
       B10VtDUB01.clear(); U1tR1.clear();
 
+      std::pair<std::size_t,std::size_t> off;
+      if (map) {
+        DenseMW_t Src(Sr.rows(), c, Sr, 0, 0), Scc(Sc.rows(), c, Sc, 0, 0);
+        ch1->apply_UV_big(Src, B10V0tR0, Scc, B01tU0tR0, off, map,
+                          depth, flops);
+        for (std::size_t j=0; j<c; j++)
+          for (std::size_t i=0; i<Sr1.rows(); i++) {
+            Sr(map[i], j) += Sr1(i, j);
+            Sc(map[i], j) += Sc1(i, j);
+          }
+        STRUMPACK_CB_SAMPLE_FLOPS(2*Sr1.rows()*c + flops);
+        return;
+      }
       Sr = DenseM_t(R1.rows(), R1.cols());
       Sc = DenseM_t(R1.rows(), R1.cols());
-      std::pair<std::size_t,std::size_t> off;
-      ch1->apply_UV_big(Sr, B10V0tR0, Sc, B01tU0tR0, off, depth, flops);
+      ch1->apply_UV_big(Sr, B10V0tR0, Sc, B01tU0tR0, off, nullptr,
+                        depth, flops);
 
       Sr.add(Sr1, depth);
       Sc.add(Sc1, depth);
@@ -216,10 +298,22 @@ namespace strumpack {
 
     template<typename scalar_t> void HSSMatrix<scalar_t>::apply_UtVt_big
     (const DenseM_t& A, DenseM_t& UtA, DenseM_t& VtA,
-     const std::pair<std::size_t, std::size_t>& offset, int depth,
+     const std::pair<std::size_t, std::size_t>& offset,
+     const std::size_t* I, int depth,
      std::atomic<long long int>& flops) const {
       if (this->leaf()) {
-        auto Al = ConstDenseMatrixWrapperPtr
+        // with a row map I, only the rows of A for this leaf are
+        // gathered
+        DenseM_t Ag;
+        if (I) {
+          Ag = DenseM_t(this->rows(), A.cols());
+          for (std::size_t j=0; j<A.cols(); j++)
+            for (std::size_t i=0; i<this->rows(); i++)
+              Ag(i, j) = A(I[offset.first+i], j);
+        }
+        auto Al = I ?
+          ConstDenseMatrixWrapperPtr(this->rows(), A.cols(), Ag, 0, 0) :
+          ConstDenseMatrixWrapperPtr
           (this->rows(), A.cols(), A, offset.first, 0);
         UtA = U_.applyC(*Al, depth);
         VtA = V_.applyC(*Al, depth);
@@ -231,12 +325,12 @@ namespace strumpack {
 #pragma omp task default(shared)                                        \
   if(depth < params::task_recursion_cutoff_level)                       \
   final(depth >= params::task_recursion_cutoff_level-1) mergeable
-        child(0)->apply_UtVt_big(A, UtA0, VtA0, offset, depth+1, flops);
+        child(0)->apply_UtVt_big(A, UtA0, VtA0, offset, I, depth+1, flops);
 #pragma omp task default(shared)                                        \
   if(depth < params::task_recursion_cutoff_level)                       \
   final(depth >= params::task_recursion_cutoff_level-1) mergeable
         child(1)->apply_UtVt_big
-          (A, UtA1, VtA1, offset+child(0)->dims(), depth+1, flops);
+          (A, UtA1, VtA1, offset+child(0)->dims(), I, depth+1, flops);
 #pragma omp taskwait
         UtA = U_.applyC(vconcat(UtA0, UtA1), depth);
         VtA = V_.applyC(vconcat(VtA0, VtA1), depth);
@@ -247,11 +341,21 @@ namespace strumpack {
 
     template<typename scalar_t> void HSSMatrix<scalar_t>::apply_UV_big
     (DenseM_t& Theta, DenseM_t& Uop, DenseM_t& Phi, DenseM_t& Vop,
-     const std::pair<std::size_t, std::size_t>& offset, int depth,
+     const std::pair<std::size_t, std::size_t>& offset,
+     const std::size_t* I, int depth,
      std::atomic<long long int>& flops) const {
       if (this->leaf()) {
-        DenseMW_t ltheta(U_.rows(), Theta.cols(), Theta, offset.first, 0);
-        DenseMW_t lphi(V_.rows(), Phi.cols(), Phi, offset.second, 0);
+        // with a row map I, the result for this leaf is added to the
+        // rows I of Theta and Phi
+        DenseM_t tt, tp;
+        if (I) {
+          tt = DenseM_t(U_.rows(), Theta.cols());
+          tp = DenseM_t(V_.rows(), Phi.cols());
+        }
+        DenseMW_t ltheta(U_.rows(), Theta.cols(), I ? tt : Theta,
+                         I ? 0 : offset.first, 0);
+        DenseMW_t lphi(V_.rows(), Phi.cols(), I ? tp : Phi,
+                       I ? 0 : offset.second, 0);
 #pragma omp task default(shared)                                        \
   if(depth < params::task_recursion_cutoff_level)                       \
   final(depth >= params::task_recursion_cutoff_level-1) mergeable
@@ -267,6 +371,14 @@ namespace strumpack {
           flops += V_.apply_flops(Vop.cols());
         } else lphi.zero();
 #pragma omp taskwait
+        if (I) {
+          for (std::size_t j=0; j<ltheta.cols(); j++)
+            for (std::size_t i=0; i<ltheta.rows(); i++)
+              Theta(I[offset.first+i], j) += ltheta(i, j);
+          for (std::size_t j=0; j<lphi.cols(); j++)
+            for (std::size_t i=0; i<lphi.rows(); i++)
+              Phi(I[offset.second+i], j) += lphi(i, j);
+        }
       } else {
         DenseM_t Uop0, Uop1, Vop0, Vop1;
         Uop0 = DenseM_t(child(0)->U_rank(), Uop.cols());
@@ -308,12 +420,13 @@ namespace strumpack {
   if(depth < params::task_recursion_cutoff_level)                       \
   final(depth >= params::task_recursion_cutoff_level-1) mergeable
         child(0)->apply_UV_big
-          (Theta, Uop0, Phi, Vop0, offset, depth+1, flops);
+          (Theta, Uop0, Phi, Vop0, offset, I, depth+1, flops);
 #pragma omp task default(shared)                                        \
   if(depth < params::task_recursion_cutoff_level)                       \
   final(depth >= params::task_recursion_cutoff_level-1) mergeable
         child(1)->apply_UV_big
-          (Theta, Uop1, Phi, Vop1, offset+child(0)->dims(), depth+1, flops);
+          (Theta, Uop1, Phi, Vop1, offset+child(0)->dims(), I,
+           depth+1, flops);
 #pragma omp taskwait
       }
     }
@@ -358,7 +358,7 @@ namespace strumpack {
           compute_local_samples(Rr, Rc, Sr, Sc, w, 0, d, depth);
         else compute_local_samples(Rr, Rc, Sr, Sc, w, d-dd, dd, depth);
         if (!this->is_compressed()) {
-          if (compute_U_V_bases(Sr, Sc, opts, w, d, depth)) {
+          if (compute_U_V_bases(Sr, Sc, opts, w, d, dd, depth)) {
             reduce_local_samples(Rr, Rc, w, 0, d, depth);
             this->U_state_ = this->V_state_ = State::COMPRESSED;
           } else
@@ -405,7 +405,7 @@ namespace strumpack {
           compute_local_samples(Rr, Rc, Sr, Sc, w, 0, d, depth);
         else compute_local_samples(Rr, Rc, Sr, Sc, w, d-dd, dd, depth);
         if (!this->is_compressed()) {
-          if (compute_U_V_bases(Sr, Sc, opts, w, d, depth)) {
+          if (compute_U_V_bases(Sr, Sc, opts, w, d, dd, depth)) {
             reduce_local_samples(Rr, Rc, w, 0, d, depth);
             this->U_state_ = this->V_state_ = State::COMPRESSED;
           } else
@@ -631,9 +631,35 @@ namespace strumpack {
     // TODO split in U and V compression
     template<typename scalar_t> bool HSSMatrix<scalar_t>::compute_U_V_bases
     (DenseM_t& Sr, DenseM_t& Sc, const opts_t& opts,
-     WorkCompress<scalar_t>& w, int d, int depth) {
+     WorkCompress<scalar_t>& w, int d, int dd, int depth) {
       auto rtol = opts.rel_tol() / w.lvl;
       auto atol = opts.abs_tol() / w.lvl;
+      if (!this->is_untouched() && d-opts.p() < opts.max_rank()) {
+        // This node already failed to compress with d-dd samples.
+        // Only orthogonalize the dd new samples against the bases
+        // kept from the previous attempt. If the samples are still
+        // (numerically) full rank, the interpolative decompositions
+        // cannot reveal a rank < d-p, so they are not recomputed.
+        auto u_rows = this->leaf() ? this->rows() :
+          child(0)->U_rank()+child(1)->U_rank();
+        auto v_rows = this->leaf() ? this->rows() :
+          child(0)->V_rank()+child(1)->V_rank();
+        DenseMW_t wSr(u_rows, d, Sr, w.offset.second, 0);
+        DenseMW_t wSc(v_rows, d, Sc, w.offset.second, 0);
+        bool Ufull = false, Vfull = false;
+#pragma omp task default(shared)                                        \
+  if(depth < params::task_recursion_cutoff_level)                       \
+  final(depth >= params::task_recursion_cutoff_level-1) mergeable
+        Ufull = samples_full_rank
+          (opts, w.U_r_max, wSr, w.Qr, d, dd, w.lvl, depth);
+#pragma omp task default(shared)                                        \
+  if(depth < params::task_recursion_cutoff_level)                       \
+  final(depth >= params::task_recursion_cutoff_level-1) mergeable
+        Vfull = samples_full_rank
+          (opts, w.V_r_max, wSc, w.Qc, d, dd, w.lvl, depth);
+#pragma omp taskwait
+        if (Ufull || Vfull) return false;
+      }
 #pragma omp task default(shared)                                        \
   if(depth < params::task_recursion_cutoff_level)                       \
   final(depth >= params::task_recursion_cutoff_level-1) mergeable
@@ -678,6 +704,8 @@ namespace strumpack {
           for (auto j : w.Jc)
             w.Ic.push_back((j < r0) ? w.c[0].Ic[j] : w.c[1].Ic[j-r0]);
         }
+        w.Qr.clear();
+        w.Qc.clear();
         return true;
       } else {
         w.Jr.clear();
@@ -686,6 +714,73 @@ namespace strumpack {
       }
     }
 
+    /**
+     * Update the orthonormal basis Q for the first d-dd columns of
+     * the samples S with the dd new columns, using block classical
+     * Gram-Schmidt with reorthogonalization, followed by a column
+     * pivoted QR (geqp3tol, as in the ID) of the new block. If Q does
+     * not hold a basis for the first d-dd columns (yet), it is
+     * recomputed from all d columns. Returns true if all d columns
+     * are numerically independent, with respect to the same
+     * tolerances as used in the ID. The ID is relative to the
+     * largest row of S, here the largest row or column of S is used,
+     * so the samples are only considered full rank if the ID would
+     * certainly fail. If they are not, Q is cleared.
+     */
+    template<typename scalar_t> bool HSSMatrix<scalar_t>::samples_full_rank
+    (const opts_t& opts, scalar_t& r_max_0, const DenseM_t& S,
+     DenseM_t& Q, int d, int dd, int L, int depth) {
+      int m = S.rows(), d0 = d - dd;
+      if (d >= m) return false;
+      bool update = int(Q.cols()) == d0 && int(Q.rows()) == m;
+      if (!update) {
+        Q = DenseM_t(m, d);
+        copy(m, d, S, 0, 0, Q, 0, 0);
+        real_t nmax(0.);
+        for (int i=0; i<m; i++)
+          nmax = std::max(nmax, blas::nrm2(d, S.ptr(i, 0), S.ld()));
+        for (int j=0; j<d; j++)
+          nmax = std::max(nmax, blas::nrm2(m, S.ptr(0, j), 1));
+        r_max_0 = nmax;
+      } else {
+        Q.resize(m, d);
+        copy(m, dd, S, 0, d0, Q, 0, d0);
+        DenseMW_t Q1(m, d0, Q, 0, 0), Q2(m, dd, Q, 0, d0);
+        DenseM_t Q1tQ2(d0, dd);
+        TIMER_TIME(TaskType::ORTHO, 1, t_ortho);
+        for (int it=0; it<2; it++) {
+          gemm(Trans::C, Trans::N, scalar_t(1.), Q1, Q2,
+               scalar_t(0.), Q1tQ2, depth);
+          gemm(Trans::N, Trans::N, scalar_t(-1.), Q1, Q1tQ2,
+               scalar_t(1.), Q2, depth);
+          STRUMPACK_ORTHO_FLOPS
+            (gemm_flops(Trans::C, Trans::N, scalar_t(1.), Q1, Q2,
+                        scalar_t(0.)) +
+             gemm_flops(Trans::N, Trans::N, scalar_t(-1.), Q1, Q1tQ2,
+                        scalar_t(1.)));
+        }
+        TIMER_STOP(t_ortho);
+      }
+      // pivoted QR of the new columns, stops when |R(k,k)| drops
+      // below the (absolute) tolerance
+      DenseMW_t Qn(m, update ? dd : d, Q, 0, update ? d0 : 0);
+      int n = Qn.cols(), rank = 0;
+      std::vector<int> piv(n);
+      std::unique_ptr<scalar_t[]> tau(new scalar_t[n]);
+      real_t tol = std::max(real_t(opts.abs_tol() / L),
+                            real_t(opts.rel_tol() / L) * std::abs(r_max_0));
+      TIMER_TIME(TaskType::QR, 1, t_qr);
+      blas::geqp3tol(m, n, Qn.data(), Qn.ld(), piv.data(), tau.get(),
+                     rank, real_t(0.), tol);
+      if (rank < n) {
+        Q.clear();
+        return false;
+      }
+      blas::xxgqr(m, n, n, Qn.data(), Qn.ld(), tau.get());
+      STRUMPACK_QR_FLOPS(orthogonalize_flops(Qn));
+      return true;
+    }
+
     template<typename scalar_t> void HSSMatrix<scalar_t>::reduce_local_samples
     (DenseM_t& Rr, DenseM_t& Rc, WorkCompress<scalar_t>& w,
      int d0, int d, int depth) {
@@ -31,6 +31,7 @@
 #include "HSSMatrix.hpp"
 
 #include "misc/TaskTimer.hpp"
+#include "BLR/BLRBatchCPU.hpp"
 #include "HSSMatrix.apply.hpp"
 #include "HSSMatrix.compress.hpp"
 #include "HSSMatrix.compress_stable.hpp"
@@ -60,6 +61,7 @@ namespace strumpack {
     template<typename scalar_t> HSSMatrix<scalar_t>::HSSMatrix
     (std::size_t m, std::size_t n, const opts_t& opts, bool active)
       : HSSMatrixBase<scalar_t>(m, n, active) {
+      level_ULV_ = opts.level_ULV();
       if (!active) return;
       if (m > std::size_t(opts.leaf_size()) ||
           n > std::size_t(opts.leaf_size())) {
@@ -72,6 +74,7 @@ namespace strumpack {
     template<typename scalar_t> HSSMatrix<scalar_t>::HSSMatrix
     (const structured::ClusterTree& t, const opts_t& opts, bool active)
       : HSSMatrixBase<scalar_t>(t.size, t.size, active) {
+      level_ULV_ = opts.level_ULV();
       if (!active) return;
       if (!t.c.empty()) {
         assert(t.c.size() == 2);
@@ -88,10 +91,12 @@ namespace strumpack {
     template<typename scalar_t> HSSMatrix<scalar_t>::HSSMatrix
     (kernel::Kernel<real_t>& K, const opts_t& opts)
       : HSSMatrixBase<scalar_t>(K.n(), K.n(), true) {
+      level_ULV_ = opts.level_ULV();
       TaskTimer timer("clustering");
       timer.start();
       auto t = binary_tree_clustering
         (opts.clustering_algorithm(), K.data(), K.permutation(), opts.leaf_size());
+      K.tree() = t;
       K.permute();
       if (opts.verbose())
         std::cout << "# clustering (" << get_name(opts.clustering_algorithm())
@@ -119,6 +124,7 @@ namespace strumpack {
       D_ = other.D_;
       B01_ = other.B01_;
       B10_ = other.B10_;
+      level_ULV_ = other.level_ULV_;
     }
 
     template<typename scalar_t> HSSMatrix<scalar_t>&
@@ -129,6 +135,7 @@ namespace strumpack {
       D_ = other.D_;
       B01_ = other.B01_;
       B10_ = other.B10_;
+      level_ULV_ = other.level_ULV_;
       return *this;
     }
 
@@ -439,6 +446,11 @@ namespace strumpack {
       os.write((const char*)&this->V_rows_, sizeof(this->V_rows_));
       os << this->Asub_;
       os << U_ << V_ << D_ << B01_ << B10_;
+      auto& F = this->ULV_;
+      os << F.L_ << F.Vt0_ << F.W1_ << F.Q_ << F.D_;
+      std::size_t npiv = F.piv_.size();
+      os.write((const char*)&npiv, sizeof(npiv));
+      os.write((const char*)F.piv_.data(), npiv*sizeof(int));
       int nc = this->ch_.size();
       os.write((const char*)&nc, sizeof(nc));
       for (auto& c : this->ch_)
@@ -459,6 +471,12 @@ namespace strumpack {
       is.read((char*)&this->V_rows_, sizeof(this->V_rows_));
       is >> this->Asub_;
       is >> U_ >> V_ >> D_ >> B01_ >> B10_;
+      auto& F = this->ULV_;
+      is >> F.L_ >> F.Vt0_ >> F.W1_ >> F.Q_ >> F.D_;
+      std::size_t npiv = 0;
+      is.read((char*)&npiv, sizeof(npiv));
+      F.piv_.resize(npiv);
+      is.read((char*)F.piv_.data(), npiv*sizeof(int));
       int nc = 0;
       is.read((char*)&nc, sizeof(nc));
       this->ch_.resize(nc);
@@ -469,10 +487,17 @@ namespace strumpack {
     template<typename scalar_t> void
     HSSMatrix<scalar_t>::write(const std::string& fname) const {
       std::ofstream f(fname, std::ios::out | std::ios::trunc);
+      write_to(f);
+    }
+
+    template<typename scalar_t> void
+    HSSMatrix<scalar_t>::write_to(std::ofstream& os) const {
       int v[3];
       get_version(v, v+1, v+2);
-      f.write((const char*)v, sizeof(v));
-      write(f);
+      os.write((const char*)v, sizeof(v));
+      int fmt[2] = {file_format_tag, file_format_version};
+      os.write((const char*)fmt, sizeof(fmt));
+      write(os);
     }
 
     template<typename scalar_t> HSSMatrix<scalar_t>
@@ -483,6 +508,11 @@ namespace strumpack {
       } catch (std::ios_base::failure& e) {
         std::cerr << e.what() << std::endl;
       }
+      return read_from(f);
+    }
+
+    template<typename scalar_t> HSSMatrix<scalar_t>
+    HSSMatrix<scalar_t>::read_from(std::ifstream& f) {
       int v[3], vf[3];
       get_version(v+0, v+1, v+2);
       f.read((char*)vf, sizeof(vf));
@@ -494,7 +524,20 @@ namespace strumpack {
                   << v[0] << "." << v[1] << "." << v[2]
                   << ")" << std::endl;
       }
+      // files written before the format version was added do not
+      // contain the ULV factors, and cannot be read
+      int fmt[2] = {0, 0};
+      f.read((char*)fmt, sizeof(fmt));
       HSSMatrix<scalar_t> H;
+      if (fmt[0] != file_format_tag || fmt[1] != file_format_version) {
+        std::cerr << "ERROR: unsupported HSS matrix file format";
+        if (fmt[0] == file_format_tag)
+          std::cerr << " version " << fmt[1] << ", expected version "
+                    << file_format_version;
+        std::cerr << "." << std::endl;
+        f.setstate(std::ios::failbit);
+        return H;
+      }
       H.read(f);
       return H;
     }
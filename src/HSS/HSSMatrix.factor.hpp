@@ -37,21 +37,28 @@ namespace strumpack {
       WorkFactor<scalar_t> w;
 #pragma omp parallel if(!omp_in_parallel())
 #pragma omp single nowait
-      factor_recursive(w, true, false, this->openmp_task_depth_);
+      {
+        if (level_ULV_) factor_level(false);
+        else factor_recursive(w, true, false, this->openmp_task_depth_);
+      }
     }
 
     template<typename scalar_t> void
     HSSMatrix<scalar_t>::partial_factor() {
       this->ULV_ = HSSFactors<scalar_t>();
-      WorkFactor<scalar_t> w;
-      child(0)->factor_recursive
-        (w, true, true, this->openmp_task_depth_);
+      if (level_ULV_) {
+#pragma omp parallel if(!omp_in_parallel())
+#pragma omp single nowait
+        child(0)->factor_level(true);
+      } else {
+        WorkFactor<scalar_t> w;
+        child(0)->factor_recursive
+          (w, true, true, this->openmp_task_depth_);
+      }
     }
 
     template<typename scalar_t> void HSSMatrix<scalar_t>::factor_recursive
     (WorkFactor<scalar_t>& w, bool isroot, bool partial, int depth) {
-      this->ULV_ = HSSFactors<scalar_t>();
-      DenseM_t Vh;
       if (!this->leaf()) {
         w.c.resize(2);
 #pragma omp task default(shared)                                        \
@@ -65,6 +72,161 @@ namespace strumpack {
         child(1)->factor_recursive
           (w.c[1], false, partial, depth+1);
 #pragma omp taskwait
+      }
+      factor_node(w, isroot, partial, depth);
+    }
+
+    /**
+     * Level-by-level version of factor_recursive/factor_node. All
+     * temporaries of a level (the D and Vh of each node, and the Vt1
+     * and Dt passed to the parent) are stored in a single workspace,
+     * and the small matrix products of all nodes of a level are
+     * executed as batches, sorted by size, instead of one BLAS call
+     * per node. Only the LQ factorization is done node by node.
+     */
+    template<typename scalar_t> void
+    HSSMatrix<scalar_t>::factor_level(bool partial) {
+      using batch_t = BLR::BatchedGEMM<scalar_t>;
+      const int depth = this->openmp_task_depth_;
+      // execute a batch of products, and count the flops
+      auto run = [depth](batch_t& b, scalar_t alpha, scalar_t beta) {
+#if defined(STRUMPACK_COUNT_FLOPS)
+        STRUMPACK_ULV_FACTOR_FLOPS(b.run(alpha, beta, depth));
+#else
+        b.run(alpha, beta, depth);
+#endif
+      };
+      TreeLevels<HSSMatrix<scalar_t>> tl(this);
+      // workspace of the level below, with the Vt1 and Dt of the
+      // children of the current level
+      DenseM_t cws;
+      std::vector<DenseMW_t> cVt1, cDt;
+      for (std::size_t l=tl.levels(); l-->0; ) {
+        auto& nodes = tl.nodes[l];
+        auto& ch = tl.ch[l];
+        const std::size_t n = nodes.size();
+        const bool root = l == 0;
+        std::vector<std::size_t> off(n+1, 0);
+        for (std::size_t i=0; i<n; i++) {
+          auto h = nodes[i];
+          std::size_t m = h->ULV_rows(), r = h->U_rank(), v = h->V_rank();
+          assert(!l || m == h->U_rows());
+          off[i+1] = off[i] + m*m + m*v + ((m > r) ? r*(v+r) : 0);
+        }
+        DenseM_t ws(off[n], 1);
+        std::vector<DenseMW_t> D(n), Vh(n), Vt1(n), Dt(n);
+        std::vector<DenseM_t> V(n);
+        for (std::size_t i=0; i<n; i++) {
+          auto h = nodes[i];
+          std::size_t m = h->ULV_rows(), r = h->U_rank(), v = h->V_rank();
+          auto p = ws.data() + off[i];
+          D[i] = DenseMW_t(m, m, p, m);    p += m*m;
+          Vh[i] = DenseMW_t(m, v, p, m);   p += m*v;
+          if (m > r) {
+            Vt1[i] = DenseMW_t(r, v, p, r);  p += r*v;
+            Dt[i] = DenseMW_t(r, r, p, r);
+          } else {
+            // P^t D and Vh are passed to the parent as they are
+            Vt1[i] = DenseMW_t(r, v, Vh[i], 0, 0);
+            Dt[i] = DenseMW_t(r, r, D[i], 0, 0);
+          }
+        }
+        // D = [Dt0 B01*Vt1_1^*; B10*Vt1_0^* Dt1], Vh = [Vt1_0 V0; Vt1_1 V1]
+        const bool needVh = !root || partial;
+        level_loop(0, n, this->openmp_task_depth_, [&](std::size_t i, int) {
+          auto h = nodes[i];
+          h->ULV_ = HSSFactors<scalar_t>();
+          if (h->leaf()) {
+            copy(h->D_, D[i], 0, 0);
+            if (needVh) {
+              Vh[i].eye();
+              copy(h->V_.E(), Vh[i], h->V_rank(), 0);
+              Vh[i].laswp(h->V_.P(), false);
+            }
+          } else {
+            auto c0u = h->child(0)->U_rank();
+            copy(cDt[ch[i]], D[i], 0, 0);
+            copy(cDt[ch[i]+1], D[i], c0u, c0u);
+            if (needVh) V[i] = h->V_.dense();
+          }
+        });
+        batch_t b1;
+        for (std::size_t i=0; i<n; i++) {
+          auto h = nodes[i];
+          if (h->leaf()) continue;
+          auto c0u = h->child(0)->U_rank(), c1u = h->child(1)->U_rank();
+          auto &Vt10 = cVt1[ch[i]], &Vt11 = cVt1[ch[i]+1];
+          DenseMW_t D01(c0u, c1u, D[i], 0, c0u), D10(c1u, c0u, D[i], c0u, 0);
+          b1.add(Trans::N, Trans::C, h->B01_, Vt11, D01);
+          b1.add(Trans::N, Trans::C, h->B10_, Vt10, D10);
+          if (needVh) {
+            auto c0v = h->child(0)->V_rank(), c1v = h->child(1)->V_rank();
+            DenseMW_t Vh0(c0u, h->V_rank(), Vh[i], 0, 0),
+              Vh1(c1u, h->V_rank(), Vh[i], c0u, 0),
+              V0(c0v, h->V_rank(), V[i], 0, 0),
+              V1(c1v, h->V_rank(), V[i], c0v, 0);
+            b1.add(Trans::N, Trans::N, Vt10, V0, Vh0);
+            b1.add(Trans::N, Trans::N, Vt11, V1, Vh1);
+          }
+        }
+        run(b1, scalar_t(1.), scalar_t(0.));
+        V.clear();
+        if (root) {
+          this->ULV_.D_ = DenseM_t(D[0]);
+          this->ULV_.piv_ = this->ULV_.D_.LU(depth);
+          STRUMPACK_ULV_FACTOR_FLOPS(LU_flops(this->ULV_.D_));
+          if (partial) this->ULV_.Vt0_ = DenseM_t(Vh[0]);
+          break;
+        }
+        // compute P^t D, split in W1 (top) and W0 (bottom)
+        std::vector<DenseMW_t> W0(n);
+        level_loop(0, n, this->openmp_task_depth_, [&](std::size_t i, int) {
+          auto h = nodes[i];
+          std::size_t m = h->ULV_rows(), r = h->U_rank();
+          D[i].laswp(h->U_.P(), true);
+          if (m > r) {
+            h->ULV_.W1_ = DenseM_t(r, m, D[i], 0, 0);
+            W0[i] = DenseMW_t(m-r, m, D[i], r, 0);
+          }
+        });
+        // W0 = -E * W1 + W0
+        batch_t b2;
+        for (std::size_t i=0; i<n; i++)
+          if (W0[i].rows())
+            b2.add(Trans::N, Trans::N, nodes[i]->U_.E(),
+                   nodes[i]->ULV_.W1_, W0[i]);
+        run(b2, scalar_t(-1.), scalar_t(1.));
+        level_loop(0, n, this->openmp_task_depth_, [&](std::size_t i, int d) {
+          if (!W0[i].rows()) return;
+          auto h = nodes[i];
+          W0[i].LQ(h->ULV_.L_, h->ULV_.Q_, d);
+          STRUMPACK_ULV_FACTOR_FLOPS(LQ_flops(W0[i]));
+          h->ULV_.Vt0_ = DenseM_t(W0[i].rows(), h->V_rank());
+        });
+        // Vt0 = Q0 * Vh, Vt1 = Q1 * Vh, Dt = W1 * Q1^*
+        batch_t b3;
+        for (std::size_t i=0; i<n; i++) {
+          if (!W0[i].rows()) continue;
+          auto h = nodes[i];
+          std::size_t m = h->ULV_rows(), r = h->U_rank(), e = m - r;
+          auto& Q = h->ULV_.Q_;
+          DenseMW_t Q0(e, m, Q, 0, 0), Q1(r, m, Q, e, 0);
+          b3.add(Trans::N, Trans::N, Q0, Vh[i], h->ULV_.Vt0_);
+          b3.add(Trans::N, Trans::N, Q1, Vh[i], Vt1[i]);
+          b3.add(Trans::N, Trans::C, h->ULV_.W1_, Q1, Dt[i]);
+        }
+        run(b3, scalar_t(1.), scalar_t(0.));
+        cws = std::move(ws);
+        cVt1 = std::move(Vt1);
+        cDt = std::move(Dt);
+      }
+    }
+
+    template<typename scalar_t> void HSSMatrix<scalar_t>::factor_node
+    (WorkFactor<scalar_t>& w, bool isroot, bool partial, int depth) {
+      this->ULV_ = HSSFactors<scalar_t>();
+      DenseM_t Vh;
+      if (!this->leaf()) {
         auto u_rows = child(0)->U_rank() + child(1)->U_rank();
         if (u_rows) {
           this->ULV_.D_ = DenseM_t(u_rows, u_rows);
@@ -42,6 +42,7 @@
 #include <string>
 
 #include "HSSBasisID.hpp"
+#include "HSSApplyPlan.hpp"
 #include "HSSOptions.hpp"
 #include "HSSExtra.hpp"
 #include "HSSMatrixBase.hpp"
@@ -466,11 +467,21 @@ namespace strumpack {
                                 const DenseM_t&_ThetaVhatC_or_VhatCPhiC,
                                 const DenseM_t& R,
                                 DenseM_t& Sr, DenseM_t& Sc) const;
+      void Schur_product_direct(const DenseM_t& Theta,
+                                const DenseM_t& DUB01,
+                                const DenseM_t& Phi,
+                                const DenseM_t&_ThetaVhatC_or_VhatCPhiC,
+                                HSSApplyPlan<scalar_t>& plan,
+                                const DenseM_t& R,
+                                DenseM_t& Sr, DenseM_t& Sc,
+                                const std::vector<std::size_t>& I) const;
       void Schur_product_indirect(const DenseM_t& DUB01,
                                   const DenseM_t& R1,
                                   const DenseM_t& R2, const DenseM_t& Sr2,
                                   const DenseM_t& Sc2,
-                                  DenseM_t& Sr, DenseM_t& Sc) const;
+                                  DenseM_t& Sr, DenseM_t& Sc,
+                                  const std::vector<std::size_t>* I=nullptr)
+        const;
       void delete_trailing_block() override;
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
@@ -498,12 +509,24 @@ namespace strumpack {
 
       /**
        * Write this HSSMatrix<scalar_t> to a binary file, called
-       * fname.
+       * fname. If the matrix has been factored, the ULV factors are
+       * also stored, so the matrix read back can be used in solve
+       * directly.
        *
-       * \see read
+       * \see read, write_to
        */
       void write(const std::string& fname) const;
 
+      /**
+       * Write this HSSMatrix<scalar_t>, with a version header, to an
+       * open binary stream. This can be used to store an HSS matrix
+       * as part of a larger file. The header contains the strumpack
+       * version and a file format version.
+       *
+       * \see write, read_from
+       */
+      void write_to(std::ofstream& os) const;
+
       /**
        * Read an HSSMatrix<scalar_t> from a binary file, called
        * fname.
@@ -512,6 +535,18 @@ namespace strumpack {
        */
       static HSSMatrix<scalar_t> read(const std::string& fname);
 
+      /**
+       * Read an HSSMatrix<scalar_t>, written with write_to, from an
+       * open binary stream, starting at the current position. Files
+       * with a different file format version, including files
+       * written before the format version was stored, are rejected:
+       * an error is printed, the failbit of the stream is set, and
+       * an empty matrix is returned.
+       *
+       * \see read, write_to
+       */
+      static HSSMatrix<scalar_t> read_from(std::ifstream& is);
+
       const HSSFactors<scalar_t>& ULV() { return this->ULV_; }
 
     protected:
@@ -523,6 +558,15 @@ namespace strumpack {
 
       HSSBasisID<scalar_t> U_, V_;
       DenseM_t D_, B01_, B10_;
+      bool level_ULV_ = false;
+
+      /**
+       * Tag and version of the file format of write_to/read_from,
+       * stored after the strumpack version. Version 2 added the ULV
+       * factors.
+       */
+      static constexpr int file_format_tag = 0x48535346;
+      static constexpr int file_format_version = 2;
 
       void compress_original(const DenseM_t& A,
                              const opts_t& opts);
@@ -558,7 +602,11 @@ namespace strumpack {
                                  int d0, int d, int depth,
                                  SJLTMatrix<scalar_t, int>* S=nullptr);
       bool compute_U_V_bases(DenseM_t& Sr, DenseM_t& Sc, const opts_t& opts,
-                             WorkCompress<scalar_t>& w, int d, int depth);
+                             WorkCompress<scalar_t>& w, int d, int dd,
+                             int depth);
+      bool samples_full_rank(const opts_t& opts, scalar_t& r_max_0,
+                             const DenseM_t& S, DenseM_t& Q,
+                             int d, int dd, int L, int depth);
       void compute_U_basis_stable(DenseM_t& Sr, const opts_t& opts,
                                   WorkCompress<scalar_t>& w,
                                   int d, int dd, int depth);
@@ -616,6 +664,9 @@ namespace strumpack {
       void factor_recursive(WorkFactor<scalar_t>& w,
                             bool isroot, bool partial,
                             int depth) override;
+      void factor_node(WorkFactor<scalar_t>& w,
+                       bool isroot, bool partial, int depth);
+      void factor_level(bool partial);
 
       void apply_fwd(const DenseM_t& b, WorkApply<scalar_t>& w,
                      bool isroot, int depth,
@@ -633,6 +684,71 @@ namespace strumpack {
                      bool partial, bool isroot, int depth) const override;
       void solve_bwd(DenseM_t& x, WorkSolve<scalar_t>& w,
                      bool isroot, int depth) const override;
+      void solve_fwd_node(const DenseM_t& b, WorkSolve<scalar_t>& w,
+                          bool partial, bool isroot, int depth) const;
+      void solve_bwd_node(DenseM_t& x, WorkSolve<scalar_t>& w,
+                          int depth) const;
+      void solve_fwd_level(const DenseM_t& b, WorkSolve<scalar_t>& w,
+                           bool partial) const;
+      void solve_bwd_level(DenseM_t& x, WorkSolve<scalar_t>& w) const;
+
+      /**
+       * Number of rows of the D in the ULV factorization of this
+       * node. This is U_rows(), except at the root, which has no U.
+       */
+      std::size_t ULV_rows() const {
+        return this->leaf() ? this->rows() :
+          child(0)->U_rank() + child(1)->U_rank();
+      }
+
+      /**
+       * The nodes of the tree rooted at h, level by level, from left
+       * to right. The children of nodes[l][i] are nodes[l+1][ch[l][i]]
+       * and nodes[l+1][ch[l][i]+1], the parent of nodes[l][i] is
+       * nodes[l-1][par[l][i]], and col[l][i] is the column offset of
+       * nodes[l][i] with respect to h.
+       */
+      template<typename H> struct TreeLevels {
+        std::vector<std::vector<H*>> nodes;
+        std::vector<std::vector<std::size_t>> ch, par, col;
+        TreeLevels(H* h) {
+          nodes.push_back({h});
+          par.push_back({0});
+          col.push_back({0});
+          for (std::size_t l=0; ; l++) {
+            std::vector<H*> n;
+            std::vector<std::size_t> p, c;
+            ch.emplace_back(nodes[l].size());
+            for (std::size_t i=0; i<nodes[l].size(); i++) {
+              auto hi = nodes[l][i];
+              ch[l][i] = n.size();
+              if (hi->leaf()) continue;
+              for (int k=0; k<2; k++) {
+                n.push_back(hi->child(k));
+                p.push_back(i);
+                c.push_back(col[l][i] + (k ? hi->child(0)->cols() : 0));
+              }
+            }
+            if (n.empty()) break;
+            nodes.push_back(std::move(n));
+            par.push_back(std::move(p));
+            col.push_back(std::move(c));
+          }
+        }
+        std::size_t levels() const { return nodes.size(); }
+      };
+      /**
+       * Low-rank part of Schur_product_direct, given VR = V1big^* R
+       * and UR = U1big^* R. The call bwd() should set Sr and Sc to
+       * the products of child(1) and child(1)^* with R, and
+       * add(op, X, Y, S) should compute S -= op(X) Y.
+       */
+      template<typename BWD, typename ADD> void
+      Schur_product_direct_low_rank
+      (const DenseM_t& Theta, const DenseM_t& DUB01, const DenseM_t& Phi,
+       const DenseM_t& ThetaVhatC_or_VhatCPhiC, const DenseM_t& R,
+       const DenseM_t& VR, const DenseM_t& UR,
+       DenseM_t& Sr, DenseM_t& Sc, const BWD& bwd, const ADD& add) const;
 
       void extract_fwd(WorkExtract<scalar_t>& w,
                        bool odiag, int depth) const override;
@@ -645,11 +761,13 @@ namespace strumpack {
       void apply_UV_big(DenseM_t& Theta, DenseM_t& Uop, DenseM_t& Phi,
                         DenseM_t& Vop,
                         const std::pair<std::size_t, std::size_t>& offset,
-                        int depth, std::atomic<long long int>& flops)
+                        const std::size_t* I, int depth,
+                        std::atomic<long long int>& flops)
         const override;
       void apply_UtVt_big(const DenseM_t& A, DenseM_t& UtA, DenseM_t& VtA,
                           const std::pair<std::size_t, std::size_t>& offset,
-                          int depth, std::atomic<long long int>& flops)
+                          const std::size_t* I, int depth,
+                          std::atomic<long long int>& flops)
         const override;
 
       void dense_recursive(DenseM_t& A, WorkDense<scalar_t>& w,
@@ -672,6 +790,7 @@ namespace strumpack {
       void write(std::ofstream& os) const override;
 
       friend class HSSMatrixMPI<scalar_t>;
+      friend class HSSApplyPlan<scalar_t>;
 
       using HSSMatrixBase<scalar_t>::child;
 
@@ -43,8 +43,13 @@ namespace strumpack {
 #pragma omp parallel if(!omp_in_parallel())
 #pragma omp single nowait
       {
-        solve_fwd(b, w, false, true, this->openmp_task_depth_);
-        solve_bwd(b, w, true, this->openmp_task_depth_);
+        if (level_ULV_) {
+          solve_fwd_level(b, w, false);
+          solve_bwd_level(b, w);
+        } else {
+          solve_fwd(b, w, false, true, this->openmp_task_depth_);
+          solve_bwd(b, w, true, this->openmp_task_depth_);
+        }
       }
     }
 
@@ -54,14 +59,330 @@ namespace strumpack {
      bool partial) const {
 #pragma omp parallel if(!omp_in_parallel())
 #pragma omp single nowait
-      solve_fwd(b, w, partial, true, this->openmp_task_depth_);
+      {
+        if (level_ULV_) solve_fwd_level(b, w, partial);
+        else solve_fwd(b, w, partial, true, this->openmp_task_depth_);
+      }
     }
 
     template<typename scalar_t> void HSSMatrix<scalar_t>::backward_solve
     (WorkSolve<scalar_t>& w, DenseMatrix<scalar_t>& b) const {
 #pragma omp parallel if(!omp_in_parallel())
 #pragma omp single nowait
-      solve_bwd(b, w, true, this->openmp_task_depth_);
+      {
+        if (level_ULV_) solve_bwd_level(b, w);
+        else solve_bwd(b, w, true, this->openmp_task_depth_);
+      }
+    }
+
+    /**
+     * Level-by-level version of solve_fwd/solve_fwd_node. The f =
+     * [ft1; y] of all nodes of a level are stored one after the other
+     * in w.lvl_f[l], where the children directly write their ft1, so
+     * f does not need to be concatenated. The y part is kept in
+     * w.lvl_f for solve_bwd_level. The small matrix products of a
+     * level are executed as batches, sorted by size.
+     */
+    template<typename scalar_t> void HSSMatrix<scalar_t>::solve_fwd_level
+    (const DenseM_t& b, WorkSolve<scalar_t>& w, bool partial) const {
+      using batch_t = BLR::BatchedGEMM<scalar_t>;
+      const int depth = this->openmp_task_depth_;
+      // execute a batch of products, and count the flops
+      auto run = [depth](batch_t& b, scalar_t alpha, scalar_t beta) {
+#if defined(STRUMPACK_COUNT_FLOPS)
+        STRUMPACK_HSS_SOLVE_FLOPS(b.run(alpha, beta, depth));
+#else
+        b.run(alpha, beta, depth);
+#endif
+      };
+      const std::size_t k = b.cols();
+      TreeLevels<const HSSMatrix<scalar_t>> tl(this);
+      const std::size_t L = tl.levels();
+      // offsets of f (U_rows x k) in w.lvl_f[l], and of s = P^t
+      // [z0; z1] (V_rows x k, or V_rank x k for a leaf) in S[l]
+      std::vector<std::vector<std::size_t>> fo(L), so(L);
+      w.lvl_f.resize(L);
+      std::vector<DenseM_t> S(L);
+      for (std::size_t l=0; l<L; l++) {
+        auto& nodes = tl.nodes[l];
+        fo[l].resize(nodes.size()+1, 0);
+        so[l].resize(nodes.size()+1, 0);
+        for (std::size_t i=0; i<nodes.size(); i++) {
+          auto h = nodes[i];
+          fo[l][i+1] = fo[l][i] + h->ULV_rows() * k;
+          so[l][i+1] = so[l][i] +
+            (h->leaf() ? h->V_rank() : h->V_rows()) * k;
+        }
+        w.lvl_f[l] = DenseM_t(fo[l].back(), 1);
+      }
+      auto f = [&](std::size_t l, std::size_t i) {
+        auto m = tl.nodes[l][i]->ULV_rows();
+        return DenseMW_t(m, k, w.lvl_f[l].data()+fo[l][i], m);
+      };
+      // the z of a node are the top V_rank rows of s
+      auto s = [&](std::size_t l, std::size_t i, bool top=false) {
+        auto h = tl.nodes[l][i];
+        auto m = h->leaf() ? h->V_rank() : h->V_rows();
+        return DenseMW_t(top ? h->V_rank() : m, k, S[l].data()+so[l][i], m);
+      };
+      for (std::size_t l=L; l-->0; ) {
+        auto& nodes = tl.nodes[l];
+        auto& ch = tl.ch[l];
+        const std::size_t n = nodes.size();
+        S[l] = DenseM_t(so[l].back(), 1);
+        // f = b for a leaf, for the other nodes the children
+        // already stored [ft1_0; ft1_1] in f
+        level_loop(0, n, this->openmp_task_depth_, [&](std::size_t i, int) {
+          auto h = nodes[i];
+          if (!h->leaf()) return;
+          auto fi = f(l, i);
+          copy(h->rows(), k, b, tl.col[l][i], 0, fi, 0, 0);
+        });
+        // f0 -= B01 z1, f1 -= B10 z0
+        batch_t b1;
+        for (std::size_t i=0; i<n; i++) {
+          auto h = nodes[i];
+          if (h->leaf()) continue;
+          auto c0u = h->child(0)->U_rank(), c1u = h->child(1)->U_rank();
+          auto fi = f(l, i);
+          DenseMW_t f0(c0u, k, fi, 0, 0), f1(c1u, k, fi, c0u, 0);
+          auto z0 = s(l+1, ch[i], true), z1 = s(l+1, ch[i]+1, true);
+          b1.add(Trans::N, Trans::N, h->B01_, z1, f0);
+          b1.add(Trans::N, Trans::N, h->B10_, z0, f1);
+        }
+        run(b1, scalar_t(-1.), scalar_t(1.));
+        if (l == 0) break;
+        // f = P^t f, copy ft1 to the f of the parent, and s = P^t
+        // [z0; z1] for the V basis
+        level_loop(0, n, this->openmp_task_depth_, [&](std::size_t i, int) {
+          auto h = nodes[i];
+          auto fi = f(l, i);
+          fi.laswp(h->U_.P(), true);
+          auto p = tl.par[l][i];
+          auto hp = tl.nodes[l-1][p];
+          auto fp = f(l-1, p);
+          std::size_t r0 = (i == tl.ch[l-1][p]) ? 0 : hp->child(0)->U_rank();
+          copy(h->U_rank(), k, fi, 0, 0, fp, r0, 0);
+          auto si = s(l, i);
+          if (h->leaf()) si.zero();
+          else {
+            auto c0v = h->child(0)->V_rank(), c1v = h->child(1)->V_rank();
+            copy(c0v, k, s(l+1, ch[i]), 0, 0, si, 0, 0);
+            copy(c1v, k, s(l+1, ch[i]+1), 0, 0, si, c0v, 0);
+            si.laswp(h->V_.P(), true);
+          }
+        });
+        // y = -E ft1 + y, with ft1 and y the top and bottom of f
+        batch_t b2;
+        for (std::size_t i=0; i<n; i++) {
+          auto h = nodes[i];
+          auto r = h->U_rank(), e = h->ULV_rows() - r;
+          if (!e) continue;
+          auto fi = f(l, i);
+          DenseMW_t ft1(r, k, fi, 0, 0), y(e, k, fi, r, 0);
+          b2.add(Trans::N, Trans::N, h->U_.E(), ft1, y);
+        }
+        run(b2, scalar_t(-1.), scalar_t(1.));
+        // y = L^{-1} y
+        level_loop(0, n, this->openmp_task_depth_, [&](std::size_t i, int d) {
+          auto h = nodes[i];
+          auto r = h->U_rank(), e = h->ULV_rows() - r;
+          if (!e) return;
+          auto fi = f(l, i);
+          DenseMW_t y(e, k, fi, r, 0);
+          trsm(Side::L, UpLo::L, Trans::N, Diag::N,
+               scalar_t(1.), h->ULV_.L_, y, d);
+          STRUMPACK_HSS_SOLVE_FLOPS
+            (trsm_flops(Side::L, scalar_t(1.), h->ULV_.L_, y));
+        });
+        // tmp = Q0^* y (U_rows x k), for the nodes with a Q
+        std::vector<std::size_t> to(n+1, 0);
+        for (std::size_t i=0; i<n; i++) {
+          auto h = nodes[i];
+          to[i+1] = to[i] +
+            ((h->ULV_rows() > h->U_rank()) ? h->ULV_rows() * k : 0);
+        }
+        DenseM_t T(to[n], 1);
+        T.zero();
+        std::vector<DenseMW_t> tmp(n);
+        for (std::size_t i=0; i<n; i++)
+          if (to[i+1] > to[i])
+            tmp[i] = DenseMW_t(nodes[i]->ULV_rows(), k, T.data()+to[i],
+                               nodes[i]->ULV_rows());
+        // tmp = Q0^* y, z = [I E^*] s
+        batch_t b3;
+        for (std::size_t i=0; i<n; i++) {
+          auto h = nodes[i];
+          std::size_t m = h->ULV_rows(), r = h->U_rank(), e = m - r;
+          if (e) {
+            auto fi = f(l, i);
+            b3.add(Trans::C, Trans::N, m, k, e, h->ULV_.Q_.data(),
+                   h->ULV_.Q_.ld(), fi.ptr(r, 0), fi.ld(),
+                   tmp[i].data(), tmp[i].ld());
+          }
+          auto v = h->V_rank(), ve = h->V_.E().rows();
+          if (!h->leaf() && ve) {
+            auto si = s(l, i);
+            b3.add(Trans::C, Trans::N, v, k, ve, h->V_.E().data(),
+                   h->V_.E().ld(), si.ptr(v, 0), si.ld(),
+                   si.data(), si.ld());
+          }
+        }
+        run(b3, scalar_t(1.), scalar_t(1.));
+        // z = Vt0^* y + z
+        batch_t b4;
+        for (std::size_t i=0; i<n; i++) {
+          auto h = nodes[i];
+          auto r = h->U_rank(), e = h->ULV_rows() - r;
+          if (!e) continue;
+          auto fi = f(l, i);
+          DenseMW_t y(e, k, fi, r, 0);
+          auto zi = s(l, i, true);
+          b4.add(Trans::C, Trans::N, h->ULV_.Vt0_, y, zi);
+        }
+        run(b4, scalar_t(1.), scalar_t(1.));
+        // ft1 -= W1 tmp, in the f of the parent
+        batch_t b5;
+        for (std::size_t i=0; i<n; i++) {
+          auto h = nodes[i];
+          if (!tmp[i].rows()) continue;
+          auto p = tl.par[l][i];
+          auto hp = tl.nodes[l-1][p];
+          auto fp = f(l-1, p);
+          std::size_t r0 = (i == tl.ch[l-1][p]) ? 0 : hp->child(0)->U_rank();
+          DenseMW_t ft1(h->U_rank(), k, fp, r0, 0);
+          b5.add(Trans::N, Trans::N, h->ULV_.W1_, tmp[i], ft1);
+        }
+        run(b5, scalar_t(-1.), scalar_t(1.));
+        if (l+1 < L) S[l+1].clear();
+      }
+      auto f0 = f(0, 0);
+      w.x = this->ULV_.D_.solve(f0, this->ULV_.piv_, depth);
+      STRUMPACK_HSS_SOLVE_FLOPS(solve_flops(f0));
+      if (partial) {
+        // compute reduced_rhs = \hat{V}^* y_0 + V^* [z_0; z_1]
+        w.reduced_rhs = DenseM_t(this->V_rank(), k);
+        gemm(Trans::C, Trans::N, scalar_t(1.),
+             this->ULV_.Vt0_, w.x, scalar_t(0.), w.reduced_rhs, depth);
+        STRUMPACK_HSS_SOLVE_FLOPS
+          (gemm_flops(Trans::C, Trans::N, scalar_t(1.),
+                      this->ULV_.Vt0_, w.x, scalar_t(0.)));
+        if (!this->leaf()) {
+          w.reduced_rhs.add
+            (V_.applyC(vconcat(s(1, 0, true), s(1, 1, true)), depth), depth);
+          STRUMPACK_HSS_SOLVE_FLOPS
+            (V_.applyC_flops(k) + w.reduced_rhs.rows() * k);
+        }
+      }
+      w.lvl_f[0].clear();
+    }
+
+    /**
+     * Level-by-level version of solve_bwd/solve_bwd_node, after
+     * solve_fwd_level. The x of the children of a level are
+     * computed, as x_c = Q_c^* [y_c; x_i], in two batches.
+     */
+    template<typename scalar_t> void HSSMatrix<scalar_t>::solve_bwd_level
+    (DenseM_t& x, WorkSolve<scalar_t>& w) const {
+      using batch_t = BLR::BatchedGEMM<scalar_t>;
+      const int depth = this->openmp_task_depth_;
+      // execute a batch of products, and count the flops
+      auto run = [depth](batch_t& b, scalar_t alpha, scalar_t beta) {
+#if defined(STRUMPACK_COUNT_FLOPS)
+        STRUMPACK_HSS_SOLVE_FLOPS(b.run(alpha, beta, depth));
+#else
+        b.run(alpha, beta, depth);
+#endif
+      };
+      const std::size_t k = x.cols();
+      TreeLevels<const HSSMatrix<scalar_t>> tl(this);
+      const std::size_t L = tl.levels();
+      assert(w.lvl_f.size() == L);
+      // x of the nodes of the current level, and of their children
+      DenseM_t X(w.x), Xc;
+      std::vector<std::size_t> xo(1, 0), xco;
+      for (std::size_t l=0; l<L; l++) {
+        auto& nodes = tl.nodes[l];
+        auto& ch = tl.ch[l];
+        const std::size_t n = nodes.size();
+        auto xi = [&](std::size_t i) {
+          auto m = nodes[i]->ULV_rows();
+          return DenseMW_t(m, k, X.data()+xo[i], m);
+        };
+        std::size_t nc = 0;
+        if (l+1 < L) {
+          auto& cnodes = tl.nodes[l+1];
+          nc = cnodes.size();
+          xco.assign(nc+1, 0);
+          for (std::size_t j=0; j<nc; j++)
+            xco[j+1] = xco[j] + cnodes[j]->ULV_rows() * k;
+          Xc = DenseM_t(xco.back(), 1);
+        }
+        auto xc = [&](std::size_t j) {
+          auto m = tl.nodes[l+1][j]->ULV_rows();
+          return DenseMW_t(m, k, Xc.data()+xco[j], m);
+        };
+        // y_c is stored below ft1_c in f_c, from solve_fwd_level
+        std::size_t fo = 0;
+        std::vector<std::size_t> yo(nc);
+        for (std::size_t j=0; j<nc; j++) {
+          auto h = tl.nodes[l+1][j];
+          yo[j] = fo + h->U_rank();
+          fo += h->ULV_rows() * k;
+        }
+        auto yc = [&](std::size_t j) {
+          auto h = tl.nodes[l+1][j];
+          return DenseMW_t(h->ULV_rows()-h->U_rank(), k,
+                           w.lvl_f[l+1].data()+yo[j], h->ULV_rows());
+        };
+        // leafs copy x to the solution, the children of other nodes
+        // without a Q simply take their part of x
+        level_loop(0, n, this->openmp_task_depth_, [&](std::size_t i, int) {
+          auto h = nodes[i];
+          auto x_i = xi(i);
+          if (h->leaf()) {
+            copy(x_i, x, tl.col[l][i], 0);
+            return;
+          }
+          for (int c=0; c<2; c++) {
+            auto hc = h->child(c);
+            if (hc->ULV_rows() > hc->U_rank()) continue;
+            auto r0 = c ? h->child(0)->U_rank() : 0;
+            auto x_c = xc(ch[i]+c);
+            copy(hc->U_rank(), k, x_i, r0, 0, x_c, 0, 0);
+          }
+        });
+        // x_c = Q_c^* [y_c; x_c] = Q_c0^* y_c + Q_c1^* x_c
+        batch_t b1, b2;
+        for (std::size_t i=0; i<n; i++) {
+          auto h = nodes[i];
+          if (h->leaf()) continue;
+          auto x_i = xi(i);
+          for (int c=0; c<2; c++) {
+            auto hc = h->child(c);
+            std::size_t m = hc->ULV_rows(), r = hc->U_rank(), e = m - r;
+            if (!e) continue;
+            auto j = ch[i] + c;
+            auto& Q = hc->ULV_.Q_;
+            auto x_c = xc(j);
+            auto y_c = yc(j);
+            auto r0 = c ? h->child(0)->U_rank() : 0;
+            b1.add(Trans::C, Trans::N, m, k, e, Q.data(), Q.ld(),
+                   y_c.data(), y_c.ld(), x_c.data(), x_c.ld());
+            b2.add(Trans::C, Trans::N, m, k, r, Q.ptr(e, 0), Q.ld(),
+                   x_i.ptr(r0, 0), x_i.ld(), x_c.data(), x_c.ld());
+          }
+        }
+        run(b1, scalar_t(1.), scalar_t(0.));
+        run(b2, scalar_t(1.), scalar_t(1.));
+        w.lvl_f[l].clear();
+        if (l+1 < L) {
+          X = std::move(Xc);
+          xo = std::move(xco);
+        }
+      }
+      w.lvl_f.clear();
+      w.x.clear();
     }
 
     // have this routine return ft1, or x at the root!!!
@@ -69,10 +390,7 @@ namespace strumpack {
     template<typename scalar_t> void HSSMatrix<scalar_t>::solve_fwd
     (const DenseMatrix<scalar_t>& b, WorkSolve<scalar_t>& w,
      bool partial, bool isroot, int depth) const {
-      DenseM_t f;
-      if (this->leaf())
-        f = DenseM_t(this->rows(), b.cols(), b, w.offset.second, 0);
-      else {
+      if (!this->leaf()) {
         w.c.resize(2);
         w.c[0].offset = w.offset;
         w.c[1].offset = w.offset + child(0)->dims();
@@ -85,6 +403,17 @@ namespace strumpack {
   final(depth >= params::task_recursion_cutoff_level-1) mergeable
         child(1)->solve_fwd(b, w.c[1], partial, false, depth+1);
 #pragma omp taskwait
+      }
+      solve_fwd_node(b, w, partial, isroot, depth);
+    }
+
+    template<typename scalar_t> void HSSMatrix<scalar_t>::solve_fwd_node
+    (const DenseMatrix<scalar_t>& b, WorkSolve<scalar_t>& w,
+     bool partial, bool isroot, int depth) const {
+      DenseM_t f;
+      if (this->leaf())
+        f = DenseM_t(this->rows(), b.cols(), b, w.offset.second, 0);
+      else {
         DenseM_t& f0 = w.c[0].ft1;
         DenseM_t& f1 = w.c[1].ft1;
         gemm(Trans::N, Trans::N, scalar_t(-1.),
@@ -199,6 +528,22 @@ namespace strumpack {
     template<typename scalar_t> void HSSMatrix<scalar_t>::solve_bwd
     (DenseMatrix<scalar_t>& x, WorkSolve<scalar_t>& w,
      bool isroot, int depth) const {
+      solve_bwd_node(x, w, depth);
+      if (!this->leaf()) {
+#pragma omp task default(shared)                                        \
+  if(depth < params::task_recursion_cutoff_level)                       \
+  final(depth >= params::task_recursion_cutoff_level-1) mergeable
+        child(0)->solve_bwd(x, w.c[0], false, depth+1);
+#pragma omp task default(shared)                                        \
+  if(depth < params::task_recursion_cutoff_level)                       \
+  final(depth >= params::task_recursion_cutoff_level-1) mergeable
+        child(1)->solve_bwd(x, w.c[1], false, depth+1);
+#pragma omp taskwait
+      }
+    }
+
+    template<typename scalar_t> void HSSMatrix<scalar_t>::solve_bwd_node
+    (DenseMatrix<scalar_t>& x, WorkSolve<scalar_t>& w, int depth) const {
       if (this->leaf()) copy(w.x, x.ptr(w.offset.second, 0), x.ld());
       else {
         w.c[0].x = DenseM_t(child(0)->U_rows(), x.cols());
@@ -225,15 +570,6 @@ namespace strumpack {
         w.x.clear();
         w.c[0].y.clear();
         w.c[1].y.clear();
-#pragma omp task default(shared)                                        \
-  if(depth < params::task_recursion_cutoff_level)                       \
-  final(depth >= params::task_recursion_cutoff_level-1) mergeable
-        child(0)->solve_bwd(x, w.c[0], false, depth+1);
-#pragma omp task default(shared)                                        \
-  if(depth < params::task_recursion_cutoff_level)                       \
-  final(depth >= params::task_recursion_cutoff_level-1) mergeable
-        child(1)->solve_bwd(x, w.c[1], false, depth+1);
-#pragma omp taskwait
       }
     }
 
@@ -637,7 +637,8 @@ namespace strumpack {
 #pragma omp parallel
 #pragma omp single nowait
       apply_UV_big
-        (Theta.sub, sUop, Phi.sub, sVop, offset, openmp_task_depth_, UVflops);
+        (Theta.sub, sUop, Phi.sub, sVop, offset, nullptr,
+         openmp_task_depth_, UVflops);
       flops += UVflops.load();
     }
 
@@ -433,12 +433,12 @@ namespace strumpack {
       virtual void apply_UV_big(DenseM_t& Theta, DenseM_t& Uop,
                                 DenseM_t& Phi, DenseM_t& Vop,
                                 const std::pair<std::size_t,std::size_t>& offset,
-                                int depth,
+                                const std::size_t* I, int depth,
                                 std::atomic<long long int>& flops) const {}
       virtual void apply_UtVt_big(const DenseM_t& A, DenseM_t& UtA,
                                   DenseM_t& VtA,
                                   const std::pair<std::size_t, std::size_t>& offset,
-                                  int depth,
+                                  const std::size_t* I, int depth,
                                   std::atomic<long long int>& flops) const {}
 
       virtual void dense_recursive(DenseM_t& A, WorkDense<scalar_t>& w,
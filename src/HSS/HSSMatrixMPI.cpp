@@ -106,6 +106,8 @@ namespace strumpack {
       timer.start();
       auto t = binary_tree_clustering
         (opts.clustering_algorithm(), K.data(), K.permutation(), opts.leaf_size());
+      K.tree() = t;
+      K.update_norms();
       if (opts.verbose() && Comm().is_root())
         std::cout << "# clustering (" << get_name(opts.clustering_algorithm())
                   << ") time = " << timer.elapsed() << std::endl;
@@ -603,6 +605,16 @@ namespace strumpack {
         (ranges_, dist, sub, leaf, grid_local(), Comm());
     }
 
+    template<typename scalar_t> void HSSMatrixMPI<scalar_t>::to_block_row
+    (const DistM_t& A, DenseM_t& sub_A, DistM_t& leaf_A,
+     const DistM_t& B, DenseM_t& sub_B, DistM_t& leaf_B) const {
+      if (!this->active()) return;
+      assert(std::size_t(A.rows())==this->cols());
+      BC2BR::block_cyclic_to_block_row<scalar_t>
+        (ranges_, {&A, &B}, {&sub_A, &sub_B}, {&leaf_A, &leaf_B},
+         grid_local(), Comm());
+    }
+
     template<typename scalar_t> void
     HSSMatrixMPI<scalar_t>::allocate_block_row
     (int d, DenseM_t& sub, DistM_t& leaf) const {
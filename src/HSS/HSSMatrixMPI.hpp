@@ -197,6 +197,9 @@ namespace strumpack {
       void to_block_row(const DistM_t& A,
                         DenseM_t& sub_A,
                         DistM_t& leaf_A) const override;
+      void to_block_row(const DistM_t& A, DenseM_t& sub_A, DistM_t& leaf_A,
+                        const DistM_t& B, DenseM_t& sub_B,
+                        DistM_t& leaf_B) const;
       void allocate_block_row(int d, DenseM_t& sub_A,
                               DistM_t& leaf_A) const override;
       void from_block_row(DistM_t& A,
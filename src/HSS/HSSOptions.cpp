@@ -97,6 +97,10 @@ namespace strumpack {
          {"hss_enable_sync",           no_argument, 0, 19},
          {"hss_disable_sync",          no_argument, 0, 20},
          {"hss_log_ranks",             no_argument, 0, 21},
+         {"hss_enable_level_ULV",      no_argument, 0, 22},
+         {"hss_disable_level_ULV",     no_argument, 0, 23},
+         {"hss_enable_indexed_random", no_argument, 0, 24},
+         {"hss_disable_indexed_random", no_argument, 0, 25},
          {"hss_verbose",               no_argument, 0, 'v'},
          {"hss_quiet",                 no_argument, 0, 'q'},
          {"help",                      no_argument, 0, 'h'},
@@ -167,9 +171,12 @@ namespace strumpack {
             set_random_engine(random::RandomEngine::LINEAR);
           else if (s.compare("mersenne") == 0)
             set_random_engine(random::RandomEngine::MERSENNE);
+          else if (s.compare("philox") == 0)
+            set_random_engine(random::RandomEngine::PHILOX);
           else
             std::cerr << "# WARNING: random number engine not recognized,"
-                      << " use 'linear' or 'mersenne'." << std::endl;
+                      << " use 'linear', 'mersenne' or 'philox'."
+                      << std::endl;
         } break;
         case 12: {
           std::istringstream iss(optarg);
@@ -228,6 +235,10 @@ namespace strumpack {
         case 19: { set_synchronized_compression(true); } break;
         case 20: { set_synchronized_compression(false); } break;
         case 21: { set_log_ranks(true); } break;
+        case 22: { set_level_ULV(true); } break;
+        case 23: { set_level_ULV(false); } break;
+        case 24: { set_indexed_random(true); } break;
+        case 25: { set_indexed_random(false); } break;
         case 'v': this->set_verbose(true); break;
         case 'q': this->set_verbose(false); break;
         case 'h': describe_options(); break;
@@ -259,7 +270,7 @@ namespace strumpack {
                 << this->max_rank() << ")" << std::endl
                 << "#   --hss_random_distribution normal|uniform (default "
                 << get_name(random_distribution()) << ")" << std::endl
-                << "#   --hss_random_engine linear|mersenne (default "
+                << "#   --hss_random_engine linear|mersenne|philox (default "
                 << get_name(random_engine()) << ")" << std::endl
                 << "#   --hss_compression_algorithm original|stable|hard_restart (default "
                 << get_name(compression_algorithm()) << ")" << std::endl
@@ -281,6 +292,14 @@ namespace strumpack {
                 << (!synchronized_compression()) << ")" << std::endl
                 << "#   --hss_log_ranks (default "
                 << log_ranks() << ")" << std::endl
+                << "#   --hss_enable_level_ULV (default "
+                << level_ULV() << ")" << std::endl
+                << "#   --hss_disable_level_ULV (default "
+                << (!level_ULV()) << ")" << std::endl
+                << "#   --hss_enable_indexed_random (default "
+                << indexed_random() << ")" << std::endl
+                << "#   --hss_disable_indexed_random (default "
+                << (!indexed_random()) << ")" << std::endl
                 << "#   --hss_verbose or -v (default "
                 << this->verbose() << ")" << std::endl
                 << "#   --hss_quiet or -q (default "
@@ -220,6 +220,23 @@ namespace strumpack {
         random_distribution_ = random_distribution;
       }
 
+      /**
+       * Set this to true to generate the random vectors of the
+       * distributed (MPI) randomized compression from the global
+       * element indices. The random vectors are then generated
+       * directly in both the 2D block-cyclic and the HSS block-row
+       * layouts, and do not need to be redistributed, and they do
+       * not depend on the process grid. The random samples are still
+       * computed in the 2D layout and redistributed. This changes
+       * the random vectors, compared to the default. It is ignored
+       * for the mersenne random engine, for which reseeding is too
+       * expensive.
+       * \see set_random_engine()
+       */
+      void set_indexed_random(bool indexed_random) {
+        indexed_random_ = indexed_random;
+      }
+
       /**
        * Specify the variant of the adaptive compression
        * algorithm. See the manual for more information.
@@ -299,6 +316,19 @@ namespace strumpack {
         sync_ = sync;
       }
 
+      /**
+       * Set this to true to compute the ULV factorization, and the
+       * corresponding solves, level by level, from the leafs up,
+       * instead of recursively. The data of all nodes in a level is
+       * stored in contiguous per-level workspaces, and the small
+       * products of a level are done as a single batch, which is
+       * more efficient for HSS trees with many small nodes. The
+       * option has to be set before the HSS matrix is constructed.
+       */
+      void set_level_ULV(bool level_ULV) {
+        level_ULV_ = level_ULV;
+      }
+
       /**
        * Log the HSS ranks to a file. TODO is this currently
        * supported??
@@ -426,6 +456,15 @@ namespace strumpack {
        */
       bool user_defined_random() const { return user_defined_random_; }
 
+      /**
+       * Whether or not to generate the random vectors of the
+       * distributed compression from the global element indices.
+       * \return True if the random vectors are generated from the
+       * global element indices
+       * \see set_indexed_random
+       */
+      bool indexed_random() const { return indexed_random_; }
+
       /**
        * Whether or not the synchronize the element extraction
        * routine.
@@ -435,6 +474,14 @@ namespace strumpack {
        */
       bool synchronized_compression() const { return sync_; }
 
+      /**
+       * Whether or not to compute the ULV factorization and solve
+       * level by level.
+       * \return True if the ULV factorization is done level by level
+       * \see set_level_ULV
+       */
+      bool level_ULV() const { return level_ULV_; }
+
       /**
        * Check if the ranks should be printed to a log file.  __NOT
        * supported currently__
@@ -472,11 +519,13 @@ namespace strumpack {
       random::RandomDistribution random_distribution_ =
         random::RandomDistribution::NORMAL;
       bool user_defined_random_ = false;
+      bool indexed_random_ = false;
       bool log_ranks_ = false;
       CompressionAlgorithm compress_algo_ = CompressionAlgorithm::STABLE;
       CompressionSketch compress_sketch_ = CompressionSketch::GAUSSIAN;
       SJLTAlgo sjlt_algo_ = SJLTAlgo::CHUNK;
       bool sync_ = false;
+      bool level_ULV_ = false;
       ClusteringAlgorithm clustering_algo_ = ClusteringAlgorithm::TWO_MEANS;
       int approximate_neighbors_ = 64;
       int ann_iterations_ = 5;
@@ -25,6 +25,8 @@
  *             (Lawrence Berkeley National Lab, Computational Research
  *             Division).
  */
+#include <fstream>
+
 #include "SparseSolverBase.hpp"
 
 #if defined(STRUMPACK_USE_PAPI)
@@ -33,6 +35,7 @@
 
 #include "misc/Tools.hpp"
 #include "misc/TaskTimer.hpp"
+#include "misc/Trace.hpp"
 #include "StrumpackOptions.hpp"
 #include "sparse/ordering/MatrixReordering.hpp"
 #include "sparse/EliminationTree.hpp"
@@ -117,6 +120,11 @@ namespace strumpack {
     return tree()->factor_nonzeros();
   }
 
+  template<typename scalar_t,typename integer_t> std::vector<FrontStats>
+  SparseSolverBase<scalar_t,integer_t>::front_statistics() const {
+    return tree()->front_statistics();
+  }
+
   template<typename scalar_t,typename integer_t> std::size_t
   SparseSolverBase<scalar_t,integer_t>::factor_memory() const {
     return tree()->factor_nonzeros() * sizeof(scalar_t);
@@ -319,6 +327,7 @@ namespace strumpack {
    int components, int width) {
     if (!matrix()) return ReturnCode::MATRIX_NOT_SET;
     if (reordered_) return ReturnCode::SUCCESS;
+    if (!opts_.trace_file().empty()) trace::enable();
     TaskTimer t1("permute-scale");
     int ierr;
     if (opts_.verbose() && is_root_)
@@ -439,9 +448,9 @@ namespace strumpack {
         if (opts_.compression() == CompressionType::HODLR ||
             opts_.compression() == CompressionType::BLR_HODLR ||
             opts_.compression() == CompressionType::ZFP_BLR_HODLR) {
-          std::cerr << "WARNING: Compression type requires ButterflyPACK, "
-            "but STRUMPACK was not configured with ButterflyPACK support!"
-                    << std::endl;
+          std::cerr << "WARNING: STRUMPACK was not configured with "
+            "ButterflyPACK support, using the native HODLR code, which "
+            "only compresses sequential fronts!" << std::endl;
         }
 #endif
 #if !defined(STRUMPACK_USE_ZFP)
@@ -555,6 +564,11 @@ namespace strumpack {
     std::cout << "# --------------------------------------------" << std::endl << std::endl;
   }
 
+  template<typename scalar_t,typename integer_t> void
+  SparseSolverBase<scalar_t,integer_t>::write_trace() const {
+    trace::write_chrome_trace(opts_.trace_file());
+  }
+
   template<typename scalar_t,typename integer_t> ReturnCode
   SparseSolverBase<scalar_t,integer_t>::factor() {
     if (!matrix()) return ReturnCode::MATRIX_NOT_SET;
@@ -562,7 +576,8 @@ namespace strumpack {
     if (!reordered_) {
       ReturnCode ierr = reorder();
       if (ierr != ReturnCode::SUCCESS) return ierr;
-    }
+    } else if (!opts_.trace_file().empty() && !trace::enabled())
+      trace::enable();
     float dfnnz = 0.;
     if (opts_.verbose()) {
       dfnnz = dense_factor_nonzeros();
@@ -636,7 +651,6 @@ namespace strumpack {
             std::cout << "#   - BLR absolute compression tolerance = "
                       << opts_.BLR_options().abs_tol() << std::endl;
           }
-#if defined(STRUMPACK_USE_BPACK)
           if (opts_.compression() == CompressionType::HODLR) {
             std::cout << "#   - maximum HODLR rank = " << max_rank << std::endl;
             std::cout << "#   - relative compression tolerance = "
@@ -654,8 +668,6 @@ namespace strumpack {
             std::cout << "#   - BLR absolute compression tolerance = "
                       << opts_.BLR_options().abs_tol() << std::endl;
           }
-#endif
-#if defined(STRUMPACK_USE_BPACK)
 #if defined(STRUMPACK_USE_ZFP)
           if (opts_.compression() == CompressionType::ZFP_BLR_HODLR) {
             std::cout << "#   - maximum HODLR rank = " << max_rank << std::endl;
@@ -669,7 +681,6 @@ namespace strumpack {
                       << opts_.BLR_options().abs_tol() << std::endl;
           }
 #endif
-#endif
 #if defined(STRUMPACK_USE_ZFP)
           if (opts_.compression() == CompressionType::LOSSY)
             std::cout << "#   - lossy compression precision = "
@@ -681,6 +692,17 @@ namespace strumpack {
       }
     }
     if (rank_out_) tree()->print_rank_statistics(*rank_out_);
+    if (!opts_.trace_file().empty()) {
+      write_trace();
+      trace::disable();
+    }
+    if (!opts_.front_stats_file().empty()) {
+      auto stats = front_statistics();
+      if (is_root_) {
+        std::ofstream f(opts_.front_stats_file());
+        FrontStats::write_csv(f, stats);
+      }
+    }
     // if (err_code == ReturnCode::SUCCESS)
     factored_ = true;
     return err_code;
@@ -42,6 +42,7 @@
 #include "StrumpackOptions.hpp"
 #include "sparse/CSRMatrix.hpp"
 #include "dense/DenseMatrix.hpp"
+#include "sparse/fronts/FrontStats.hpp"
 
 /**
  * All of STRUMPACK is contained in the strumpack namespace.
@@ -335,6 +336,18 @@ namespace strumpack {
      */
     std::size_t factor_memory() const;
 
+    /**
+     * Return performance statistics (time, flops, extend-add volume,
+     * rank, memory) for each front, sorted from most to least
+     * expensive. Call this after the factorization. For the
+     * SparseSolverMPIDist distributed memory solver, this routine is
+     * collective on the MPI communicator, and all fronts are only
+     * returned on the root process.
+     *
+     * \see SPOptions::set_front_stats_file
+     */
+    std::vector<FrontStats> front_statistics() const;
+
     /**
      * Return the number of iterations performed by the outer (Krylov)
      * iterative solver. Call this after calling the solve routine.
@@ -420,6 +433,7 @@ namespace strumpack {
     void print_solve_stats(TaskTimer& t) const;
 
     virtual void reduce_flop_counters() const {}
+    virtual void write_trace() const;
     void print_flop_breakdown_HSS() const;
     void print_flop_breakdown_HODLR() const;
     void flop_breakdown_reset() const;
@@ -27,10 +27,12 @@
  */
 #include "StrumpackSparseSolverMPIDist.hpp"
 #include "misc/TaskTimer.hpp"
+#include "misc/Trace.hpp"
 #include "sparse/EliminationTreeMPIDist.hpp"
 #include "iterative/IterativeSolversMPI.hpp"
 #include "sparse/ordering/MatrixReorderingMPI.hpp"
 #include "sparse/Redistribute.hpp"
+#include "sparse/fronts/FrontGridCache.hpp"
 
 namespace strumpack {
 
@@ -50,7 +52,8 @@ namespace strumpack {
   SparseSolverMPIDist
   (MPI_Comm comm, int argc, char* argv[], bool verbose) :
     SparseSolverBase<scalar_t,integer_t>
-    (argc, argv, verbose, !mpi_rank(comm)), comm_(comm) {
+    (argc, argv, verbose, !mpi_rank(comm)), comm_(comm),
+    grids_(new FrontGridCache(comm_)) {
     if (opts_.verbose() && is_root_)
       std::cout << "# using " << comm_.size()
                 << " MPI processes" << std::endl;
@@ -229,11 +232,11 @@ namespace strumpack {
       auto shifted_mat = mat_mpi_->add_missing_diagonal(opts_.pivot_threshold());
       tree_mpi_dist_.reset
         (new EliminationTreeMPIDist<scalar_t,integer_t>
-         (opts_, *shifted_mat, *nd_mpi_, comm_));
+         (opts_, *shifted_mat, *nd_mpi_, comm_, grids_.get()));
     } else
       tree_mpi_dist_.reset
         (new EliminationTreeMPIDist<scalar_t,integer_t>
-         (opts_, *mat_mpi_, *nd_mpi_, comm_));
+         (opts_, *mat_mpi_, *nd_mpi_, comm_, grids_.get()));
   }
 
   template<typename scalar_t,typename integer_t> ReturnCode
@@ -435,6 +438,11 @@ namespace strumpack {
     }
   }
 
+  template<typename scalar_t,typename integer_t> void
+  SparseSolverMPIDist<scalar_t,integer_t>::write_trace() const {
+    trace::write_chrome_trace(opts_.trace_file(), comm_.comm());
+  }
+
   template<typename scalar_t,typename integer_t> void
   SparseSolverMPIDist<scalar_t,integer_t>::
   reduce_flop_counters() const {
@@ -185,6 +185,12 @@ namespace strumpack {
        {"sp_proportional_mapping",      required_argument, 0, 50},
        {"sp_enable_openmp_tree",        no_argument, 0, 51},
        {"sp_disable_openmp_tree",       no_argument, 0, 52},
+       {"sp_trace",                     required_argument, 0, 53},
+       {"sp_front_stats",               required_argument, 0, 54},
+       {"sp_dense_tile_size",           required_argument, 0, 55},
+       {"sp_dense_tiled_min_sep_size",  required_argument, 0, 56},
+       {"sp_enable_lossy_cb",           no_argument, 0, 57},
+       {"sp_disable_lossy_cb",          no_argument, 0, 58},
        {"sp_verbose",                   no_argument, 0, 'v'},
        {"sp_quiet",                     no_argument, 0, 'q'},
        {"help",                         no_argument, 0, 'h'},
@@ -428,6 +434,20 @@ namespace strumpack {
       } break;
       case 51: enable_openmp_tree(); break;
       case 52: disable_openmp_tree(); break;
+      case 53: set_trace_file(optarg); break;
+      case 54: set_front_stats_file(optarg); break;
+      case 55: {
+        std::istringstream iss(optarg);
+        iss >> dense_tile_size_;
+        set_dense_tile_size(dense_tile_size_);
+      } break;
+      case 56: {
+        std::istringstream iss(optarg);
+        iss >> dense_tiled_min_sep_;
+        set_dense_tiled_min_sep_size(dense_tiled_min_sep_);
+      } break;
+      case 57: enable_lossy_CB(); break;
+      case 58: disable_lossy_CB(); break;
       case 'h': { describe_options(); } break;
       case 'v': set_verbose(true); break;
       case 'q': set_verbose(false); break;
@@ -441,9 +461,7 @@ namespace strumpack {
     //             << std::endl;
     HSS_options().set_from_command_line(argc, cargv);
     BLR_options().set_from_command_line(argc, cargv);
-#if defined(STRUMPACK_USE_BPACK)
     HODLR_options().set_from_command_line(argc, cargv);
-#endif
     // ND_options().set_from_command_line(argc, cargv);
 #else
     std::cerr << "WARNING: no support for getopt.h, "
@@ -551,6 +569,20 @@ namespace strumpack {
     std::cout << "#   --sp_disable_replace_tiny_pivots" << std::endl;
     std::cout << "#   --sp_write_root_front" << std::endl;
     std::cout << "#   --sp_print_compressed_front_stats" << std::endl;
+    std::cout << "#   --sp_trace file" << std::endl
+              << "#          write a Chrome trace of the factorization"
+              << std::endl;
+    std::cout << "#   --sp_front_stats file" << std::endl
+              << "#          write per front statistics as CSV"
+              << std::endl;
+    std::cout << "#   --sp_dense_tile_size (default "
+              << dense_tile_size() << ")" << std::endl
+              << "#          tile size for the tiled dense LU"
+              << std::endl;
+    std::cout << "#   --sp_dense_tiled_min_sep_size (default "
+              << dense_tiled_min_sep_size() << ")" << std::endl
+              << "#          minimum separator size for the tiled dense LU"
+              << std::endl;
     std::cout << "#   --sp_proportional_mapping (default "
               << get_name(prop_map_) << ")" << std::endl
               << "#          should be [FLOPS|FACTOR_MEMORY|PEAK_MEMORY]" << std::endl
@@ -577,6 +609,11 @@ namespace strumpack {
               << lossy_accuracy() << ")" << std::endl
               << "#          lossy compression accuracy" << std::endl
               << "#          (for precision mode, set < 0)" << std::endl;
+    std::cout << "#   --sp_enable_lossy_cb (default "
+              << std::boolalpha << lossy_CB() << ")" << std::endl
+              << "#          also compress the contribution blocks" << std::endl;
+    std::cout << "#   --sp_disable_lossy_cb (default "
+              << std::boolalpha << !lossy_CB() << ")" << std::endl;
     std::cout << "#   --sp_hss_min_sep_size (default "
               << hss_min_sep_size() << ")" << std::endl
               << "#          minimum separator size for hss compression"
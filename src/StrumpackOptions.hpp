@@ -33,6 +33,7 @@
 #define SPOPTIONS_HPP
 
 #include <limits>
+#include <string>
 #include <cstdlib>
 
 #include "dense/BLASLAPACKWrapper.hpp"
@@ -789,6 +790,31 @@ namespace strumpack {
      */
     void disable_openmp_tree() { use_openmp_tree_ = false; }
 
+    /**
+     * Set the tile size for the tiled, task based, dense LU
+     * factorization of large dense fronts.
+     *
+     * \see set_dense_tiled_min_sep_size, LU_tiled
+     */
+    void set_dense_tile_size(int nb) {
+      assert(nb > 0);
+      dense_tile_size_ = nb;
+    }
+
+    /**
+     * Set the minimum separator size for which the dense (not
+     * compressed) fronts are factored with a tiled LU, with the
+     * panel factorizations, the triangular solves and the Schur
+     * complement update all in a single task graph. Smaller fronts
+     * use recursive task based dense linear algebra.
+     *
+     * \see set_dense_tile_size, LU_tiled
+     */
+    void set_dense_tiled_min_sep_size(int s) {
+      assert(s >= 0);
+      dense_tiled_min_sep_ = s;
+    }
+
     /**
      * Set the precision for lossy compression. Preferred mode is
      * accuracy. To use precision mode, set the accuracy to a negative
@@ -808,12 +834,55 @@ namespace strumpack {
      */
     void set_lossy_accuracy(double a) { lossy_accuracy_ = a; }
 
+    /**
+     * With lossy (or lossless) compression, also compress the
+     * contribution block of a front after its factorization, while
+     * it waits to be assembled in the parent front. It is
+     * decompressed again in the extend-add to the parent. This
+     * reduces the peak memory of the factorization. Only used when
+     * the parent front is also lossy compressed.
+     *
+     * \see set_lossy_precision, set_lossy_accuracy
+     */
+    void enable_lossy_CB() { lossy_CB_ = true; }
+
+    /**
+     * Do not compress the contribution blocks of lossy compressed
+     * fronts, see enable_lossy_CB. This is the default.
+     */
+    void disable_lossy_CB() { lossy_CB_ = false; }
+
     /**
      * Print statistics, about ranks, memory etc, for the root front
      * only.
      */
     void set_print_compressed_front_stats(bool b) { print_comp_front_stats_ = b; }
 
+    /**
+     * Record a trace of the reordering and the numerical
+     * factorization, with an event per front, and write it to the
+     * given file, in the Chrome trace event JSON format, at the end
+     * of the factorization. This can be viewed in chrome://tracing or
+     * https://ui.perfetto.dev. An empty string (the default, unless
+     * the environment variable STRUMPACK_TRACE is set) disables
+     * tracing.
+     *
+     * \see trace::write_chrome_trace
+     */
+    void set_trace_file(const std::string& f) { trace_file_ = f; }
+
+    /**
+     * Write statistics for each front (time for assembly, factor and
+     * Schur update, flops, extend-add volume, rank, memory), sorted
+     * by time, as CSV to the given file after the factorization. An
+     * empty string (the default) disables this.
+     *
+     * \see SparseSolverBase::front_statistics
+     */
+    void set_front_stats_file(const std::string& f) {
+      front_stats_file_ = f;
+    }
+
     /**
      * Set the type of proportional mapping.
      */
@@ -1186,6 +1255,18 @@ namespace strumpack {
      */
     bool use_openmp_tree() const { return use_openmp_tree_; }
 
+    /**
+     * Tile size for the tiled dense LU factorization.
+     * \see set_dense_tile_size
+     */
+    int dense_tile_size() const { return dense_tile_size_; }
+
+    /**
+     * Minimum separator size to use the tiled dense LU factorization.
+     * \see set_dense_tiled_min_sep_size
+     */
+    int dense_tiled_min_sep_size() const { return dense_tiled_min_sep_; }
+
     /**
      * Returns the number of GPU streams to use.
      */
@@ -1212,12 +1293,33 @@ namespace strumpack {
         -1 : lossy_accuracy_;
     }
 
+    /**
+     * Compress the contribution blocks of lossy compressed fronts?
+     * \see enable_lossy_CB
+     */
+    bool lossy_CB() const { return lossy_CB_; }
+
     /**
      * Info about the stats of the root front will be printed to
      * std::cout
      */
     bool print_compressed_front_stats() const { return print_comp_front_stats_; }
 
+    /**
+     * File to write the trace of the factorization to, empty if
+     * tracing is disabled.
+     * \see set_trace_file
+     */
+    const std::string& trace_file() const { return trace_file_; }
+
+    /**
+     * File to write the per front statistics to, empty if disabled.
+     * \see set_front_stats_file
+     */
+    const std::string& front_stats_file() const {
+      return front_stats_file_;
+    }
+
     /**
      * Get the type of proportional mapping to be used.
      */
@@ -1325,8 +1427,13 @@ namespace strumpack {
     real_t pivot_ = std::sqrt(blas::lamch<real_t>('E'));
     bool write_root_front_ = false;
     bool print_comp_front_stats_ = false;
+    std::string trace_file_ = std::getenv("STRUMPACK_TRACE") ?
+      std::getenv("STRUMPACK_TRACE") : "";
+    std::string front_stats_file_;
     ProportionalMapping prop_map_ = ProportionalMapping::FLOPS;
     bool use_openmp_tree_ = true;
+    int dense_tile_size_ = 256;
+    int dense_tiled_min_sep_ = 2048;
     bool use_symmetric_ = false;
     bool use_positive_definite_ = false;
 
@@ -1364,6 +1471,7 @@ namespace strumpack {
     int lossy_min_sep_size_ = 8;
     int lossy_precision_ = 16;
     double lossy_accuracy_ = 1e-3;
+    bool lossy_CB_ = false;
 
     // ordering::NDOptions nd_opts_;
 
@@ -42,6 +42,7 @@ namespace strumpack {
 
   // forward declarations
   template<typename scalar_t,typename integer_t> class MatrixReorderingMPI;
+  class FrontGridCache;
 
   /**
    * \class SparseSolverMPIDist
@@ -312,6 +313,7 @@ namespace strumpack {
     void perf_counters_stop(const std::string& s) override;
     void synchronize() override { comm_.barrier(); }
     void reduce_flop_counters() const override;
+    void write_trace() const override;
 
     double max_peak_memory() const override {
       return comm_.reduce(double(params::peak_memory), MPI_MAX);
@@ -337,6 +339,9 @@ namespace strumpack {
 
     std::unique_ptr<CSRMatrixMPI<scalar_t,integer_t>> mat_mpi_;
     std::unique_ptr<MatrixReorderingMPI<scalar_t,integer_t>> nd_mpi_;
+    // communicators/grids for the distributed fronts, kept across
+    // symbolic factorizations
+    std::unique_ptr<FrontGridCache> grids_;
     std::unique_ptr<EliminationTreeMPIDist<scalar_t,integer_t>> tree_mpi_dist_;
   };
 
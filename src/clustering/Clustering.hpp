@@ -96,12 +96,14 @@ namespace strumpack {
 
 
   template<typename T> void
-  pca_partition(DenseMatrix<T>& p, std::vector<std::size_t>& nc, int* perm);
+  pca_partition(DenseMatrix<T>& p, std::vector<std::size_t>& nc, int* perm,
+                int depth=0);
   template<typename T> structured::ClusterTree
   recursive_pca(DenseMatrix<T>& p, std::size_t cluster_size, int* perm);
 
   template<typename T> void
-  cobble_partition(DenseMatrix<T>& p, std::vector<std::size_t>& nc, int* perm);
+  cobble_partition(DenseMatrix<T>& p, std::vector<std::size_t>& nc, int* perm,
+                   int depth=0);
   template<typename T> structured::ClusterTree
   recursive_cobble(DenseMatrix<T>& p, std::size_t cluster_size, int* perm);
 
@@ -111,7 +113,7 @@ namespace strumpack {
 
   template<typename T> void
   kd_partition(DenseMatrix<T>& p, std::vector<std::size_t>& nc,
-               std::size_t cluster_size, int* perm);
+               std::size_t cluster_size, int* perm, int depth=0);
   template<typename T> structured::ClusterTree
   recursive_kd(DenseMatrix<T>& p, std::size_t cluster_size, int* perm);
 
@@ -30,37 +30,59 @@
 
 #include "Clustering.hpp"
 #include "kernel/Metrics.hpp"
+#include "StrumpackParameters.hpp"
 
 namespace strumpack {
 
   template<typename scalar_t> void cobble_partition
-  (DenseMatrix<scalar_t>& p, std::vector<std::size_t>& nc, int* perm) {
+  (DenseMatrix<scalar_t>& p, std::vector<std::size_t>& nc, int* perm,
+   int depth) {
     using real_t = scalar_t;
     auto d = p.rows();
     auto n = p.cols();
-    // find centroid
+    // find centroid, first partial sums per block of points
+    const std::size_t B = 4096, nb = (n + B - 1) / B;
+    DenseMatrix<scalar_t> bsum(d, nb);
+#if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
+#pragma omp taskloop default(shared)                    \
+  if(depth < params::task_recursion_cutoff_level)
+#endif
+    for (std::size_t b=0; b<nb; b++) {
+      auto bs = bsum.ptr(0, b);
+      std::fill(bs, bs+d, scalar_t(0.));
+      for (std::size_t i=b*B; i<std::min(n, (b+1)*B); i++) {
+        auto pi = p.ptr(0, i);
+        for (std::size_t j=0; j<d; j++)
+          bs[j] += pi[j];
+      }
+    }
     std::vector<scalar_t> centroid(d);
-    for (std::size_t i=0; i<n; i++)
+    for (std::size_t b=0; b<nb; b++)
       for (std::size_t j=0; j<d; j++)
-        centroid[j] += p(j, i);
+        centroid[j] += bsum(j, b);
     for (std::size_t j=0; j<d; j++)
       centroid[j] /= n;
 
     // find farthest point from centroid
-    std::size_t first_index = 0;
-    real_t max_dist(-1);
-    for (std::size_t i=0; i<n; i++) {
-      auto dd = Euclidean_distance(d, p.ptr(0, i), centroid.data());
-      if (dd > max_dist) {
-        max_dist = dd;
-        first_index = i;
-      }
-    }
+    std::vector<real_t> dists(n);
+#if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
+#pragma omp taskloop default(shared) grainsize(4096)    \
+  if(depth < params::task_recursion_cutoff_level)
+#endif
+    for (std::size_t i=0; i<n; i++)
+      dists[i] = Euclidean_distance_squared
+        (d, p.ptr(0, i), centroid.data());
+    std::size_t first_index =
+      std::max_element(dists.begin(), dists.end()) - dists.begin();
 
     // compute and sort distance from the firsth point
-    std::vector<real_t> dists(n);
+#if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
+#pragma omp taskloop default(shared) grainsize(4096)    \
+  if(depth < params::task_recursion_cutoff_level)
+#endif
     for (std::size_t i=0; i<n; i++)
-      dists[i] = Euclidean_distance(d, p.ptr(0, i), p.ptr(0, first_index));
+      dists[i] = Euclidean_distance_squared
+        (d, p.ptr(0, i), p.ptr(0, first_index));
 
     std::vector<std::size_t> idx(n);
     std::iota(idx.begin(), idx.end(), 0);
@@ -94,30 +116,50 @@ namespace strumpack {
     }
   }
 
-  template<typename scalar_t> structured::ClusterTree recursive_cobble
-  (DenseMatrix<scalar_t>& p, std::size_t cluster_size, int* perm) {
+  template<typename scalar_t> structured::ClusterTree recursive_cobble_rec
+  (DenseMatrix<scalar_t>& p, std::size_t cluster_size, int* perm,
+   int depth) {
     auto n = p.cols();
     structured::ClusterTree tree(n);
     if (n < cluster_size) return tree;
     std::vector<std::size_t> nc(2);
-    cobble_partition(p, nc, perm);
+    cobble_partition(p, nc, perm, depth);
     if (!nc[0] || !nc[1]) return tree;
     tree.c.resize(2);
     tree.c[0].size = nc[0];
     tree.c[1].size = nc[1];
     DenseMatrixWrapper<scalar_t> p0(p.rows(), nc[0], p, 0, 0);
-    tree.c[0] = recursive_cobble(p0, cluster_size, perm);
     DenseMatrixWrapper<scalar_t> p1(p.rows(), nc[1], p, 0, nc[0]);
-    tree.c[1] = recursive_cobble(p1, cluster_size, perm+nc[0]);
+#pragma omp task default(shared)                                        \
+  if(depth < params::task_recursion_cutoff_level)                       \
+  final(depth >= params::task_recursion_cutoff_level-1) mergeable
+    tree.c[0] = recursive_cobble_rec(p0, cluster_size, perm, depth+1);
+#pragma omp task default(shared)                                        \
+  if(depth < params::task_recursion_cutoff_level)                       \
+  final(depth >= params::task_recursion_cutoff_level-1) mergeable
+    tree.c[1] = recursive_cobble_rec
+      (p1, cluster_size, perm+nc[0], depth+1);
+#pragma omp taskwait
+    return tree;
+  }
+
+  template<typename scalar_t> structured::ClusterTree recursive_cobble
+  (DenseMatrix<scalar_t>& p, std::size_t cluster_size, int* perm) {
+    structured::ClusterTree tree;
+#pragma omp parallel if(!omp_in_parallel())
+#pragma omp single nowait
+    tree = recursive_cobble_rec(p, cluster_size, perm, 0);
     return tree;
   }
 
 
   // explicit template instantiation (only for real types!)
   template void cobble_partition
-  (DenseMatrix<float>& p, std::vector<std::size_t>& nc, int* perm);
+  (DenseMatrix<float>& p, std::vector<std::size_t>& nc, int* perm,
+   int depth);
   template void cobble_partition
-  (DenseMatrix<double>& p, std::vector<std::size_t>& nc, int* perm);
+  (DenseMatrix<double>& p, std::vector<std::size_t>& nc, int* perm,
+   int depth);
 
   template structured::ClusterTree
   recursive_cobble(DenseMatrix<float>& p, std::size_t cluster_size,
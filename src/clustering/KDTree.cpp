@@ -29,22 +29,42 @@
 #include <algorithm>
 
 #include "Clustering.hpp"
+#include "StrumpackParameters.hpp"
 
 namespace strumpack {
 
   template<typename scalar_t> void kd_partition
   (DenseMatrix<scalar_t>& p, std::vector<std::size_t>& nc,
-   std::size_t cluster_size, int* perm) {
+   std::size_t cluster_size, int* perm, int depth) {
     auto n = p.cols();
     auto d = p.rows();
-    // find coordinate of the most spread
+    // find coordinate of the most spread, per block of points first
+    const std::size_t B = 4096, nb = (n + B - 1) / B;
+    DenseMatrix<scalar_t> bmaxs(d, nb), bmins(d, nb);
+#if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
+#pragma omp taskloop default(shared)                    \
+  if(depth < params::task_recursion_cutoff_level)
+#endif
+    for (std::size_t b=0; b<nb; b++) {
+      auto bmax = bmaxs.ptr(0, b);
+      auto bmin = bmins.ptr(0, b);
+      std::copy(p.ptr(0, b*B), p.ptr(0, b*B)+d, bmax);
+      std::copy(p.ptr(0, b*B), p.ptr(0, b*B)+d, bmin);
+      for (std::size_t i=b*B+1; i<std::min(n, (b+1)*B); ++i) {
+        auto pi = p.ptr(0, i);
+        for (std::size_t j=0; j<d; ++j) {
+          bmax[j] = std::max(pi[j], bmax[j]);
+          bmin[j] = std::min(pi[j], bmin[j]);
+        }
+      }
+    }
     std::vector<scalar_t> maxs(d), mins(d);
     for (std::size_t j=0; j<d; ++j)
       maxs[j] = mins[j] = p(j, 0);
-    for (std::size_t i=1; i<n; ++i)
+    for (std::size_t b=0; b<nb; ++b)
       for (std::size_t j=0; j<d; ++j) {
-        maxs[j] = std::max(p(j, i), maxs[j]);
-        mins[j] = std::min(p(j, i), mins[j]);
+        maxs[j] = std::max(bmaxs(j, b), maxs[j]);
+        mins[j] = std::min(bmins(j, b), mins[j]);
       }
     scalar_t max_var = maxs[0] - mins[0];
     std::size_t dim = 0;
@@ -120,21 +140,38 @@ namespace strumpack {
   }
 
 
-  template<typename scalar_t> structured::ClusterTree recursive_kd
-  (DenseMatrix<scalar_t>& p, std::size_t cluster_size, int* perm) {
+  template<typename scalar_t> structured::ClusterTree recursive_kd_rec
+  (DenseMatrix<scalar_t>& p, std::size_t cluster_size, int* perm,
+   int depth) {
     auto n = p.cols();
     structured::ClusterTree tree(n);
     if (n < cluster_size) return tree;
     std::vector<std::size_t> nc(2);
-    kd_partition(p, nc, cluster_size, perm);
+    kd_partition(p, nc, cluster_size, perm, depth);
     if (!nc[0] || !nc[1]) return tree;
     tree.c.resize(2);
     tree.c[0].size = nc[0];
     tree.c[1].size = nc[1];
     DenseMatrixWrapper<scalar_t> p0(p.rows(), nc[0], p, 0, 0);
-    tree.c[0] = recursive_kd(p0, cluster_size, perm);
     DenseMatrixWrapper<scalar_t> p1(p.rows(), nc[1], p, 0, nc[0]);
-    tree.c[1] = recursive_kd(p1, cluster_size, perm+nc[0]);
+#pragma omp task default(shared)                                        \
+  if(depth < params::task_recursion_cutoff_level)                       \
+  final(depth >= params::task_recursion_cutoff_level-1) mergeable
+    tree.c[0] = recursive_kd_rec(p0, cluster_size, perm, depth+1);
+#pragma omp task default(shared)                                        \
+  if(depth < params::task_recursion_cutoff_level)                       \
+  final(depth >= params::task_recursion_cutoff_level-1) mergeable
+    tree.c[1] = recursive_kd_rec(p1, cluster_size, perm+nc[0], depth+1);
+#pragma omp taskwait
+    return tree;
+  }
+
+  template<typename scalar_t> structured::ClusterTree recursive_kd
+  (DenseMatrix<scalar_t>& p, std::size_t cluster_size, int* perm) {
+    structured::ClusterTree tree;
+#pragma omp parallel if(!omp_in_parallel())
+#pragma omp single nowait
+    tree = recursive_kd_rec(p, cluster_size, perm, 0);
     return tree;
   }
 
@@ -28,6 +28,7 @@
  */
 #include "Clustering.hpp"
 #include "kernel/Metrics.hpp"
+#include "StrumpackParameters.hpp"
 
 namespace strumpack {
 
@@ -43,7 +44,7 @@ namespace strumpack {
   /** only works for k == 2 */
   template<typename scalar_t>
   std::vector<std::size_t> kmeans_start_random_dist_maximized
-  (const DenseMatrix<scalar_t>& p, std::mt19937& generator) {
+  (const DenseMatrix<scalar_t>& p, std::mt19937& generator, int depth) {
     constexpr std::size_t k = 2;
     const auto n = p.cols();
     const auto d = p.rows();
@@ -51,6 +52,10 @@ namespace strumpack {
     const auto t = uniform_random(generator);
     // compute probabilities
     std::vector<scalar_t> cur_dist(n);
+#if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
+#pragma omp taskloop default(shared) grainsize(4096)    \
+  if(depth < params::task_recursion_cutoff_level)
+#endif
     for (std::size_t i=0; i<n; i++)
       cur_dist[i] = Euclidean_distance_squared(d, &p(0, i), &p(0, t));
     std::discrete_distribution<int> random_center
@@ -116,7 +121,7 @@ namespace strumpack {
            typename real_t=typename RealType<scalar_t>::value_type>
   void k_means
   (int k, DenseMatrix<scalar_t>& p, std::vector<std::size_t>& nc,
-   int* perm, std::mt19937& generator) {
+   int* perm, std::mt19937& generator, int depth) {
     const auto d = p.rows();
     const auto n = p.cols();
     DenseMatrix<scalar_t> center(d, k);
@@ -126,8 +131,8 @@ namespace strumpack {
     constexpr int kmeans_options = 2;
     switch (kmeans_options) {
     case 1: ind_centers = kmeans_start_random(n, k, generator); break;
-    case 2: ind_centers = kmeans_start_random_dist_maximized(p, generator);
-      break;
+    case 2: ind_centers = kmeans_start_random_dist_maximized
+        (p, generator, depth); break;
     case 3: ind_centers = kmeans_start_dist_maximized(p); break;
     case 4: ind_centers = kmeans_start_fixed(p); break;
     }
@@ -137,29 +142,56 @@ namespace strumpack {
     int iter = 0;
     bool changes = true;
     std::vector<int> cluster(n);
+    // The points are processed in fixed size blocks, each block
+    // computes its own partial center sums and counts, which are
+    // reduced afterwards. The result does not depend on the number
+    // of threads.
+    const std::size_t B = 4096, nb = (n + B - 1) / B;
+    DenseMatrix<scalar_t> bcenter(d*k, nb);
+    std::vector<std::size_t> bnc(k*nb);
+    std::vector<int> bchanges(nb);
     while ((changes == true) && (iter < kmeans_max_it)) {
-      // for each point, find the closest cluster center
-      changes = false;
-      for (std::size_t i=0; i<n; i++) {
-        auto min_dist = Euclidean_distance(d, &p(0, i), &center(0, 0));
-        int ci = 0;
-        for (int c=1; c<k; c++) {
-          auto dd = Euclidean_distance(d, &p(0, i), &center(0, c));
-          if (dd < min_dist) {
-            min_dist = dd;
-            ci = c;
+      // for each point, find the closest cluster center, and
+      // accumulate the new centers
+#if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
+#pragma omp taskloop default(shared)                    \
+  if(depth < params::task_recursion_cutoff_level)
+#endif
+      for (std::size_t b=0; b<nb; b++) {
+        auto bc = bcenter.ptr(0, b);
+        auto bn = &bnc[k*b];
+        std::fill(bc, bc+d*k, scalar_t(0.));
+        std::fill(bn, bn+k, 0);
+        bchanges[b] = 0;
+        for (std::size_t i=b*B; i<std::min(n, (b+1)*B); i++) {
+          auto pi = p.ptr(0, i);
+          auto min_dist = Euclidean_distance_squared(d, pi, &center(0, 0));
+          int ci = 0;
+          for (int c=1; c<k; c++) {
+            auto dd = Euclidean_distance_squared(d, pi, &center(0, c));
+            if (dd < min_dist) {
+              min_dist = dd;
+              ci = c;
+            }
           }
+          if (ci != cluster[i]) bchanges[b] = 1;
+          cluster[i] = ci;
+          bn[ci]++;
+          auto bci = bc + d*ci;
+          for (std::size_t j=0; j<d; j++)
+            bci[j] += pi[j];
         }
-        if (ci != cluster[i]) changes = true;
-        cluster[i] = ci;
       }
+      changes = false;
       std::fill(nc.begin(), nc.end(), 0);
       center.zero();
-      for (std::size_t i=0; i<n; i++) {
-        auto c = cluster[i];
-        nc[c]++;
-        for (std::size_t j=0; j<d; j++)
-          center(j, c) += p(j, i);
+      for (std::size_t b=0; b<nb; b++) {
+        if (bchanges[b]) changes = true;
+        for (int c=0; c<k; c++) {
+          nc[c] += bnc[k*b+c];
+          for (std::size_t j=0; j<d; j++)
+            center(j, c) += bcenter(d*c+j, b);
+        }
       }
       for (int c=0; c<k; c++)
         for (std::size_t j=0; j<d; j++)
@@ -184,23 +216,44 @@ namespace strumpack {
 
 
   template<typename scalar_t>
-  structured::ClusterTree recursive_2_means
+  structured::ClusterTree recursive_2_means_rec
   (DenseMatrix<scalar_t>& p, std::size_t cluster_size,
-   int* perm, std::mt19937& generator) {
+   int* perm, std::mt19937& generator, int depth) {
     const auto n = p.cols();
     structured::ClusterTree tree(n);
     if (n < cluster_size) return tree;
     std::vector<std::size_t> nc(2);
-    k_means(2, p, nc, perm, generator);
+    k_means(2, p, nc, perm, generator, depth);
     if (!nc[0] || !nc[1]) return tree;
     tree.c.resize(2);
     tree.c[0].size = nc[0];
     tree.c[1].size = nc[1];
-    // TODO threading
+    // each subtree gets its own generator, so the result does not
+    // depend on the order in which the tasks are executed
+    std::mt19937 g0(generator()), g1(generator());
     DenseMatrixWrapper<scalar_t> p0(p.rows(), nc[0], p, 0, 0);
-    tree.c[0] = recursive_2_means(p0, cluster_size, perm, generator);
     DenseMatrixWrapper<scalar_t> p1(p.rows(), nc[1], p, 0, nc[0]);
-    tree.c[1] = recursive_2_means(p1, cluster_size, perm+nc[0], generator);
+#pragma omp task default(shared)                                        \
+  if(depth < params::task_recursion_cutoff_level)                       \
+  final(depth >= params::task_recursion_cutoff_level-1) mergeable
+    tree.c[0] = recursive_2_means_rec(p0, cluster_size, perm, g0, depth+1);
+#pragma omp task default(shared)                                        \
+  if(depth < params::task_recursion_cutoff_level)                       \
+  final(depth >= params::task_recursion_cutoff_level-1) mergeable
+    tree.c[1] = recursive_2_means_rec
+      (p1, cluster_size, perm+nc[0], g1, depth+1);
+#pragma omp taskwait
+    return tree;
+  }
+
+  template<typename scalar_t>
+  structured::ClusterTree recursive_2_means
+  (DenseMatrix<scalar_t>& p, std::size_t cluster_size,
+   int* perm, std::mt19937& generator) {
+    structured::ClusterTree tree;
+#pragma omp parallel if(!omp_in_parallel())
+#pragma omp single nowait
+    tree = recursive_2_means_rec(p, cluster_size, perm, generator, 0);
     return tree;
   }
 
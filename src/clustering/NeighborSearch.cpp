@@ -32,30 +32,47 @@
 #include <algorithm>
 #include <numeric>
 #include <random>
-#include <chrono>
+#include <limits>
 
 #include "NeighborSearch.hpp"
 #include "kernel/Metrics.hpp"
+#include "StrumpackParameters.hpp"
 
 namespace strumpack {
 
   //--------------DISTANCE MATRIX------------------
   // finds distances between all data points with indices from
-  // index_subset
+  // index_subset, as ||x||^2 + ||y||^2 - 2 x^T y, with a single
+  // gemm. The points are first centered to limit cancellation.
   template<typename real_t, typename int_t>
   DenseMatrix<real_t> find_distance_matrix
   (const DenseMatrix<real_t>& data,
    const std::vector<int_t>& index_subset) {
     auto subset_size = index_subset.size();
-    DenseMatrix<real_t> distances(subset_size, subset_size);
     auto d = data.rows();
+    DenseMatrix<real_t> X(d, subset_size),
+      distances(subset_size, subset_size);
+    std::vector<real_t> centroid(d), nrm(subset_size);
+    for (std::size_t i=0; i<subset_size; i++)
+      for (std::size_t k=0; k<d; k++)
+        centroid[k] += data(k, index_subset[i]);
+    for (std::size_t k=0; k<d; k++)
+      centroid[k] /= subset_size;
     for (std::size_t i=0; i<subset_size; i++) {
-      distances(i, i) = real_t(0);
-      for (std::size_t j=i+1; j<subset_size; j++) {
-        distances(j, i) = Euclidean_distance_squared
-          (d, &data(0, index_subset[i]), &data(0, index_subset[j]));
-        distances(i, j) = distances(j, i);
+      real_t nx(0.);
+      for (std::size_t k=0; k<d; k++) {
+        auto x = data(k, index_subset[i]) - centroid[k];
+        X(k, i) = x;
+        nx += x * x;
       }
+      nrm[i] = nx;
+    }
+    gemm(Trans::T, Trans::N, real_t(-2.), X, X, real_t(0.), distances);
+    for (std::size_t j=0; j<subset_size; j++) {
+      for (std::size_t i=0; i<subset_size; i++)
+        distances(i, j) = std::max
+          (real_t(0.), distances(i, j) + nrm[i] + nrm[j]);
+      distances(j, j) = real_t(0.);
     }
     return distances;
   }
@@ -70,6 +87,7 @@ namespace strumpack {
     auto d = data.rows();
     auto subset_size = index_subset.size();
     DenseMatrix<real_t> distances(subset_size, n);
+#pragma omp parallel for default(shared) schedule(static)
     for (std::size_t j=0; j<n; j++)
       for (std::size_t i=0; i<subset_size; i++)
         distances(i, j) = Euclidean_distance_squared
@@ -80,24 +98,14 @@ namespace strumpack {
   //-------FIND APPROXIMATE NEAREST NEIGHBORS FROM PROJECTION TREE---
 
   // 1. CONSTRUCT THE TREE
-  // leaves - list of all indices such that
-  // leaves[leaf_sizes[i]]...leaves[leaf_sizes[i+1]]
-  // belong to i-th leaf of the projection tree
-  // gauss_id and gaussian samples - for the fixed samples option
+  // reorders the n indices such that each leaf of the random
+  // projection tree is a contiguous range, see projection_tree_leaves
   template<typename real_t, typename int_t>
   void construct_projection_tree
   (const DenseMatrix<real_t>& data, std::size_t min_leaf_size,
-   std::vector<int_t>& cur_indices, std::size_t start,
-   std::size_t cur_node_size, std::vector<std::size_t>& leaves,
-   std::vector<std::size_t>& leaf_sizes, std::mt19937& generator) {
+   int_t* indices, std::size_t n, std::mt19937& generator, int depth) {
     auto d = data.rows();
-    if (cur_node_size < min_leaf_size) {
-      auto prev_size = leaf_sizes.back();
-      leaf_sizes.push_back(cur_node_size + prev_size);
-      for (std::size_t i=0; i<cur_node_size; i++)
-        leaves.push_back(cur_indices[start+i]);
-      return;
-    }
+    if (n < min_leaf_size) return;
 
     // choose random direction
     std::vector<real_t> direction_vector(d);
@@ -109,86 +117,108 @@ namespace strumpack {
       direction_vector[i] /= dir_vector_norm;
 
     // find relative coordinates
-    std::vector<real_t> relative_coordinates(cur_node_size, 0.0);
-    //#pragma omp parallel for if(cur_node_size > 1000)
-    for (std::size_t i=0; i<cur_node_size; i++)
+    std::vector<real_t> relative_coordinates(n);
+#if defined(STRUMPACK_USE_OPENMP_TASKLOOP)
+#pragma omp taskloop default(shared) grainsize(4096)    \
+  if(depth < params::task_recursion_cutoff_level)
+#endif
+    for (std::size_t i=0; i<n; i++)
       relative_coordinates[i] = blas::dotc
-        (d, &data(0, cur_indices[start+i]), 1, &direction_vector[0], 1);
+        (d, &data(0, indices[i]), 1, &direction_vector[0], 1);
 
-    // median split
-    std::vector<int_t> idx(cur_node_size);
+    // median split, only a selection is needed, not a full sort
+    std::vector<int_t> idx(n);
     std::iota(idx.begin(), idx.end(), 0);
-    int_t half_size = (int_t)cur_node_size / 2;
-    // std::nth_element
-    //   (idx.begin(), idx.begin()+half_size, idx.end(),
-    //    [&](const int_t& a, const int_t& b) {
-    //      return (relative_coordinates[a] < relative_coordinates[b]) ||
-    //        ((relative_coordinates[a] == relative_coordinates[b])
-    //         && (a < b)); });
-    std::sort
-      (idx.begin(), idx.end(),
+    std::size_t half_size = n / 2;
+    std::nth_element
+      (idx.begin(), idx.begin()+half_size, idx.end(),
        [&](const int_t& a, const int_t& b) {
          return (relative_coordinates[a] < relative_coordinates[b]) ||
-           ((relative_coordinates[a] == relative_coordinates[b]) && (a < b)); });
-    // std::stable_sort
-    //   (idx.begin(), idx.end(),
-    //    [&](const int_t& a, const int_t& b) {
-    //      return relative_coordinates[a] < relative_coordinates[b]; });
-    std::vector<int_t> cur_indices_sorted(cur_node_size, 0);
-    for (std::size_t i=0; i<cur_node_size; i++)
-      cur_indices_sorted[i] = cur_indices[start+idx[i]];
-    for (std::size_t i=start; i<start+cur_node_size; i++)
-      cur_indices[i] = cur_indices_sorted[i-start];
+           ((relative_coordinates[a] == relative_coordinates[b])
+            && (a < b)); });
+    std::vector<int_t> indices_sorted(n);
+    for (std::size_t i=0; i<n; i++)
+      indices_sorted[i] = indices[idx[i]];
+    std::copy(indices_sorted.begin(), indices_sorted.end(), indices);
 
+    // each subtree gets its own generator, so the result does not
+    // depend on the order in which the tasks are executed
+    std::mt19937 g0(generator()), g1(generator());
+#pragma omp task default(shared)                                        \
+  if(depth < params::task_recursion_cutoff_level)                       \
+  final(depth >= params::task_recursion_cutoff_level-1) mergeable
     construct_projection_tree
-      (data, min_leaf_size, cur_indices, start,
-       half_size, leaves, leaf_sizes, generator);
+      (data, min_leaf_size, indices, half_size, g0, depth+1);
+#pragma omp task default(shared)                                        \
+  if(depth < params::task_recursion_cutoff_level)                       \
+  final(depth >= params::task_recursion_cutoff_level-1) mergeable
     construct_projection_tree
-      (data, min_leaf_size, cur_indices, start + half_size,
-       cur_node_size - half_size, leaves, leaf_sizes, generator);
+      (data, min_leaf_size, indices+half_size, n-half_size, g1, depth+1);
+#pragma omp taskwait
+  }
+
+  // leaf_sizes[i]...leaf_sizes[i+1] is the range of the i-th leaf of
+  // the projection tree. This only depends on the sizes.
+  inline void projection_tree_leaves
+  (std::size_t min_leaf_size, std::size_t start, std::size_t n,
+   std::vector<std::size_t>& leaf_sizes) {
+    if (n < min_leaf_size) {
+      leaf_sizes.push_back(start + n);
+      return;
+    }
+    auto half_size = n / 2;
+    projection_tree_leaves(min_leaf_size, start, half_size, leaf_sizes);
+    projection_tree_leaves
+      (min_leaf_size, start+half_size, n-half_size, leaf_sizes);
   }
 
   // 2. FIND CLOSEST POINTS INSIDE LEAVES
-  // find ann_number exact neighbors for every point among the points
-  // within its leaf (in randomized projection tree)
+  // merge the exact neighbors for every point among the points
+  // within its leaf (in randomized projection tree) into the current
+  // list of ann_number approximate neighbors. The current list is
+  // kept as a max-heap on the score during the merge, and is sorted
+  // afterwards.
   template<typename real_t, typename int_t>
   void find_neighbors_in_tree
-  (const DenseMatrix<real_t>& data, std::vector<std::size_t>& leaves,
-   std::vector<std::size_t>& leaf_sizes, DenseMatrix<int_t>& neighbors,
-   DenseMatrix<real_t>& scores) {
+  (const DenseMatrix<real_t>& data, const std::vector<int_t>& leaves,
+   const std::vector<std::size_t>& leaf_sizes,
+   DenseMatrix<int_t>& neighbors, DenseMatrix<real_t>& scores) {
     auto ann_number = neighbors.rows();
+    using nb_t = std::pair<real_t,int_t>;
 #pragma omp parallel for default(shared) schedule(dynamic)
     for (std::size_t leaf=0; leaf<leaf_sizes.size()-1; leaf++) {
       // initialize size and content of the current leaf
       auto cur_leaf_size = leaf_sizes[leaf+1] - leaf_sizes[leaf];
       // list of indices in the current leaf
-      std::vector<int_t> index_subset(cur_leaf_size, 0);
-      for (std::size_t i=0; i<index_subset.size(); i++)
-        index_subset[i] = leaves[leaf_sizes[leaf] + i];
+      std::vector<int_t> index_subset
+        (leaves.begin()+leaf_sizes[leaf], leaves.begin()+leaf_sizes[leaf+1]);
       auto leaf_dists = find_distance_matrix(data, index_subset);
-
-      // record ann_number closest points in each leaf to neighbors
-      std::vector<int_t> idx(cur_leaf_size);
+      std::vector<nb_t> heap(ann_number);
       for (std::size_t i=0; i<cur_leaf_size; i++) {
-        std::iota(idx.begin(), idx.end(), 0);
-        std::partial_sort
-          (idx.begin(), idx.begin()+ann_number, idx.end(),
-           [&](const int_t& i1, const int_t& i2) {
-             return (leaf_dists(i,i1) < leaf_dists(i,i2)) ||
-               ((leaf_dists(i,i1) == leaf_dists(i,i2)) && (i1 < i2)); });
-        // std::stable_sort
-        //   (idx.begin(), idx.end(),
-        //    [&](const int_t& i1, const int_t& i2) {
-        //      return leaf_dists(i,i1) < leaf_dists(i,i2); });
+        auto c = index_subset[i];
+        for (std::size_t j=0; j<ann_number; j++)
+          heap[j] = nb_t(scores(j, c), neighbors(j, c));
+        std::make_heap(heap.begin(), heap.end());
+        for (std::size_t j=0; j<cur_leaf_size; j++) {
+          nb_t cand(leaf_dists(j, i), index_subset[j]);
+          if (!(cand < heap.front())) continue;
+          if (std::any_of(heap.begin(), heap.end(), [&](const nb_t& h) {
+                return h.second == cand.second; }))
+            continue;
+          std::pop_heap(heap.begin(), heap.end());
+          heap.back() = cand;
+          std::push_heap(heap.begin(), heap.end());
+        }
+        std::sort_heap(heap.begin(), heap.end());
         for (std::size_t j=0; j<ann_number; j++) {
-          neighbors(j, index_subset[i]) = leaves[leaf_sizes[leaf] + idx[j]];
-          scores(j, index_subset[i]) = leaf_dists(i, idx[j]);
+          scores(j, c) = heap[j].first;
+          neighbors(j, c) = heap[j].second;
         }
       }
     }
   }
 
-  // 3. FIND ANN IN ONE TREE SAMPLE
+  // 3. FIND ANN IN ONE TREE SAMPLE, AND MERGE WITH CURRENT NEIGHBORS
   template<typename real_t, typename int_t>
   void find_ann_candidates
   (const DenseMatrix<real_t>& data, DenseMatrix<int_t>& neighbors,
@@ -196,66 +226,19 @@ namespace strumpack {
     auto n = data.cols();
     auto ann_number = neighbors.rows();
     std::size_t min_leaf_size = 6 * ann_number;
-    std::vector<std::size_t> leaves, leaf_sizes;
-    leaves.reserve(n);
-    leaf_sizes.reserve(2*n / min_leaf_size);
+    std::vector<std::size_t> leaf_sizes;
+    leaf_sizes.reserve(2*n / min_leaf_size + 1);
     leaf_sizes.push_back(0);
-    std::size_t cur_node_size = n;
-    std::size_t start = 0;
-    std::vector<int_t> cur_indices(cur_node_size);
-    std::iota(cur_indices.begin(), cur_indices.end(), 0);
+    projection_tree_leaves(min_leaf_size, 0, n, leaf_sizes);
+    std::vector<int_t> leaves(n);
+    std::iota(leaves.begin(), leaves.end(), 0);
+#pragma omp parallel if(!omp_in_parallel())
+#pragma omp single nowait
     construct_projection_tree
-      (data, min_leaf_size, cur_indices, start,
-       cur_node_size, leaves, leaf_sizes, generator);
+      (data, min_leaf_size, leaves.data(), n, generator, 0);
     find_neighbors_in_tree(data, leaves, leaf_sizes, neighbors, scores);
   }
 
-  //---------------CHOOSE BEST NEIGHBORS FROM TWO TREE SAMPLES----------------
-
-  // take closest neighbors from neighbors and new_neighbors, write them
-  // to neighbors and scores
-  template<typename real_t, typename int_t>
-  void choose_best_neighbors
-  (DenseMatrix<int_t>& neighbors, DenseMatrix<real_t>& scores,
-   DenseMatrix<int_t>& new_neighbors, DenseMatrix<real_t>& new_scores) {
-    auto ann_number = neighbors.rows();
-    std::vector<int_t> cur_neighbors(ann_number);
-    std::vector<real_t> cur_scores(ann_number);
-    for (std::size_t c=0; c<neighbors.cols(); c++) {
-      std::size_t r1 = 0, r2 = 0, cur = 0;
-      while ((r1 < ann_number) && (r2 < ann_number) &&
-             (cur < ann_number)) {
-        if (scores(r1, c) > new_scores(r2, c)) {
-          cur_neighbors[cur] = new_neighbors(r2, c);
-          cur_scores[cur] = new_scores(r2, c);
-          r2++;
-        } else {
-          cur_neighbors[cur] = neighbors(r1, c);
-          cur_scores[cur] = scores(r1, c);
-          if (neighbors(r1, c) == new_neighbors(r2, c)) r2++;
-          r1++;
-        }
-        cur++;
-      }
-      while (cur < ann_number) {
-        if (r1 == ann_number) {
-          cur_neighbors[cur] = new_neighbors(r2, c);
-          cur_scores[cur] = new_scores(r2, c);
-          r2++;
-        } else {
-          cur_neighbors[cur] = neighbors(r1, c);
-          cur_scores[cur] = scores(r1, c);
-          r1++;
-        }
-        cur++;
-      }
-      for (std::size_t i=0; i<ann_number; i++) {
-        neighbors(i, c) = cur_neighbors[i];
-        scores(i, c) = cur_scores[i];
-      }
-    }
-  }
-
   //----------------QUALITY CHECK WITH TRUE NEIGHBORS-------------------------
   template<typename real_t, typename int_t> void find_true_nn
   (const DenseMatrix<real_t>& data, const std::vector<std::size_t>& samples,
@@ -328,8 +311,10 @@ namespace strumpack {
     auto n = data.cols();
     neighbors.resize(ann_number, n);
     scores.resize(ann_number, n);
-    neighbors.zero();
-    scores.zero();
+    // empty lists, these are replaced by the first tree, since each
+    // leaf has at least ann_number points
+    neighbors.fill(int_t(n));
+    scores.fill(std::numeric_limits<real_t>::max());
     std::mt19937 generator(1); // reproducible
     find_ann_candidates(data, neighbors, scores, generator);
     real_t quality = check_quality(data, neighbors, generator);
@@ -337,10 +322,7 @@ namespace strumpack {
     // nearest neighbors
     std::size_t iter = 0;
     for (; iter<num_iters && quality<0.99; iter++) {
-      DenseMatrix<int_t> new_neighbors(ann_number, n);
-      DenseMatrix<real_t> new_scores(ann_number, n);
-      find_ann_candidates(data, new_neighbors, new_scores, generator);
-      choose_best_neighbors(neighbors, scores, new_neighbors, new_scores);
+      find_ann_candidates(data, neighbors, scores, generator);
       quality = check_quality(data, neighbors, generator);
     }
     // std::cout << "# ANN search quality = " << quality
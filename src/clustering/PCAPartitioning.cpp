@@ -29,19 +29,20 @@
 #include <algorithm>
 
 #include "Clustering.hpp"
+#include "StrumpackParameters.hpp"
 
 namespace strumpack {
 
   template<typename scalar_t> void pca_partition
   (DenseMatrix<scalar_t>& p, std::vector<std::size_t>& nc,
-   int* perm) {
+   int* perm, int depth) {
     auto n = p.cols();
     auto d = p.rows();
     // find first pca direction
     int num = 0;
     scalar_t lambda;
     DenseMatrix<scalar_t> Z(d, 1), ptp(d, d);
-    gemm(Trans::N, Trans::C, scalar_t(1.), p, p, scalar_t(0.), ptp);
+    gemm(Trans::N, Trans::C, scalar_t(1.), p, p, scalar_t(0.), ptp, depth);
     double abstol = 1e-5;
     blas::syevx('V', 'I', 'U', d, ptp.data(), d, scalar_t(1.),
                 scalar_t(1.), d, d, abstol, num, &lambda, Z.data(), d);
@@ -50,7 +51,7 @@ namespace strumpack {
                 << std::endl;
     // compute pca coordinates
     DenseMatrix<scalar_t> new_x_coord(n, 1);
-    gemv(Trans::C, scalar_t(1.), p, Z, scalar_t(0.), new_x_coord, 0);
+    gemv(Trans::C, scalar_t(1.), p, Z, scalar_t(0.), new_x_coord, depth);
 
     std::vector<std::size_t> cluster(n);
     nc.resize(2);
@@ -101,30 +102,49 @@ namespace strumpack {
   }
 
 
-  template<typename scalar_t> structured::ClusterTree recursive_pca
-  (DenseMatrix<scalar_t>& p, std::size_t cluster_size, int* perm) {
+  template<typename scalar_t> structured::ClusterTree recursive_pca_rec
+  (DenseMatrix<scalar_t>& p, std::size_t cluster_size, int* perm,
+   int depth) {
     auto n = p.cols();
     structured::ClusterTree tree(n);
     if (n < cluster_size) return tree;
     std::vector<std::size_t> nc(2);
-    pca_partition(p, nc, perm);
+    pca_partition(p, nc, perm, depth);
     if (!nc[0] || !nc[1]) return tree;
     tree.c.resize(2);
     tree.c[0].size = nc[0];
     tree.c[1].size = nc[1];
     DenseMatrixWrapper<scalar_t> p0(p.rows(), nc[0], p, 0, 0);
-    tree.c[0] = recursive_pca(p0, cluster_size, perm);
     DenseMatrixWrapper<scalar_t> p1(p.rows(), nc[1], p, 0, nc[0]);
-    tree.c[1] = recursive_pca(p1, cluster_size, perm+nc[0]);
+#pragma omp task default(shared)                                        \
+  if(depth < params::task_recursion_cutoff_level)                       \
+  final(depth >= params::task_recursion_cutoff_level-1) mergeable
+    tree.c[0] = recursive_pca_rec(p0, cluster_size, perm, depth+1);
+#pragma omp task default(shared)                                        \
+  if(depth < params::task_recursion_cutoff_level)                       \
+  final(depth >= params::task_recursion_cutoff_level-1) mergeable
+    tree.c[1] = recursive_pca_rec(p1, cluster_size, perm+nc[0], depth+1);
+#pragma omp taskwait
+    return tree;
+  }
+
+  template<typename scalar_t> structured::ClusterTree recursive_pca
+  (DenseMatrix<scalar_t>& p, std::size_t cluster_size, int* perm) {
+    structured::ClusterTree tree;
+#pragma omp parallel if(!omp_in_parallel())
+#pragma omp single nowait
+    tree = recursive_pca_rec(p, cluster_size, perm, 0);
     return tree;
   }
 
 
   // explicit template instantiations (only for real types!)
   template void pca_partition
-  (DenseMatrix<float>& p, std::vector<std::size_t>& nc, int* perm);
+  (DenseMatrix<float>& p, std::vector<std::size_t>& nc, int* perm,
+   int depth);
   template void pca_partition
-  (DenseMatrix<double>& p, std::vector<std::size_t>& nc, int* perm);
+  (DenseMatrix<double>& p, std::vector<std::size_t>& nc, int* perm,
+   int depth);
 
   template structured::ClusterTree recursive_pca
   (DenseMatrix<float>& p, std::size_t cluster_size, int* perm);
@@ -108,7 +108,11 @@ namespace strumpack {
     //      DW_t(n, rank, V_, 0, 0), scalar_t(0.), V);
 
     U = D_t(m, rank); U.copy(U_, 0, 0);
-    V = DW_t(n, rank, V_, 0, 0).conj_transpose();
+    // the columns of V_ hold (residual) rows of A, not conjugated
+    V = D_t(rank, n);
+    for (std::size_t j=0; j<n; j++)
+      for (int i=0; i<rank; i++)
+        V(i, j) = V_(j, i);
   }
 
 
@@ -120,6 +120,26 @@ namespace strumpack {
      */
     BLACSGrid(MPIComm&& comm, int P) : comm_(std::move(comm)), P_(P) { setup(); }
 
+    /**
+     * Construct a BLACSGrid from an MPIComm object, with a given
+     * nprows x npcols layout. The MPIComm will be duplicated. Ranks
+     * [nprows*npcols, P) will be idle in the grid. This operation is
+     * collective on comm. comm can be a null communicator
+     * (MPI_COMM_NULL), see BLACSGrid(const MPIComm&, int).
+     *
+     * \param comm MPIComm used to initialize the grid, this will be
+     * duplicated
+     * \param P total number of ranks in the new grid (P ==
+     * comm.size() or comm.is_null())
+     * \param nprows number of processor rows
+     * \param npcols number of processor columns, nprows*npcols <= P
+     */
+    BLACSGrid(const MPIComm& comm, int P, int nprows, int npcols)
+      : comm_(comm), P_(P), nprows_(nprows), npcols_(npcols) {
+      assert(nprows * npcols <= P);
+      setup();
+    }
+
     /**
      * Destructor, this will free all resources associated with this
      * grid.
@@ -162,6 +182,8 @@ namespace strumpack {
       //std::cout << "WARNING copying a BLACS grid is expensive!!" << std::endl;
       comm_ = grid.Comm();
       P_ = grid.P();
+      nprows_ = grid.nprows_;
+      npcols_ = grid.npcols_;
       setup();
       return *this;
     }
@@ -281,6 +303,33 @@ namespace strumpack {
       proc_rows = procs / proc_cols;
     }
 
+    /**
+     * Find a 2D layout for an m x n matrix, distributed 2D block
+     * cyclicly with MB x NB blocks, over at most procs processes.
+     * This is similar to layout(int, int&, int&), but will leave
+     * ranks idle when the matrix is too small to give each active
+     * rank at least min_blocks blocks. For small matrices, a few
+     * ranks (each running multiple threads) are more efficient than
+     * a large grid with mostly empty local blocks.
+     *
+     * \param procs maximum number of processes in the 2d layout
+     * \param m number of rows of the matrix
+     * \param n number of columns of the matrix
+     * \param MB row blocksize
+     * \param NB column blocksize
+     * \param min_blocks minimum number of blocks per active rank
+     * \param proc_rows output, number of rows in the 2d layout
+     * \param proc_cols output, number of columns in the 2d layout
+     */
+    static void layout(int procs, std::size_t m, std::size_t n,
+                       int MB, int NB, int min_blocks,
+                       int& proc_rows, int& proc_cols) {
+      std::size_t mb = (m + MB - 1) / MB, nb = (n + NB - 1) / NB,
+        maxp = (mb * nb) / std::max(1, min_blocks);
+      layout(std::max(1, int(std::min(std::size_t(procs), maxp))),
+             proc_rows, proc_cols);
+    }
+
     /**
      * Return a BLACSGrid which is the transpose of the current
      * grid. Ie., has npcols processor rows and nprows processor
@@ -313,7 +362,8 @@ namespace strumpack {
     std::unique_ptr<MPIComm> active_comm_;
 
     void setup() {
-      layout(P_, nprows_, npcols_);
+      if (nprows_ <= 0 || npcols_ <= 0)
+        layout(P_, nprows_, npcols_);
       if (comm_.is_null()) {
         ctxt_ = ctxt_all_ = ctxt_T_ = -1;
         prow_ = pcol_ = -1;
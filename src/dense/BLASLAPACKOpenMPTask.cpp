@@ -26,6 +26,9 @@
  *             Division).
  *
  */
+#include <memory>
+#include <vector>
+
 #include "BLASLAPACKOpenMPTask.hpp"
 #include "StrumpackFortranCInterface.h"
 
@@ -36,6 +39,8 @@ namespace strumpack {
   const int OMPThreshold = OMPTileSize*OMPTileSize*OMPTileSize;
   const int gemmOMPThreshold = OMPThreshold;
   const int trsmOMPThreshold = OMPThreshold;
+  // tile size for potrf_omp_task, panel width for sytrf_omp_task
+  const int OMPPanelSize = 256;
 
   template<typename scalar>
   void gemm_omp_task(char ta, char tb, int m, int n, int k, scalar alpha,
@@ -531,6 +536,440 @@ namespace strumpack {
   }
 
 
+  // Tiled LU with partial pivoting (restricted to the rows of a11)
+  // of the block matrix [a11 a12; a21 a22], with the Schur
+  // complement update of a22. The tasks form a DAG through the
+  // depend clauses, with one dependency object per tile column, plus
+  // one per tile of a21. The updates of all tiles in a column only
+  // read the column object, so they run concurrently, while the next
+  // row swap/trsm or panel on that column waits for all of them. The
+  // panel of step k+1 can start as soon as its column has been
+  // updated in step k, overlapping with the rest of the trailing
+  // update (lookahead). The panel itself uses getrf_omp_task, which
+  // generates nested tasks for the threads not busy with the
+  // trailing update. The row interchanges for the columns to the
+  // left of each panel are applied at the end, since those columns
+  // are still read by the updates of later steps.
+  template<typename scalar>
+  int getrf_tiled_omp_task(int n1, int n2, scalar* a11, int ld11,
+                           scalar* a12, int ld12, scalar* a21, int ld21,
+                           scalar* a22, int ld22, int* ipiv, int nb,
+                           typename RealType<scalar>::value_type thresh,
+                           int depth) {
+    if (n1 <= 0) return 0;
+    if (nb <= 0) nb = std::max(n1, n2);
+    const int T1 = (n1 + nb - 1) / nb, T2 = (n2 + nb - 1) / nb,
+      T = T1 + T2;
+    auto offset = [&](int i) { return (i < T1) ? i*nb : (i-T1)*nb; };
+    auto size = [&](int i) {
+      return (i < T1) ? std::min(nb, n1-i*nb) : std::min(nb, n2-(i-T1)*nb);
+    };
+    auto tile = [&](int i, int j) {
+      auto r = std::size_t(offset(i)), c = std::size_t(offset(j));
+      if (i < T1) return (j < T1) ? a11 + r + c*ld11 : a12 + r + c*ld12;
+      else return (j < T1) ? a21 + r + c*ld21 : a22 + r + c*ld22;
+    };
+    auto ld = [&](int i, int j) {
+      if (i < T1) return (j < T1) ? ld11 : ld12;
+      else return (j < T1) ? ld21 : ld22;
+    };
+    std::unique_ptr<char[]> deps(new char[T + T2*T1]);
+    char *col = deps.get(), *t21 = col + T;
+    int info = 0;
+    for (int k=0; k<T1; k++) {
+      const int r = k*nb, kb = size(k);
+#pragma omp task default(shared) firstprivate(k,r,kb)   \
+  depend(inout:col[k]) priority(2)
+      {
+        int linfo = getrf_omp_task
+          (n1-r, kb, tile(k,k), ld11, ipiv+r, depth+1);
+        for (int i=0; i<std::min(n1-r, kb); i++) ipiv[r+i] += r;
+        if (linfo) {
+#pragma omp critical
+          if (!info || r + linfo < info) info = r + linfo;
+        }
+        if (thresh > 0) {
+          auto Dkk = tile(k,k);
+          for (std::size_t i=0; i<std::size_t(kb); i++) {
+            auto& d = Dkk[i+i*ld11];
+            if (std::abs(d) < thresh)
+              d = (std::real(d) < 0) ? -thresh : thresh;
+          }
+        }
+      }
+      for (int i=T1; i<T; i++)
+#pragma omp task default(shared) firstprivate(i,k,kb)   \
+  depend(in:col[k]) depend(inout:t21[(i-T1)*T1+k]) priority(1)
+        blas::trsm('R', 'U', 'N', 'N', size(i), kb, scalar(1.),
+                   tile(k,k), ld11, tile(i,k), ld21);
+      for (int j=k+1; j<T; j++) {
+#pragma omp task default(shared) firstprivate(j,k,r,kb)           \
+  depend(in:col[k]) depend(inout:col[j]) priority(j == k+1 ? 2 : 0)
+        {
+          auto Aj = (j < T1) ? a11 + std::size_t(offset(j))*ld11 :
+            a12 + std::size_t(offset(j))*ld12;
+          blas::laswp(size(j), Aj, ld(k,j), r+1, r+kb, ipiv, 1);
+          blas::trsm('L', 'L', 'N', 'U', kb, size(j), scalar(1.),
+                     tile(k,k), ld11, tile(k,j), ld(k,j));
+        }
+        for (int i=k+1; i<T; i++) {
+          if (i < T1) {
+#pragma omp task default(shared) firstprivate(i,j,k,kb) \
+  depend(in:col[k],col[j]) priority(j == k+1 ? 1 : 0)
+            blas::gemm('N', 'N', size(i), size(j), kb, scalar(-1.),
+                       tile(i,k), ld(i,k), tile(k,j), ld(k,j),
+                       scalar(1.), tile(i,j), ld(i,j));
+          } else {
+#pragma omp task default(shared) firstprivate(i,j,k,kb)         \
+  depend(in:col[j],t21[(i-T1)*T1+k]) priority(j == k+1 ? 1 : 0)
+            blas::gemm('N', 'N', size(i), size(j), kb, scalar(-1.),
+                       tile(i,k), ld(i,k), tile(k,j), ld(k,j),
+                       scalar(1.), tile(i,j), ld(i,j));
+          }
+        }
+      }
+    }
+#pragma omp taskwait
+    for (int j=0; j<T1-1; j++)
+#pragma omp task default(shared) firstprivate(j)
+      blas::laswp(size(j), a11 + std::size_t(offset(j))*ld11, ld11,
+                  (j+1)*nb+1, n1, ipiv, 1);
+#pragma omp taskwait
+    return info;
+  }
+
+  // tiled Cholesky factorization (lower), drop in replacement for
+  // potrf. The tasks on tile (i,j) depend on the tiles they read and
+  // write, so the factorization of the next diagonal tile can start
+  // before the current trailing update has completed.
+  template<typename scalar>
+  int potrf_omp_task(char ul, int n, scalar* a, int lda, int depth) {
+    const int nb = OMPPanelSize;
+    if (depth>=params::task_recursion_cutoff_level || n <= 2*nb ||
+        !(ul=='L' || ul=='l'))
+      return blas::potrf(ul, n, a, lda);
+    using real_t = typename RealType<scalar>::value_type;
+    const int T = (n + nb - 1) / nb;
+    auto size = [&](int i) { return std::min(nb, n-i*nb); };
+    auto tile = [&](int i, int j) {
+      return a + std::size_t(i)*nb + std::size_t(j)*nb*lda;
+    };
+    std::unique_ptr<char[]> deps(new char[T*T]);
+    char* t = deps.get();
+    int info = 0;
+    for (int k=0; k<T; k++) {
+#pragma omp task default(shared) firstprivate(k)        \
+  depend(inout:t[k+k*T]) priority(2)
+      {
+        int linfo = blas::potrf('L', size(k), tile(k,k), lda);
+        if (linfo) {
+#pragma omp critical
+          if (!info || k*nb + linfo < info) info = k*nb + linfo;
+        }
+      }
+      for (int i=k+1; i<T; i++)
+#pragma omp task default(shared) firstprivate(i,k)                      \
+  depend(in:t[k+k*T]) depend(inout:t[i+k*T]) priority(i == k+1 ? 2 : 1)
+        blas::trsm('R', 'L', 'C', 'N', size(i), size(k), scalar(1.),
+                   tile(k,k), lda, tile(i,k), lda);
+      for (int j=k+1; j<T; j++) {
+#pragma omp task default(shared) firstprivate(j,k)                      \
+  depend(in:t[j+k*T]) depend(inout:t[j+j*T]) priority(j == k+1 ? 2 : 0)
+        blas::herk('L', 'N', size(j), size(k), real_t(-1.),
+                   tile(j,k), lda, real_t(1.), tile(j,j), lda);
+        for (int i=j+1; i<T; i++)
+#pragma omp task default(shared) firstprivate(i,j,k)    \
+  depend(in:t[i+k*T],t[j+k*T]) depend(inout:t[i+j*T])   \
+  priority(j == k+1 ? 1 : 0)
+          blas::gemm('N', 'C', size(i), size(j), size(k), scalar(-1.),
+                     tile(i,k), lda, tile(j,k), lda,
+                     scalar(1.), tile(i,j), lda);
+      }
+    }
+#pragma omp taskwait
+    return info;
+  }
+
+  template<typename real_t> real_t cabs1(real_t a) {
+    return std::abs(a);
+  }
+  template<typename real_t> real_t cabs1(std::complex<real_t> a) {
+    return std::abs(a.real()) + std::abs(a.imag());
+  }
+  template<typename scalar> int iamax(int n, const scalar* x) {
+    int imax = 0;
+    auto xmax = cabs1(x[0]);
+    for (int i=1; i<n; i++)
+      if (cabs1(x[i]) > xmax) { xmax = cabs1(x[i]); imax = i; }
+    return imax;
+  }
+
+  // Bunch-Kaufman factorization of at most nb columns of the lower
+  // triangle of the n x n matrix a, as in LAPACK xLASYF, but without
+  // the update of the trailing matrix. Returns the number of columns
+  // factored, kb. The trailing matrix a(kb:n,kb:n) still needs to be
+  // updated with -a(kb:n,0:kb)*w(kb:n,0:kb)^T, after which the
+  // interchanges in the first kb columns are partially undone, see
+  // lasyf_lower_finish.
+  template<typename scalar>
+  int lasyf_lower_panel(int n, int nb, scalar* a, int lda, int* ipiv,
+                        scalar* w, int ldw, int& info) {
+    using real_t = typename RealType<scalar>::value_type;
+    const real_t alpha = (1. + std::sqrt(17.)) / 8.;
+    auto A = [&](int i, int j) -> scalar& {
+      return a[i+std::size_t(j)*lda]; };
+    auto W = [&](int i, int j) -> scalar& {
+      return w[i+std::size_t(j)*ldw]; };
+    info = 0;
+    int k = 0;
+    while (!((k >= nb-1 && nb < n) || k >= n)) {
+      int kstep = 1, kp = k;
+      // copy column k of A to column k of W and update it
+      blas::copy(n-k, &A(k,k), 1, &W(k,k), 1);
+      if (k)
+        blas::gemv('N', n-k, k, scalar(-1.), &A(k,0), lda,
+                   &W(k,0), ldw, scalar(1.), &W(k,k), 1);
+      real_t absakk = cabs1(W(k,k)), colmax = 0;
+      int imax = k;
+      if (k < n-1) {
+        imax = k + 1 + iamax(n-k-1, &W(k+1,k));
+        colmax = cabs1(W(imax,k));
+      }
+      if (std::max(absakk, colmax) == real_t(0)) {
+        // column k is zero
+        if (!info) info = k + 1;
+        blas::copy(n-k, &W(k,k), 1, &A(k,k), 1);
+      } else {
+        if (absakk < alpha * colmax) {
+          // copy column imax to column k+1 of W and update it
+          for (int i=k; i<imax; i++) W(i,k+1) = A(imax,i);
+          blas::copy(n-imax, &A(imax,imax), 1, &W(imax,k+1), 1);
+          if (k)
+            blas::gemv('N', n-k, k, scalar(-1.), &A(k,0), lda,
+                       &W(imax,0), ldw, scalar(1.), &W(k,k+1), 1);
+          // largest off-diagonal element in row imax
+          int jmax = k + iamax(imax-k, &W(k,k+1));
+          real_t rowmax = cabs1(W(jmax,k+1));
+          if (imax < n-1) {
+            jmax = imax + 1 + iamax(n-imax-1, &W(imax+1,k+1));
+            rowmax = std::max(rowmax, cabs1(W(jmax,k+1)));
+          }
+          if (absakk >= alpha * colmax * (colmax / rowmax))
+            kp = k;
+          else if (cabs1(W(imax,k+1)) >= alpha * rowmax) {
+            kp = imax;
+            blas::copy(n-k, &W(k,k+1), 1, &W(k,k), 1);
+          } else {
+            kp = imax;
+            kstep = 2;
+          }
+        }
+        int kk = k + kstep - 1;
+        // updated column kp is already stored in column kk of W
+        if (kp != kk) {
+          // copy non-updated column kk to column kp
+          A(kp,kp) = A(kk,kk);
+          for (int i=kk+1; i<kp; i++) A(kp,i) = A(i,kk);
+          if (kp < n-1)
+            blas::copy(n-kp-1, &A(kp+1,kk), 1, &A(kp+1,kp), 1);
+          // interchange rows kk and kp in first kk columns of A and W
+          blas::swap(kk, &A(kk,0), lda, &A(kp,0), lda);
+          blas::swap(kk+1, &W(kk,0), ldw, &W(kp,0), ldw);
+        }
+        if (kstep == 1) {
+          // store L(k) in column k of A
+          blas::copy(n-k, &W(k,k), 1, &A(k,k), 1);
+          if (k < n-1)
+            blas::scal(n-k-1, scalar(1.) / A(k,k), &A(k+1,k), 1);
+        } else {
+          // store L(k) and L(k+1) in columns k and k+1 of A
+          if (k < n-2) {
+            scalar d21 = W(k+1,k), d11 = W(k+1,k+1) / d21,
+              d22 = W(k,k) / d21, t = scalar(1.) / (d11*d22 - scalar(1.));
+            d21 = t / d21;
+            for (int j=k+2; j<n; j++) {
+              A(j,k) = d21 * (d11*W(j,k) - W(j,k+1));
+              A(j,k+1) = d21 * (d22*W(j,k+1) - W(j,k));
+            }
+          }
+          // copy D(k) to A
+          A(k,k) = W(k,k);
+          A(k+1,k) = W(k+1,k);
+          A(k+1,k+1) = W(k+1,k+1);
+        }
+      }
+      // LAPACK convention, 1-based
+      if (kstep == 1) ipiv[k] = kp + 1;
+      else ipiv[k] = ipiv[k+1] = -(kp + 1);
+      k += kstep;
+    }
+    return k;
+  }
+
+  // put the first kb columns of L in the same form as LAPACK xSYTRF,
+  // by partially undoing the interchanges in those columns
+  template<typename scalar>
+  void lasyf_lower_finish(int kb, scalar* a, int lda, const int* ipiv) {
+    int j = kb; // 1-based
+    while (j > 1) {
+      int jj = j, jp = ipiv[j-1];
+      if (jp < 0) { jp = -jp; j--; }
+      j--;
+      if (jp != jj && j >= 1)
+        blas::swap(j, a+jp-1, lda, a+jj-1, lda);
+    }
+  }
+
+  // Bunch-Kaufman LDL^T factorization of a symmetric matrix, lower
+  // triangle, drop in replacement for sytrf. The panels are factored
+  // as in LAPACK, the trailing matrix update is split in block
+  // columns, each a task.
+  template<typename scalar>
+  int sytrf_omp_task(char ul, int n, scalar* a, int lda, int* ipiv,
+                     int depth) {
+    const int nb = OMPPanelSize;
+    if (depth>=params::task_recursion_cutoff_level || n <= 2*nb ||
+        !(ul=='L' || ul=='l'))
+      return blas::sytrf(ul, n, a, lda, ipiv);
+    std::unique_ptr<scalar[]> w(new scalar[std::size_t(n)*nb]);
+    int info = 0;
+    for (int k=0; k<n; ) {
+      int m = n - k, kb, iinfo = 0;
+      auto akk = a + k + std::size_t(k)*lda;
+      if (m > nb) {
+        kb = lasyf_lower_panel(m, nb, akk, lda, ipiv+k, w.get(), m, iinfo);
+        // update the lower triangle of A22 := A22 - L21*W^T
+        auto A = [&](int i, int j) { return akk+i+std::size_t(j)*lda; };
+        auto W = [&](int i, int j) { return w.get()+i+std::size_t(j)*m; };
+        for (int j=kb; j<m; j+=nb) {
+#pragma omp task default(shared) firstprivate(j)                \
+  final(depth >= params::task_recursion_cutoff_level-1) mergeable
+          {
+            int jb = std::min(nb, m-j);
+            for (int jj=j; jj<j+jb; jj++)
+              blas::gemv('N', j+jb-jj, kb, scalar(-1.), A(jj,0), lda,
+                         W(jj,0), m, scalar(1.), A(jj,jj), 1);
+            if (j+jb < m)
+              gemm_omp_task('N', 'T', m-j-jb, jb, kb, scalar(-1.),
+                            A(j+jb,0), lda, W(j,0), m, scalar(1.),
+                            A(j+jb,j), lda, depth+1);
+          }
+        }
+#pragma omp taskwait
+        lasyf_lower_finish(kb, akk, lda, ipiv+k);
+      } else {
+        iinfo = blas::sytrf('L', m, akk, lda, ipiv+k);
+        kb = m;
+      }
+      if (!info && iinfo > 0) info = iinfo + k;
+      for (int j=k; j<k+kb; j++)
+        ipiv[j] += (ipiv[j] > 0) ? k : -k;
+      k += kb;
+    }
+    return info;
+  }
+
+  // B := L^{-1} P^T B, with P*L*D*L^T*P^T = A as computed by
+  // (lower) sytrf. In the xSYTRF format, the columns of L have not
+  // been permuted by the later interchanges. For a block of columns
+  // of L, those interchanges are applied to a copy of the block,
+  // which then multiplies B, after all interchanges of the block,
+  // with a (task parallel) trsm and gemm.
+  template<typename scalar>
+  void trsm_sytrf_omp_task(int n, int nrhs, const scalar* a, int lda,
+                           const int* ipiv, scalar* b, int ldb, int depth) {
+    const int nb = OMPPanelSize;
+    auto A = [&](int i, int j) { return a[i+std::size_t(j)*lda]; };
+    // a block can have nb+1 columns, to not split a 2x2 pivot
+    std::unique_ptr<scalar[]> w(new scalar[std::size_t(n)*(nb+1)]);
+    std::vector<int> p(n);
+    for (int k0=0; k0<n; ) {
+      // do not split a 2x2 pivot
+      int k1 = k0;
+      while (k1 < std::min(n, k0+nb)) k1 += (ipiv[k1] > 0) ? 1 : 2;
+      const int kb = k1 - k0, m = n - k0;
+      auto W = [&](int i, int j) -> scalar& {
+        return w[i+std::size_t(j)*m]; };
+      for (int j=0; j<kb; j++) {
+        for (int i=0; i<=j; i++) W(i,j) = scalar(0.);
+        for (int i=j+1; i<m; i++) W(i,j) = A(k0+i,k0+j);
+      }
+      for (int k=k0; k<k1; ) {
+        if (ipiv[k] > 0) {
+          p[k] = ipiv[k];
+          if (p[k]-1 != k)
+            blas::swap(k-k0, &W(k-k0,0), m, &W(p[k]-1-k0,0), m);
+          k++;
+        } else {
+          // 2x2 pivot, row k+1 is interchanged with -ipiv[k]
+          W(k+1-k0,k-k0) = scalar(0.);
+          p[k] = k + 1;
+          p[k+1] = -ipiv[k];
+          if (p[k+1]-1 != k+1)
+            blas::swap(k-k0, &W(k+1-k0,0), m, &W(p[k+1]-1-k0,0), m);
+          k += 2;
+        }
+      }
+      laswp_omp_task(nrhs, b, ldb, k0+1, k1, p.data(), 1, depth);
+      trsm_omp_task('L', 'L', 'N', 'U', kb, nrhs, scalar(1.),
+                    w.get(), m, b+k0, ldb, depth);
+      if (k1 < n)
+        gemm_omp_task('N', 'N', n-k1, nrhs, kb, scalar(-1.),
+                      &W(kb,0), m, b+k0, ldb, scalar(1.), b+k1, ldb, depth);
+      k0 = k1;
+    }
+  }
+
+  // C := C - X^T * D^{-1} * X, lower triangle only, where D is the
+  // block diagonal factor, with 1x1 and 2x2 blocks, from (lower)
+  // sytrf.
+  template<typename scalar>
+  void syrk_sytrf_omp_task(int n, int m, const scalar* a, int lda,
+                           const int* ipiv, const scalar* x, int ldx,
+                           scalar* c, int ldc, int depth) {
+    const int nb = OMPPanelSize;
+    auto A = [&](int i, int j) { return a[i+std::size_t(j)*lda]; };
+    auto X = [&](int i, int j) { return x[i+std::size_t(j)*ldx]; };
+    // Y = D^{-1} X, see xSYTRS
+    std::unique_ptr<scalar[]> y(new scalar[std::size_t(n)*m]);
+    auto Y = [&](int i, int j) -> scalar& {
+      return y[i+std::size_t(j)*n]; };
+    for (int k=0; k<n; ) {
+      if (ipiv[k] > 0) {
+        auto dinv = scalar(1.) / A(k,k);
+        for (int j=0; j<m; j++) Y(k,j) = dinv * X(k,j);
+        k++;
+      } else {
+        auto akm1k = A(k+1,k), akm1 = A(k,k) / akm1k,
+          ak = A(k+1,k+1) / akm1k, denom = akm1*ak - scalar(1.);
+        for (int j=0; j<m; j++) {
+          auto bkm1 = X(k,j) / akm1k, bk = X(k+1,j) / akm1k;
+          Y(k,j) = (ak*bkm1 - bk) / denom;
+          Y(k+1,j) = (akm1*bk - bkm1) / denom;
+        }
+        k += 2;
+      }
+    }
+    for (int j=0; j<m; j+=nb) {
+#pragma omp task default(shared) firstprivate(j)                        \
+  if(depth < params::task_recursion_cutoff_level)                       \
+  final(depth >= params::task_recursion_cutoff_level-1) mergeable
+      {
+        int jb = std::min(nb, m-j);
+        for (int jj=j; jj<j+jb; jj++)
+          blas::gemv('T', n, j+jb-jj, scalar(-1.), x+std::size_t(jj)*ldx,
+                     ldx, y.get()+std::size_t(jj)*n, 1, scalar(1.),
+                     c+jj+std::size_t(jj)*ldc, 1);
+        if (j+jb < m)
+          gemm_omp_task('T', 'N', m-j-jb, jb, n, scalar(-1.),
+                        x+std::size_t(j+jb)*ldx, ldx,
+                        y.get()+std::size_t(j)*n, n, scalar(1.),
+                        c+j+jb+std::size_t(j)*ldc, ldc, depth+1);
+      }
+    }
+#pragma omp taskwait
+  }
+
   template<typename scalar>
   int getrs_omp_task(char t, int m, int n, const scalar *a, int lda,
                      const int* piv, scalar *b, int ldb,
@@ -597,6 +1036,31 @@ namespace strumpack {
   template int getrf_omp_task(int m, int n, std::complex<float>* a, int lda, int* ipiv, int depth);
   template int getrf_omp_task(int m, int n, std::complex<double>* a, int lda, int* ipiv, int depth);
 
+  template int getrf_tiled_omp_task(int n1, int n2, float* a11, int ld11, float* a12, int ld12, float* a21, int ld21, float* a22, int ld22, int* ipiv, int nb, float thresh, int depth);
+  template int getrf_tiled_omp_task(int n1, int n2, double* a11, int ld11, double* a12, int ld12, double* a21, int ld21, double* a22, int ld22, int* ipiv, int nb, double thresh, int depth);
+  template int getrf_tiled_omp_task(int n1, int n2, std::complex<float>* a11, int ld11, std::complex<float>* a12, int ld12, std::complex<float>* a21, int ld21, std::complex<float>* a22, int ld22, int* ipiv, int nb, float thresh, int depth);
+  template int getrf_tiled_omp_task(int n1, int n2, std::complex<double>* a11, int ld11, std::complex<double>* a12, int ld12, std::complex<double>* a21, int ld21, std::complex<double>* a22, int ld22, int* ipiv, int nb, double thresh, int depth);
+
+  template int potrf_omp_task(char ul, int n, float* a, int lda, int depth);
+  template int potrf_omp_task(char ul, int n, double* a, int lda, int depth);
+  template int potrf_omp_task(char ul, int n, std::complex<float>* a, int lda, int depth);
+  template int potrf_omp_task(char ul, int n, std::complex<double>* a, int lda, int depth);
+
+  template int sytrf_omp_task(char ul, int n, float* a, int lda, int* ipiv, int depth);
+  template int sytrf_omp_task(char ul, int n, double* a, int lda, int* ipiv, int depth);
+  template int sytrf_omp_task(char ul, int n, std::complex<float>* a, int lda, int* ipiv, int depth);
+  template int sytrf_omp_task(char ul, int n, std::complex<double>* a, int lda, int* ipiv, int depth);
+
+  template void trsm_sytrf_omp_task(int n, int nrhs, const float* a, int lda, const int* ipiv, float* b, int ldb, int depth);
+  template void trsm_sytrf_omp_task(int n, int nrhs, const double* a, int lda, const int* ipiv, double* b, int ldb, int depth);
+  template void trsm_sytrf_omp_task(int n, int nrhs, const std::complex<float>* a, int lda, const int* ipiv, std::complex<float>* b, int ldb, int depth);
+  template void trsm_sytrf_omp_task(int n, int nrhs, const std::complex<double>* a, int lda, const int* ipiv, std::complex<double>* b, int ldb, int depth);
+
+  template void syrk_sytrf_omp_task(int n, int m, const float* a, int lda, const int* ipiv, const float* x, int ldx, float* c, int ldc, int depth);
+  template void syrk_sytrf_omp_task(int n, int m, const double* a, int lda, const int* ipiv, const double* x, int ldx, double* c, int ldc, int depth);
+  template void syrk_sytrf_omp_task(int n, int m, const std::complex<float>* a, int lda, const int* ipiv, const std::complex<float>* x, int ldx, std::complex<float>* c, int ldc, int depth);
+  template void syrk_sytrf_omp_task(int n, int m, const std::complex<double>* a, int lda, const int* ipiv, const std::complex<double>* x, int ldx, std::complex<double>* c, int ldc, int depth);
+
   template int getrs_omp_task(char t, int m, int n, const float *a, int lda, const int* piv, float *b, int ldb, int depth);
   template int getrs_omp_task(char t, int m, int n, const double *a, int lda, const int* piv, double *b, int ldb, int depth);
   template int getrs_omp_task(char t, int m, int n, const std::complex<float> *a, int lda, const int* piv, std::complex<float> *b, int ldb, int depth);
@@ -43,6 +43,11 @@ namespace strumpack {
   template<typename scalar> void trsm_omp_task(char s, char ul, char ta, char d, int m, int n, scalar alpha, const scalar* a, int lda, scalar* b, int ldb, int depth);
   template<typename scalar> void laswp_omp_task(int n, scalar* a, int lda, int k1, int k2, const int* ipiv, int incx, int depth);
   template<typename scalar> int getrf_omp_task(int m, int n, scalar* a, int lda, int* ipiv, int depth);
+  template<typename scalar> int getrf_tiled_omp_task(int n1, int n2, scalar* a11, int ld11, scalar* a12, int ld12, scalar* a21, int ld21, scalar* a22, int ld22, int* ipiv, int nb, typename RealType<scalar>::value_type thresh, int depth);
+  template<typename scalar> int potrf_omp_task(char ul, int n, scalar* a, int lda, int depth);
+  template<typename scalar> int sytrf_omp_task(char ul, int n, scalar* a, int lda, int* ipiv, int depth);
+  template<typename scalar> void trsm_sytrf_omp_task(int n, int nrhs, const scalar* a, int lda, const int* ipiv, scalar* b, int ldb, int depth);
+  template<typename scalar> void syrk_sytrf_omp_task(int n, int m, const scalar* a, int lda, const int* ipiv, const scalar* x, int ldx, scalar* c, int ldc, int depth);
   template<typename scalar> int getrs_omp_task(char t, int m, int n, const scalar *a, int lda, const int* piv, scalar *b, int ldb, int depth);
 
 } // end namespace strumpack
@@ -225,6 +225,29 @@ namespace strumpack {
          std::complex<double>* alpha, const std::complex<double>* a, strumpack_blas_int* lda,
          std::complex<double>* b, strumpack_blas_int* ldb);
 
+      void STRUMPACK_FC_GLOBAL(ssyrk,SSYRK)
+        (char* ul, char* t, strumpack_blas_int* n, strumpack_blas_int* k, float* alpha,
+         const float* a, strumpack_blas_int* lda, float* beta, float* c, strumpack_blas_int* ldc);
+      void STRUMPACK_FC_GLOBAL(dsyrk,DSYRK)
+        (char* ul, char* t, strumpack_blas_int* n, strumpack_blas_int* k, double* alpha,
+         const double* a, strumpack_blas_int* lda, double* beta, double* c, strumpack_blas_int* ldc);
+      void STRUMPACK_FC_GLOBAL(csyrk,CSYRK)
+        (char* ul, char* t, strumpack_blas_int* n, strumpack_blas_int* k,
+         std::complex<float>* alpha, const std::complex<float>* a, strumpack_blas_int* lda,
+         std::complex<float>* beta, std::complex<float>* c, strumpack_blas_int* ldc);
+      void STRUMPACK_FC_GLOBAL(zsyrk,ZSYRK)
+        (char* ul, char* t, strumpack_blas_int* n, strumpack_blas_int* k,
+         std::complex<double>* alpha, const std::complex<double>* a, strumpack_blas_int* lda,
+         std::complex<double>* beta, std::complex<double>* c, strumpack_blas_int* ldc);
+      void STRUMPACK_FC_GLOBAL(cherk,CHERK)
+        (char* ul, char* t, strumpack_blas_int* n, strumpack_blas_int* k, float* alpha,
+         const std::complex<float>* a, strumpack_blas_int* lda, float* beta,
+         std::complex<float>* c, strumpack_blas_int* ldc);
+      void STRUMPACK_FC_GLOBAL(zherk,ZHERK)
+        (char* ul, char* t, strumpack_blas_int* n, strumpack_blas_int* k, double* alpha,
+         const std::complex<double>* a, strumpack_blas_int* lda, double* beta,
+         std::complex<double>* c, strumpack_blas_int* ldc);
+
       void STRUMPACK_FC_GLOBAL(strmm,STRMM)
         (char* s, char* ul, char* t, char* d, strumpack_blas_int* m, strumpack_blas_int* n, float* alpha,
          const float* a, strumpack_blas_int* lda, float* b, strumpack_blas_int* ldb);
@@ -1126,6 +1149,63 @@ namespace strumpack {
       STRUMPACK_BYTES(2*8*trsm_moves(m, n));
     }
 
+    void syrk(char ul, char t, int n, int k, float alpha,
+              const float* a, int lda, float beta, float* c, int ldc) {
+      strumpack_blas_int n_ = n, k_ = k, lda_ = lda, ldc_ = ldc;
+      STRUMPACK_FC_GLOBAL(ssyrk,SSYRK)
+        (&ul, &t, &n_, &k_, &alpha, a, &lda_, &beta, c, &ldc_);
+      STRUMPACK_FLOPS(syrk_flops(n, k));
+      STRUMPACK_BYTES(4*syrk_moves(n, k));
+    }
+    void syrk(char ul, char t, int n, int k, double alpha,
+              const double* a, int lda, double beta, double* c, int ldc) {
+      strumpack_blas_int n_ = n, k_ = k, lda_ = lda, ldc_ = ldc;
+      STRUMPACK_FC_GLOBAL(dsyrk,DSYRK)
+        (&ul, &t, &n_, &k_, &alpha, a, &lda_, &beta, c, &ldc_);
+      STRUMPACK_FLOPS(syrk_flops(n, k));
+      STRUMPACK_BYTES(8*syrk_moves(n, k));
+    }
+    void syrk(char ul, char t, int n, int k, std::complex<float> alpha,
+              const std::complex<float>* a, int lda, std::complex<float> beta, std::complex<float>* c, int ldc) {
+      strumpack_blas_int n_ = n, k_ = k, lda_ = lda, ldc_ = ldc;
+      STRUMPACK_FC_GLOBAL(csyrk,CSYRK)
+        (&ul, &t, &n_, &k_, &alpha, a, &lda_, &beta, c, &ldc_);
+      STRUMPACK_FLOPS(4*syrk_flops(n, k));
+      STRUMPACK_BYTES(2*4*syrk_moves(n, k));
+    }
+    void syrk(char ul, char t, int n, int k, std::complex<double> alpha,
+              const std::complex<double>* a, int lda, std::complex<double> beta, std::complex<double>* c, int ldc) {
+      strumpack_blas_int n_ = n, k_ = k, lda_ = lda, ldc_ = ldc;
+      STRUMPACK_FC_GLOBAL(zsyrk,ZSYRK)
+        (&ul, &t, &n_, &k_, &alpha, a, &lda_, &beta, c, &ldc_);
+      STRUMPACK_FLOPS(4*syrk_flops(n, k));
+      STRUMPACK_BYTES(2*8*syrk_moves(n, k));
+    }
+    void herk(char ul, char t, int n, int k, float alpha,
+              const float* a, int lda, float beta, float* c, int ldc) {
+      syrk(ul, t, n, k, alpha, a, lda, beta, c, ldc);
+    }
+    void herk(char ul, char t, int n, int k, double alpha,
+              const double* a, int lda, double beta, double* c, int ldc) {
+      syrk(ul, t, n, k, alpha, a, lda, beta, c, ldc);
+    }
+    void herk(char ul, char t, int n, int k, float alpha,
+              const std::complex<float>* a, int lda, float beta, std::complex<float>* c, int ldc) {
+      strumpack_blas_int n_ = n, k_ = k, lda_ = lda, ldc_ = ldc;
+      STRUMPACK_FC_GLOBAL(cherk,CHERK)
+        (&ul, &t, &n_, &k_, &alpha, a, &lda_, &beta, c, &ldc_);
+      STRUMPACK_FLOPS(4*syrk_flops(n, k));
+      STRUMPACK_BYTES(2*4*syrk_moves(n, k));
+    }
+    void herk(char ul, char t, int n, int k, double alpha,
+              const std::complex<double>* a, int lda, double beta, std::complex<double>* c, int ldc) {
+      strumpack_blas_int n_ = n, k_ = k, lda_ = lda, ldc_ = ldc;
+      STRUMPACK_FC_GLOBAL(zherk,ZHERK)
+        (&ul, &t, &n_, &k_, &alpha, a, &lda_, &beta, c, &ldc_);
+      STRUMPACK_FLOPS(4*syrk_flops(n, k));
+      STRUMPACK_BYTES(2*8*syrk_moves(n, k));
+    }
+
     void trmm(char s, char ul, char t, char d, int m, int n, float alpha,
               const float* a, int lda, float* b, int ldb) {
       strumpack_blas_int m_ = m, n_ = n, lda_ = lda, ldb_ = ldb;
@@ -470,6 +470,35 @@ namespace strumpack {
               const std::complex<double>* a, int lda,
               std::complex<double>* b, int ldb);
 
+    inline long long syrk_flops(long long n, long long k) {
+      return n * (n + 1) * k;
+    }
+    inline long long syrk_moves(long long n, long long k) {
+      return n * k + n * (n + 1);
+    }
+    void syrk(char ul, char t, int n, int k, float alpha,
+              const float* a, int lda, float beta, float* c, int ldc);
+    void syrk(char ul, char t, int n, int k, double alpha,
+              const double* a, int lda, double beta, double* c, int ldc);
+    void syrk(char ul, char t, int n, int k, std::complex<float> alpha,
+              const std::complex<float>* a, int lda,
+              std::complex<float> beta, std::complex<float>* c, int ldc);
+    void syrk(char ul, char t, int n, int k, std::complex<double> alpha,
+              const std::complex<double>* a, int lda,
+              std::complex<double> beta, std::complex<double>* c, int ldc);
+
+    // for real types, herk is the same as syrk
+    void herk(char ul, char t, int n, int k, float alpha,
+              const float* a, int lda, float beta, float* c, int ldc);
+    void herk(char ul, char t, int n, int k, double alpha,
+              const double* a, int lda, double beta, double* c, int ldc);
+    void herk(char ul, char t, int n, int k, float alpha,
+              const std::complex<float>* a, int lda, float beta,
+              std::complex<float>* c, int ldc);
+    void herk(char ul, char t, int n, int k, double alpha,
+              const std::complex<double>* a, int lda, double beta,
+              std::complex<double>* c, int ldc);
+
     template<typename scalar_t> inline
     long long trmm_flops(long long m, long long n, scalar_t alpha, char s) {
       if (s=='L' || s=='l')
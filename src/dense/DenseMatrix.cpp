@@ -43,6 +43,11 @@
 
 namespace strumpack {
 
+  // DenseMatrix::LU switches from the recursive getrf_omp_task to the
+  // tiled LU_tiled for (square) matrices of at least this size
+  const int LU_tiled_min_size = 2048;
+  const int LU_tiled_tile_size = 256;
+
   template<typename scalar_t> DenseMatrix<scalar_t>::DenseMatrix()
     : data_(nullptr), rows_(0), cols_(0), ld_(1) { }
 
@@ -174,19 +179,18 @@ namespace strumpack {
   (random::RandomGeneratorBase<typename RealType<scalar_t>::
    value_type>& rgen) {
     TIMER_TIME(TaskType::RANDOM_GENERATE, 1, t_gen);
-    for (std::size_t j=0; j<cols(); j++)
-      for (std::size_t i=0; i<rows(); i++)
-        operator()(i,j) = rgen.get();
+    if (is_complex<scalar_t>()) {
+      for (std::size_t j=0; j<cols(); j++)
+        for (std::size_t i=0; i<rows(); i++)
+          operator()(i,j) = rgen.get();
+    } else
+      rgen.fill(rows(), cols(), reinterpret_cast<real_t*>(data()), ld());
     STRUMPACK_FLOPS(rgen.flops_per_prng()*cols()*rows());
   }
 
   template<typename scalar_t> void DenseMatrix<scalar_t>::random() {
-    TIMER_TIME(TaskType::RANDOM_GENERATE, 1, t_gen);
     auto rgen = random::make_default_random_generator<real_t>();
-    for (std::size_t j=0; j<cols(); j++)
-      for (std::size_t i=0; i<rows(); i++)
-        operator()(i,j) = rgen->get();
-    STRUMPACK_FLOPS(rgen->flops_per_prng()*cols()*rows());
+    random(*rgen);
   }
 
   template<typename scalar_t> void DenseMatrix<scalar_t>::zero() {
@@ -582,17 +586,28 @@ namespace strumpack {
 #else
     bool in_par = false;
 #endif
-    if (in_par)
+    if (in_par) {
+      if (rows() == cols() && rows() >= LU_tiled_min_size) {
+        DenseMatrix<scalar_t> e;
+        return LU_tiled(*this, e, e, e, piv, LU_tiled_tile_size, 0, depth);
+      }
       return getrf_omp_task(rows(), cols(), data(), ld(), piv.data(), depth);
-    else
+    } else
       return blas::getrf(rows(), cols(), data(), ld(), piv.data());
   }
 
   template<typename scalar_t> int
   DenseMatrix<scalar_t>::Cholesky(int depth) {
     assert(rows() == cols());
-    // TODO openmp tasking ?
-    int info = blas::potrf('L', rows(), data(), ld());
+#if defined(_OPENMP)
+    bool in_par = depth < params::task_recursion_cutoff_level
+      && omp_in_parallel();
+#else
+    bool in_par = false;
+#endif
+    int info = in_par ?
+      potrf_omp_task('L', rows(), data(), ld(), depth) :
+      blas::potrf('L', rows(), data(), ld());
     if (info)
       std::cerr << "ERROR: Cholesky factorization failed with info="
                 << info << std::endl;
@@ -603,7 +618,15 @@ namespace strumpack {
   DenseMatrix<scalar_t>::LDLt(int depth) {
     assert(rows() == cols());
     std::vector<int> piv(rows());
-    int info = blas::sytrf('L', rows(), data(), ld(), piv.data());
+#if defined(_OPENMP)
+    bool in_par = depth < params::task_recursion_cutoff_level
+      && omp_in_parallel();
+#else
+    bool in_par = false;
+#endif
+    int info = in_par ?
+      sytrf_omp_task('L', rows(), data(), ld(), piv.data(), depth) :
+      blas::sytrf('L', rows(), data(), ld(), piv.data());
     if (info)
       std::cerr << "ERROR: LDLt factorization failed with info="
                 << info << std::endl;
@@ -1075,6 +1098,50 @@ namespace strumpack {
                  alpha, a.data(), a.ld(), b.data(), b.ld());
   }
 
+  template<typename scalar_t> void
+  trsm_LDLt(const DenseMatrix<scalar_t>& A, const std::vector<int>& piv,
+            DenseMatrix<scalar_t>& B, int depth) {
+    assert(A.rows() == A.cols() && B.rows() == A.rows());
+    assert(piv.size() >= A.rows());
+    if (!A.rows() || !B.cols()) return;
+    trsm_sytrf_omp_task
+      (A.rows(), B.cols(), A.data(), A.ld(), piv.data(),
+       B.data(), B.ld(), depth);
+  }
+
+  template<typename scalar_t> void
+  syrk_LDLt(const DenseMatrix<scalar_t>& A, const std::vector<int>& piv,
+            const DenseMatrix<scalar_t>& X, DenseMatrix<scalar_t>& C,
+            int depth) {
+    assert(A.rows() == A.cols() && X.rows() == A.rows());
+    assert(C.rows() == X.cols() && C.cols() == X.cols());
+    assert(piv.size() >= A.rows());
+    if (!A.rows() || !C.rows()) return;
+    syrk_sytrf_omp_task
+      (A.rows(), X.cols(), A.data(), A.ld(), piv.data(),
+       X.data(), X.ld(), C.data(), C.ld(), depth);
+  }
+
+  template<typename scalar_t> int
+  LU_tiled(DenseMatrix<scalar_t>& A11, DenseMatrix<scalar_t>& A12,
+           DenseMatrix<scalar_t>& A21, DenseMatrix<scalar_t>& A22,
+           std::vector<int>& piv, int nb,
+           typename RealType<scalar_t>::value_type thresh, int depth) {
+    assert(A11.rows() == A11.cols());
+    assert(A12.rows() == A11.rows() || A12.cols() == 0);
+    assert(A21.cols() == A11.cols() || A21.rows() == 0);
+    assert(A22.rows() == A21.rows() && A22.cols() == A12.cols());
+    int n1 = A11.rows(), n2 = A22.rows(), info = 0;
+    piv.resize(n1);
+#pragma omp parallel if(!omp_in_parallel()) default(shared)
+#pragma omp single nowait
+    info = getrf_tiled_omp_task
+      (n1, n2, A11.data(), A11.ld(), A12.data(), A12.ld(),
+       A21.data(), A21.ld(), A22.data(), A22.ld(),
+       piv.data(), nb, thresh, depth);
+    return info;
+  }
+
   /**
    * DTRSV  solves one of the systems of equations
    *
@@ -1365,6 +1432,48 @@ namespace strumpack {
        const DenseMatrix<std::complex<double>>& a,
        DenseMatrix<std::complex<double>>& b, int depth);
 
+  template void
+  trsm_LDLt(const DenseMatrix<float>& A, const std::vector<int>& piv,
+            DenseMatrix<float>& B, int depth);
+  template void
+  trsm_LDLt(const DenseMatrix<double>& A, const std::vector<int>& piv,
+            DenseMatrix<double>& B, int depth);
+  template void
+  trsm_LDLt(const DenseMatrix<std::complex<float>>& A, const std::vector<int>& piv,
+            DenseMatrix<std::complex<float>>& B, int depth);
+  template void
+  trsm_LDLt(const DenseMatrix<std::complex<double>>& A, const std::vector<int>& piv,
+            DenseMatrix<std::complex<double>>& B, int depth);
+  template void
+  syrk_LDLt(const DenseMatrix<float>& A, const std::vector<int>& piv,
+            const DenseMatrix<float>& X, DenseMatrix<float>& C, int depth);
+  template void
+  syrk_LDLt(const DenseMatrix<double>& A, const std::vector<int>& piv,
+            const DenseMatrix<double>& X, DenseMatrix<double>& C, int depth);
+  template void
+  syrk_LDLt(const DenseMatrix<std::complex<float>>& A, const std::vector<int>& piv,
+            const DenseMatrix<std::complex<float>>& X, DenseMatrix<std::complex<float>>& C, int depth);
+  template void
+  syrk_LDLt(const DenseMatrix<std::complex<double>>& A, const std::vector<int>& piv,
+            const DenseMatrix<std::complex<double>>& X, DenseMatrix<std::complex<double>>& C, int depth);
+
+  template int
+  LU_tiled(DenseMatrix<float>& A11, DenseMatrix<float>& A12,
+           DenseMatrix<float>& A21, DenseMatrix<float>& A22,
+           std::vector<int>& piv, int nb, float thresh, int depth);
+  template int
+  LU_tiled(DenseMatrix<double>& A11, DenseMatrix<double>& A12,
+           DenseMatrix<double>& A21, DenseMatrix<double>& A22,
+           std::vector<int>& piv, int nb, double thresh, int depth);
+  template int
+  LU_tiled(DenseMatrix<std::complex<float>>& A11, DenseMatrix<std::complex<float>>& A12,
+           DenseMatrix<std::complex<float>>& A21, DenseMatrix<std::complex<float>>& A22,
+           std::vector<int>& piv, int nb, float thresh, int depth);
+  template int
+  LU_tiled(DenseMatrix<std::complex<double>>& A11, DenseMatrix<std::complex<double>>& A12,
+           DenseMatrix<std::complex<double>>& A21, DenseMatrix<std::complex<double>>& A22,
+           std::vector<int>& piv, int nb, double thresh, int depth);
+
   template void
   trsv(UpLo ul, Trans ta, Diag d, const DenseMatrix<float>& a,
        DenseMatrix<float>& b, int depth);
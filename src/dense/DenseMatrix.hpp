@@ -692,7 +692,9 @@ namespace strumpack {
      * triangular with unit diagonal elements, and U is upper
      * triangular. This calls the LAPACK routine DGETRF. The L and U
      * factors are stored in place, the permutation is returned, and
-     * can be applied with the laswp() routine.
+     * can be applied with the laswp() routine. Inside an OpenMP
+     * parallel region, large matrices are factored with the tiled
+     * LU_tiled, smaller ones with a recursive task based algorithm.
      *
      * \param piv pivot vector, will be resized if necessary
      * \param depth current OpenMP task recursion depth
@@ -718,8 +720,9 @@ namespace strumpack {
 
     /**
      * Compute a Cholesky factorization of this matrix in-place. This
-     * calls the LAPACK routine DPOTRF. Only the lower triangle is
-     * written. Only the lower triangle is referenced/stored.
+     * calls the LAPACK routine DPOTRF, or, inside an OpenMP parallel
+     * region, a tiled task based algorithm. Only the lower triangle
+     * is written. Only the lower triangle is referenced/stored.
      *
      * \param depth current OpenMP task recursion depth
      * \return info from xpotrf
@@ -728,12 +731,14 @@ namespace strumpack {
     int Cholesky(int depth=0);
 
     /**
-     * Compute an LDLt factorization of this matrix in-place. This
-     * calls the LAPACK routine sytrf. Only the lower triangle is
-     * referenced/stored.
+     * Compute an LDLt factorization of this matrix in-place, using
+     * Bunch-Kaufman pivoting. This calls the LAPACK routine sytrf,
+     * or, inside an OpenMP parallel region, a blocked version with a
+     * task parallel trailing matrix update, which produces the same
+     * output format. Only the lower triangle is referenced/stored.
      *
      * \param depth current OpenMP task recursion depth
-     * \return info from xsytrf
+     * \return the pivot vector, in the LAPACK xsytrf format
      * \see LU, Cholesky, solve_LDLt
      */
     std::vector<int> LDLt(int depth=0);
@@ -1389,6 +1394,68 @@ namespace strumpack {
        const DenseMatrix<scalar_t>& a, DenseMatrix<scalar_t>& b,
        int depth=0);
 
+  /**
+   * Given the LDLt factorization P*L*D*L^T*P^T of A, computed with
+   * A.LDLt(), compute B := L^{-1} * P^T * B. This is the forward
+   * substitution of solve_LDLt_in_place, without the D^{-1}, but
+   * using level 3 BLAS and OpenMP tasks. For a symmetric front, with
+   * B = F12, this is followed by syrk_LDLt to compute the Schur
+   * complement.
+   *
+   * \param A LDLt factors, as returned by A.LDLt()
+   * \param piv pivot vector returned by A.LDLt()
+   * \param B right hand side, overwritten
+   * \param depth current OpenMP task recursion depth
+   */
+  template<typename scalar_t> void
+  trsm_LDLt(const DenseMatrix<scalar_t>& A, const std::vector<int>& piv,
+            DenseMatrix<scalar_t>& B, int depth=0);
+
+  /**
+   * Compute C := C - X^T * D^{-1} * X, only the lower triangle of C,
+   * with D the block diagonal (1x1 and 2x2 blocks) factor of the
+   * LDLt factorization of A. With X computed by trsm_LDLt from B,
+   * this is C - B^T * A^{-1} * B.
+   *
+   * \param A LDLt factors, as returned by A.LDLt()
+   * \param piv pivot vector returned by A.LDLt()
+   * \param X A.rows() x C.rows() matrix
+   * \param C symmetric matrix, lower triangle is updated
+   * \param depth current OpenMP task recursion depth
+   */
+  template<typename scalar_t> void
+  syrk_LDLt(const DenseMatrix<scalar_t>& A, const std::vector<int>& piv,
+            const DenseMatrix<scalar_t>& X, DenseMatrix<scalar_t>& C,
+            int depth=0);
+
+  /**
+   * Partial LU factorization, with partial pivoting restricted to the
+   * rows of A11, of the 2x2 block matrix [A11 A12; A21 A22]:
+   *
+   *   A11 = P * L11 * U11,  A12 := L11^{-1} * P^T * A12,
+   *   A21 := A21 * U11^{-1},  A22 := A22 - A21 * A12.
+   *
+   * This uses a tiled algorithm, where the panel factorizations, the
+   * triangular solves and the Schur complement update are all tasks
+   * in a single DAG, using OpenMP task dependencies, see
+   * getrf_tiled_omp_task. A12, A21 and A22 can be empty. A11 and A12
+   * and/or A21 can be views in the same matrix.
+   *
+   * \param piv pivot vector, will be resized to A11.rows()
+   * \param nb tile size
+   * \param thresh if positive, the diagonal elements of U11 that are
+   * smaller than thresh in absolute value, are replaced by +/- thresh
+   * \param depth current OpenMP task recursion depth
+   * \return if nonzero, the pivot in this column of A11 was exactly
+   * zero
+   */
+  template<typename scalar_t> int
+  LU_tiled(DenseMatrix<scalar_t>& A11, DenseMatrix<scalar_t>& A12,
+           DenseMatrix<scalar_t>& A21, DenseMatrix<scalar_t>& A22,
+           std::vector<int>& piv, int nb,
+           typename RealType<scalar_t>::value_type thresh=0,
+           int depth=0);
+
   /**
    * DTRSV  solves one of the systems of equations
    *
@@ -443,15 +443,9 @@ namespace strumpack {
 
   template<typename scalar_t> void DistributedMatrix<scalar_t>::random() {
     if (!active()) return;
-    TIMER_TIME(TaskType::RANDOM_GENERATE, 1, t_gen);
     auto rgen = random::make_default_random_generator<real_t>();
     rgen->seed(prow(), pcol());
-    int rlo, rhi, clo, chi;
-    lranges(rlo, rhi, clo, chi);
-    for (int c=clo; c<chi; ++c)
-      for (int r=rlo; r<rhi; ++r)
-        operator()(r,c) = rgen->get();
-    STRUMPACK_FLOPS(rgen->flops_per_prng()*(chi-clo)*(rhi-rlo));
+    random(*rgen);
   }
 
   template<typename scalar_t> void DistributedMatrix<scalar_t>::random
@@ -461,9 +455,13 @@ namespace strumpack {
     TIMER_TIME(TaskType::RANDOM_GENERATE, 1, t_gen);
     int rlo, rhi, clo, chi;
     lranges(rlo, rhi, clo, chi);
-    for (int c=clo; c<chi; ++c)
-      for (int r=rlo; r<rhi; ++r)
-        operator()(r,c) = rgen.get();
+    if (is_complex<scalar_t>()) {
+      for (int c=clo; c<chi; ++c)
+        for (int r=rlo; r<rhi; ++r)
+          operator()(r,c) = rgen.get();
+    } else
+      rgen.fill(rhi-rlo, chi-clo, reinterpret_cast<real_t*>
+                (data()+rlo+clo*ld()), ld());
     STRUMPACK_FLOPS(rgen.flops_per_prng()*(chi-clo)*(rhi-rlo));
   }
 
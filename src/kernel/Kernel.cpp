@@ -26,6 +26,17 @@
  *             Division).
  *
  */
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#if defined(__unix__) || defined(__APPLE__)
+#define STRUMPACK_KERNEL_USE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #include "KernelRegression.hpp"
 #include "Kernel.h"
 #if defined(STRUMPACK_USE_MPI)
@@ -40,14 +51,80 @@ template<typename scalar_t>
 class STRUMPACKKernelRegression {
 public:
   STRUMPACKKernelRegression() {}
+  ~STRUMPACKKernelRegression() {
+    K_.reset();
+    training_.reset();
+#if defined(STRUMPACK_KERNEL_USE_MMAP)
+    if (map_) munmap(map_, map_size_);
+#endif
+  }
   std::unique_ptr<Kernel<scalar_t>> K_;
   bool dist_ = false;
-  DenseMatrix<scalar_t> training_, weights_;
+  std::unique_ptr<DenseMatrix<scalar_t>> training_;
+  DenseMatrix<scalar_t> weights_;
+  // factored HSS matrix from the last (sequential) HSS fit, kept
+  // for solve_HSS and save, at the cost of its memory
+  std::unique_ptr<HSSMatrix<scalar_t>> H_;
+  scalar_t h_ = 0, lambda_ = 0;
+  int p_ = 1, type_ = 0;
+  // loaded with STRUMPACK_kernel_load, and the memory mapped file
+  bool loaded_ = false;
+  void* map_ = nullptr;
+  std::size_t map_size_ = 0;
 #if defined(STRUMPACK_USE_MPI)
   BLACSGrid grid_;
   DistributedMatrix<scalar_t> dweights_;
 #endif
+
+  void create_kernel() {
+    switch(type_) {
+    case 0:
+      K_.reset(new GaussKernel<scalar_t>(*training_, h_, lambda_));
+      break;
+    case 1:
+      K_.reset(new LaplaceKernel<scalar_t>(*training_, h_, lambda_));
+      break;
+    case 2:
+      K_.reset(new ANOVAKernel<scalar_t>(*training_, h_, lambda_, p_));
+      break;
+    default: std::cout << "ERROR: Kernel type not recognized!" << std::endl;
+    }
+  }
+
+  // after STRUMPACK_kernel_load, the training points are in the
+  // permuted order, and possibly memory mapped read-only. Fitting
+  // again permutes them, with labels in the original order, so
+  // first copy them back to the original order.
+  void unload() {
+    if (!loaded_) return;
+    training_.reset(new DenseMatrix<scalar_t>(*training_));
+    training_->lapmt(K_->permutation(), false);
+    create_kernel();
+#if defined(STRUMPACK_KERNEL_USE_MMAP)
+    if (map_) munmap(map_, map_size_);
+    map_ = nullptr;
+    map_size_ = 0;
+#endif
+    loaded_ = false;
+  }
+};
+
+/**
+ * Header of a kernel model file, followed (at offset
+ * model_data_offset) by the permuted training points (d x n), the
+ * weights (n), the permutation (n ints), the serialized cluster tree
+ * (size, followed by the ints), and finally the factored HSS matrix,
+ * see HSSMatrix::write_to.
+ */
+struct KernelModelHeader {
+  char magic[8];
+  int version[3];
+  int scalar_bytes, type, p, n, d;
+  double h, lambda;
 };
+static const char kernel_model_magic[8] =
+  {'S', 'P', 'K', 'R', 'R', 'M', 'D', 'L'};
+static const std::size_t model_data_offset = 256;
 
 template<typename scalar_t> STRUMPACKKernel STRUMPACK_create_kernel
 (int n, int d, scalar_t* train, scalar_t h, scalar_t lambda, int p, int type) {
@@ -61,43 +138,169 @@ template<typename scalar_t> STRUMPACKKernel STRUMPACK_create_kernel
     std::cout << "# C++, creating kernel: n=" << n << ", d=" << d
               << " h=" << h << " lambda=" << lambda << std::endl;
   auto kernel = new STRUMPACKKernelRegression<scalar_t>();
-  kernel->training_ = DenseMatrix<scalar_t>(d, n, train, d);
-  switch(type) {
-  case 0:
-    kernel->K_.reset(new GaussKernel<scalar_t>(kernel->training_, h, lambda));
-    break;
-  case 1:
-    kernel->K_.reset(new LaplaceKernel<scalar_t>(kernel->training_, h, lambda));
-    break;
-  case 2:
-    kernel->K_.reset(new ANOVAKernel<scalar_t>(kernel->training_, h, lambda, p));
-    break;
-  default: std::cout << "ERROR: Kernel type not recognized!" << std::endl;
-  }
+  kernel->training_.reset(new DenseMatrix<scalar_t>(d, n, train, d));
+  kernel->h_ = h;
+  kernel->lambda_ = lambda;
+  kernel->p_ = p;
+  kernel->type_ = type;
+  kernel->create_kernel();
   return kernel;
 }
 
+template<typename scalar_t> int STRUMPACK_kernel_save
+(STRUMPACKKernel kernel, const char* fname) {
+  auto KR = static_cast<STRUMPACKKernelRegression<scalar_t>*>(kernel);
+  const std::size_t n = KR->K_->n(), d = KR->K_->d();
+  if (KR->dist_ || KR->weights_.rows() != n || !KR->H_) {
+    std::cerr << "ERROR: only a kernel fitted with "
+              << "STRUMPACK_kernel_fit_HSS can be saved." << std::endl;
+    return 1;
+  }
+  std::ofstream f(fname, std::ios::out | std::ios::trunc | std::ios::binary);
+  if (!f.good()) {
+    std::cerr << "ERROR: could not open " << fname << std::endl;
+    return 1;
+  }
+  KernelModelHeader hdr;
+  std::memcpy(hdr.magic, kernel_model_magic, sizeof(hdr.magic));
+  get_version(hdr.version, hdr.version+1, hdr.version+2);
+  hdr.scalar_bytes = sizeof(scalar_t);
+  hdr.type = KR->type_;
+  hdr.p = KR->p_;
+  hdr.n = n;
+  hdr.d = d;
+  hdr.h = KR->h_;
+  hdr.lambda = KR->lambda_;
+  char buf[model_data_offset];
+  std::fill(buf, buf+model_data_offset, 0);
+  std::memcpy(buf, &hdr, sizeof(hdr));
+  f.write(buf, model_data_offset);
+  const auto& X = KR->K_->data();
+  for (std::size_t j=0; j<n; j++)
+    f.write((const char*)X.ptr(0, j), d*sizeof(scalar_t));
+  f.write((const char*)KR->weights_.data(), n*sizeof(scalar_t));
+  auto& perm = KR->K_->permutation();
+  std::vector<int> p(n);
+  std::copy(perm.begin(), perm.end(), p.begin());
+  f.write((const char*)p.data(), n*sizeof(int));
+  auto t = KR->K_->tree().serialize();
+  int ts = t.size();
+  f.write((const char*)&ts, sizeof(ts));
+  f.write((const char*)t.data(), ts*sizeof(int));
+  KR->H_->write_to(f);
+  return f.good() ? 0 : 1;
+}
+
+template<typename scalar_t> STRUMPACKKernel STRUMPACK_kernel_load
+(const char* fname) {
+  std::ifstream f(fname, std::ios::in | std::ios::binary);
+  KernelModelHeader hdr;
+  if (!f.good() || !f.read((char*)&hdr, sizeof(hdr)) ||
+      std::memcmp(hdr.magic, kernel_model_magic, sizeof(hdr.magic))) {
+    std::cerr << "ERROR: " << fname
+              << " is not a STRUMPACK kernel model file." << std::endl;
+    return nullptr;
+  }
+  if (hdr.scalar_bytes != sizeof(scalar_t)) {
+    std::cerr << "ERROR: kernel model " << fname
+              << " was stored in a different precision." << std::endl;
+    return nullptr;
+  }
+  const std::size_t n = hdr.n, d = hdr.d;
+  auto KR = new STRUMPACKKernelRegression<scalar_t>();
+  KR->h_ = hdr.h;
+  KR->lambda_ = hdr.lambda;
+  KR->p_ = hdr.p;
+  KR->type_ = hdr.type;
+  // the training points are the bulk of the file, these are memory
+  // mapped read-only, and copied only when the model is fitted again
+  std::size_t train_bytes = d*n*sizeof(scalar_t);
+#if defined(STRUMPACK_KERNEL_USE_MMAP)
+  int fd = open(fname, O_RDONLY);
+  if (fd != -1) {
+    std::size_t bytes = model_data_offset + train_bytes;
+    void* map = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map != MAP_FAILED) {
+      KR->map_ = map;
+      KR->map_size_ = bytes;
+      KR->training_.reset
+        (new DenseMatrixWrapper<scalar_t>
+         (d, n, (scalar_t*)((char*)map + model_data_offset), d));
+    }
+  }
+#endif
+  if (!KR->training_) {
+    KR->training_.reset(new DenseMatrix<scalar_t>(d, n));
+    f.seekg(model_data_offset);
+    f.read((char*)KR->training_->data(), train_bytes);
+  }
+  KR->create_kernel();
+  f.seekg(model_data_offset + train_bytes);
+  KR->weights_ = DenseMatrix<scalar_t>(n, 1);
+  f.read((char*)KR->weights_.data(), n*sizeof(scalar_t));
+  std::vector<int> p(n);
+  f.read((char*)p.data(), n*sizeof(int));
+  KR->K_->permutation() = p;
+  int ts = 0;
+  f.read((char*)&ts, sizeof(ts));
+  std::vector<int> t(ts);
+  f.read((char*)t.data(), ts*sizeof(int));
+  KR->K_->tree() = structured::ClusterTree::deserialize(t);
+  KR->H_.reset(new HSSMatrix<scalar_t>(HSSMatrix<scalar_t>::read_from(f)));
+  KR->loaded_ = true;
+  if (!f.good()) {
+    std::cerr << "ERROR: failed to read kernel model "
+              << fname << std::endl;
+    delete KR;
+    return nullptr;
+  }
+  return KR;
+}
+
 template<typename scalar_t> void STRUMPACK_kernel_fit_HSS
 (STRUMPACKKernel kernel, scalar_t* labels, int argc, char* argv[]) {
   auto KR = static_cast<STRUMPACKKernelRegression<scalar_t>*>(kernel);
+  KR->unload();
   std::vector<scalar_t> vl(labels, labels+KR->K_->n());
   HSSOptions<scalar_t> opts;
   opts.set_verbose(false);
   opts.set_clustering_algorithm(ClusteringAlgorithm::COBBLE);
   opts.set_from_command_line(argc, argv);
-  KR->weights_ = KR->K_->fit_HSS(vl, opts);
+  KR->H_.reset(new HSSMatrix<scalar_t>());
+  KR->weights_ = KR->K_->fit_HSS(vl, opts, *KR->H_);
+  KR->dist_ = false;
+}
+
+template<typename scalar_t> void STRUMPACK_kernel_solve_HSS
+(STRUMPACKKernel kernel, scalar_t* labels) {
+  auto KR = static_cast<STRUMPACKKernelRegression<scalar_t>*>(kernel);
+  if (!KR->H_) {
+    std::cerr << "ERROR: STRUMPACK_kernel_solve_HSS requires "
+              << "STRUMPACK_kernel_fit_HSS or STRUMPACK_kernel_load."
+              << std::endl;
+    return;
+  }
+  auto n = KR->K_->n();
+  DenseMatrix<scalar_t> weights(n, 1, labels, n);
+  weights.lapmr(KR->K_->permutation(), true);
+  KR->H_->solve(weights);
+  KR->weights_ = std::move(weights);
+  KR->dist_ = false;
 }
 
 #if defined(STRUMPACK_USE_MPI)
 template<typename scalar_t> void STRUMPACK_kernel_fit_HSS_MPI
 (STRUMPACKKernel kernel, scalar_t* labels, int argc, char* argv[]) {
   auto KR = static_cast<STRUMPACKKernelRegression<scalar_t>*>(kernel);
+  KR->unload();
   KR->grid_ = std::move(BLACSGrid(MPIComm(MPI_COMM_WORLD)));
   std::vector<scalar_t> vl(labels, labels+KR->K_->n());
   HSSOptions<scalar_t> opts;
   opts.set_verbose(false);
   opts.set_clustering_algorithm(ClusteringAlgorithm::COBBLE);
   opts.set_from_command_line(argc, argv);
+  KR->H_.reset();
   KR->dweights_ = KR->K_->fit_HSS(KR->grid_, vl, opts);
   KR->dist_ = true;
 }
@@ -106,11 +309,13 @@ template<typename scalar_t> void STRUMPACK_kernel_fit_HODLR_MPI
 (STRUMPACKKernel kernel, scalar_t* labels, int argc, char* argv[]) {
 #if defined(STRUMPACK_USE_BPACK)
   auto KR = static_cast<STRUMPACKKernelRegression<scalar_t>*>(kernel);
+  KR->unload();
   std::vector<scalar_t> vl(labels, labels+KR->K_->n());
   HODLR::HODLROptions<scalar_t> opts;
   opts.set_verbose(false);
   opts.set_clustering_algorithm(ClusteringAlgorithm::COBBLE);
   opts.set_from_command_line(argc, argv);
+  KR->H_.reset();
   KR->weights_ = KR->K_->fit_HODLR(MPI_COMM_WORLD, vl, opts);
 #else
   std::cerr << "ERROR: STRUMPACK was not configured with HODLR support."
@@ -185,6 +390,31 @@ extern "C" {
   }
 #endif
 
+  void STRUMPACK_kernel_solve_HSS_double
+  (STRUMPACKKernel kernel, double* labels) {
+    STRUMPACK_kernel_solve_HSS<double>(kernel, labels);
+  }
+  void STRUMPACK_kernel_solve_HSS_float
+  (STRUMPACKKernel kernel, float* labels) {
+    STRUMPACK_kernel_solve_HSS<float>(kernel, labels);
+  }
+
+  int STRUMPACK_kernel_save_double
+  (STRUMPACKKernel kernel, const char* fname) {
+    return STRUMPACK_kernel_save<double>(kernel, fname);
+  }
+  int STRUMPACK_kernel_save_float
+  (STRUMPACKKernel kernel, const char* fname) {
+    return STRUMPACK_kernel_save<float>(kernel, fname);
+  }
+
+  STRUMPACKKernel STRUMPACK_kernel_load_double(const char* fname) {
+    return STRUMPACK_kernel_load<double>(fname);
+  }
+  STRUMPACKKernel STRUMPACK_kernel_load_float(const char* fname) {
+    return STRUMPACK_kernel_load<float>(fname);
+  }
+
   void STRUMPACK_kernel_predict_double
   (STRUMPACKKernel kernel, int m, double* test, double* prediction) {
     STRUMPACK_kernel_predict<double>(kernel, m, test, prediction);
@@ -48,6 +48,14 @@ extern "C" {
   void STRUMPACK_destroy_kernel_double(STRUMPACKKernel K);
   void STRUMPACK_destroy_kernel_float(STRUMPACKKernel K);
 
+  /**
+   * Fit the kernel with an HSS approximation of the kernel
+   * matrix. The factored HSS matrix is kept in the kernel, for
+   * STRUMPACK_kernel_solve_HSS and STRUMPACK_kernel_save, until the
+   * kernel is refitted or destroyed. This increases the resident
+   * memory by the size of the HSS matrix and its ULV factors,
+   * compared to keeping only the weights.
+   */
   void STRUMPACK_kernel_fit_HSS_double
   (STRUMPACKKernel K, double* labels, int argc, char* argv[]);
   void STRUMPACK_kernel_fit_HSS_float
@@ -71,6 +79,38 @@ extern "C" {
   (STRUMPACKKernel K, float* labels, int argc, char* argv[]);
 #endif
 
+  /**
+   * Compute new weights for the given labels, reusing the factored
+   * HSS matrix from STRUMPACK_kernel_fit_HSS, or from a model loaded
+   * with STRUMPACK_kernel_load. There is no recompression or
+   * refactorization.
+   */
+  void STRUMPACK_kernel_solve_HSS_double(STRUMPACKKernel K, double* labels);
+  void STRUMPACK_kernel_solve_HSS_float(STRUMPACKKernel K, float* labels);
+
+  /**
+   * Store a kernel, fitted with STRUMPACK_kernel_fit_HSS, to a single
+   * binary file. This contains the kernel parameters, the (permuted)
+   * training points, the weights, the permutation, the cluster tree
+   * and the factored HSS matrix, with a file format version. Returns
+   * 0 on success.
+   */
+  int STRUMPACK_kernel_save_double(STRUMPACKKernel K, const char* fname);
+  int STRUMPACK_kernel_save_float(STRUMPACKKernel K, const char* fname);
+
+  /**
+   * Load a kernel stored with STRUMPACK_kernel_save. The training
+   * points are memory mapped (read-only) where supported, and only
+   * copied if the kernel is fitted again. The returned kernel
+   * can be used for prediction, or in STRUMPACK_kernel_solve_HSS,
+   * without refitting. Returns NULL on failure, also for a model
+   * stored with an HSS file format version that is no longer
+   * supported. Destroy with
+   * STRUMPACK_destroy_kernel.
+   */
+  STRUMPACKKernel STRUMPACK_kernel_load_double(const char* fname);
+  STRUMPACKKernel STRUMPACK_kernel_load_float(const char* fname);
+
   /**
    * This works for both sequential and MPI fits.
    */
@@ -37,6 +37,7 @@
 #define STRUMPACK_KERNEL_HPP
 
 #include "Metrics.hpp"
+#include "structured/ClusterTree.hpp"
 #include "HSS/HSSOptions.hpp"
 #include "dense/DenseMatrix.hpp"
 #if defined(STRUMPACK_USE_MPI)
@@ -48,6 +49,11 @@
 
 namespace strumpack {
 
+  // forward declaration
+  namespace HSS {
+    template<typename scalar_t> class HSSMatrix;
+  }
+
   /**
    * Defines simple kernel matrix definitions and kernel regression.
    */
@@ -90,7 +96,9 @@ namespace strumpack {
        * diagonal.
        */
       Kernel(DenseM_t& data, scalar_t lambda)
-        : data_(data), lambda_(lambda) { }
+        : data_(data), lambda_(lambda) {
+        update_norms();
+      }
 
       /**
        * Default constructor.
@@ -139,11 +147,8 @@ namespace strumpack {
                       const std::vector<std::size_t>& J,
                       DenseMatrix<real_t>& B) const {
         assert(B.rows() == I.size() && B.cols() == J.size());
-        for (std::size_t j=0; j<J.size(); j++)
-          for (std::size_t i=0; i<I.size(); i++) {
-            assert(I[i] < n() && J[j] < n());
-            B(i, j) = eval(I[i], J[j]);
-          }
+        if (I.empty() || J.empty()) return;
+        eval_block(I, J, B);
       }
 
       /**
@@ -161,11 +166,12 @@ namespace strumpack {
                       const std::vector<std::size_t>& J,
                       DenseMatrix<std::complex<real_t>>& B) const {
         assert(B.rows() == I.size() && B.cols() == J.size());
+        if (I.empty() || J.empty()) return;
+        DenseM_t KIJ(I.size(), J.size());
+        eval_block(I, J, KIJ);
         for (std::size_t j=0; j<J.size(); j++)
-          for (std::size_t i=0; i<I.size(); i++) {
-            assert(I[i] < n() && J[j] < n());
-            B(i, j) = eval(I[i], J[j]);
-          }
+          for (std::size_t i=0; i<I.size(); i++)
+            B(i, j) = KIJ(i, j);
       }
 
       /**
@@ -189,6 +195,25 @@ namespace strumpack {
       DenseM_t fit_HSS
       (std::vector<scalar_t>& labels, const HSS::HSSOptions<scalar_t>& opts);
 
+      /**
+       * Same as fit_HSS(labels, opts), but the compressed and
+       * factored HSS matrix is returned in H. This can be used to
+       * compute weights for other labels, without recompression and
+       * refactorization, or to store the HSS matrix.
+       *
+       * \param labels Binary labels, supposed to be in {-1, 1}.
+       * Should be labels.size() == this->n().
+       * \param opts HSS options
+       * \param H output, the factored HSS approximation of the kernel
+       * matrix, in the permuted order.
+       * \return A vector (1 column matrix) with scalar weights, to be
+       * used in predict
+       * \see fit_HSS, predict
+       */
+      DenseM_t fit_HSS
+      (std::vector<scalar_t>& labels, const HSS::HSSOptions<scalar_t>& opts,
+       HSS::HSSMatrix<scalar_t>& H);
+
       /**
        * Return prediction scores for the test points, using the
        * weights computed in fit_HSS() or fit_HODLR().
@@ -203,6 +228,30 @@ namespace strumpack {
       std::vector<scalar_t> predict
       (const DenseM_t& test, const DenseM_t& weights) const;
 
+      /**
+       * Return prediction scores for the test points, using the
+       * weights computed in fit_HSS() or fit_HODLR(). This uses a
+       * tree code over the cluster tree from the fitting: the
+       * contribution of a cluster of training points which is far
+       * enough from a test point is approximated by the sum of the
+       * weights in that cluster times a single kernel value. The
+       * other (near-field) clusters are evaluated directly, in
+       * blocks. This is only accelerated for kernels which implement
+       * kernel_bounds (Gauss and Laplace), otherwise all clusters
+       * are evaluated directly.
+       *
+       * \param test Test data set, should be test.rows() == this->d()
+       * \param weights Weights computed by fit_HSS() or fit_HODLR()
+       * \param tol Absolute tolerance, relative to the 1-norm of the
+       * weights. The error on each prediction is bounded by tol *
+       * ||weights||_1. With tol = 0 the result is exact, up to
+       * roundoff.
+       * \return Vector with prediction scores.
+       * \see predict, fit_HSS, fit_HODLR
+       */
+      std::vector<scalar_t> predict
+      (const DenseM_t& test, const DenseM_t& weights, real_t tol) const;
+
 #if defined(STRUMPACK_USE_MPI)
       /**
        * Compute weights for kernel ridge regression
@@ -242,6 +291,19 @@ namespace strumpack {
       std::vector<scalar_t> predict
       (const DenseM_t& test, const DistM_t& weights) const;
 
+      /**
+       * Tree code prediction with distributed weights, see
+       * predict(const DenseM_t&, const DenseM_t&, real_t).
+       *
+       * \param test Test data set, should be test.rows() == this->d()
+       * \param weights Weights computed by fit_HSS()
+       * \param tol Absolute tolerance, relative to the 1-norm of the
+       * weights.
+       * \return Vector with prediction scores.
+       */
+      std::vector<scalar_t> predict
+      (const DenseM_t& test, const DistM_t& weights, real_t tol) const;
+
 #if defined(STRUMPACK_USE_BPACK)
       /**
        * Compute weights for kernel ridge regression
@@ -284,14 +346,142 @@ namespace strumpack {
       std::vector<int>& permutation() { return perm_; }
       const std::vector<int>& permutation() const { return perm_; }
 
+      /**
+       * The cluster tree corresponding to the (permuted) data
+       * points. This is set when the data points are clustered in
+       * the HSS or HODLR construction, and is used by the tree code
+       * in predict.
+       */
+      structured::ClusterTree& tree() { return tree_; }
+      const structured::ClusterTree& tree() const { return tree_; }
+
       virtual void permute() {
         data_.lapmr(perm_, true);
+        update_norms();
+      }
+
+      /**
+       * Recompute the cached squared 2-norms of the data points. This
+       * is called from the constructor and from permute(), but needs
+       * to be called explicitly when the data points are modified
+       * (or reordered, for instance by the clustering) after
+       * construction of the kernel.
+       */
+      void update_norms() {
+        const auto d = this->d();
+        sqnorms_.resize(n());
+        for (std::size_t j=0; j<n(); j++) {
+          real_t nrm(0.);
+          auto x = data_.ptr(0, j);
+          for (std::size_t k=0; k<d; k++)
+            nrm += std::real(x[k] * blas::my_conj(x[k]));
+          sqnorms_[j] = nrm;
+        }
       }
 
     protected:
       DenseM_t& data_;
       scalar_t lambda_;
       std::vector<int> perm_;
+      std::vector<real_t> sqnorms_;
+      structured::ClusterTree tree_;
+
+      /**
+       * Evaluate the submatrix K(I,J) into B. The default
+       * implementation gathers the data points for I and J in
+       * contiguous buffers and calls kernel_block.
+       *
+       * \param I set of row indices, not empty
+       * \param J set of column indices, not empty
+       * \param B output, of size I.size() x J.size()
+       */
+      virtual void eval_block(const std::vector<std::size_t>& I,
+                              const std::vector<std::size_t>& J,
+                              DenseM_t& B) const {
+        auto XI = gather_points(I);
+        auto XJ = gather_points(J);
+        std::vector<real_t> nI(I.size()), nJ(J.size());
+        for (std::size_t i=0; i<I.size(); i++) nI[i] = sqnorms_[I[i]];
+        for (std::size_t j=0; j<J.size(); j++) nJ[j] = sqnorms_[J[j]];
+        kernel_block(XI, nI.data(), XJ, nJ.data(), B);
+        add_regularization(I, J, B);
+      }
+
+      /**
+       * Evaluate the kernel function for all pairs of columns of X
+       * and Y, B(i,j) = k(X(:,i), Y(:,j)), without the
+       * regularization. The default implementation calls
+       * eval_kernel_function for each entry. Subclasses can override
+       * this with a blocked implementation.
+       *
+       * \param X d() x m matrix of points
+       * \param nX squared 2-norms of the columns of X
+       * \param Y d() x n matrix of points
+       * \param nY squared 2-norms of the columns of Y
+       * \param B output, of size m x n
+       */
+      virtual void kernel_block(const DenseM_t& X, const real_t* nX,
+                                const DenseM_t& Y, const real_t* nY,
+                                DenseM_t& B) const {
+        for (std::size_t j=0; j<Y.cols(); j++)
+          for (std::size_t i=0; i<X.cols(); i++)
+            B(i, j) = eval_kernel_function(X.ptr(0, i), Y.ptr(0, j));
+      }
+
+      /**
+       * Compute bounds on the kernel function k(x,y), for any points
+       * x and y with \f$d_{min} \leq \|x-y\|_2 \leq d_{max}\f$. This
+       * is used for the far-field approximation in the tree code
+       * prediction.
+       *
+       * \param dmin lower bound on the Euclidean distance
+       * \param dmax upper bound on the Euclidean distance
+       * \param kmin output, lower bound on the kernel function
+       * \param kmax output, upper bound on the kernel function
+       * \return false if no bounds are available for this kernel
+       */
+      virtual bool kernel_bounds(real_t dmin, real_t dmax,
+                                 real_t& kmin, real_t& kmax) const {
+        return false;
+      }
+
+      /**
+       * Copy the data points with indices I to the columns of a
+       * d() x I.size() matrix.
+       */
+      DenseM_t gather_points(const std::vector<std::size_t>& I) const {
+        const auto d = this->d();
+        DenseM_t X(d, I.size());
+        for (std::size_t i=0; i<I.size(); i++) {
+          assert(I[i] < n());
+          std::copy(data_.ptr(0, I[i]), data_.ptr(0, I[i])+d, X.ptr(0, i));
+        }
+        return X;
+      }
+
+      /**
+       * Tree code evaluation of the prediction scores, see predict.
+       * Adds to pred.
+       *
+       * \param test test points, test.rows() == d()
+       * \param w weights, of size n(), in the (permuted) order of
+       * the data points
+       * \param tol absolute tolerance relative to ||w||_1
+       * \param pred prediction scores, of size test.cols()
+       */
+      void tree_code_predict(const DenseM_t& test, const scalar_t* w,
+                             real_t tol, std::vector<scalar_t>& pred) const;
+
+      /**
+       * Add lambda to all entries of B for which I[i] == J[j].
+       */
+      void add_regularization(const std::vector<std::size_t>& I,
+                              const std::vector<std::size_t>& J,
+                              DenseM_t& B) const {
+        for (std::size_t j=0; j<J.size(); j++)
+          for (std::size_t i=0; i<I.size(); i++)
+            if (I[i] == J[j]) B(i, j) += lambda_;
+      }
 
       /**
        * Purely virtual function that needs to be defined in the
@@ -331,6 +521,8 @@ namespace strumpack {
      */
     template<typename scalar_t>
     class GaussKernel : public Kernel<scalar_t> {
+      using real_t = typename RealType<scalar_t>::value_type;
+
     public:
       /**
        * Constructor of the kernel object.
@@ -354,6 +546,33 @@ namespace strumpack {
           (-Euclidean_distance_squared(this->d(), x, y)
            / (scalar_t(2.) * h_ * h_));
       }
+
+      bool kernel_bounds(real_t dmin, real_t dmax,
+                         real_t& kmin, real_t& kmax) const override {
+        const real_t s = real_t(-1.) / (real_t(2.) * h_ * h_);
+        kmax = std::exp(s * dmin * dmin);
+        kmin = std::exp(s * dmax * dmax);
+        return true;
+      }
+
+      /**
+       * Blocked evaluation, using \f$\|x-y\|_2^2 = \|x\|_2^2 +
+       * \|y\|_2^2 - 2 x^T y\f$, where the inner products for all
+       * pairs are computed with a single gemm.
+       */
+      void kernel_block(const DenseMatrix<scalar_t>& X, const real_t* nX,
+                        const DenseMatrix<scalar_t>& Y, const real_t* nY,
+                        DenseMatrix<scalar_t>& B) const override {
+        const auto m = X.cols(), n = Y.cols();
+        gemm(Trans::C, Trans::N, scalar_t(-2.), X, Y, scalar_t(0.), B);
+        const scalar_t s = scalar_t(-1.) / (scalar_t(2.) * h_ * h_);
+        for (std::size_t j=0; j<n; j++) {
+          auto Bj = B.ptr(0, j);
+          for (std::size_t i=0; i<m; i++)
+            Bj[i] = std::exp
+              (s * std::max(real_t(0.), std::real(Bj[i]) + nX[i] + nY[j]));
+        }
+      }
     };
 
 
@@ -376,6 +595,8 @@ namespace strumpack {
      */
     template<typename scalar_t>
     class LaplaceKernel : public Kernel<scalar_t> {
+      using real_t = typename RealType<scalar_t>::value_type;
+
     public:
       /**
        * Constructor of the kernel object.
@@ -397,6 +618,42 @@ namespace strumpack {
       (const scalar_t* x, const scalar_t* y) const override {
         return std::exp(-norm1_distance(this->d(), x, y) / h_);
       }
+
+      /**
+       * Uses \f$\|v\|_2 \leq \|v\|_1 \leq \sqrt{d} \|v\|_2\f$.
+       */
+      bool kernel_bounds(real_t dmin, real_t dmax,
+                         real_t& kmin, real_t& kmax) const override {
+        kmax = std::exp(-dmin / h_);
+        kmin = std::exp(-std::sqrt(real_t(this->d())) * dmax / h_);
+        return true;
+      }
+
+      /**
+       * Blocked evaluation. The 1-norm distance does not map to a
+       * gemm, but with the points X stored transposed, the distances
+       * are accumulated one feature at a time over contiguous columns
+       * of B.
+       */
+      void kernel_block(const DenseMatrix<scalar_t>& X, const real_t*,
+                        const DenseMatrix<scalar_t>& Y, const real_t*,
+                        DenseMatrix<scalar_t>& B) const override {
+        const auto m = X.cols(), n = Y.cols(), d = this->d();
+        auto Xt = X.conj_transpose();
+        for (std::size_t j=0; j<n; j++) {
+          auto y = Y.ptr(0, j);
+          auto Bj = B.ptr(0, j);
+          std::fill(Bj, Bj+m, scalar_t(0.));
+          for (std::size_t k=0; k<d; k++) {
+            const auto yk = y[k];
+            const auto xk = Xt.ptr(0, k);
+            for (std::size_t i=0; i<m; i++)
+              Bj[i] += std::abs(xk[i] - yk);
+          }
+          for (std::size_t i=0; i<m; i++)
+            Bj[i] = std::exp(-Bj[i] / h_);
+        }
+      }
     };
 
     /**
@@ -422,6 +679,8 @@ namespace strumpack {
      */
     template<typename scalar_t>
     class ANOVAKernel : public Kernel<scalar_t> {
+      using real_t = typename RealType<scalar_t>::value_type;
+
     public:
       /**
        * Constructor of the kernel object.
@@ -468,6 +727,53 @@ namespace strumpack {
         }
         return Kpp[p_];
       }
+
+      /**
+       * Blocked evaluation. For every column of B, the power sums
+       * Kss are accumulated one feature at a time for all rows, with
+       * the points X stored transposed so that the inner loop is
+       * contiguous. The recurrence is then applied elementwise.
+       */
+      void kernel_block(const DenseMatrix<scalar_t>& X, const real_t*,
+                        const DenseMatrix<scalar_t>& Y, const real_t*,
+                        DenseMatrix<scalar_t>& B) const override {
+        const auto m = X.cols(), n = Y.cols(), d = this->d();
+        auto Xt = X.conj_transpose();
+        const scalar_t s = scalar_t(-1.) / (scalar_t(2.) * h_ * h_);
+        DenseMatrix<scalar_t> Kss(m, p_), Kpp(m, p_+1);
+        std::vector<scalar_t> tmp(m), Ks(m);
+        for (std::size_t j=0; j<n; j++) {
+          auto y = Y.ptr(0, j);
+          Kss.zero();
+          for (std::size_t k=0; k<d; k++) {
+            const auto yk = y[k];
+            const auto xk = Xt.ptr(0, k);
+            for (std::size_t i=0; i<m; i++) {
+              auto xy = xk[i] - yk;
+              tmp[i] = Ks[i] = std::exp(s * xy * xy);
+            }
+            for (int q=0; q<p_; q++) {
+              if (q) for (std::size_t i=0; i<m; i++) Ks[i] *= tmp[i];
+              auto Kssq = Kss.ptr(0, q);
+              for (std::size_t i=0; i<m; i++) Kssq[i] += Ks[i];
+            }
+          }
+          std::fill(Kpp.ptr(0, 0), Kpp.ptr(0, 0)+m, scalar_t(1.));
+          for (int q=1; q<=p_; q++) {
+            auto Kppq = Kpp.ptr(0, q);
+            std::fill(Kppq, Kppq+m, scalar_t(0.));
+            for (int r=1; r<=q; r++) {
+              const scalar_t sgn = (r % 2) ? scalar_t(1.) : scalar_t(-1.);
+              auto Kppqr = Kpp.ptr(0, q-r);
+              auto Kssr = Kss.ptr(0, r-1);
+              for (std::size_t i=0; i<m; i++)
+                Kppq[i] += sgn * Kppqr[i] * Kssr[i];
+            }
+            for (std::size_t i=0; i<m; i++) Kppq[i] /= q;
+          }
+          std::copy(Kpp.ptr(0, p_), Kpp.ptr(0, p_)+m, B.ptr(0, j));
+        }
+      }
     };
 
 
@@ -503,6 +809,14 @@ namespace strumpack {
         return A_(i, j) + ((i == j) ? this->lambda_ : scalar_t(0.));
       }
 
+      void eval_block(const std::vector<std::size_t>& I,
+                      const std::vector<std::size_t>& J,
+                      DenseMatrix<scalar_t>& B) const override {
+        for (std::size_t j=0; j<J.size(); j++)
+          for (std::size_t i=0; i<I.size(); i++)
+            B(i, j) = eval(I[i], J[j]);
+      }
+
       void permute() override {
         Kernel<scalar_t>::permute();
         A_.lapmt(this->perm_, true);
@@ -36,6 +36,9 @@
 #ifndef STRUMPACK_KERNEL_REGRESSION_HPP
 #define STRUMPACK_KERNEL_REGRESSION_HPP
 
+#include <functional>
+#include <algorithm>
+
 #include "misc/TaskTimer.hpp"
 #include "Kernel.hpp"
 #include "HSS/HSSMatrix.hpp"
@@ -55,11 +58,19 @@ namespace strumpack {
     template<typename scalar_t>
     DenseMatrix<scalar_t> Kernel<scalar_t>::fit_HSS
     (std::vector<scalar_t>& labels, const HSS::HSSOptions<scalar_t>& opts) {
+      HSS::HSSMatrix<scalar_t> H;
+      return fit_HSS(labels, opts, H);
+    }
+
+    template<typename scalar_t>
+    DenseMatrix<scalar_t> Kernel<scalar_t>::fit_HSS
+    (std::vector<scalar_t>& labels, const HSS::HSSOptions<scalar_t>& opts,
+     HSS::HSSMatrix<scalar_t>& H) {
       TaskTimer timer("compression");
       if (opts.verbose())
         std::cout << "# starting HSS compression..." << std::endl;
       timer.start();
-      HSS::HSSMatrix<scalar_t> H(*this, opts);
+      H = HSS::HSSMatrix<scalar_t>(*this, opts);
       DenseMW_t B(1, n(), labels.data(), 1);
       B.lapmt(perm_, true);
       //perm_.clear(); // TODO not needed anymore??
@@ -122,6 +133,137 @@ namespace strumpack {
       return prediction;
     }
 
+    template<typename scalar_t>
+    std::vector<scalar_t> Kernel<scalar_t>::predict
+    (const DenseM_t& test, const DenseM_t& weights, real_t tol) const {
+      assert(test.rows() == d());
+      std::vector<scalar_t> prediction(test.cols());
+      tree_code_predict(test, weights.data(), tol, prediction);
+      return prediction;
+    }
+
+    template<typename scalar_t> void Kernel<scalar_t>::tree_code_predict
+    (const DenseM_t& test, const scalar_t* w, real_t tol,
+     std::vector<scalar_t>& pred) const {
+      struct Node {
+        std::size_t lo, size;
+        int c0 = -1, c1 = -1, leaf = -1;
+        real_t r = 0, wabs = 0;
+        scalar_t wsum = 0;
+      };
+      const auto d = this->d();
+      structured::ClusterTree t(n());
+      if (std::size_t(tree_.size) == n()) t = tree_;
+      else t.refine(128);
+      std::vector<Node> nodes;
+      nodes.reserve(t.nodes());
+      DenseM_t C(d, t.nodes());
+      std::vector<int> leaf_nodes;
+      // nodes in postorder, with center (the mean of the points),
+      // radius, and the sum of the weights, computed bottom up
+      std::function<int(const structured::ClusterTree&,std::size_t)>
+        build = [&](const structured::ClusterTree& ct, std::size_t lo) {
+        Node nd;
+        nd.lo = lo;
+        nd.size = ct.size;
+        if (ct.c.empty()) {
+          nd.leaf = leaf_nodes.size();
+          leaf_nodes.push_back(nodes.size());
+          auto c = C.ptr(0, nodes.size());
+          std::fill(c, c+d, scalar_t(0.));
+          for (std::size_t i=lo; i<lo+nd.size; i++) {
+            for (std::size_t k=0; k<d; k++) c[k] += data_(k, i);
+            nd.wsum += w[i];
+            nd.wabs += std::abs(w[i]);
+          }
+          if (nd.size)
+            for (std::size_t k=0; k<d; k++) c[k] /= real_t(nd.size);
+          for (std::size_t i=lo; i<lo+nd.size; i++)
+            nd.r = std::max
+              (nd.r, Euclidean_distance(d, c, data_.ptr(0, i)));
+        } else {
+          nd.c0 = build(ct.c[0], lo);
+          nd.c1 = build(ct.c[1], lo+ct.c[0].size);
+          auto& n0 = nodes[nd.c0];
+          auto& n1 = nodes[nd.c1];
+          auto c = C.ptr(0, nodes.size());
+          for (std::size_t k=0; k<d; k++)
+            c[k] = nd.size ? (real_t(n0.size) * C(k, nd.c0) +
+                              real_t(n1.size) * C(k, nd.c1))
+              / real_t(nd.size) : scalar_t(0.);
+          nd.r = std::max
+            (Euclidean_distance(d, c, C.ptr(0, nd.c0)) + n0.r,
+             Euclidean_distance(d, c, C.ptr(0, nd.c1)) + n1.r);
+          nd.wsum = n0.wsum + n1.wsum;
+          nd.wabs = n0.wabs + n1.wabs;
+        }
+        nodes.push_back(nd);
+        return int(nodes.size()) - 1;
+      };
+      const int root = build(t, 0);
+      const std::size_t B = 64;
+      const std::size_t batches = (test.cols() + B - 1) / B;
+#pragma omp parallel
+      {
+        std::vector<std::vector<std::size_t>> near(leaf_nodes.size());
+        std::vector<int> touched, stack;
+#pragma omp for schedule(dynamic)
+        for (std::size_t b=0; b<batches; b++) {
+          const auto c0 = b * B;
+          const auto c1 = std::min(c0 + B, std::size_t(test.cols()));
+          for (std::size_t c=c0; c<c1; c++) {
+            auto y = test.ptr(0, c);
+            stack.assign(1, root);
+            while (!stack.empty()) {
+              const auto& nd = nodes[stack.back()];
+              const auto ind = stack.back();
+              stack.pop_back();
+              if (nd.wabs == real_t(0.)) continue;
+              auto dc = Euclidean_distance(d, y, C.ptr(0, ind));
+              real_t kmin, kmax;
+              if (kernel_bounds(std::max(real_t(0.), dc - nd.r),
+                                dc + nd.r, kmin, kmax) &&
+                  kmax - kmin <= real_t(2.) * tol) {
+                pred[c] += real_t(.5) * (kmin + kmax) * nd.wsum;
+                continue;
+              }
+              if (nd.leaf >= 0) {
+                if (near[nd.leaf].empty()) touched.push_back(nd.leaf);
+                near[nd.leaf].push_back(c);
+              } else {
+                stack.push_back(nd.c1);
+                stack.push_back(nd.c0);
+              }
+            }
+          }
+          // near-field, one block per leaf, for all test points in
+          // this batch which need the leaf
+          for (auto l : touched) {
+            const auto& nd = nodes[leaf_nodes[l]];
+            auto& T = near[l];
+            DenseM_t Y(d, T.size()), K(nd.size, T.size());
+            std::vector<real_t> nY(T.size());
+            for (std::size_t j=0; j<T.size(); j++) {
+              std::copy(test.ptr(0, T[j]), test.ptr(0, T[j])+d, Y.ptr(0, j));
+              real_t nrm(0.);
+              for (std::size_t k=0; k<d; k++)
+                nrm += std::real(Y(k, j) * blas::my_conj(Y(k, j)));
+              nY[j] = nrm;
+            }
+            DenseMW_t X(d, nd.size, data_.ptr(0, nd.lo), data_.ld());
+            kernel_block(X, sqnorms_.data()+nd.lo, Y, nY.data(), K);
+            for (std::size_t j=0; j<T.size(); j++) {
+              scalar_t sum(0.);
+              for (std::size_t i=0; i<nd.size; i++)
+                sum += w[nd.lo+i] * K(i, j);
+              pred[T[j]] += sum;
+            }
+            T.clear();
+          }
+          touched.clear();
+        }
+      }
+    }
 
 #if defined(STRUMPACK_USE_MPI)
     template<typename scalar_t>
@@ -208,6 +350,24 @@ namespace strumpack {
       return prediction;
     }
 
+    template<typename scalar_t>
+    std::vector<scalar_t> Kernel<scalar_t>::predict
+    (const DenseM_t& test, const DistM_t& weights, real_t tol) const {
+      std::vector<scalar_t> prediction(test.cols());
+      if (weights.active() && weights.lcols()) {
+        // only the local weights, the tree code skips clusters
+        // without weights
+        std::vector<scalar_t> w(n());
+        for (int r=0; r<weights.lrows(); r++)
+          w[weights.rowl2g(r)] = weights(r, 0);
+        tree_code_predict(test, w.data(), tol, prediction);
+      }
+      // reduce the local sums to the global vector
+      weights.Comm().all_reduce
+        (prediction.data(), prediction.size(), MPI_SUM);
+      return prediction;
+    }
+
 #if defined(STRUMPACK_USE_BPACK)
     template<typename scalar_t>
     DenseMatrix<scalar_t> Kernel<scalar_t>::fit_HODLR
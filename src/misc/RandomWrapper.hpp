@@ -36,6 +36,13 @@
 #include <memory>
 #include <random>
 #include <iostream>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 
 namespace strumpack {
 
@@ -51,7 +58,9 @@ namespace strumpack {
      */
     enum class RandomEngine {
       LINEAR,   /*!< The C++11 std::minstd_rand random number generator. */
-      MERSENNE  /*!< The C++11 std::mt19937 random number generator.     */
+      MERSENNE, /*!< The C++11 std::mt19937 random number generator.     */
+      PHILOX    /*!< Counter based Philox4x32-10 generator, supports
+                  parallel bulk generation.                         */
     };
 
     /**
@@ -63,6 +72,7 @@ namespace strumpack {
       switch (e) {
       case RandomEngine::LINEAR: return "minstd_rand";
       case RandomEngine::MERSENNE: return "mt19937";
+      case RandomEngine::PHILOX: return "philox4x32-10";
       }
       return "unknown";
     }
@@ -111,6 +121,33 @@ namespace strumpack {
       virtual real_t get() = 0;
       virtual real_t get(std::uint32_t i, std::uint32_t j) = 0;
       virtual int flops_per_prng() = 0;
+
+      /**
+       * Fill a column major m x n array A, with leading dimension
+       * ld, with the next m*n elements of the random sequence. This
+       * gives the same result as calling get() m*n times, column by
+       * column.
+       */
+      virtual void fill(std::size_t m, std::size_t n,
+                        real_t* A, std::size_t ld) {
+        for (std::size_t j=0; j<n; j++)
+          for (std::size_t i=0; i<m; i++)
+            A[i+j*ld] = get();
+      }
+
+      /**
+       * Fill a column major m x n array A, with leading dimension
+       * ld, with the reproducible elements for the 2d points
+       * (i0+i,j0+j). This gives the same result as calling
+       * get(i0+i,j0+j) for each element.
+       */
+      virtual void fill_indexed(std::uint32_t i0, std::uint32_t j0,
+                                std::size_t m, std::size_t n,
+                                real_t* A, std::size_t ld) {
+        for (std::size_t j=0; j<n; j++)
+          for (std::size_t i=0; i<m; i++)
+            A[i+j*ld] = get(i0+i, j0+j);
+      }
     };
 
     /**
@@ -190,6 +227,227 @@ namespace strumpack {
       D d;
     };
 
+    /**
+     * \class PhiloxRandomGenerator
+     * \brief Counter based random number generator
+     *
+     * Implements the Philox4x32-10 generator from Salmon et al.,
+     * "Parallel Random Numbers: As Easy as 1, 2, 3", SC11. Each
+     * random number is a pure function of a counter and the key
+     * (seed), so no state needs to be updated when generating
+     * elements out of order. The reproducible get(i,j) does not
+     * require reseeding, and fill/fill_indexed can generate large
+     * blocks in parallel, with results independent of the number
+     * of threads.
+     *
+     * Every call of the Philox bijection produces 4 32-bit words,
+     * which are converted to 2 values of type real_t. For the
+     * normal distribution the Box-Muller transform is used.
+     *
+     * \tparam real_t float or double
+     * \tparam D the random number distribution
+     *
+     * \see RandomGeneratorBase, RandomGenerator
+     */
+    template<typename real_t, RandomDistribution D>
+    class PhiloxRandomGenerator : public RandomGeneratorBase<real_t> {
+    public:
+      /**
+       * Default constructor, using seed 0.
+       */
+      PhiloxRandomGenerator() { seed(std::size_t(0)); }
+
+      /**
+       * Constructor using seed s.
+       */
+      PhiloxRandomGenerator(std::size_t s) { seed(s); }
+
+      /**
+       * Seed with value s. This sets the key and resets the
+       * sequence.
+       */
+      void seed(std::size_t s) {
+        k_[0] = std::uint32_t(s);
+        k_[1] = std::uint32_t(std::uint64_t(s) >> 32);
+        reset(0, 0, 2);
+      }
+
+      /**
+       * Seed with a seed sequence. This sets the key and resets the
+       * sequence.
+       */
+      void seed(std::seed_seq& s) {
+        s.generate(k_, k_+2);
+        reset(0, 0, 2);
+      }
+
+      /**
+       * Seed with two values (for instance 2 coordinates, point in a
+       * matrix). This selects an independent sequence, the key is
+       * not modified.
+       */
+      void seed(std::uint32_t i, std::uint32_t j) { reset(i, j, 1); }
+
+      /**
+       * get the next random element.
+       */
+      real_t get() {
+        auto p = n_ >> 1;
+        if (p != bp_) {
+          sequence_block(p, b_);
+          bp_ = p;
+        }
+        return b_[n_++ & 1];
+      }
+
+      /**
+       * Get a (reproducible) element for a specific 2d point.
+       */
+      real_t get(std::uint32_t i, std::uint32_t j) {
+        real_t b[2];
+        indexed_block(i >> 1, j, b);
+        return b[i & 1];
+      }
+
+      /**
+       * Return the (approximate) number of flops required to generate
+       * a random number.
+       */
+      int flops_per_prng() {
+        return (D == RandomDistribution::NORMAL) ? 23 : 7;
+      }
+
+      void fill(std::size_t m, std::size_t n,
+                real_t* A, std::size_t ld) {
+        const auto n0 = n_;
+#pragma omp parallel for schedule(static)                      \
+  if(!omp_in_parallel() && m*n >= parallel_fill_min)
+        for (std::size_t j=0; j<n; j++)
+          fill_column
+            (n0+j*m, m, A+j*ld, [this](std::uint64_t p, real_t* b) {
+              sequence_block(p, b); });
+        n_ += m * n;
+        bp_ = invalid_block;
+      }
+
+      void fill_indexed(std::uint32_t i0, std::uint32_t j0,
+                        std::size_t m, std::size_t n,
+                        real_t* A, std::size_t ld) {
+#pragma omp parallel for schedule(static)                      \
+  if(!omp_in_parallel() && m*n >= parallel_fill_min)
+        for (std::size_t j=0; j<n; j++) {
+          std::uint32_t jj = j0 + j;
+          fill_column
+            (i0, m, A+j*ld, [this,jj](std::uint64_t p, real_t* b) {
+              indexed_block(std::uint32_t(p), jj, b); });
+        }
+      }
+
+    private:
+      static const std::uint64_t invalid_block =
+        std::numeric_limits<std::uint64_t>::max();
+      static const std::size_t parallel_fill_min = 1 << 14;
+
+      std::uint32_t k_[2] = {0, 0}, s_[3] = {0, 0, 2};
+      std::uint64_t n_ = 0, bp_ = invalid_block;
+      real_t b_[2];
+
+      void reset(std::uint32_t s0, std::uint32_t s1, std::uint32_t s2) {
+        s_[0] = s0; s_[1] = s1; s_[2] = s2;
+        n_ = 0;
+        bp_ = invalid_block;
+      }
+
+      /**
+       * Elements [k,k+m) of the sequence of pairs generated by
+       * block(p, b), written to x.
+       */
+      template<typename B> static void
+      fill_column(std::uint64_t k, std::size_t m, real_t* x,
+                  const B& block) {
+        const auto e = k + m;
+        real_t b[2];
+        if (k < e && (k & 1)) {
+          block(k >> 1, b);
+          *x++ = b[1];
+          k++;
+        }
+        for (; k+1<e; k+=2, x+=2)
+          block(k >> 1, x);
+        if (k < e) {
+          block(k >> 1, b);
+          *x = b[0];
+        }
+      }
+
+      void sequence_block(std::uint64_t p, real_t* b) const {
+        // element pairs of the sequence selected by seed(...)
+        std::uint32_t c[4] =
+          {std::uint32_t(p), s_[0] + std::uint32_t(p >> 32), s_[1], s_[2]};
+        philox4x32_10(c);
+        transform(c, b);
+      }
+
+      void indexed_block(std::uint32_t i, std::uint32_t j,
+                         real_t* b) const {
+        // pairs of rows for get(i,j), the last counter word is 0,
+        // which does not overlap with the sequences
+        std::uint32_t c[4] = {i, j, 0, 0};
+        philox4x32_10(c);
+        transform(c, b);
+      }
+
+      static void mulhilo(std::uint32_t a, std::uint32_t b,
+                          std::uint32_t& hi, std::uint32_t& lo) {
+        std::uint64_t p = std::uint64_t(a) * std::uint64_t(b);
+        hi = std::uint32_t(p >> 32);
+        lo = std::uint32_t(p);
+      }
+
+      void philox4x32_10(std::uint32_t* c) const {
+        std::uint32_t k0 = k_[0], k1 = k_[1];
+        for (int r=0; r<10; r++) {
+          std::uint32_t hi0, lo0, hi1, lo1;
+          mulhilo(0xD2511F53, c[0], hi0, lo0);
+          mulhilo(0xCD9E8D57, c[2], hi1, lo1);
+          c[0] = hi1 ^ c[1] ^ k0;
+          c[1] = lo1;
+          c[2] = hi0 ^ c[3] ^ k1;
+          c[3] = lo0;
+          k0 += 0x9E3779B9;
+          k1 += 0xBB67AE85;
+        }
+      }
+
+      /**
+       * Convert 2 (for float), or 4 (for double) 32 bit words to 2
+       * uniform [0,1) numbers, with 24 and 53 random bits
+       * respectively.
+       */
+      static void uniform(const std::uint32_t* c, float* u) {
+        u[0] = (c[0] >> 8) * (1.f / 16777216.f);
+        u[1] = (c[1] >> 8) * (1.f / 16777216.f);
+      }
+      static void uniform(const std::uint32_t* c, double* u) {
+        u[0] = (((std::uint64_t(c[0]) << 32) | c[1]) >> 11)
+          * (1. / 9007199254740992.);
+        u[1] = (((std::uint64_t(c[2]) << 32) | c[3]) >> 11)
+          * (1. / 9007199254740992.);
+      }
+
+      static void transform(const std::uint32_t* c, real_t* b) {
+        uniform(c, b);
+        if (D == RandomDistribution::NORMAL) {
+          // Box-Muller, 1-u is in (0,1]
+          const real_t twopi = real_t(6.283185307179586476925286766559);
+          real_t r = std::sqrt(real_t(-2.) * std::log(real_t(1.) - b[0])),
+            t = twopi * b[1];
+          b[0] = r * std::cos(t);
+          b[1] = r * std::sin(t);
+        }
+      }
+    };
+
     /**
      * Factory method to construct a RandomGeneratorBase with a
      * specified random engine and random distribution, with seed s.
@@ -221,6 +479,15 @@ namespace strumpack {
           return std::unique_ptr<RandomGeneratorBase<real_t>>
             (new RandomGenerator<real_t,std::mt19937,
              std::uniform_real_distribution<real_t>>(seed));
+      } else if (e == RandomEngine::PHILOX) {
+        if (d == RandomDistribution::NORMAL)
+          return std::unique_ptr<RandomGeneratorBase<real_t>>
+            (new PhiloxRandomGenerator
+             <real_t,RandomDistribution::NORMAL>(seed));
+        else if (d == RandomDistribution::UNIFORM)
+          return std::unique_ptr<RandomGeneratorBase<real_t>>
+            (new PhiloxRandomGenerator
+             <real_t,RandomDistribution::UNIFORM>(seed));
       }
       return NULL;
     }
@@ -29,11 +29,13 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <sstream>
 #include <cassert>
 #if defined(_OPENMP)
 #include <omp.h>
 #endif
 #include "TaskTimer.hpp"
+#include "Trace.hpp"
 #if defined(STRUMPACK_USE_MPI)
 #include "misc/MPIWrapper.hpp"
 #endif
@@ -45,7 +47,7 @@ tpoint TaskTimer::t_begin = GET_TIME_NOW();
 TimerList TaskTimer::time_log_list = TimerList();
 
 TaskTimer::TaskTimer(std::string name, int depth)
-  : t_name(name), started(false), stopped(false),
+  : t_name(name), started(false), stopped(false), t_trace_start(-1),
     type(TaskType::EXPLICITLY_NAMED_TASK), number(depth) {
 #if defined(_OPENMP)
   tid = omp_get_thread_num();
@@ -55,7 +57,7 @@ TaskTimer::TaskTimer(std::string name, int depth)
 }
 
 TaskTimer::TaskTimer(std::string name, std::function<void()> f, int depth)
-  : t_name(name), started(false), stopped(false),
+  : t_name(name), started(false), stopped(false), t_trace_start(-1),
     type(TaskType::EXPLICITLY_NAMED_TASK), number(depth) {
 #if defined(_OPENMP)
   tid = omp_get_thread_num();
@@ -66,7 +68,7 @@ TaskTimer::TaskTimer(std::string name, std::function<void()> f, int depth)
 }
 
 TaskTimer::TaskTimer(TaskType task_type, int depth)
-  : started(false), stopped(false), type(task_type), number(depth) {
+  : started(false), stopped(false), t_trace_start(-1), type(task_type), number(depth) {
 #if defined(_OPENMP)
   tid = omp_get_thread_num();
 #else
@@ -193,12 +195,19 @@ void TaskTimer::print(std::ostream& os) {
 void TaskTimer::start() {
   t_start = GET_TIME_NOW();
   started = true;
+  t_trace_start = trace::enabled() ? trace::now() : -1;
 }
 
 void TaskTimer::stop() {
   t_stop = GET_TIME_NOW();
   stopped = true;
   time_log_list.list[tid].push_back(*this);
+  if (t_trace_start >= 0) {
+    std::ostringstream name;
+    print_name(name);
+    trace::record(name.str().c_str(), t_trace_start, trace::now(),
+                  -1, number);
+  }
 }
 
 void TaskTimer::set_elapsed(double t) {
@@ -34,6 +34,7 @@
 #include <string>
 #include <chrono>
 #include <functional>
+#include <cstdint>
 #include "StrumpackConfig.hpp"
 
 namespace strumpack {
@@ -92,6 +93,9 @@ namespace strumpack {
     bool started;
     bool stopped;
 
+    // start time for trace::record, -1 if tracing was not enabled
+    std::int64_t t_trace_start;
+
     TaskType type;
     int number;
     int tid;
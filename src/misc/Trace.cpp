@@ -0,0 +1,214 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+
+#include "Trace.hpp"
+#if defined(STRUMPACK_USE_MPI)
+#include <mpi.h>
+#endif
+
+namespace strumpack {
+  namespace trace {
+
+    namespace {
+      struct ThreadBuffer {
+        std::vector<Event> events;
+        std::atomic<std::uint64_t> count{0};
+        int tid = 0;
+      };
+
+      using clock = std::chrono::steady_clock;
+      const clock::time_point epoch = clock::now();
+      std::atomic<bool> trace_enabled(false);
+      std::size_t capacity = 65536;
+      std::mutex buffers_mtx;
+      std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+      thread_local ThreadBuffer* local_buffer = nullptr;
+
+      // only takes the lock the first time a thread records an event
+      ThreadBuffer& thread_buffer() {
+        if (!local_buffer) {
+          std::lock_guard<std::mutex> lock(buffers_mtx);
+          std::unique_ptr<ThreadBuffer> b(new ThreadBuffer());
+          b->events.resize(capacity);
+          b->tid = buffers.size();
+          local_buffer = b.get();
+          buffers.push_back(std::move(b));
+        }
+        return *local_buffer;
+      }
+
+      std::vector<Event> collect_events() {
+        std::vector<Event> ev;
+        std::lock_guard<std::mutex> lock(buffers_mtx);
+        for (auto& b : buffers) {
+          auto c = b->count.load(std::memory_order_acquire);
+          auto cap = b->events.size();
+          auto n = std::min<std::uint64_t>(c, cap);
+          for (auto i=c-n; i<c; i++)
+            ev.push_back(b->events[i % cap]);
+        }
+        return ev;
+      }
+
+      void write_json_string(std::ostream& os, const char* s) {
+        os << '"';
+        for (; *s; s++) {
+          if (*s == '"' || *s == '\\') os << '\\';
+          if (static_cast<unsigned char>(*s) >= 0x20) os << *s;
+        }
+        os << '"';
+      }
+
+      void write_events(const std::string& filename,
+                        const std::vector<Event>& ev, int P) {
+        std::ofstream f(filename);
+        f << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+        for (int p=0; p<P; p++)
+          f << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << p
+            << ",\"args\":{\"name\":\"rank " << p << "\"}},\n";
+        f << std::fixed << std::setprecision(3);
+        for (std::size_t i=0; i<ev.size(); i++) {
+          auto& e = ev[i];
+          f << "{\"name\":";
+          write_json_string(f, e.name);
+          f << ",\"cat\":\"" << (e.front >= 0 ? "front" : "task")
+            << "\",\"ph\":\"X\",\"pid\":" << e.rank
+            << ",\"tid\":" << e.tid
+            << ",\"ts\":" << e.begin / 1.e3
+            << ",\"dur\":" << (e.end - e.begin) / 1.e3
+            << ",\"args\":{";
+          if (e.front >= 0)
+            f << "\"front\":" << e.front << ",\"dim_sep\":" << e.dim_sep
+              << ",\"dim_upd\":" << e.dim_upd << ",";
+          f << "\"level\":" << e.level << ",\"flops\":"
+            << std::setprecision(0) << e.flops << std::setprecision(3)
+            << "}}" << (i+1 < ev.size() ? ",\n" : "\n");
+        }
+        f << "]}" << std::endl;
+      }
+    } // end anonymous namespace
+
+    void enable(std::size_t cap) {
+      std::lock_guard<std::mutex> lock(buffers_mtx);
+      capacity = std::max(cap, std::size_t(1));
+      for (auto& b : buffers) {
+        b->events.resize(capacity);
+        b->count.store(0, std::memory_order_release);
+      }
+      trace_enabled.store(true, std::memory_order_release);
+    }
+
+    void disable() {
+      trace_enabled.store(false, std::memory_order_release);
+    }
+
+    bool enabled() {
+      return trace_enabled.load(std::memory_order_relaxed);
+    }
+
+    void clear() {
+      std::lock_guard<std::mutex> lock(buffers_mtx);
+      for (auto& b : buffers)
+        b->count.store(0, std::memory_order_release);
+    }
+
+    std::int64_t now() {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>
+        (clock::now() - epoch).count();
+    }
+
+    void record(const char* name, std::int64_t begin, std::int64_t end,
+                int front, int level, std::int64_t dim_sep,
+                std::int64_t dim_upd, double flops) {
+      if (!enabled()) return;
+      auto& b = thread_buffer();
+      auto c = b.count.load(std::memory_order_relaxed);
+      auto& e = b.events[c % b.events.size()];
+      std::strncpy(e.name, name, sizeof(e.name)-1);
+      e.name[sizeof(e.name)-1] = '\0';
+      e.begin = begin;
+      e.end = end;
+      e.dim_sep = dim_sep;
+      e.dim_upd = dim_upd;
+      e.flops = flops;
+      e.front = front;
+      e.level = level;
+      e.tid = b.tid;
+      e.rank = 0;
+      b.count.store(c+1, std::memory_order_release);
+    }
+
+    void write_chrome_trace(const std::string& filename) {
+      write_events(filename, collect_events(), 1);
+    }
+
+#if defined(STRUMPACK_USE_MPI)
+    void write_chrome_trace(const std::string& filename, MPI_Comm comm) {
+      auto ev = collect_events();
+      int rank, P;
+      MPI_Comm_rank(comm, &rank);
+      MPI_Comm_size(comm, &P);
+      // align the clocks of all ranks at the barrier, and shift such
+      // that all timestamps are non-negative
+      MPI_Barrier(comm);
+      auto tsync = now();
+      std::int64_t tmin = tsync;
+      for (auto& e : ev) tmin = std::min(tmin, e.begin);
+      std::int64_t shift = tsync - tmin, max_shift = 0;
+      MPI_Allreduce(&shift, &max_shift, 1, MPI_INT64_T, MPI_MAX, comm);
+      for (auto& e : ev) {
+        e.begin += max_shift - tsync;
+        e.end += max_shift - tsync;
+        e.rank = rank;
+      }
+      int bytes = ev.size() * sizeof(Event);
+      std::vector<int> rbytes(P), displs(P);
+      MPI_Gather(&bytes, 1, MPI_INT, rbytes.data(), 1, MPI_INT, 0, comm);
+      std::vector<Event> all;
+      if (rank == 0) {
+        for (int p=1; p<P; p++)
+          displs[p] = displs[p-1] + rbytes[p-1];
+        all.resize((displs[P-1] + rbytes[P-1]) / sizeof(Event));
+      }
+      MPI_Gatherv(ev.data(), bytes, MPI_BYTE, all.data(),
+                  rbytes.data(), displs.data(), MPI_BYTE, 0, comm);
+      if (rank == 0) write_events(filename, all, P);
+    }
+#endif
+
+  } // end namespace trace
+} // end namespace strumpack
@@ -0,0 +1,157 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+/*! \file Trace.hpp
+ * \brief Low overhead event tracing, with export to the Chrome trace
+ * event format (chrome://tracing, https://ui.perfetto.dev).
+ */
+#ifndef STRUMPACK_TRACE_HPP
+#define STRUMPACK_TRACE_HPP
+
+#include <string>
+#include <chrono>
+#include <cstdint>
+
+#include "StrumpackConfig.hpp"
+#if defined(STRUMPACK_USE_MPI)
+#include <mpi.h>
+#endif
+
+namespace strumpack {
+
+  /**
+   * Tracing of (multifrontal) tasks. Tracing is always compiled in,
+   * but disabled by default. When enabled, each thread records events
+   * in its own fixed size ring buffer, without locking. When a buffer
+   * is full, the oldest events are overwritten. Events can be written
+   * in the Chrome trace event JSON format, where each MPI rank shows
+   * up as a separate process.
+   */
+  namespace trace {
+
+    /**
+     * A single traced event. Timestamps are in nanoseconds, see
+     * now().
+     */
+    struct Event {
+      char name[32];
+      std::int64_t begin, end;
+      std::int64_t dim_sep, dim_upd;
+      double flops;
+      int front, level, tid, rank;
+    };
+
+    /**
+     * Enable tracing, and clear all previously recorded events. This
+     * should not be called while other threads are recording events.
+     *
+     * \param capacity Number of events stored per thread, when more
+     * events are recorded, the oldest ones are overwritten.
+     */
+    void enable(std::size_t capacity=65536);
+    void disable();
+    bool enabled();
+
+    /**
+     * Discard all recorded events. This should not be called while
+     * other threads are recording events.
+     */
+    void clear();
+
+    /**
+     * Current time in nanoseconds, from a monotonic clock, relative
+     * to the time the library was loaded.
+     */
+    std::int64_t now();
+
+    /**
+     * Record an event in the ring buffer of the calling thread.
+     *
+     * \param name Name of the event, truncated to 31 characters
+     * \param begin Start time, see now()
+     * \param end Stop time, see now()
+     * \param front Front identifier (separator number), or -1
+     * \param level Level in the elimination tree, or -1
+     * \param dim_sep Front separator dimension
+     * \param dim_upd Front update dimension
+     * \param flops Number of flops performed in this event
+     */
+    void record(const char* name, std::int64_t begin, std::int64_t end,
+                int front=-1, int level=-1, std::int64_t dim_sep=0,
+                std::int64_t dim_upd=0, double flops=0.);
+
+    /**
+     * Write all events recorded by this process to file, in the
+     * Chrome trace event JSON format. This does not communicate.
+     */
+    void write_chrome_trace(const std::string& filename);
+
+#if defined(STRUMPACK_USE_MPI)
+    /**
+     * Write all recorded events to file, in the Chrome trace event
+     * JSON format. This is collective on comm, events are gathered
+     * and written by rank 0 of comm, and the clocks of the different
+     * ranks are aligned with a barrier.
+     */
+    void write_chrome_trace(const std::string& filename, MPI_Comm comm);
+#endif
+
+    /**
+     * Records an event from construction to destruction, if tracing
+     * is enabled at construction.
+     */
+    class Scope {
+    public:
+      Scope(const char* name, int front=-1, int level=-1,
+            std::int64_t dim_sep=0, std::int64_t dim_upd=0)
+        : name_(name), front_(front), level_(level),
+          dsep_(dim_sep), dupd_(dim_upd) {
+        if (enabled()) begin_ = now();
+      }
+      ~Scope() {
+        if (begin_ >= 0)
+          record(name_, begin_, now(), front_, level_,
+                 dsep_, dupd_, flops_);
+      }
+      Scope(const Scope&) = delete;
+      Scope& operator=(const Scope&) = delete;
+
+      void set_flops(double f) { flops_ = f; }
+      void add_flops(double f) { flops_ += f; }
+
+    private:
+      const char* name_;
+      int front_, level_;
+      std::int64_t dsep_, dupd_, begin_ = -1;
+      double flops_ = 0.;
+    };
+
+  } // end namespace trace
+} // end namespace strumpack
+
+#endif // STRUMPACK_TRACE_HPP
@@ -192,6 +192,14 @@ namespace strumpack {
     return nonzeros;
   }
 
+  template<typename scalar_t,typename integer_t> std::vector<FrontStats>
+  EliminationTree<scalar_t,integer_t>::front_statistics() const {
+    std::vector<FrontStats> s;
+    root_->collect_stats(s);
+    FrontStats::sort(s);
+    return s;
+  }
+
   template<typename scalar_t,typename integer_t> ReturnCode
   EliminationTree<scalar_t,integer_t>::inertia
   (integer_t& neg, integer_t& zero, integer_t& pos) const {
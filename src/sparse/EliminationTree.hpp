@@ -36,6 +36,7 @@
 #include "CompressedSparseMatrix.hpp"
 #include "StrumpackOptions.hpp"
 #include "fronts/FrontFactory.hpp"
+#include "fronts/FrontStats.hpp"
 
 namespace strumpack {
 
@@ -73,6 +74,13 @@ namespace strumpack {
     virtual long long factor_nonzeros() const;
     virtual long long dense_factor_nonzeros() const;
 
+    /**
+     * Statistics for all fronts factored by this process, sorted by
+     * decreasing cost. The MPI version gathers the statistics of all
+     * processes on rank 0.
+     */
+    virtual std::vector<FrontStats> front_statistics() const;
+
     virtual ReturnCode inertia(integer_t& neg,
                                integer_t& zero,
                                integer_t& pos) const;
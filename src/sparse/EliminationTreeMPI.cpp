@@ -78,6 +78,27 @@ namespace strumpack {
       (EliminationTree<scalar_t,integer_t>::dense_factor_nonzeros(), MPI_SUM);
   }
 
+  template<typename scalar_t,typename integer_t> std::vector<FrontStats>
+  EliminationTreeMPI<scalar_t,integer_t>::front_statistics() const {
+    auto s = EliminationTree<scalar_t,integer_t>::front_statistics();
+    for (auto& f : s) f.mpi_rank = rank_;
+    int bytes = s.size() * sizeof(FrontStats);
+    std::vector<int> rbytes(P_), displs(P_);
+    comm_.gather(&bytes, 1, rbytes.data(), 1, 0);
+    std::vector<FrontStats> all;
+    if (rank_ == 0) {
+      for (int p=1; p<P_; p++)
+        displs[p] = displs[p-1] + rbytes[p-1];
+      all.resize((displs[P_-1] + rbytes[P_-1]) / sizeof(FrontStats));
+    }
+    comm_.gather_v(reinterpret_cast<char*>(s.data()), bytes,
+                   reinterpret_cast<char*>(all.data()),
+                   rbytes.data(), displs.data(), 0);
+    if (rank_ != 0) return s;
+    FrontStats::sort(all);
+    return all;
+  }
+
   template<typename scalar_t,typename integer_t> ReturnCode
   EliminationTreeMPI<scalar_t,integer_t>::inertia
   (integer_t& neg, integer_t& zero, integer_t& pos) const {
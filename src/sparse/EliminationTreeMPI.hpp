@@ -59,6 +59,7 @@ namespace strumpack {
     integer_t maximum_rank() const override;
     long long factor_nonzeros() const override;
     long long dense_factor_nonzeros() const override;
+    std::vector<FrontStats> front_statistics() const override;
     const MPIComm& Comm() const { return comm_; }
 
     ReturnCode inertia(integer_t& neg,
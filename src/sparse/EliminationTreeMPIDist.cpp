@@ -44,8 +44,9 @@ namespace strumpack {
 
   template<typename scalar_t,typename integer_t>
   EliminationTreeMPIDist<scalar_t,integer_t>::EliminationTreeMPIDist
-  (const Opts_t& opts, const CSRMPI_t& A, Reord_t& nd, const MPIComm& comm)
-    : EliminationTreeMPI<scalar_t,integer_t>(comm), nd_(nd) {
+  (const Opts_t& opts, const CSRMPI_t& A, Reord_t& nd, const MPIComm& comm,
+   FrontGridCache* grids)
+    : EliminationTreeMPI<scalar_t,integer_t>(comm), nd_(nd), grids_(grids) {
 
     std::vector<std::vector<integer_t>> lupd(nd_.ltree().separators());
     // every process is responsible for 1 distributed separator, so
@@ -663,7 +664,7 @@ namespace strumpack {
       } else {
         auto fmpi = create_frontal_matrix<scalar_t,integer_t>
           (opts, local_pfronts_.size(), dsep_begin, dsep_end, dsep_upd,
-           level, this->nr_fronts_, fcomm, P, rank_ == P0);
+           level, this->nr_fronts_, fcomm, P, rank_ == P0, grids_);
         if (rank_ >= P0 && rank_ < P0+P)
           local_pfronts_.emplace_back
             (dsep_begin, dsep_end, P0, P, fmpi->grid());
@@ -678,14 +679,21 @@ namespace strumpack {
     auto wr = dist_subtree_work[chr];
     int Pl = std::max(1, std::min(int(std::round(P * wl / (wl + wr))), P-1));
     int Pr = std::max(1, P - Pl);
-    auto cl = fcomm.sub(0, Pl);
-    auto cr = fcomm.sub(P-Pr, Pr);
+    MPIComm cl, cr;
+    const MPIComm *pcl = &cl, *pcr = &cr;
+    if (grids_) {
+      pcl = &grids_->sub(fcomm, 0, Pl);
+      pcr = &grids_->sub(fcomm, P-Pr, Pr);
+    } else {
+      cl = fcomm.sub(0, Pl);
+      cr = fcomm.sub(P-Pr, Pr);
+    }
     auto lch = prop_map
       (opts, local_upd, local_subtree_work, dist_upd, dleaf_upd,
-       dist_subtree_work, chl, P0, Pl, P0+P-Pr, Pr, cl, level+1);
+       dist_subtree_work, chl, P0, Pl, P0+P-Pr, Pr, *pcl, level+1);
     auto rch = prop_map
       (opts, local_upd, local_subtree_work, dist_upd, dleaf_upd,
-       dist_subtree_work, chr, P0+P-Pr, Pr, P0, Pl, cr, level+1);
+       dist_subtree_work, chr, P0+P-Pr, Pr, P0, Pl, *pcr, level+1);
     if (front) {
       front->set_lchild(std::move(lch));
       front->set_rchild(std::move(rch));
@@ -736,7 +744,7 @@ namespace strumpack {
         } else {
           auto fmpi = create_frontal_matrix<scalar_t,integer_t>
             (opts, local_pfronts_.size(), sep_beg, sep_end, upd,
-             m.level, this->nr_fronts_, *pcomm, m.P, rank_ == m.P0);
+             m.level, this->nr_fronts_, *pcomm, m.P, rank_ == m.P0, grids_);
           if (rank_ >= m.P0 && rank_ < m.P0+m.P)
             local_pfronts_.emplace_back
               (sep_beg, sep_end, m.P0, m.P, fmpi->grid());
@@ -760,14 +768,25 @@ namespace strumpack {
             int Pl = std::max
               (1, std::min(int(std::round(m.P * wl / (wl + wr))), m.P-1));
             int Pr = std::max(1, m.P - Pl);
-            fstack.emplace
-              (MapData{chl, m.P0, Pl, m.P0+m.P-Pr, Pr,
-                       nullptr, pcomm->sub(0, Pl),
-                       m.level+1, front.get(), true});
-            fstack.emplace
-              (MapData{chr, m.P0+m.P-Pr, Pr, m.P0, Pl,
-                       nullptr, pcomm->sub(m.P-Pr, Pr),
-                       m.level+1, front.get(), false});
+            if (grids_) {
+              fstack.emplace
+                (MapData{chl, m.P0, Pl, m.P0+m.P-Pr, Pr,
+                         &grids_->sub(*pcomm, 0, Pl), MPI_COMM_NULL,
+                         m.level+1, front.get(), true});
+              fstack.emplace
+                (MapData{chr, m.P0+m.P-Pr, Pr, m.P0, Pl,
+                         &grids_->sub(*pcomm, m.P-Pr, Pr), MPI_COMM_NULL,
+                         m.level+1, front.get(), false});
+            } else {
+              fstack.emplace
+                (MapData{chl, m.P0, Pl, m.P0+m.P-Pr, Pr,
+                         nullptr, pcomm->sub(0, Pl),
+                         m.level+1, front.get(), true});
+              fstack.emplace
+                (MapData{chr, m.P0+m.P-Pr, Pr, m.P0, Pl,
+                         nullptr, pcomm->sub(m.P-Pr, Pr),
+                         m.level+1, front.get(), false});
+            }
           }
         }
       }
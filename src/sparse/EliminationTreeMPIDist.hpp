@@ -42,6 +42,7 @@ namespace strumpack {
   template<typename scalar_t,typename integer_t> class FrontMPI;
   template<typename scalar_t,typename integer_t> class CSRMatrixMPI;
   template<typename integer_t> class RedistSubTree;
+  class FrontGridCache;
 
   template<typename scalar_t,typename integer_t>
   class EliminationTreeMPIDist :
@@ -58,7 +59,8 @@ namespace strumpack {
 
   public:
     EliminationTreeMPIDist(const Opts_t& opts, const CSRMPI_t& A,
-                           Reord_t& nd, const MPIComm& comm);
+                           Reord_t& nd, const MPIComm& comm,
+                           FrontGridCache* grids=nullptr);
 
     void update_values(const Opts_t& opts, const CSRMPI_t& A,
                        Reord_t& nd);
@@ -86,6 +88,9 @@ namespace strumpack {
     using EliminationTreeMPI<scalar_t,integer_t>::subtree_ranges_;
 
     Reord_t& nd_;
+    // cache for front communicators and grids, only used during
+    // construction, can be null
+    FrontGridCache* grids_ = nullptr;
     PropMapSparseMatrix<scalar_t,integer_t> Aprop_;
     ProportionalMapping prop_map_;
 
@@ -210,6 +210,14 @@ namespace strumpack {
     return std::max(r, std::max(rl, rr));
   }
 
+  template<typename scalar_t,typename integer_t> void
+  Front<scalar_t,integer_t>::collect_stats
+  (std::vector<FrontStats>& s) const {
+    if (stats_.front >= 0) s.push_back(stats_);
+    if (lchild_) lchild_->collect_stats(s);
+    if (rchild_) rchild_->collect_stats(s);
+  }
+
   template<typename scalar_t,typename integer_t> void
   Front<scalar_t,integer_t>::multifrontal_solve(DenseM_t& b) const {
     auto max_dupd = max_dim_upd();
@@ -36,6 +36,8 @@
 
 #include "StrumpackParameters.hpp"
 #include "misc/TaskTimer.hpp"
+#include "misc/Trace.hpp"
+#include "FrontStats.hpp"
 #include "dense/DenseMatrix.hpp"
 #include "sparse/CompressedSparseMatrix.hpp"
 #include "BLR/BLRMatrix.hpp"
@@ -82,6 +84,17 @@ namespace strumpack {
 
     void draw(std::ostream& of, int etree_level=0) const;
 
+    /**
+     * Statistics recorded during the factorization of this front.
+     */
+    const FrontStats& stats() const { return stats_; }
+
+    /**
+     * Append the statistics of all fronts in this subtree that were
+     * factored (by this process) to s.
+     */
+    void collect_stats(std::vector<FrontStats>& s) const;
+
     void find_upd_indices(const std::vector<std::size_t>& I,
                           std::vector<std::size_t>& lI,
                           std::vector<std::size_t>& oI) const;
@@ -387,6 +400,24 @@ namespace strumpack {
                                  BLRMPI_t& F21, BLRMPI_t& F22,
                                  scalar_t** pbuf, const FBLRMPI_t* pa) const;
 
+    /**
+     * Extend-add to a distributed BLR parent, with compression of the
+     * contribution block before communication. By default this is
+     * the same as the uncompressed extend-add.
+     */
+    virtual void
+    extadd_blr_copy_to_buffers_compressed
+    (std::vector<std::vector<scalar_t>>& sbuf, const FBLRMPI_t* pa,
+     const Opts_t& opts) const {
+      extadd_blr_copy_to_buffers(sbuf, pa);
+    }
+    virtual void
+    extadd_blr_copy_from_buffers_compressed
+    (BLRMPI_t& F11, BLRMPI_t& F12, BLRMPI_t& F21, BLRMPI_t& F22,
+     scalar_t** pbuf, const FBLRMPI_t* pa) const {
+      extadd_blr_copy_from_buffers(F11, F12, F21, F22, pbuf, pa);
+    }
+
     virtual void
     extadd_blr_copy_from_buffers_col(BLRMPI_t& F11, BLRMPI_t& F12,
                                      BLRMPI_t& F21, BLRMPI_t& F22,
@@ -439,6 +470,41 @@ namespace strumpack {
     integer_t sep_, sep_begin_, sep_end_;
     std::vector<integer_t> upd_;
     std::unique_ptr<F_t> lchild_, rchild_;
+    FrontStats stats_;
+
+    /**
+     * Reset the statistics for this front, call this after the
+     * children have been factored. This returns the current time, see
+     * trace::now().
+     */
+    std::int64_t stats_start(int etree_level) {
+      stats_ = FrontStats();
+      stats_.front = sep_;
+      stats_.level = etree_level;
+      stats_.dim_sep = dim_sep();
+      stats_.dim_upd = dim_upd();
+      for (auto ch : {lchild_.get(), rchild_.get()})
+        if (ch) stats_.extend_add_bytes +=
+                  (long long)(ch->dim_upd()) * ch->dim_upd() *
+                  sizeof(scalar_t);
+      return trace::now();
+    }
+    /**
+     * Seconds since t0, obtained from trace::now().
+     */
+    static double stats_elapsed(std::int64_t t0) {
+      return (trace::now() - t0) / 1.e9;
+    }
+    /**
+     * Record the rank and the memory for the factors and the
+     * contribution block of this front.
+     */
+    void stats_finish(integer_t rank) {
+      stats_.rank = rank;
+      stats_.memory = (node_factor_nonzeros() +
+                       (long long)(dim_upd()) * dim_upd()) *
+        sizeof(scalar_t);
+    }
 
     virtual long long node_factor_nonzeros() const {
       return dense_node_factor_nonzeros();
@@ -300,6 +300,9 @@ namespace strumpack {
         er = rchild_->factor(A, opts, workspace, etree_level+1, task_depth);
     }
     ReturnCode err_code = (el == ReturnCode::SUCCESS) ? er : el;
+    trace::Scope ts("BLR_factor", this->sep_, etree_level,
+                    dim_sep(), dim_upd());
+    auto t0 = this->stats_start(etree_level);
     TaskTimer t("");
 #if defined(STRUMPACK_COUNT_FLOPS)
     long long int f0 = 0, ftot = 0;
@@ -313,8 +316,9 @@ namespace strumpack {
     const auto dsep = dim_sep();
     const auto dupd = dim_upd();
     auto& blr_opts = opts.BLR_options();
-    if (blr_opts.low_rank_algorithm() ==
-        BLR::LowRankAlgorithm::RRQR) {
+    if (blr_opts.low_rank_algorithm() == BLR::LowRankAlgorithm::RRQR ||
+        blr_opts.low_rank_algorithm() ==
+        BLR::LowRankAlgorithm::RANDOMIZED) {
       if (blr_opts.BLR_factor_algorithm() ==
           BLR::BLRFactorAlgorithm::COLWISE) {
         // factor column-block-wise for memory reduction
@@ -476,6 +480,11 @@ namespace strumpack {
     }
     if (lchild_) lchild_->release_work_memory(workspace);
     if (rchild_) rchild_->release_work_memory(workspace);
+    if (blr_opts.mixed_precision()) {
+      F11blr_.convert_to_mixed_precision(blr_opts);
+      F12blr_.convert_to_mixed_precision(blr_opts);
+      F21blr_.convert_to_mixed_precision(blr_opts);
+    }
     if (opts.print_compressed_front_stats()) {
       auto time = t.elapsed();
       auto nnz = F11blr_.nonzeros();
@@ -518,6 +527,9 @@ namespace strumpack {
     //   BLR::draw(F11blr_, "F11root_"
     //             + std::to_string(opts.BLR_options().leaf_size()) + "_"
     //             + BLR::get_name(opts.BLR_options().admissibility()));
+    this->stats_.factor_time = this->stats_elapsed(t0);
+    this->stats_finish
+      (std::max(F11blr_.rank(), std::max(F12blr_.rank(), F21blr_.rank())));
     return err_code;
   }
 
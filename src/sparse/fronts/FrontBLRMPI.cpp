@@ -41,10 +41,11 @@ namespace strumpack {
   template<typename scalar_t,typename integer_t>
   FrontBLRMPI<scalar_t,integer_t>::FrontBLRMPI
   (integer_t sep, integer_t sep_begin, integer_t sep_end,
-   std::vector<integer_t>& upd, const MPIComm& comm, int P, int leaf)
+   std::vector<integer_t>& upd, const MPIComm& comm, int P, int leaf,
+   FrontGridCache* grids)
     : FrontMPI<scalar_t,integer_t>
-    (sep, sep_begin, sep_end, upd, comm, P),
-      pgrid_(Comm(), P), leaf_(leaf) {}
+    (sep, sep_begin, sep_end, upd, comm, P, grids),
+      pgrid_(FrontGridCache::BLR_grid(grids, comm, P)), leaf_(leaf) {}
 
   template<typename scalar_t,typename integer_t> void
   FrontBLRMPI<scalar_t,integer_t>::release_work_memory() {
@@ -52,8 +53,9 @@ namespace strumpack {
   }
 
   template<typename scalar_t,typename integer_t> void
-  FrontBLRMPI<scalar_t,integer_t>::extend_add() {
+  FrontBLRMPI<scalar_t,integer_t>::extend_add(const Opts_t& opts) {
     if (!lchild_ && !rchild_) return;
+    const bool compressed = opts.BLR_options().compressed_CB();
     std::vector<std::vector<scalar_t>> sbuf(this->P());
     for (auto& ch : {lchild_.get(), rchild_.get()}) {
       if (ch && Comm().is_root()) {
@@ -61,16 +63,23 @@ namespace strumpack {
           (static_cast<long long int>(ch->dim_upd())*ch->dim_upd());
       }
       if (!visit(ch)) continue;
-      ch->extadd_blr_copy_to_buffers(sbuf, this);
+      if (compressed)
+        ch->extadd_blr_copy_to_buffers_compressed(sbuf, this, opts);
+      else ch->extadd_blr_copy_to_buffers(sbuf, this);
     }
     std::vector<scalar_t,NoInit<scalar_t>> rbuf;
     std::vector<scalar_t*> pbuf;
     Comm().all_to_all_v(sbuf, rbuf, pbuf);
     for (auto& ch : {lchild_.get(), rchild_.get()}) {
       if (!ch) continue;
-      ch->extadd_blr_copy_from_buffers
-        (F11blr_, F12blr_, F21blr_, F22blr_,
-         pbuf.data()+this->master(ch), this);
+      if (compressed)
+        ch->extadd_blr_copy_from_buffers_compressed
+          (F11blr_, F12blr_, F21blr_, F22blr_,
+           pbuf.data()+this->master(ch), this);
+      else
+        ch->extadd_blr_copy_from_buffers
+          (F11blr_, F12blr_, F21blr_, F22blr_,
+           pbuf.data()+this->master(ch), this);
     }
   }
 
@@ -141,6 +150,14 @@ namespace strumpack {
       (F22blr_, sbuf, pa, this->upd_to_parent(pa), begin_col, end_col);
   }
 
+  template<typename scalar_t,typename integer_t> void
+  FrontBLRMPI<scalar_t,integer_t>::extadd_blr_copy_to_buffers_compressed
+  (std::vector<std::vector<scalar_t>>& sbuf, const FBLRMPI_t* pa,
+   const Opts_t& opts) const {
+    BLR::BLRExtendAdd<scalar_t,integer_t>::copy_to_buffers_compressed
+      (F22blr_, sbuf, pa, this->upd_to_parent(pa), opts.BLR_options());
+  }
+
   template<typename scalar_t,typename integer_t> void
   FrontBLRMPI<scalar_t,integer_t>::extadd_blr_copy_from_buffers
   (BLRMPI_t& F11, BLRMPI_t& F12, BLRMPI_t& F21, BLRMPI_t& F22,
@@ -158,23 +175,31 @@ namespace strumpack {
       (F11, F12, F21, F22, pbuf, pa, this, begin_col, end_col);
   }
 
+  template<typename scalar_t,typename integer_t> void
+  FrontBLRMPI<scalar_t,integer_t>::extadd_blr_copy_from_buffers_compressed
+  (BLRMPI_t& F11, BLRMPI_t& F12, BLRMPI_t& F21, BLRMPI_t& F22,
+   scalar_t** pbuf, const FBLRMPI_t* pa) const {
+    BLR::BLRExtendAdd<scalar_t,integer_t>::copy_from_buffers_compressed
+      (F11, F12, F21, F22, pbuf, pa, this);
+  }
+
   template<typename scalar_t,typename integer_t> void
   FrontBLRMPI<scalar_t,integer_t>::build_front
   (const SpMat_t& A) {
     const auto dupd = dim_upd();
     const auto dsep = dim_sep();
     if (dsep) {
-      F11blr_ = BLRMPI_t(pgrid_, sep_tiles_, sep_tiles_);
+      F11blr_ = BLRMPI_t(*pgrid_, sep_tiles_, sep_tiles_);
       F11blr_.fill(0.);
       if (dim_upd()) {
-        F12blr_ = BLRMPI_t(pgrid_, sep_tiles_, upd_tiles_);
-        F21blr_ = BLRMPI_t(pgrid_, upd_tiles_, sep_tiles_);
+        F12blr_ = BLRMPI_t(*pgrid_, sep_tiles_, upd_tiles_);
+        F21blr_ = BLRMPI_t(*pgrid_, upd_tiles_, sep_tiles_);
         F12blr_.fill(0.);
         F21blr_.fill(0.);
       }
     }
     if (dupd) {
-      F22blr_ = BLRMPI_t(pgrid_, upd_tiles_, upd_tiles_);
+      F22blr_ = BLRMPI_t(*pgrid_, upd_tiles_, upd_tiles_);
       F22blr_.fill(0.);
     }
     using Trip_t = Triplet<scalar_t>;
@@ -247,6 +272,9 @@ namespace strumpack {
     // TODO use the existing workspace
     // now this is cleared to save space
     workspace.clear();
+    trace::Scope ts("BLR_MPI_factor", this->sep_, etree_level,
+                    dim_sep(), dim_upd());
+    auto t0 = this->stats_start(etree_level);
     TaskTimer t("FrontBLRMPI_factor");
     if (opts.print_compressed_front_stats()) t.start();
     if (opts.BLR_options().BLR_factor_algorithm() ==
@@ -254,10 +282,10 @@ namespace strumpack {
       // factor column-block-wise for memory reduction
       if (dim_sep()) {
         if (dim_upd()) {
-          F11blr_ = BLRMPI_t(pgrid_, sep_tiles_, sep_tiles_);
-          F12blr_ = BLRMPI_t(pgrid_, sep_tiles_, upd_tiles_);
-          F21blr_ = BLRMPI_t(pgrid_, upd_tiles_, sep_tiles_);
-          F22blr_ = BLRMPI_t(pgrid_, upd_tiles_, upd_tiles_);
+          F11blr_ = BLRMPI_t(*pgrid_, sep_tiles_, sep_tiles_);
+          F12blr_ = BLRMPI_t(*pgrid_, sep_tiles_, upd_tiles_);
+          F21blr_ = BLRMPI_t(*pgrid_, upd_tiles_, sep_tiles_);
+          F22blr_ = BLRMPI_t(*pgrid_, upd_tiles_, upd_tiles_);
           using Trip_t = Triplet<scalar_t>;
           std::vector<Trip_t> e11, e12, e21;
           A.push_front_elements
@@ -284,7 +312,7 @@ namespace strumpack {
                 (A, i, part, CP, r1buf, r2buf, r3buf, opts);
             });
         } else {
-          F11blr_ = BLRMPI_t(pgrid_, sep_tiles_, sep_tiles_);
+          F11blr_ = BLRMPI_t(*pgrid_, sep_tiles_, sep_tiles_);
           using Trip_t = Triplet<scalar_t>;
           std::vector<Trip_t> e11, e12, e21;
           A.push_front_elements
@@ -307,7 +335,7 @@ namespace strumpack {
       if (rchild_) rchild_->release_work_memory();
     } else {
       build_front(A);
-      extend_add();
+      extend_add(opts);
       if (lchild_) lchild_->release_work_memory();
       if (rchild_) rchild_->release_work_memory();
       if (dim_sep() && grid2d().active()) {
@@ -368,6 +396,9 @@ namespace strumpack {
         std::cout << std::endl;
       }
     }
+    this->stats_.factor_time = this->stats_elapsed(t0);
+    // only the root of the front's communicator reports this front
+    if (!Comm().is_root()) this->stats_.front = -1;
     return err_code;
   }
 
@@ -391,9 +422,9 @@ namespace strumpack {
       TIMER_TIME(TaskType::SOLVE_LOWER, 0, t_s);
       std::vector<std::size_t> col_tiles(1, b.cols());
       auto b_blr = BLRMPI_t::from_ScaLAPACK
-        (b, pgrid_, sep_tiles_, col_tiles);
+        (b, *pgrid_, sep_tiles_, col_tiles);
       auto bupd_blr = BLRMPI_t::from_ScaLAPACK
-        (bupd, pgrid_, upd_tiles_, col_tiles);
+        (bupd, *pgrid_, upd_tiles_, col_tiles);
       b_blr.laswp(piv_, true);
       if (b.cols() == 1) {
         trsv(UpLo::L, Trans::N, Diag::U, F11blr_, b_blr);
@@ -420,9 +451,9 @@ namespace strumpack {
       TIMER_TIME(TaskType::SOLVE_UPPER, 0, t_s);
       std::vector<std::size_t> col_tiles(1, y.cols());
       auto y_blr = BLRMPI_t::from_ScaLAPACK
-        (y, pgrid_, sep_tiles_, col_tiles);
+        (y, *pgrid_, sep_tiles_, col_tiles);
       auto yupd_blr = BLRMPI_t::from_ScaLAPACK
-        (yupd, pgrid_, upd_tiles_, col_tiles);
+        (yupd, *pgrid_, upd_tiles_, col_tiles);
       if (y.cols() == 1) {
         if (dim_upd())
           gemv(Trans::N, scalar_t(-1.), F12blr_, yupd_blr, scalar_t(1.), y_blr);
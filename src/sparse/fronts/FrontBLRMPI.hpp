@@ -51,7 +51,7 @@ namespace strumpack {
   public:
     FrontBLRMPI(integer_t sep, integer_t sep_begin, integer_t sep_end,
                 std::vector<integer_t>& upd, const MPIComm& comm, int P,
-                int leaf);
+                int leaf, FrontGridCache* grids=nullptr);
 
     void release_work_memory() override;
 
@@ -63,7 +63,7 @@ namespace strumpack {
                           const std::vector<Triplet<scalar_t>>& r3buf,
                           const Opts_t& opts);
 
-    void extend_add();
+    void extend_add(const Opts_t& opts);
     void extend_add_cols(std::size_t i, bool part, std::size_t CP,
                          const Opts_t& opts);
     void extend_add_copy_to_buffers(std::vector<std::vector<scalar_t>>& sbuf,
@@ -84,6 +84,12 @@ namespace strumpack {
                                           scalar_t** pbuf, const FBLRMPI_t* pa,
                                           integer_t begin_col, integer_t end_col)
       const override;
+    void extadd_blr_copy_to_buffers_compressed
+    (std::vector<std::vector<scalar_t>>& sbuf, const FBLRMPI_t* pa,
+     const Opts_t& opts) const override;
+    void extadd_blr_copy_from_buffers_compressed
+    (BLRMPI_t& F11, BLRMPI_t& F12, BLRMPI_t& F21, BLRMPI_t& F22,
+     scalar_t** pbuf, const FBLRMPI_t* pa) const override;
 
     ReturnCode factor(const SpMat_t& A, const Opts_t& opts,
                       VectorPool<scalar_t>& workspace,
@@ -110,21 +116,22 @@ namespace strumpack {
     void partition(const Opts_t& opts, const SpMat_t& A,
                    integer_t* sorder, bool is_root, int task_depth) override;
 
-    const BLR::ProcessorGrid2D& grid2d() const { return pgrid_; }
+    const BLR::ProcessorGrid2D& grid2d() const { return *pgrid_; }
 
     int sep_rg2p(std::size_t i) const { return F11blr_.rg2p(i); }
     int sep_cg2p(std::size_t j) const { return F11blr_.cg2p(j); }
 
     // might not be active, but still need this for extadd
-    int upd_rg2p(std::size_t i) const { return (i/leaf_)%pgrid_.nprows(); }
-    int upd_cg2p(std::size_t j) const { return (j/leaf_)%pgrid_.npcols(); }
+    int upd_rg2p(std::size_t i) const { return (i/leaf_)%pgrid_->nprows(); }
+    int upd_cg2p(std::size_t j) const { return (j/leaf_)%pgrid_->npcols(); }
 
   private:
     BLRMPI_t F11blr_, F12blr_, F21blr_, F22blr_;
     std::vector<int> piv_;
     std::vector<std::size_t> sep_tiles_, upd_tiles_;
     DenseMatrix<bool> adm_;
-    BLR::ProcessorGrid2D pgrid_;
+    // possibly shared with other fronts
+    std::shared_ptr<BLR::ProcessorGrid2D> pgrid_;
     int leaf_ = 0;
 
     long long node_factor_nonzeros() const override;
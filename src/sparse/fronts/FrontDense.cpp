@@ -230,6 +230,8 @@ namespace strumpack {
     // TODO can we allocate the memory in one go??
     const auto dsep = dim_sep();
     const auto dupd = dim_upd();
+    trace::Scope ts("assemble", this->sep_, etree_level, dsep, dupd);
+    auto t0 = this->stats_start(etree_level);
     F11_ = DenseM_t(dsep, dsep); F11_.zero();
     F12_ = DenseM_t(dsep, dupd); F12_.zero();
     F21_ = DenseM_t(dupd, dsep); F21_.zero();
@@ -253,6 +255,7 @@ namespace strumpack {
       rchild_->extend_add_to_dense
         (F11_, F12_, F21_, F22_, this, workspace, task_depth);
     if (etree_level == 0 && opts.write_root_front()) F11_.write("Froot");
+    this->stats_.assembly_time = this->stats_elapsed(t0);
     return err_code;
   }
 
@@ -261,7 +264,16 @@ namespace strumpack {
   (const SpMat_t& A, const Opts_t& opts,
    int etree_level, int task_depth) {
     ReturnCode err_code = ReturnCode::SUCCESS;
-    if (dim_sep()) {
+    trace::Scope ts("factor", this->sep_, etree_level, dim_sep(), dim_upd());
+    auto t0 = trace::now();
+    if (dim_sep() >= opts.dense_tiled_min_sep_size()) {
+      // panel factorizations, trsms and Schur update in a single DAG
+      if (LU_tiled(F11_, F12_, F21_, F22_, piv_, opts.dense_tile_size(),
+                   opts.replace_tiny_pivots() ? opts.pivot_threshold() : 0,
+                   task_depth))
+        err_code = ReturnCode::ZERO_PIVOT;
+      this->stats_.factor_time = this->stats_elapsed(t0);
+    } else if (dim_sep()) {
       if (F11_.LU(piv_, task_depth))
         err_code = ReturnCode::ZERO_PIVOT;
       if (opts.replace_tiny_pivots()) {
@@ -276,15 +288,21 @@ namespace strumpack {
              scalar_t(1.), F11_, F12_, task_depth);
         trsm(Side::R, UpLo::U, Trans::N, Diag::N,
              scalar_t(1.), F11_, F21_, task_depth);
+        this->stats_.factor_time = this->stats_elapsed(t0);
+        t0 = trace::now();
         gemm(Trans::N, Trans::N, scalar_t(-1.), F21_, F12_,
              scalar_t(1.), F22_, task_depth);
-      }
-    }
-    STRUMPACK_FULL_RANK_FLOPS
-      (LU_flops(F11_) +
-       gemm_flops(Trans::N, Trans::N, scalar_t(-1.), F21_, F12_, scalar_t(1.)) +
-       trsm_flops(Side::L, scalar_t(1.), F11_, F12_) +
-       trsm_flops(Side::R, scalar_t(1.), F11_, F21_));
+        this->stats_.schur_time = this->stats_elapsed(t0);
+      } else this->stats_.factor_time = this->stats_elapsed(t0);
+    } else this->stats_.factor_time = this->stats_elapsed(t0);
+    auto flops = LU_flops(F11_) +
+      gemm_flops(Trans::N, Trans::N, scalar_t(-1.), F21_, F12_, scalar_t(1.)) +
+      trsm_flops(Side::L, scalar_t(1.), F11_, F12_) +
+      trsm_flops(Side::R, scalar_t(1.), F11_, F21_);
+    STRUMPACK_FULL_RANK_FLOPS(flops);
+    ts.set_flops(flops);
+    this->stats_.flops = flops;
+    this->stats_finish(0);
     return err_code;
   }
 
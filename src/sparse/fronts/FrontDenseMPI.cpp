@@ -38,9 +38,10 @@ namespace strumpack {
   template<typename scalar_t,typename integer_t>
   FrontDenseMPI<scalar_t,integer_t>::FrontDenseMPI
   (integer_t sep, integer_t sep_begin, integer_t sep_end,
-   std::vector<integer_t>& upd, const MPIComm& comm, int P)
+   std::vector<integer_t>& upd, const MPIComm& comm, int P,
+   FrontGridCache* grids)
     : FrontMPI<scalar_t,integer_t>
-    (sep, sep_begin, sep_end, upd, comm, P) {
+    (sep, sep_begin, sep_end, upd, comm, P, grids) {
   }
 
   template<typename scalar_t,typename integer_t> void
@@ -247,6 +248,9 @@ namespace strumpack {
         (A, opts, etree_level+1, task_depth);
       if (er != ReturnCode::SUCCESS) err_code = er;
     }
+    trace::Scope ts("dense_MPI_factor", this->sep_, etree_level,
+                    this->dim_sep(), this->dim_upd());
+    auto t0 = this->stats_start(etree_level);
     build_front(A);
     if (etree_level == 0 && opts.write_root_front()) {
       auto Fs = F11_.gather();
@@ -267,6 +271,9 @@ namespace strumpack {
 #if defined(STRUMPACK_USE_ZFP) || defined(STRUMPACK_USE_SZ3)
     compress(opts);
 #endif
+    this->stats_.factor_time = this->stats_elapsed(t0);
+    // only the root of the front's communicator reports this front
+    if (!Comm().is_root()) this->stats_.front = -1;
     return err_code;
   }
 
@@ -62,7 +62,8 @@ namespace strumpack {
     FrontDenseMPI(integer_t sep,
                   integer_t sep_begin, integer_t sep_end,
                   std::vector<integer_t>& upd,
-                  const MPIComm& comm, int P);
+                  const MPIComm& comm, int P,
+                  FrontGridCache* grids=nullptr);
     FrontDenseMPI(const FDMPI_t&) = delete;
     FrontDenseMPI& operator=(FDMPI_t const&) = delete;
 
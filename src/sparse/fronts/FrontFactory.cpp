@@ -37,6 +37,8 @@
 #include "FrontBLR.hpp"
 #if defined(STRUMPACK_USE_BPACK)
 #include "FrontHODLR.hpp"
+#else
+#include "FrontNativeHODLR.hpp"
 #endif
 #if defined(STRUMPACK_USE_MPI)
 #include "FrontDenseMPI.hpp"
@@ -88,22 +90,28 @@ namespace strumpack {
       }
     } break;
     case CompressionType::HODLR: {
-#if defined(STRUMPACK_USE_BPACK)
       if (is_HODLR(dsep, dupd, opts)) {
+#if defined(STRUMPACK_USE_BPACK)
         front = std::make_unique<FrontHODLR<scalar_t,integer_t>>
           (s, sbegin, send, upd);
+#else
+        front = std::make_unique<FrontNativeHODLR<scalar_t,integer_t>>
+          (s, sbegin, send, upd);
+#endif
         if (root) fc.HODLR++;
       }
-#endif
     } break;
     case CompressionType::BLR_HODLR: {
-#if defined(STRUMPACK_USE_BPACK)
       if (is_HODLR(dsep, dupd, opts, 0)) {
+#if defined(STRUMPACK_USE_BPACK)
         front = std::make_unique<FrontHODLR<scalar_t,integer_t>>
           (s, sbegin, send, upd);
+#else
+        front = std::make_unique<FrontNativeHODLR<scalar_t,integer_t>>
+          (s, sbegin, send, upd);
+#endif
         if (root) fc.HODLR++;
       }
-#endif
       if (!front && is_BLR(dsep, dupd, opts, 1)) {
         front = std::make_unique<FrontBLR<scalar_t,integer_t>>
           (s, sbegin, send, upd);
@@ -111,13 +119,16 @@ namespace strumpack {
       }
     } break;
     case CompressionType::ZFP_BLR_HODLR: {
-#if defined(STRUMPACK_USE_BPACK)
       if (is_HODLR(dsep, dupd, opts, 0)) {
+#if defined(STRUMPACK_USE_BPACK)
         front = std::make_unique<FrontHODLR<scalar_t,integer_t>>
           (s, sbegin, send, upd);
+#else
+        front = std::make_unique<FrontNativeHODLR<scalar_t,integer_t>>
+          (s, sbegin, send, upd);
+#endif
         if (root) fc.HODLR++;
       }
-#endif
       if (!front && is_BLR(dsep, dupd, opts, 1)) {
         front.reset
           (new FrontBLR<scalar_t,integer_t>(s, sbegin, send, upd));
@@ -224,7 +235,8 @@ namespace strumpack {
   std::unique_ptr<FrontMPI<scalar_t,integer_t>> create_frontal_matrix
   (const SPOptions<scalar_t>& opts, integer_t s,
    integer_t sbegin, integer_t send, std::vector<integer_t>& upd,
-   int level, FrontCounter& fc, const MPIComm& comm, int P, bool root) {
+   int level, FrontCounter& fc, const MPIComm& comm, int P, bool root,
+   FrontGridCache* grids) {
     auto dsep = send - sbegin;
     auto dupd = upd.size();
     std::unique_ptr<FrontMPI<scalar_t,integer_t>> front;
@@ -232,14 +244,15 @@ namespace strumpack {
     case CompressionType::HSS: {
       if (is_HSS(dsep, dupd, opts)) {
         front = std::make_unique<FrontHSSMPI<scalar_t,integer_t>>
-          (s, sbegin, send, upd, comm, P);
+          (s, sbegin, send, upd, comm, P, grids);
         if (root) fc.HSS++;
       }
     } break;
     case CompressionType::BLR: {
       if (is_BLR(dsep, dupd, opts)) {
         front = std::make_unique<FrontBLRMPI<scalar_t,integer_t>>
-          (s, sbegin, send, upd, comm, P, opts.BLR_options().leaf_size());
+          (s, sbegin, send, upd, comm, P,
+           opts.BLR_options().leaf_size(), grids);
         if (root) fc.BLR++;
       }
     } break;
@@ -247,7 +260,7 @@ namespace strumpack {
 #if defined(STRUMPACK_USE_BPACK)
       if (is_HODLR(dsep, dupd, opts)) {
         front = std::make_unique<FrontHODLRMPI<scalar_t,integer_t>>
-          (s, sbegin, send, upd, comm, P);
+          (s, sbegin, send, upd, comm, P, grids);
         if (root) fc.HODLR++;
       }
 #endif
@@ -256,13 +269,14 @@ namespace strumpack {
 #if defined(STRUMPACK_USE_BPACK)
       if (is_HODLR(dsep, dupd, opts, 0)) {
         front = std::make_unique<FrontHODLRMPI<scalar_t,integer_t>>
-          (s, sbegin, send, upd, comm, P);
+          (s, sbegin, send, upd, comm, P, grids);
         if (root) fc.HODLR++;
       }
 #endif
       if (!front && is_BLR(dsep, dupd, opts, 1)) {
         front = std::make_unique<FrontBLRMPI<scalar_t,integer_t>>
-          (s, sbegin, send, upd, comm, P, opts.BLR_options().leaf_size());
+          (s, sbegin, send, upd, comm, P,
+           opts.BLR_options().leaf_size(), grids);
         if (root) fc.BLR++;
       }
     } break;
@@ -270,13 +284,14 @@ namespace strumpack {
 #if defined(STRUMPACK_USE_BPACK)
       if (is_HODLR(dsep, dupd, opts, 0)) {
         front = std::make_unique<FrontHODLRMPI<scalar_t,integer_t>>
-          (s, sbegin, send, upd, comm, P);
+          (s, sbegin, send, upd, comm, P, grids);
         if (root) fc.HODLR++;
       }
 #endif
       if (!front && is_BLR(dsep, dupd, opts, 1)) {
         front = std::make_unique<FrontBLRMPI<scalar_t,integer_t>>
-          (s, sbegin, send, upd, comm, P, opts.BLR_options().leaf_size());
+          (s, sbegin, send, upd, comm, P,
+           opts.BLR_options().leaf_size(), grids);
         if (root) fc.BLR++;
       }
     } break;
@@ -287,7 +302,7 @@ namespace strumpack {
     // (NONE, LOSSLESS, LOSSY or not compiled with HODLR)
     if (!front) {
       front = std::make_unique<FrontDenseMPI<scalar_t,integer_t>>
-        (s, sbegin, send, upd, comm, P);
+        (s, sbegin, send, upd, comm, P, grids);
       if (root) fc.dense++;
     }
     return front;
@@ -296,53 +311,65 @@ namespace strumpack {
   template std::unique_ptr<FrontMPI<float,int>>
   create_frontal_matrix(const SPOptions<float>& opts, int s, int sbegin, int send,
                         std::vector<int>& upd, int level, FrontCounter& fc,
-                        const MPIComm& comm, int P, bool root);
+                        const MPIComm& comm, int P, bool root,
+                        FrontGridCache* grids);
   template std::unique_ptr<FrontMPI<double,int>>
   create_frontal_matrix(const SPOptions<double>& opts, int s, int sbegin, int send,
                         std::vector<int>& upd, int level, FrontCounter& fc,
-                        const MPIComm& comm, int P, bool root);
+                        const MPIComm& comm, int P, bool root,
+                        FrontGridCache* grids);
   template std::unique_ptr<FrontMPI<std::complex<float>,int>>
   create_frontal_matrix(const SPOptions<std::complex<float>>& opts, int s, int sbegin, int send,
                         std::vector<int>& upd, int level, FrontCounter& fc,
-                        const MPIComm& comm, int P, bool root);
+                        const MPIComm& comm, int P, bool root,
+                        FrontGridCache* grids);
   template std::unique_ptr<FrontMPI<std::complex<double>,int>>
   create_frontal_matrix(const SPOptions<std::complex<double>>& opts, int s, int sbegin, int send,
                         std::vector<int>& upd, int level, FrontCounter& fc,
-                        const MPIComm& comm, int P, bool root);
+                        const MPIComm& comm, int P, bool root,
+                        FrontGridCache* grids);
 
   template std::unique_ptr<FrontMPI<float,long int>>
   create_frontal_matrix(const SPOptions<float>& opts, long int s, long int sbegin,
                         long int send, std::vector<long int>& upd, int level,
-                        FrontCounter& fc, const MPIComm& comm, int P, bool root);
+                        FrontCounter& fc, const MPIComm& comm, int P, bool root,
+                        FrontGridCache* grids);
   template std::unique_ptr<FrontMPI<double,long int>>
   create_frontal_matrix(const SPOptions<double>& opts, long int s, long int sbegin,
                         long int send, std::vector<long int>& upd, int level,
-                        FrontCounter& fc, const MPIComm& comm, int P, bool root);
+                        FrontCounter& fc, const MPIComm& comm, int P, bool root,
+                        FrontGridCache* grids);
   template std::unique_ptr<FrontMPI<std::complex<float>,long int>>
   create_frontal_matrix(const SPOptions<std::complex<float>>& opts, long int s,
                         long int sbegin, long int send, std::vector<long int>& upd,
-                        int level, FrontCounter& fc, const MPIComm& comm, int P, bool root);
+                        int level, FrontCounter& fc, const MPIComm& comm, int P, bool root,
+                        FrontGridCache* grids);
   template std::unique_ptr<FrontMPI<std::complex<double>,long int>>
   create_frontal_matrix(const SPOptions<std::complex<double>>& opts, long int s,
                         long int sbegin, long int send, std::vector<long int>& upd,
-                        int level, FrontCounter& fc, const MPIComm& comm, int P, bool root);
+                        int level, FrontCounter& fc, const MPIComm& comm, int P, bool root,
+                        FrontGridCache* grids);
 
   template std::unique_ptr<FrontMPI<float,long long int>>
   create_frontal_matrix(const SPOptions<float>& opts, long long int s, long long int sbegin,
                         long long int send, std::vector<long long int>& upd,
-                        int level, FrontCounter& fc, const MPIComm& comm, int P, bool root);
+                        int level, FrontCounter& fc, const MPIComm& comm, int P, bool root,
+                        FrontGridCache* grids);
   template std::unique_ptr<FrontMPI<double,long long int>>
   create_frontal_matrix(const SPOptions<double>& opts, long long int s, long long int sbegin,
                         long long int send, std::vector<long long int>& upd,
-                        int level, FrontCounter& fc, const MPIComm& comm, int P, bool root);
+                        int level, FrontCounter& fc, const MPIComm& comm, int P, bool root,
+                        FrontGridCache* grids);
   template std::unique_ptr<FrontMPI<std::complex<float>,long long int>>
   create_frontal_matrix(const SPOptions<std::complex<float>>& opts, long long int s,
                         long long int sbegin, long long int send, std::vector<long long int>& upd,
-                        int level, FrontCounter& fc, const MPIComm& comm, int P, bool root);
+                        int level, FrontCounter& fc, const MPIComm& comm, int P, bool root,
+                        FrontGridCache* grids);
   template std::unique_ptr<FrontMPI<std::complex<double>,long long int>>
   create_frontal_matrix(const SPOptions<std::complex<double>>& opts, long long int s,
                         long long int sbegin, long long int send, std::vector<long long int>& upd,
-                        int level, FrontCounter& fc, const MPIComm& comm, int P, bool root);
+                        int level, FrontCounter& fc, const MPIComm& comm, int P, bool root,
+                        FrontGridCache* grids);
 
 #endif
 
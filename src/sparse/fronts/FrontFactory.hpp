@@ -99,15 +99,12 @@ namespace strumpack {
 
   template<typename scalar_t> bool is_HODLR
   (int dsep, int dupd, const SPOptions<scalar_t>& opts, int l=0) {
-#if defined(STRUMPACK_USE_BPACK)
+    // without ButterflyPACK, sequential fronts use FrontNativeHODLR
     return (opts.compression() == CompressionType::HODLR ||
             opts.compression() == CompressionType::BLR_HODLR ||
             opts.compression() == CompressionType::ZFP_BLR_HODLR) &&
       (dsep >= opts.compression_min_sep_size(l) ||
        dsep + dupd >= opts.compression_min_front_size(l));
-#else
-    return false;
-#endif
   }
 
   template<typename scalar_t> bool is_lossy
@@ -135,6 +132,7 @@ namespace strumpack {
   // forward definition
   template<typename scalar_t,typename integer_t> class Front;
   template<typename scalar_t,typename integer_t> class FrontMPI;
+  class FrontGridCache;
 
   template<typename scalar_t, typename integer_t>
   std::unique_ptr<Front<scalar_t,integer_t>> create_frontal_matrix
@@ -148,7 +146,8 @@ namespace strumpack {
   std::unique_ptr<FrontMPI<scalar_t,integer_t>> create_frontal_matrix
   (const SPOptions<scalar_t>& opts, integer_t s,
    integer_t sbegin, integer_t send, std::vector<integer_t>& upd,
-   int level, FrontCounter& fc, const MPIComm& comm, int P, bool root);
+   int level, FrontCounter& fc, const MPIComm& comm, int P, bool root,
+   FrontGridCache* grids=nullptr);
 #endif
 
 } // end namespace strumpack
@@ -0,0 +1,113 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government igs granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+#include <algorithm>
+
+#include "FrontGridCache.hpp"
+#include "dense/DistributedMatrix.hpp"
+#include "BLR/BLRMatrixMPI.hpp"
+
+namespace strumpack {
+
+  FrontGridCache::FrontGridCache(const MPIComm& comm) {
+    if (!comm.is_null())
+      MPI_Comm_group(comm.comm(), &group_);
+  }
+
+  FrontGridCache::~FrontGridCache() {
+    clear();
+    if (group_ != MPI_GROUP_NULL)
+      MPI_Group_free(&group_);
+  }
+
+  void FrontGridCache::clear() {
+    blr_.clear();
+    blacs_.clear();
+    comms_.clear();
+  }
+
+  FrontGridCache::key_t
+  FrontGridCache::ranks(const MPIComm& comm) const {
+    int P = comm.size();
+    std::vector<int> lranks(P), granks(P);
+    std::iota(lranks.begin(), lranks.end(), 0);
+    MPI_Group group;
+    MPI_Comm_group(comm.comm(), &group);
+    MPI_Group_translate_ranks
+      (group, P, lranks.data(), group_, granks.data());
+    MPI_Group_free(&group);
+    return granks;
+  }
+
+  const MPIComm& FrontGridCache::sub(const MPIComm& comm, int P0, int P) {
+    if (comm.is_null()) return null_;
+    auto key = ranks(comm);
+    key.push_back(P0);
+    key.push_back(P);
+    auto c = comms_.find(key);
+    if (c != comms_.end()) return c->second;
+    return comms_.emplace(std::move(key), comm.sub(P0, P)).first->second;
+  }
+
+  void FrontGridCache::layout
+  (int P, std::size_t n, int& nprows, int& npcols) {
+    // each active rank should get at least a 2x2 set of blocks
+    const int MB = DistributedMatrix<double>::default_MB,
+      NB = DistributedMatrix<double>::default_NB;
+    BLACSGrid::layout(P, n, n, MB, NB, 4, nprows, npcols);
+  }
+
+  std::shared_ptr<BLACSGrid> FrontGridCache::blacs_grid
+  (FrontGridCache* grids, const MPIComm& comm, int P, std::size_t n) {
+    int nprows, npcols;
+    layout(P, n, nprows, npcols);
+    if (!grids || comm.is_null())
+      return std::make_shared<BLACSGrid>(comm, P, nprows, npcols);
+    auto key = grids->ranks(comm);
+    key.push_back(nprows);
+    key.push_back(npcols);
+    auto g = grids->blacs_.find(key);
+    if (g != grids->blacs_.end()) return g->second;
+    auto grid = std::make_shared<BLACSGrid>(comm, P, nprows, npcols);
+    grids->blacs_.emplace(std::move(key), grid);
+    return grid;
+  }
+
+  std::shared_ptr<BLR::ProcessorGrid2D> FrontGridCache::BLR_grid
+  (FrontGridCache* grids, const MPIComm& comm, int P) {
+    if (!grids || comm.is_null())
+      return std::make_shared<BLR::ProcessorGrid2D>(comm, P);
+    auto key = grids->ranks(comm);
+    auto g = grids->blr_.find(key);
+    if (g != grids->blr_.end()) return g->second;
+    auto grid = std::make_shared<BLR::ProcessorGrid2D>(comm, P);
+    grids->blr_.emplace(std::move(key), grid);
+    return grid;
+  }
+
+} // end namespace strumpack
@@ -0,0 +1,149 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government igs granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+/**
+ * \file FrontGridCache.hpp
+ * \brief Contains the FrontGridCache class, a cache for the process
+ * grids and communicators used by the distributed fronts.
+ */
+#ifndef FRONT_GRID_CACHE_HPP
+#define FRONT_GRID_CACHE_HPP
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "misc/MPIWrapper.hpp"
+#include "dense/BLACSGrid.hpp"
+
+namespace strumpack {
+
+  // forward declarations
+  namespace BLR {
+    class ProcessorGrid2D;
+  }
+
+  /**
+   * \class FrontGridCache
+   *
+   * \brief Cache for the communicators, BLACS grids and BLR process
+   * grids of the distributed fronts.
+   *
+   * Setting up a communicator or a (BLACS) grid is collective and
+   * relatively expensive. This class keeps those objects, keyed on
+   * the set of ranks (of the communicator passed to the constructor)
+   * that they span, so that fronts mapped to the same ranks share
+   * them, also across multiple symbolic factorizations.
+   *
+   * Since the key only depends on the rank set, all ranks of the
+   * communicator on which a collective operation is performed agree
+   * on whether an object is found in the cache, and hence either all
+   * or none of them participate in the collective setup.
+   *
+   * This should be destroyed before MPI_Finalize. Objects handed out
+   * as std::shared_ptr can outlive the cache.
+   */
+  class FrontGridCache {
+  public:
+    /**
+     * Construct an empty cache.
+     *
+     * \param comm communicator containing all ranks that will use
+     * the cache, used to identify rank sets
+     */
+    FrontGridCache(const MPIComm& comm);
+    ~FrontGridCache();
+
+    FrontGridCache(const FrontGridCache&) = delete;
+    FrontGridCache& operator=(const FrontGridCache&) = delete;
+
+    /**
+     * Return the sub-communicator with ranks [P0, P0+P) from comm,
+     * see MPIComm::sub. Collective on comm, if not found in the
+     * cache. The returned reference remains valid for the lifetime
+     * of the cache.
+     */
+    const MPIComm& sub(const MPIComm& comm, int P0, int P);
+
+    /**
+     * Return a BLACS grid for a front of dimension n, using (at
+     * most) P ranks from comm, with the layout from
+     * layout(int,std::size_t,int&,int&). Collective on comm if comm
+     * is not null and the grid is not found in the cache. If comm is
+     * null, a new grid is returned which only holds the layout.
+     *
+     * \param grids cache, can be null, then a new grid is constructed
+     * \param comm communicator for the front, or MPI_COMM_NULL
+     * \param P number of ranks, comm.size() if comm is not null
+     * \param n dimension of the front
+     */
+    static std::shared_ptr<BLACSGrid>
+    blacs_grid(FrontGridCache* grids, const MPIComm& comm,
+               int P, std::size_t n);
+
+    /**
+     * Return a BLR::ProcessorGrid2D using P ranks from comm.
+     * Collective on comm if comm is not null and the grid is not
+     * found in the cache.
+     *
+     * \param grids cache, can be null, then a new grid is constructed
+     * \param comm communicator for the front, or MPI_COMM_NULL
+     * \param P number of ranks, comm.size() if comm is not null
+     */
+    static std::shared_ptr<BLR::ProcessorGrid2D>
+    BLR_grid(FrontGridCache* grids, const MPIComm& comm, int P);
+
+    /**
+     * Select a 2D block-cyclic process grid for a front of
+     * dimension n (separator + update), with at most P ranks. Small
+     * fronts are mapped to fewer (multithreaded) ranks, so that each
+     * active rank holds at least a few ScaLAPACK blocks, see
+     * BLACSGrid::layout(int,std::size_t,std::size_t,int,int,int,int&,int&).
+     */
+    static void layout(int P, std::size_t n, int& nprows, int& npcols);
+
+    /**
+     * Release all cached objects. Grids that are still used by
+     * fronts are kept alive by those fronts.
+     */
+    void clear();
+
+  private:
+    using key_t = std::vector<int>;
+    MPI_Group group_ = MPI_GROUP_NULL;
+    MPIComm null_;
+    std::map<key_t,MPIComm> comms_;
+    std::map<key_t,std::shared_ptr<BLACSGrid>> blacs_;
+    std::map<key_t,std::shared_ptr<BLR::ProcessorGrid2D>> blr_;
+
+    key_t ranks(const MPIComm& comm) const;
+  };
+
+} // end namespace strumpack
+
+#endif // FRONT_GRID_CACHE_HPP
@@ -436,6 +436,9 @@ namespace strumpack {
       if (er != ReturnCode::SUCCESS) err_code = er;
     }
     if (!this->dim_blk()) return err_code;
+    trace::Scope ts("HODLR_factor", this->sep_, etree_level,
+                    this->dim_sep(), this->dim_upd());
+    auto t0 = this->stats_start(etree_level);
     TaskTimer t("");
     if (opts.print_compressed_front_stats()) t.start();
     construct_hierarchy(A, opts, task_depth);
@@ -499,6 +502,8 @@ namespace strumpack {
     }
     if (lchild_) lchild_->release_work_memory();
     if (rchild_) rchild_->release_work_memory();
+    this->stats_.factor_time = this->stats_elapsed(t0);
+    this->stats_finish(front_rank());
     return err_code;
   }
 
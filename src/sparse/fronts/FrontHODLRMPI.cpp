@@ -37,9 +37,10 @@ namespace strumpack {
   template<typename scalar_t,typename integer_t>
   FrontHODLRMPI<scalar_t,integer_t>::FrontHODLRMPI
   (integer_t sep, integer_t sep_begin, integer_t sep_end,
-   std::vector<integer_t>& upd, const MPIComm& comm, int total_procs)
+   std::vector<integer_t>& upd, const MPIComm& comm, int total_procs,
+   FrontGridCache* grids)
     : FrontMPI<scalar_t,integer_t>
-    (sep, sep_begin, sep_end, upd, comm, total_procs) {
+    (sep, sep_begin, sep_end, upd, comm, total_procs, grids) {
   }
 
   template<typename scalar_t,typename integer_t>
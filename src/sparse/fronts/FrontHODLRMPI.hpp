@@ -53,7 +53,8 @@ namespace strumpack {
   public:
     FrontHODLRMPI(integer_t sep, integer_t sep_begin,
                   integer_t sep_end, std::vector<integer_t>& upd,
-                  const MPIComm& comm, int _total_procs);
+                  const MPIComm& comm, int _total_procs,
+                  FrontGridCache* grids=nullptr);
 
     ~FrontHODLRMPI();
 
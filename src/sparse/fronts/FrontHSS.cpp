@@ -45,11 +45,14 @@ namespace strumpack {
 
   template<typename scalar_t,typename integer_t> void
   FrontHSS<scalar_t,integer_t>::release_work_memory() {
+    // the plan refers to the generators of H_.child(1)
+    CB_plan_.reset();
     ThetaVhatC_or_VhatCPhiC_.clear();
     H_.delete_trailing_block();
     R1.clear();
     Sr2.clear();
     Sc2.clear();
+    R1_cols_ = 0;
     DUB01_.clear();
   }
 
@@ -154,74 +157,45 @@ namespace strumpack {
    DenseM_t& Sr, DenseM_t& Sc, F_t* pa, int task_depth) {
     if (!dim_upd()) return;
     auto I = this->upd_to_parent(pa);
-    auto cR = R.extract_rows(I);
-    auto dchild = R1.cols();
-    auto dall = R.cols();
+    std::size_t dchild = R1_cols_, dall = R.cols();
     if (dchild > 0 && opts.indirect_sampling()) {
-      DenseM_t cSr, cSc;
-      DenseMW_t cRd0(cR.rows(), dchild, cR, 0, 0);
       TIMER_TIME(TaskType::HSS_SCHUR_PRODUCT, 2, t_sprod);
-      H_.Schur_product_indirect(DUB01_, R1, cRd0, Sr2, Sc2, cSr, cSc);
+      // the rows I of the first dchild columns of R are used, and the
+      // result is added to the rows I of Sr and Sc, without copies
+      H_.Schur_product_indirect
+        (DUB01_, DenseMW_t(R1.rows(), dchild, R1, 0, 0), R,
+         DenseMW_t(Sr2.rows(), dchild, Sr2, 0, 0),
+         DenseMW_t(Sc2.rows(), dchild, Sc2, 0, 0), Sr, Sc, &I);
       TIMER_STOP(t_sprod);
-      DenseMW_t(Sr.rows(), dchild, Sr, 0, 0)
-        .scatter_rows_add(I, cSr, task_depth);
-      DenseMW_t(Sc.rows(), dchild, Sc, 0, 0)
-        .scatter_rows_add(I, cSc, task_depth);
       R1.clear();
       Sr2.clear();
       Sc2.clear();
+      R1_cols_ = 0;
       if (dall > dchild) {
         DenseMW_t Srdd(Sr.rows(), dall-dchild, Sr, 0, dchild);
         DenseMW_t Scdd(Sc.rows(), dall-dchild, Sc, 0, dchild);
-        DenseMW_t cRdd(cR.rows(), dall-dchild, cR, 0, dchild);
-        sample_CB_direct(cRdd, Srdd, Scdd, I, task_depth);
+        auto Rdd = ConstDenseMatrixWrapperPtr
+          (R.rows(), dall-dchild, R, 0, dchild);
+        sample_CB_direct(*Rdd, Srdd, Scdd, I, task_depth);
       }
-    } else sample_CB_direct(cR, Sr, Sc, I, task_depth);
+    } else sample_CB_direct(R, Sr, Sc, I, task_depth);
   }
 
   template<typename scalar_t,typename integer_t> void
   FrontHSS<scalar_t,integer_t>::sample_CB_direct
-  (const DenseM_t& cR, DenseM_t& Sr, DenseM_t& Sc,
+  (const DenseM_t& R, DenseM_t& Sr, DenseM_t& Sc,
    const std::vector<std::size_t>& I, int task_depth) {
-#if 0
-    // TODO count flops here
-    auto cSr = H_.child(1)->apply(cR);
-    auto cSc = H_.child(1)->applyC(cR);
-    if (Theta_.cols() < Phi_.cols()) {
-      // TODO 2 tasks?
-      DenseM_t tmp(ThetaVhatC_or_VhatCPhiC_.rows(), cR.cols());
-      gemm(Trans::N, Trans::N, scalar_t(1.), ThetaVhatC_or_VhatCPhiC_, cR,
-           scalar_t(0.), tmp, task_depth);
-      gemm(Trans::N, Trans::N, scalar_t(-1.), Theta_, tmp,
-           scalar_t(1.), cSr, task_depth);
-      tmp = DenseM_t(_Theta.cols(), cR.cols());
-      gemm(Trans::C, Trans::N, scalar_t(1.), Theta_, cR,
-           scalar_t(0.), tmp, task_depth);
-      gemm(Trans::C, Trans::N, scalar_t(-1.), ThetaVhatC_or_VhatCPhiC_, tmp,
-           scalar_t(1.), cSc, task_depth);
-    } else {
-      DenseM_t tmp(Phi.cols(), cR.cols());
-      gemm(Trans::C, Trans::N, scalar_t(1.), Phi_, cR,
-           scalar_t(0.), tmp, task_depth);
-      gemm(Trans::N, Trans::N, scalar_t(-1.), ThetaVhatC_or_VhatCPhiC_, tmp,
-           scalar_t(1.), cSr, task_depth);
-      tmp = DenseM_t(_ThetaVhatC_or_VhatCPhiC.cols(), cR.cols());
-      gemm(Trans::C, Trans::N, scalar_t(1.), ThetaVhatC_or_VhatCPhiC_, cR,
-           scalar_t(0.), tmp, task_depth);
-      gemm(Trans::N, Trans::N, scalar_t(-1.), Phi_, tmp,
-           scalar_t(1.), cSc, task_depth);
-    }
-#else
-    DenseM_t cSr(cR.rows(), cR.cols());
-    DenseM_t cSc(cR.rows(), cR.cols());
+    // the rows I of R are used, and the samples added to the rows I
+    // of Sr and Sc, without copying them to a separate matrix
     TIMER_TIME(TaskType::HSS_SCHUR_PRODUCT, 2, t_sprod);
+    if (!CB_plan_)
+      CB_plan_ = std::make_unique<HSS::HSSApplyPlan<scalar_t>>
+        (*H_.child(1), R.cols());
+    else CB_plan_->reserve(R.cols());
     H_.Schur_product_direct
-      (Theta_, DUB01_, Phi_, ThetaVhatC_or_VhatCPhiC_, cR, cSr, cSc);
+      (Theta_, DUB01_, Phi_, ThetaVhatC_or_VhatCPhiC_, *CB_plan_,
+       R, Sr, Sc, I);
     TIMER_STOP(t_sprod);
-#endif
-    Sr.scatter_rows_add(I, cSr, task_depth);
-    Sc.scatter_rows_add(I, cSc, task_depth);
-    STRUMPACK_CB_SAMPLE_FLOPS(cSr.rows()*cSr.cols()*2);
   }
 
   template<typename scalar_t,typename integer_t> ReturnCode
@@ -294,15 +268,19 @@ namespace strumpack {
     TIMER_STOP(t_UUtxR);
 
     if (opts.indirect_sampling() && etree_level != 0) {
-      auto dold = R1.cols();
+      auto dold = R1_cols_;
       auto dd = Rr.cols();
       auto dnew = dold + dd;
-      R1.resize(dsep, dnew);
-      Sr2.resize(dupd, dnew);
-      Sc2.resize(dupd, dnew);
+      if (dnew > R1.cols()) {
+        auto dcap = std::max(dnew, 2*R1.cols());
+        R1.resize(dsep, dcap);
+        Sr2.resize(dupd, dcap);
+        Sc2.resize(dupd, dcap);
+      }
       copy(dsep, dd, Rr, 0, 0, R1, 0, dold);
       copy(dupd, dd, Sr, dsep, 0, Sr2, 0, dold);
       copy(dupd, dd, Sc, dsep, 0, Sc2, 0, dold);
+      R1_cols_ = dnew;
     }
   }
 
@@ -360,6 +338,9 @@ namespace strumpack {
     ReturnCode err_code = ReturnCode::SUCCESS;
     if (el != ReturnCode::SUCCESS) err_code = el;
     if (er != ReturnCode::SUCCESS) err_code = er;
+    trace::Scope ts("HSS_factor", this->sep_, etree_level,
+                    dim_sep(), dim_upd());
+    auto t0 = this->stats_start(etree_level);
     TaskTimer t("FrontHSS_factor");
     if (opts.print_compressed_front_stats()) t.start();
     H_.set_openmp_task_depth(task_depth);
@@ -430,6 +411,8 @@ namespace strumpack {
                 << " %compression, time= " << time
                 << " sec" << std::endl;
     }
+    this->stats_.factor_time = this->stats_elapsed(t0);
+    this->stats_finish(front_rank());
     return err_code;
   }
 
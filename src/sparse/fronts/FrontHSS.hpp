@@ -63,7 +63,7 @@ namespace strumpack {
                    DenseM_t& Sr, DenseM_t& Sc,
                    F_t* pa, int task_depth) override;
 
-    void sample_CB_direct(const DenseM_t& cR, DenseM_t& Sr, DenseM_t& Sc,
+    void sample_CB_direct(const DenseM_t& R, DenseM_t& Sr, DenseM_t& Sc,
                           const std::vector<std::size_t>& I, int task_depth);
 
     void release_work_memory() override;
@@ -94,7 +94,7 @@ namespace strumpack {
     bool isHSS() const override { return true; };
     std::string type() const override { return "FrontHSS"; }
 
-    int random_samples() const override { return R1.cols(); };
+    int random_samples() const override { return R1_cols_; };
 
     void partition(const Opts_t& opts, const SpMat_t& A, integer_t* sorder,
                    bool is_root=true, int task_depth=0) override;
@@ -118,8 +118,15 @@ namespace strumpack {
                            HSS matrix of this front */
     DenseM_t Sr2, Sc2;  /* bottom of the sample matrix used to
                            construct HSS matrix of this front */
+    std::size_t R1_cols_ = 0; /* columns of R1, Sr2 and Sc2 in use,
+                                 the capacity is doubled as needed */
     std::uint32_t sampled_columns_ = 0;
 
+    /** index vectors and workspace for the products with
+        H_.child(1) when sampling the Schur complement, reused over
+        the adaptive sampling steps of the parent front */
+    std::unique_ptr<HSS::HSSApplyPlan<scalar_t>> CB_plan_;
+
   private:
     FrontHSS(const FrontHSS&) = delete;
     FrontHSS& operator=(FrontHSS const&) = delete;
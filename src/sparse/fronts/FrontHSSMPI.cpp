@@ -35,9 +35,10 @@ namespace strumpack {
   template<typename scalar_t,typename integer_t>
   FrontHSSMPI<scalar_t,integer_t>::FrontHSSMPI
   (integer_t sep, integer_t sep_begin, integer_t sep_end,
-   std::vector<integer_t>& upd, const MPIComm& comm, int total_procs)
+   std::vector<integer_t>& upd, const MPIComm& comm, int total_procs,
+   FrontGridCache* grids)
     : FrontMPI<scalar_t,integer_t>
-    (sep, sep_begin, sep_end, upd, comm, total_procs) {
+    (sep, sep_begin, sep_end, upd, comm, total_procs, grids) {
   }
 
   template<typename scalar_t,typename integer_t> void
@@ -140,6 +141,9 @@ namespace strumpack {
       if (er != ReturnCode::SUCCESS) err_code = er;
     }
     if (!dim_blk()) return err_code;
+    trace::Scope ts("HSS_MPI_factor", this->sep_, etree_level,
+                    dim_sep(), dim_upd());
+    auto t0 = this->stats_start(etree_level);
     TaskTimer t("FrontHSSMPI_factor");
     if (opts.print_compressed_front_stats()) t.start();
     auto mult = [&](DistM_t& R, DistM_t& Sr, DistM_t& Sc) {
@@ -205,6 +209,9 @@ namespace strumpack {
                   << " %compression, time= " << time
                   << " sec" << std::endl;
     }
+    this->stats_.factor_time = this->stats_elapsed(t0);
+    // only the root of the front's communicator reports this front
+    if (!Comm().is_root()) this->stats_.front = -1;
     return err_code;
   }
 
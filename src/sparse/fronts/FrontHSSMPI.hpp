@@ -47,7 +47,7 @@ namespace strumpack {
   public:
     FrontHSSMPI(integer_t sep, integer_t sep_begin, integer_t sep_end,
                 std::vector<integer_t>& upd, const MPIComm& comm,
-                int _total_procs);
+                int _total_procs, FrontGridCache* grids=nullptr);
     FrontHSSMPI(const FrontHSSMPI&) = delete;
     FrontHSSMPI& operator=(FrontHSSMPI const&) = delete;
 
@@ -158,17 +158,43 @@ namespace strumpack {
 
   template<typename scalar_t,typename integer_t> long long
   FrontLossy<scalar_t,integer_t>::node_factor_nonzeros() const {
-    return (F11c_.compressed_size() + F12c_.compressed_size() +
-            F21c_.compressed_size()) / sizeof(scalar_t);
+    std::size_t nnz = 0;
+    for (auto Fc : {&F11c_, &F12c_, &F21c_})
+      for (auto& P : *Fc)
+        nnz += P.compressed_size();
+    return nnz / sizeof(scalar_t);
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  FrontLossy<scalar_t,integer_t>::compress_panels
+  (const DenseM_t& F, std::vector<LM_t>& Fc, int prec, double acc) const {
+    Fc.clear();
+    // reserve, LossyMatrix should not be moved around
+    Fc.reserve((F.cols() + nb_ - 1) / nb_);
+    for (std::size_t c=0; c<F.cols(); c+=nb_)
+      Fc.emplace_back
+        (DenseM_t(F.rows(), std::min(nb_, F.cols()-c), F, 0, c),
+         prec, acc);
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  FrontLossy<scalar_t,integer_t>::decompress_panels
+  (const std::vector<LM_t>& Fc, DenseM_t& F) const {
+    std::size_t rows = Fc.empty() ? 0 : Fc[0].rows(), cols = 0;
+    for (auto& P : Fc) cols += P.cols();
+    F = DenseM_t(rows, cols);
+    for (std::size_t k=0, c=0; k<Fc.size(); c+=Fc[k++].cols())
+      copy(Fc[k].decompress(), F, 0, c);
   }
 
   template<typename scalar_t,typename integer_t> void
   FrontLossy<scalar_t,integer_t>::compress(const Opts_t& opts) {
     auto prec = opts.lossy_precision();
     auto acc = opts.lossy_accuracy();
-    F11c_ = LossyMatrix<scalar_t>(this->F11_, prec, acc);
-    F12c_ = LossyMatrix<scalar_t>(this->F12_, prec, acc);
-    F21c_ = LossyMatrix<scalar_t>(this->F21_, prec, acc);
+    nb_ = opts.dense_tile_size();
+    compress_panels(this->F11_, F11c_, prec, acc);
+    compress_panels(this->F12_, F12c_, prec, acc);
+    compress_panels(this->F21_, F21c_, prec, acc);
     this->F11_.clear();
     this->F12_.clear();
     this->F21_.clear();
@@ -177,39 +203,88 @@ namespace strumpack {
   template<typename scalar_t,typename integer_t> void
   FrontLossy<scalar_t,integer_t>::decompress
   (DenseM_t& F11, DenseM_t& F12, DenseM_t& F21) const {
-    F11 = F11c_.decompress();
-    F12 = F12c_.decompress();
-    F21 = F21c_.decompress();
+    decompress_panels(F11c_, F11);
+    decompress_panels(F12c_, F12);
+    decompress_panels(F21c_, F21);
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  FrontLossy<scalar_t,integer_t>::decompress_CB
+  (VectorPool<scalar_t>& workspace) {
+    const std::size_t dupd = this->dim_upd();
+    auto& CB = this->CBstorage_;
+    CB = workspace.get();
+    std::size_t old_size = CB.size();
+    if (dupd*dupd > old_size) {
+      STRUMPACK_ADD_MEMORY((dupd*dupd - old_size)*sizeof(scalar_t));
+    }
+    CB.resize(dupd*dupd);
+    this->F22_ = DenseMW_t(dupd, dupd, CB.data(), dupd);
+    F22c_->decompress(this->F22_);
+    F22c_.reset();
   }
 
   template<typename scalar_t,typename integer_t> ReturnCode
   FrontLossy<scalar_t,integer_t>::factor
   (const SpMat_t& A, const Opts_t& opts, VectorPool<scalar_t>& workspace,
    int etree_level, int task_depth) {
+    // the contribution blocks of lossy children are only compressed
+    // when this front does the extend-add, see extend_add_to_dense
+    for (auto& ch : {this->lchild_.get(), this->rchild_.get()})
+      if (auto c = dynamic_cast<FrontLossy<scalar_t,integer_t>*>(ch))
+        c->compress_CB_ = opts.lossy_CB();
     auto e = FD_t::factor(A, opts, workspace, etree_level, task_depth);
     compress(opts);
+    if (compress_CB_ && this->dim_upd()) {
+      // the (uncompressed) CB storage goes back to the pool, to be
+      // reused by other fronts while this CB waits for the parent
+      F22c_.reset
+        (new LM_t(this->F22_, opts.lossy_precision(),
+                  opts.lossy_accuracy()));
+      FD_t::release_work_memory(workspace);
+    }
     return e;
   }
 
+  template<typename scalar_t,typename integer_t> void
+  FrontLossy<scalar_t,integer_t>::extend_add_to_dense
+  (DenseM_t& paF11, DenseM_t& paF12, DenseM_t& paF21, DenseM_t& paF22,
+   const F_t* p, VectorPool<scalar_t>& workspace, int task_depth) {
+    if (F22c_) decompress_CB(workspace);
+    FD_t::extend_add_to_dense
+      (paF11, paF12, paF21, paF22, p, workspace, task_depth);
+  }
+
   template<typename scalar_t,typename integer_t> void
   FrontLossy<scalar_t,integer_t>::fwd_solve_phase2
   (DenseM_t& b, DenseM_t& bupd, int etree_level, int task_depth) const {
-    DenseM_t F11, F12, F21;
-    decompress(F11, F12, F21);
-    if (this->dim_sep()) {
-      DenseMW_t bloc(this->dim_sep(), b.cols(), b, this->sep_begin_, 0);
-      bloc.laswp(this->piv_, true);
+    const std::size_t dsep = this->dim_sep();
+    if (!dsep) return;
+    DenseMW_t bloc(dsep, b.cols(), b, this->sep_begin_, 0);
+    bloc.laswp(this->piv_, true);
+    // decompress and apply one block column of L at a time
+    for (std::size_t k=0, c=0; k<F11c_.size(); c+=F11c_[k++].cols()) {
+      const std::size_t w = F11c_[k].cols();
+      auto F = F11c_[k].decompress();
+      DenseMW_t Fkk(w, w, F, c, 0), bk(w, b.cols(), bloc, c, 0),
+        Fk(dsep-c-w, w, F, c+w, 0), bb(dsep-c-w, b.cols(), bloc, c+w, 0);
       if (b.cols() == 1) {
-        trsv(UpLo::L, Trans::N, Diag::U, F11, bloc, task_depth);
+        trsv(UpLo::L, Trans::N, Diag::U, Fkk, bk, task_depth);
+        if (c+w < dsep)
+          gemv(Trans::N, scalar_t(-1.), Fk, bk,
+               scalar_t(1.), bb, task_depth);
         if (this->dim_upd())
-          gemv(Trans::N, scalar_t(-1.), F21, bloc,
+          gemv(Trans::N, scalar_t(-1.), F21c_[k].decompress(), bk,
                scalar_t(1.), bupd, task_depth);
       } else {
         trsm(Side::L, UpLo::L, Trans::N, Diag::U,
-             scalar_t(1.), F11, bloc, task_depth);
+             scalar_t(1.), Fkk, bk, task_depth);
+        if (c+w < dsep)
+          gemm(Trans::N, Trans::N, scalar_t(-1.), Fk, bk,
+               scalar_t(1.), bb, task_depth);
         if (this->dim_upd())
-          gemm(Trans::N, Trans::N, scalar_t(-1.), F21, bloc,
-               scalar_t(1.), bupd, task_depth);
+          gemm(Trans::N, Trans::N, scalar_t(-1.), F21c_[k].decompress(),
+               bk, scalar_t(1.), bupd, task_depth);
       }
     }
   }
@@ -217,21 +292,39 @@ namespace strumpack {
   template<typename scalar_t,typename integer_t> void
   FrontLossy<scalar_t,integer_t>::bwd_solve_phase1
   (DenseM_t& y, DenseM_t& yupd, int etree_level, int task_depth) const {
-    DenseM_t F11, F12, F21;
-    decompress(F11, F12, F21);
-    if (this->dim_sep()) {
-      DenseMW_t yloc(this->dim_sep(), y.cols(), y, this->sep_begin_, 0);
-      if (y.cols() == 1) {
-        if (this->dim_upd())
-          gemv(Trans::N, scalar_t(-1.), F12, yupd,
+    const std::size_t dsep = this->dim_sep();
+    if (!dsep) return;
+    DenseMW_t yloc(dsep, y.cols(), y, this->sep_begin_, 0);
+    if (this->dim_upd())
+      for (std::size_t k=0, c=0; k<F12c_.size(); c+=F12c_[k++].cols()) {
+        const std::size_t w = F12c_[k].cols();
+        DenseMW_t yk(w, y.cols(), yupd, c, 0);
+        if (y.cols() == 1)
+          gemv(Trans::N, scalar_t(-1.), F12c_[k].decompress(), yk,
                scalar_t(1.), yloc, task_depth);
-        trsv(UpLo::U, Trans::N, Diag::N, F11, yloc, task_depth);
+        else
+          gemm(Trans::N, Trans::N, scalar_t(-1.), F12c_[k].decompress(),
+               yk, scalar_t(1.), yloc, task_depth);
+      }
+    // decompress and apply one block column of U at a time, starting
+    // from the last one
+    for (std::size_t k=F11c_.size(), c=dsep; k-- > 0; ) {
+      const std::size_t w = F11c_[k].cols();
+      c -= w;
+      auto F = F11c_[k].decompress();
+      DenseMW_t Fkk(w, w, F, c, 0), yk(w, y.cols(), yloc, c, 0),
+        Fk(c, w, F, 0, 0), y0(c, y.cols(), yloc, 0, 0);
+      if (y.cols() == 1) {
+        trsv(UpLo::U, Trans::N, Diag::N, Fkk, yk, task_depth);
+        if (c)
+          gemv(Trans::N, scalar_t(-1.), Fk, yk,
+               scalar_t(1.), y0, task_depth);
       } else {
-        if (this->dim_upd())
-          gemm(Trans::N, Trans::N, scalar_t(-1.), F12, yupd,
-               scalar_t(1.), yloc, task_depth);
         trsm(Side::L, UpLo::U, Trans::N, Diag::N, scalar_t(1.),
-             F11, yloc, task_depth);
+             Fkk, yk, task_depth);
+        if (c)
+          gemm(Trans::N, Trans::N, scalar_t(-1.), Fk, yk,
+               scalar_t(1.), y0, task_depth);
       }
     }
   }
@@ -239,7 +332,9 @@ namespace strumpack {
   template<typename scalar_t,typename integer_t> ReturnCode
   FrontLossy<scalar_t,integer_t>::node_inertia
   (integer_t& neg, integer_t& zero, integer_t& pos) const {
-    return this->matrix_inertia(F11c_.decompress(), neg, zero, pos);
+    DenseM_t F11;
+    decompress_panels(F11c_, F11);
+    return this->matrix_inertia(F11, neg, zero, pos);
   }
 
   // explicit template instantiations
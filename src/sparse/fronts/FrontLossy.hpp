@@ -109,6 +109,7 @@ namespace strumpack {
     using SpMat_t = CompressedSparseMatrix<scalar_t,integer_t>;
     using real_t = typename RealType<scalar_t>::value_type;
     using Opts_t = SPOptions<scalar_t>;
+    using LM_t = LossyMatrix<scalar_t>;
 
   public:
     FrontLossy(integer_t sep, integer_t sep_begin, integer_t sep_end,
@@ -118,6 +119,12 @@ namespace strumpack {
                       VectorPool<scalar_t>& workspace,
                       int etree_level=0, int task_depth=0) override;
 
+    using FD_t::extend_add_to_dense;
+    void extend_add_to_dense(DenseM_t& paF11, DenseM_t& paF12,
+                             DenseM_t& paF21, DenseM_t& paF22,
+                             const F_t* p, VectorPool<scalar_t>& workspace,
+                             int task_depth) override;
+
     std::string type() const override { return "FrontLossy"; }
 
     void compress(const Opts_t& opts);
@@ -127,7 +134,19 @@ namespace strumpack {
     long long node_factor_nonzeros() const override;
 
   private:
-    LossyMatrix<scalar_t> F11c_, F12c_, F21c_;
+    // F11, F12 and F21 are compressed per block of (at most) nb_
+    // columns, so they can be decompressed one block at a time in
+    // the solve
+    std::vector<LM_t> F11c_, F12c_, F21c_;
+    // compressed contribution block, waiting for the extend-add
+    std::unique_ptr<LM_t> F22c_;
+    std::size_t nb_ = 0;
+    bool compress_CB_ = false;
+
+    void compress_panels(const DenseM_t& F, std::vector<LM_t>& Fc,
+                         int prec, double acc) const;
+    void decompress_panels(const std::vector<LM_t>& Fc, DenseM_t& F) const;
+    void decompress_CB(VectorPool<scalar_t>& workspace);
 
     void fwd_solve_phase2(DenseM_t& b, DenseM_t& bupd,
                           int etree_level, int task_depth) const override;
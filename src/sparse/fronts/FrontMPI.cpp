@@ -36,9 +36,11 @@ namespace strumpack {
   template<typename scalar_t,typename integer_t>
   FrontMPI<scalar_t,integer_t>::FrontMPI
   (integer_t sep, integer_t sep_begin, integer_t sep_end,
-   std::vector<integer_t>& upd, const MPIComm& comm, int P)
+   std::vector<integer_t>& upd, const MPIComm& comm, int P,
+   FrontGridCache* grids)
     : F_t(nullptr, nullptr, sep, sep_begin, sep_end, upd),
-      blacs_grid_(comm, P) {
+      blacs_grid_(FrontGridCache::blacs_grid
+                  (grids, comm, P, this->dim_blk())) {
   }
 
   template<typename scalar_t,typename integer_t> integer_t
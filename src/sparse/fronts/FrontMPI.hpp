@@ -33,6 +33,7 @@
 
 #include "misc/MPIWrapper.hpp"
 #include "dense/DistributedMatrix.hpp"
+#include "FrontGridCache.hpp"
 
 namespace strumpack {
 
@@ -58,7 +59,7 @@ namespace strumpack {
   public:
     FrontMPI(integer_t sep, integer_t sep_begin,
              integer_t sep_end, std::vector<integer_t>& upd,
-             const MPIComm& comm, int P);
+             const MPIComm& comm, int P, FrontGridCache* grids=nullptr);
 
     FrontMPI(const FrontMPI&) = delete;
     FrontMPI& operator=(FrontMPI const&) = delete;
@@ -140,8 +141,8 @@ namespace strumpack {
 
     MPIComm& Comm() { return grid()->Comm(); }
     const MPIComm& Comm() const { return grid()->Comm(); }
-    BLACSGrid* grid() override { return &blacs_grid_; }
-    const BLACSGrid* grid() const override { return &blacs_grid_; }
+    BLACSGrid* grid() override { return blacs_grid_.get(); }
+    const BLACSGrid* grid() const override { return blacs_grid_.get(); }
     int P() const override { return grid()->P(); }
 
     virtual long long factor_nonzeros(int task_depth=0) const override;
@@ -153,7 +154,8 @@ namespace strumpack {
                           bool is_root=true, int task_depth=0) override;
 
   protected:
-    BLACSGrid blacs_grid_;     // 2D processor grid
+    // 2D processor grid, possibly shared with other fronts
+    std::shared_ptr<BLACSGrid> blacs_grid_;
 
     virtual long long node_factor_nonzeros() const override;
 
@@ -0,0 +1,175 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+#include "FrontNativeHODLR.hpp"
+#include "sparse/CSRGraph.hpp"
+
+namespace strumpack {
+
+  template<typename scalar_t,typename integer_t>
+  FrontNativeHODLR<scalar_t,integer_t>::FrontNativeHODLR
+  (integer_t sep, integer_t sep_begin, integer_t sep_end,
+   std::vector<integer_t>& upd)
+    : FD_t(sep, sep_begin, sep_end, upd) {}
+
+  template<typename scalar_t,typename integer_t> void
+  FrontNativeHODLR<scalar_t,integer_t>::delete_factors() {
+    FD_t::delete_factors();
+    H_ = HODLR::NativeHODLRMatrix<scalar_t>();
+  }
+
+  template<typename scalar_t,typename integer_t> integer_t
+  FrontNativeHODLR<scalar_t,integer_t>::front_rank(int task_depth) const {
+    return H_.rank();
+  }
+
+  template<typename scalar_t,typename integer_t> long long
+  FrontNativeHODLR<scalar_t,integer_t>::node_factor_nonzeros() const {
+    return H_.nonzeros() + this->F12_.nonzeros() + this->F21_.nonzeros();
+  }
+
+  template<typename scalar_t,typename integer_t> ReturnCode
+  FrontNativeHODLR<scalar_t,integer_t>::factor
+  (const SpMat_t& A, const Opts_t& opts, VectorPool<scalar_t>& workspace,
+   int etree_level, int task_depth) {
+    ReturnCode e1, e2;
+    if (task_depth == 0) {
+#pragma omp parallel if(!omp_in_parallel()) default(shared)
+#pragma omp single nowait
+      {
+        e1 = this->factor_phase1(A, opts, workspace, etree_level,
+                                 task_depth+1);
+        e2 = factor_node(opts, etree_level, task_depth);
+      }
+    } else {
+      e1 = this->factor_phase1(A, opts, workspace, etree_level, task_depth);
+      e2 = factor_node(opts, etree_level, task_depth);
+    }
+    return (e1 == ReturnCode::SUCCESS) ? e2 : e1;
+  }
+
+  template<typename scalar_t,typename integer_t> ReturnCode
+  FrontNativeHODLR<scalar_t,integer_t>::factor_node
+  (const Opts_t& opts, int etree_level, int task_depth) {
+    ReturnCode err_code = ReturnCode::SUCCESS;
+    if (!dim_sep()) {
+      this->stats_finish(0);
+      return err_code;
+    }
+    trace::Scope ts("factor", this->sep_, etree_level, dim_sep(), dim_upd());
+    auto t0 = trace::now();
+    auto& hopts = opts.HODLR_options();
+    if (sep_tree_.size != dim_sep())
+      sep_tree_ = structured::ClusterTree(dim_sep()).
+        refine(hopts.leaf_size());
+    H_ = HODLR::NativeHODLRMatrix<scalar_t>(sep_tree_);
+    H_.compress(this->F11_, hopts, task_depth+1);
+    this->F11_.clear();
+    if (H_.factor(task_depth))
+      err_code = ReturnCode::ZERO_PIVOT;
+    if (dim_upd()) {
+      // F12 <- F11^{-1} F12, the forward solve only applies F21
+      H_.solve(this->F12_, task_depth);
+      this->stats_.factor_time = this->stats_elapsed(t0);
+      t0 = trace::now();
+      gemm(Trans::N, Trans::N, scalar_t(-1.), this->F21_, this->F12_,
+           scalar_t(1.), this->F22_, task_depth);
+      this->stats_.schur_time = this->stats_elapsed(t0);
+    } else this->stats_.factor_time = this->stats_elapsed(t0);
+    auto flops = gemm_flops
+      (Trans::N, Trans::N, scalar_t(-1.), this->F21_, this->F12_,
+       scalar_t(1.));
+    STRUMPACK_FULL_RANK_FLOPS(flops);
+    ts.set_flops(flops);
+    this->stats_.flops = flops;
+    this->stats_finish(front_rank());
+    return err_code;
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  FrontNativeHODLR<scalar_t,integer_t>::fwd_solve_phase2
+  (DenseM_t& b, DenseM_t& bupd, int etree_level, int task_depth) const {
+    if (dim_sep()) {
+      DenseMW_t bloc(dim_sep(), b.cols(), b, this->sep_begin_, 0);
+      H_.solve(bloc, task_depth);
+      if (dim_upd()) {
+        if (b.cols() == 1)
+          gemv(Trans::N, scalar_t(-1.), this->F21_, bloc,
+               scalar_t(1.), bupd, task_depth);
+        else
+          gemm(Trans::N, Trans::N, scalar_t(-1.), this->F21_, bloc,
+               scalar_t(1.), bupd, task_depth);
+      }
+    }
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  FrontNativeHODLR<scalar_t,integer_t>::bwd_solve_phase1
+  (DenseM_t& y, DenseM_t& yupd, int etree_level, int task_depth) const {
+    if (dim_sep() && dim_upd()) {
+      DenseMW_t yloc(dim_sep(), y.cols(), y, this->sep_begin_, 0);
+      if (y.cols() == 1)
+        gemv(Trans::N, scalar_t(-1.), this->F12_, yupd,
+             scalar_t(1.), yloc, task_depth);
+      else
+        gemm(Trans::N, Trans::N, scalar_t(-1.), this->F12_, yupd,
+             scalar_t(1.), yloc, task_depth);
+    }
+  }
+
+  template<typename scalar_t,typename integer_t> void
+  FrontNativeHODLR<scalar_t,integer_t>::partition
+  (const Opts_t& opts, const SpMat_t& A, integer_t* sorder,
+   bool is_root, int task_depth) {
+    if (!dim_sep()) return;
+    auto g = A.extract_graph
+      (opts.separator_ordering_level(), this->sep_begin_, this->sep_end_);
+    sep_tree_ = g.recursive_bisection
+      (opts.HODLR_options().leaf_size(), 0,
+       sorder+this->sep_begin_, nullptr, 0, 0, dim_sep());
+    for (integer_t i=this->sep_begin_; i<this->sep_end_; i++)
+      sorder[i] += this->sep_begin_;
+  }
+
+  // explicit template instantiations
+  template class FrontNativeHODLR<float,int>;
+  template class FrontNativeHODLR<double,int>;
+  template class FrontNativeHODLR<std::complex<float>,int>;
+  template class FrontNativeHODLR<std::complex<double>,int>;
+
+  template class FrontNativeHODLR<float,long int>;
+  template class FrontNativeHODLR<double,long int>;
+  template class FrontNativeHODLR<std::complex<float>,long int>;
+  template class FrontNativeHODLR<std::complex<double>,long int>;
+
+  template class FrontNativeHODLR<float,long long int>;
+  template class FrontNativeHODLR<double,long long int>;
+  template class FrontNativeHODLR<std::complex<float>,long long int>;
+  template class FrontNativeHODLR<std::complex<double>,long long int>;
+
+} // end namespace strumpack
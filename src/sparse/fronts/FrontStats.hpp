@@ -0,0 +1,103 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+/*! \file FrontStats.hpp
+ * \brief Per front performance statistics, collected during the
+ * multifrontal factorization.
+ */
+#ifndef FRONT_STATS_HPP
+#define FRONT_STATS_HPP
+
+#include <vector>
+#include <ostream>
+#include <algorithm>
+
+namespace strumpack {
+
+  /**
+   * Performance statistics for a single front. These are recorded
+   * during the factorization by the thread (or MPI process)
+   * factoring the front, without any synchronization, and can be
+   * collected afterwards, see SparseSolverBase::front_statistics.
+   *
+   * Times are in seconds. The flop count is only available for dense
+   * fronts, compressed fronts report the rank instead.
+   */
+  struct FrontStats {
+    long long front = -1;          /*!< separator number, -1 if unused */
+    int level = 0;                 /*!< level in the elimination tree */
+    int mpi_rank = 0;              /*!< rank which recorded this front */
+    long long dim_sep = 0;         /*!< separator dimension */
+    long long dim_upd = 0;         /*!< update (CB) dimension */
+    double assembly_time = 0.;     /*!< time to assemble and extend-add */
+    double factor_time = 0.;       /*!< time for F11 factor and trsm */
+    double schur_time = 0.;        /*!< time for the Schur update F22 */
+    double flops = 0.;             /*!< flops of the factorization */
+    long long extend_add_bytes = 0; /*!< bytes from child CBs */
+    long long rank = 0;            /*!< maximum rank, compressed fronts */
+    long long memory = 0;          /*!< bytes, factors + CB */
+
+    double time() const {
+      return assembly_time + factor_time + schur_time;
+    }
+    double gflops() const {
+      auto t = time();
+      return t > 0 ? flops / t / 1.e9 : 0.;
+    }
+
+    /**
+     * Sort from most to least expensive, by time.
+     */
+    static void sort(std::vector<FrontStats>& s) {
+      std::sort(s.begin(), s.end(),
+                [](const FrontStats& a, const FrontStats& b) {
+                  return a.time() > b.time(); });
+    }
+
+    /**
+     * Write to a CSV file, with a header line.
+     */
+    static void write_csv(std::ostream& os,
+                          const std::vector<FrontStats>& s) {
+      os << "front,level,mpi_rank,dim_sep,dim_upd,assembly_time,"
+         << "factor_time,schur_time,total_time,flops,GFlops,"
+         << "extend_add_bytes,rank,memory" << std::endl;
+      for (auto& f : s)
+        os << f.front << "," << f.level << "," << f.mpi_rank << ","
+           << f.dim_sep << "," << f.dim_upd << ","
+           << f.assembly_time << "," << f.factor_time << ","
+           << f.schur_time << "," << f.time() << ","
+           << f.flops << "," << f.gflops() << ","
+           << f.extend_add_bytes << "," << f.rank << ","
+           << f.memory << std::endl;
+    }
+  };
+
+} // end namespace strumpack
+
+#endif // FRONT_STATS_HPP
@@ -37,6 +37,7 @@
 #include "sparse/fronts/FrontLossy.hpp"
 #endif
 #include "BLR/BLRMatrix.hpp"
+#include "HODLR/NativeHODLRMatrix.hpp"
 #if defined(STRUMPACK_USE_MPI)
 #include "BLR/BLRMatrixMPI.hpp"
 #include "sparse/fronts/ExtendAdd.hpp"
@@ -114,8 +115,17 @@ namespace strumpack {
           ("Lossless compression requires ZFP to be enabled.");
 #endif
       }
-      case Type::HODLR:
-        throw std::invalid_argument("Type HODLR requires MPI.");
+      case Type::HODLR: {
+        if (A.rows() != A.cols())
+          throw std::invalid_argument
+            ("HODLR compression only supported for square matrices.");
+        HODLR::HODLROptions<scalar_t> hodlr_opts(opts);
+        auto H = row_tree ?
+          new HODLR::NativeHODLRMatrix<scalar_t>(*row_tree) :
+          new HODLR::NativeHODLRMatrix<scalar_t>(A.rows(), hodlr_opts);
+        H->compress(A, hodlr_opts);
+        return std::unique_ptr<StructuredMatrix<scalar_t>>(H);
+      }
       case Type::HODBF:
         throw std::invalid_argument("Type HODBF requires MPI.");
       case Type::BUTTERFLY:
@@ -293,8 +303,17 @@ namespace strumpack {
         }
         return std::unique_ptr<StructuredMatrix<scalar_t>>(B);
       }
-      case Type::HODLR:
-        throw std::invalid_argument("Type HODLR requires MPI.");
+      case Type::HODLR: {
+        if (rows != cols)
+          throw std::invalid_argument
+            ("HODLR compression only supported for square matrices.");
+        HODLR::HODLROptions<scalar_t> hodlr_opts(opts);
+        auto H = row_tree ?
+          new HODLR::NativeHODLRMatrix<scalar_t>(*row_tree) :
+          new HODLR::NativeHODLRMatrix<scalar_t>(rows, hodlr_opts);
+        H->compress(A, hodlr_opts);
+        return std::unique_ptr<StructuredMatrix<scalar_t>>(H);
+      }
       case Type::HODBF:
         throw std::invalid_argument("Type HODBF requires MPI.");
       case Type::BUTTERFLY:
@@ -583,8 +602,17 @@ namespace strumpack {
       case Type::BLR:
         throw std::invalid_argument
           ("Type BLR does not support matrix-free compression.");
-      case Type::HODLR:
-        throw std::invalid_argument("Type HODLR requires MPI.");
+      case Type::HODLR: {
+        if (rows != cols)
+          throw std::invalid_argument
+            ("HODLR compression only supported for square matrices.");
+        HODLR::HODLROptions<scalar_t> hodlr_opts(opts);
+        auto H = row_tree ?
+          new HODLR::NativeHODLRMatrix<scalar_t>(*row_tree) :
+          new HODLR::NativeHODLRMatrix<scalar_t>(rows, hodlr_opts);
+        H->compress(Amult, hodlr_opts);
+        return std::unique_ptr<StructuredMatrix<scalar_t>>(H);
+      }
       case Type::HODBF:
         throw std::invalid_argument("Type HODBF requires MPI.");
       case Type::BUTTERFLY:
@@ -651,7 +679,8 @@ namespace strumpack {
       case Type::BLR:
         return construct_from_elements<scalar_t>(rows, cols, Aelem, opts);
       case Type::HODLR:
-        throw std::invalid_argument("Type HODLR requires MPI.");
+        return construct_from_elements<scalar_t>
+          (rows, cols, Aelem, opts, row_tree, col_tree);
       case Type::HODBF:
         throw std::invalid_argument("Type HODBF requires MPI.");
       case Type::BUTTERFLY:
@@ -196,15 +196,20 @@ namespace strumpack {
      * |  ^        |  seq | MPI  | DENSE | ELEM | MF | PMF | NN | mult | factor | solve | shift | s | d | c | z |
      * | BLR       |  X   |  X   | X     |  X   |    |     |    | X    |   X    |  X    | ?     | X | X | X | X |
      * | HSS       |  X   |  X   | X     |      |    | X   | X  |  X   |   X    |  X    | X     | X | X | X | X |
-     * | HODLR     |      |  X   | X     |  X   | X  |     | X  |  X   |   X    |  X    | ?     |   | X |   | X |
+     * | HODLR     |  X   |  X   | X     |  X   | X  | X   | X  |  X   |   X    |  X    | ?     | X | X | X | X |
      * | HODBF     |      |  X   | X     |  X   | X  |     | X  |  X   |   X    |  X    | ?     |   | X |   | X |
      * | BUTTERFLY |      |  X   | X     |  X   | X  |     | X  |  X   |        |       |       |   | X |   | X |
      * | LR        |      |  X   | X     |  X   | X  |     | X  |  X   |        |       |       |   | X |   | X |
      * | LOSSY     |  X   |      | X     |      |    |     |    |      |        |       |       | X | X | X | X |
      * | LOSSLESS  |  X   |      | X     |      |    |     |    |      |        |       |       | X | X | X | X |
      *
+     * The sequential HODLR format is HODLR::NativeHODLRMatrix, which
+     * supports all precisions. The MPI HODLR format requires
+     * ButterflyPACK, and only supports double and
+     * std::complex<double>.
+     *
      * \see HSS::HSSMatrix, BLR::BLRMatrix, HODLR::HODLRMatrix,
-     * HODLR::ButterflyMatrix, ...
+     * HODLR::NativeHODLRMatrix, HODLR::ButterflyMatrix, ...
      */
     template<typename scalar_t> class StructuredMatrix {
       using real_t = typename RealType<scalar_t>::value_type;
@@ -64,8 +64,9 @@ namespace strumpack {
        BLR,       /*!< Block Low Rank, see BLR::BLRMatrix
                     and BLR::BLRMatrixMPI */
        HODLR,     /*!< Hierarchically Off-Diagonal Low Rank,
-                    see HODLR::HODLRMatrix. Does not support
-                    float or std::complex<float>. */
+                    see HODLR::NativeHODLRMatrix (sequential) and
+                    HODLR::HODLRMatrix (MPI). The MPI version does
+                    not support float or std::complex<float>. */
        HODBF,     /*!< Hierarchically Off-Diagonal
                     Butterfly, implemented as
                     HODLR::HODLRMatrix. Does not support
@@ -45,6 +45,68 @@ void abort_MPI(MPI_Comm *c, int *error, ... ) {
   abort();
 }
 
+/*
+ * Partial factorization of [A11 A12; A21 A22], with A the Toeplitz
+ * matrix split in two, using the right-looking algorithm with the
+ * lookahead depth from opts. The Schur complement should match the
+ * one computed without lookahead.
+ */
+int check_lookahead(const MPIComm& c, int N,
+                    const BLR::BLROptions<double>& opts) {
+  using BLRMPI_t = BLR::BLRMatrixMPI<double>;
+  BLR::ProcessorGrid2D g(c);
+  int N1 = N / 2, N2 = N - N1;
+  structured::ClusterTree t1(N1), t2(N2);
+  t1.refine(opts.leaf_size());
+  t2.refine(opts.leaf_size());
+  auto r1 = t1.template leaf_sizes<std::size_t>();
+  auto r2 = t2.template leaf_sizes<std::size_t>();
+  DenseMatrix<bool> adm(r1.size(), r1.size());
+  adm.fill(true);
+  for (std::size_t t=0; t<r1.size(); t++)
+    adm(t, t) = false;
+  auto Toeplitz = [](int i, int j) { return 1./(1.+abs(i-j)); };
+  auto fill = [&](BLRMPI_t& B, int r0, int c0) {
+    B.fill(0.);
+    for (std::size_t j=0; j<B.cols(); j++)
+      for (std::size_t i=0; i<B.rows(); i++)
+        if (g.is_local(B.rg2t(i), B.cg2t(j)))
+          B.global(i, j) = Toeplitz(r0+i, c0+j);
+  };
+  auto schur = [&](int lookahead, BLRMPI_t& A22) {
+    auto o = opts;
+    o.set_BLR_factor_algorithm(BLR::BLRFactorAlgorithm::RL);
+    o.set_lookahead(lookahead);
+    BLRMPI_t A11(g, r1, r1), A12(g, r1, r2), A21(g, r2, r1);
+    A22 = BLRMPI_t(g, r2, r2);
+    fill(A11, 0, 0);  fill(A12, 0, N1);
+    fill(A21, N1, 0); fill(A22, N1, N1);
+    BLRMPI_t::partial_factor(A11, A12, A21, A22, adm, o);
+  };
+  BLRMPI_t S0, S1;
+  schur(0, S0);
+  schur(std::max(1, opts.lookahead()), S1);
+  double err[2] = {0., 0.};
+  for (std::size_t j=0; j<S0.cols(); j++)
+    for (std::size_t i=0; i<S0.rows(); i++)
+      if (g.is_local(S0.rg2t(i), S0.cg2t(j))) {
+        auto e = S1.global(i, j) - S0.global(i, j);
+        err[0] += e * e;
+        err[1] += S0.global(i, j) * S0.global(i, j);
+      }
+  c.all_reduce(err, 2, MPI_SUM);
+  auto relerr = std::sqrt(err[0] / err[1]);
+  if (c.is_root())
+    cout << "# lookahead, ||S_lookahead - S||_F / ||S||_F = "
+         << relerr << endl;
+  if (relerr > ERROR_TOLERANCE * max(opts.rel_tol(),opts.abs_tol())) {
+    if (c.is_root())
+      cout << "ERROR: lookahead Schur complement differs!!" << endl;
+    return 1;
+  }
+  return 0;
+}
+
 int main(int argc, char* argv[]) {
   // the HODLR interfaces require MPI
   MPI_Init(&argc, &argv);
@@ -65,6 +127,11 @@ int main(int argc, char* argv[]) {
     opts.set_from_command_line(argc, argv);
 
 
+    if (opts.lookahead() > 0 && check_lookahead(c, N, opts)) {
+      MPI_Finalize();
+      return 1;
+    }
+
     // define a partition tree for the HODLR matrix
     structured::ClusterTree t(N);
     t.refine(opts.leaf_size());
@@ -31,7 +31,10 @@
 using namespace std;
 
 #include "dense/DenseMatrix.hpp"
+#include "dense/ACA.hpp"
 #include "BLR/BLRMatrix.hpp"
+#include "BLR/LRTile.hpp"
+#include "BLR/LRTileMP.hpp"
 #include "structured/ClusterTree.hpp"
 #include "misc/TaskTimer.hpp"
 using namespace strumpack;
@@ -40,6 +43,179 @@ using namespace strumpack::BLR;
 #define ERROR_TOLERANCE 1e2
 #define SOLVE_TOLERANCE 1e-12
 
+// ACA on a complex rank 5 matrix, U*V should reproduce A (not conj(A))
+int check_complex_ACA() {
+  using cplx = std::complex<double>;
+  int m = 60, n = 50, r = 5;
+  DenseMatrix<cplx> X(m, r), Y(r, n), A(m, n), U, V;
+  for (int k=0; k<r; k++) {
+    for (int i=0; i<m; i++) X(i,k) = std::polar(1., .3*(i+1)*(k+1));
+    for (int j=0; j<n; j++) Y(k,j) = std::polar(1./(k+1), .2*(j+1)*(k+2));
+  }
+  gemm(Trans::N, Trans::N, cplx(1.), X, Y, cplx(0.), A);
+  adaptive_cross_approximation<cplx>
+    (U, V, m, n, [&](std::size_t i, std::size_t j) { return A(i,j); },
+     1e-12, 1e-14, r+5);
+  auto Anorm = A.normF();
+  gemm(Trans::N, Trans::N, cplx(-1.), U, V, cplx(1.), A);
+  cout << "# complex ACA, rank = " << U.cols() << ", ||A-U*V||_F/||A||_F = "
+       << A.normF() / Anorm << endl;
+  if (A.normF() / Anorm > 1e-8) {
+    cout << "ERROR: complex ACA error too big!!" << endl;
+    return 1;
+  }
+  return 0;
+}
+
+// randomized compression of a tile with quickly decaying singular
+// values, the error should be close to the requested tolerance
+int check_randomized_tile() {
+  int m = 200, n = 150, r = 60;
+  DenseMatrix<double> X(m, r), Y(r, n), T(m, n);
+  X.random();
+  Y.random();
+  double rmax, rmin;
+  X.orthogonalize(rmax, rmin, 0);
+  for (int k=0; k<r; k++)
+    for (int j=0; j<n; j++) Y(k,j) *= std::pow(10., -k/4.);
+  gemm(Trans::N, Trans::N, 1., X, Y, 0., T);
+  BLROptions<double> opts;
+  opts.set_low_rank_algorithm(LowRankAlgorithm::RANDOMIZED);
+  opts.set_rel_tol(1e-10);
+  opts.set_abs_tol(1e-20);
+  int ierr = 0;
+  for (std::size_t seed=0; seed<3; seed++) {
+    LRTile<double> t(T, opts, -1, seed);
+    auto E = T;
+    gemm(Trans::N, Trans::N, -1., t.U(), t.V(), 1., E);
+    auto err = E.normF() / T.normF();
+    cout << "# randomized tile, seed = " << seed << ", rank = "
+         << t.rank() << ", ||T-U*V||_F/||T||_F = " << err << endl;
+    if (err > 1e2 * opts.rel_tol()) {
+      cout << "ERROR: randomized tile compression error too big!!" << endl;
+      ierr++;
+    }
+  }
+  return ierr;
+}
+
+// mixed precision tile, the queries should agree with the stored
+// parts: dense/extract/copy_to/U()*V() with each other, and with the
+// working precision tile up to the requested tolerance. The lower
+// precision parts are large enough to be converted in several blocks.
+int check_mixed_precision_tile() {
+  int m = 120, n = 100, r = 100;
+  DenseMatrix<double> X(m, r), Y(r, n), T(m, n);
+  X.random();
+  Y.random();
+  for (int k=0; k<r; k++)
+    for (int j=0; j<n; j++) Y(k,j) *= std::pow(10., -k/15.);
+  gemm(Trans::N, Trans::N, 1., X, Y, 0., T);
+  BLROptions<double> opts;
+  opts.set_rel_tol(1e-6);
+  LRTile<double> t(T, opts);
+  auto tmp = LRTileMP<double>::create(t, opts);
+  if (!tmp) {
+    cout << "ERROR: no mixed precision tile created!!" << endl;
+    return 1;
+  }
+  auto Dt = t.dense(), Dmp = tmp->dense();
+  auto Tnorm = Dt.normF();
+  Dmp.scaled_add(-1., Dt);
+  auto err = Dmp.normF() / Tnorm;
+  cout << "# mixed precision tile, rank = " << tmp->rank() << " ("
+       << tmp->rank(0) << "/" << tmp->rank(1) << "/" << tmp->rank(2)
+       << "), ||T_mp-T||_F/||T||_F = " << err << endl;
+  Dmp = tmp->dense();
+  std::vector<double> buf((m+n)*tmp->rank());
+  auto ptr = buf.data();
+  tmp->copy_to(ptr);
+  DenseMatrixWrapper<double> U(m, tmp->rank(), buf.data(), m),
+    V(tmp->rank(), n, buf.data()+m*tmp->rank(), tmp->rank());
+  DenseMatrix<double> UV(m, n);
+  gemm(Trans::N, Trans::N, 1., U, V, 0., UV);
+  std::vector<std::size_t> I{3, 0, 77}, J{99, 5};
+  DenseMatrix<double> B(I.size(), J.size());
+  tmp->extract(I, J, B);
+  double err2 = 0.;
+  for (std::size_t j=0; j<J.size(); j++)
+    for (std::size_t i=0; i<I.size(); i++)
+      err2 = std::max
+        (err2, std::abs(B(i,j) - Dmp(I[i],J[j])) / Tnorm);
+  UV.scaled_add(-1., Dmp);
+  auto err3 = UV.normF() / Tnorm;
+  if (err > 1e2 * opts.rel_tol() || ptr != buf.data()+buf.size() ||
+      err2 > 1e-12 || err3 > 1e-12 ||
+      tmp->rank() != t.rank() || tmp->rank(0) == t.rank() ||
+      tmp->zeros() != t.zeros()) {
+    cout << "ERROR: mixed precision tile does not match!!" << endl;
+    return 1;
+  }
+  // row interchanges and triangular solve, as in the factorization
+  std::vector<int> piv(m);
+  for (int i=0; i<m; i++) piv[i] = std::min(m, i + 1 + (7*i) % 5);
+  DenseMatrix<double> L(m, m);
+  L.random();
+  L.scale(1. / m);
+  tmp->laswp(piv, true);
+  tmp->trsm_b(Side::L, UpLo::L, Trans::N, Diag::U, 1., L);
+  Dmp.laswp(piv, true);
+  trsm(Side::L, UpLo::L, Trans::N, Diag::U, 1., L, Dmp);
+  auto Dmp2 = tmp->dense();
+  Dmp2.scaled_add(-1., Dmp);
+  auto err4 = Dmp2.normF() / Dmp.normF();
+  // accessing the factors converts the tile to working precision
+  Dmp = tmp->dense();
+  gemm(Trans::N, Trans::N, 1., tmp->U(), tmp->V(), -1., Dmp);
+  auto err5 = Dmp.normF() / Tnorm;
+  cout << "# mixed precision tile, after laswp and trsm, error = " << err4
+       << ", ||U*V-T_mp||_F/||T||_F = " << err5 << endl;
+  if (err4 > 1e2 * opts.rel_tol() || err5 > 1e-12 ||
+      tmp->rank(0) != t.rank()) {
+    cout << "ERROR: mixed precision tile does not match!!" << endl;
+    return 1;
+  }
+  return 0;
+}
+
+// packing the tiles in a single buffer should not change the
+// matrix, and the packed buffer with the tile ranks should be enough
+// to recreate it with pack(ranks, data). This uses small tiles, so
+// that there are low-rank tiles regardless of the leaf size.
+int check_pack(const DenseMatrix<double>& A,
+               const BLROptions<double>& opts) {
+  auto m = A.rows();
+  structured::ClusterTree tree(m);
+  tree.refine(64);
+  auto tiles = tree.template leaf_sizes<std::size_t>();
+  DenseMatrix<bool> adm(tiles.size(), tiles.size());
+  adm.fill(true);
+  for (std::size_t t=0; t<tiles.size(); t++)
+    adm(t, t) = false;
+  BLRMatrix<double> P(m, tiles, m, tiles);
+  P.compress_and_factor(A, adm, opts);
+  auto D = P.dense();
+  auto ranks = P.tile_ranks();
+  P.pack();
+  BLRMatrix<double> Q(m, tiles, m, tiles);
+  Q.pack(ranks, P.packed_data());
+  auto DP = P.dense(), DQ = Q.dense();
+  DP.scaled_add(-1., D);
+  DQ.scaled_add(-1., D);
+  int lr = 0;
+  for (auto r : ranks) if (r != -1) lr++;
+  cout << "# packed " << lr << " low-rank tiles out of " << ranks.size()
+       << ", ||P-D||_F = " << DP.normF()
+       << ", ||unpack(P)-D||_F = " << DQ.normF() << endl;
+  if (!P.packed() || !Q.packed() || Q.tile_ranks() != ranks ||
+      P.packed_size(ranks) != Q.packed_size(Q.tile_ranks()) ||
+      DP.normF() != 0. || DQ.normF() != 0.) {
+    cout << "ERROR: packed BLR matrix does not match!!" << endl;
+    return 1;
+  }
+  return 0;
+}
+
 
 int run(int argc, char* argv[]) {
   int m = 100; //, n = 1;
@@ -129,6 +305,11 @@ int run(int argc, char* argv[]) {
     }*/
   blr_opts.set_from_command_line(argc, argv);
 
+  if (check_complex_ACA()) return 1;
+  if (check_randomized_tile()) return 1;
+  if (check_mixed_precision_tile()) return 1;
+  if (check_pack(A, blr_opts)) return 1;
+
   if (blr_opts.verbose()) A.print("A");
   cout << "# tol = " << blr_opts.rel_tol() << endl;
 
@@ -154,6 +335,7 @@ int run(int argc, char* argv[]) {
   // BLRMatrix<double> B(A, tiles, adm, blr_opts);
   BLRMatrix<double> B(m, tiles, m, tiles);
   B.compress_and_factor(A, adm, blr_opts);
+  if (blr_opts.mixed_precision()) B.convert_to_mixed_precision(blr_opts);
   t3.stop();
 #if defined(STRUMPACK_COUNT_FLOPS)
   //std::cout << "flop_counter_stop" << std::endl;
@@ -249,6 +249,24 @@ int run(int argc, char* argv[]) {
     return 1;
   }
 
+  if (hss_opts.level_ULV()) {
+    // compare against the recursive ULV factorization/solve
+    auto opts_rec = hss_opts;
+    opts_rec.set_level_ULV(false);
+    HSSMatrix<double> Hrec(A, opts_rec);
+    Hrec.factor();
+    DenseMatrix<double> Crec(B);
+    Hrec.solve(Crec);
+    Crec.scaled_add(-1., C);
+    cout << "# relative difference level/recursive ULV solve = "
+         << Crec.normF() / C.normF() << endl;
+    if (Crec.normF() / C.normF() > ERROR_TOLERANCE
+        * max(hss_opts.rel_tol(),hss_opts.abs_tol())) {
+      cout << "ERROR: level ULV solve differs from recursive ULV!!" << endl;
+      return 1;
+    }
+  }
+
   if (!H.leaf()) {
     H.partial_factor();
     cout << "# Computing Schur update .." << endl;
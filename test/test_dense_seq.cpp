@@ -0,0 +1,205 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+#include <iostream>
+#include <random>
+using namespace std;
+
+#include "dense/DenseMatrix.hpp"
+#include "StrumpackParameters.hpp"
+using namespace strumpack;
+
+#define ERROR_TOLERANCE 1e2
+
+template<typename scalar_t> scalar_t random_value(std::mt19937& gen) {
+  std::uniform_real_distribution<double> d(-1., 1.);
+  return scalar_t(d(gen));
+}
+template<> std::complex<double> random_value(std::mt19937& gen) {
+  std::uniform_real_distribution<double> d(-1., 1.);
+  return std::complex<double>(d(gen), d(gen));
+}
+
+/*
+ * Compare the lower triangles of the factors F and Fref, relative to
+ * the norm of Fref.
+ */
+template<typename scalar_t> double
+lower_difference(const DenseMatrix<scalar_t>& F,
+                 const DenseMatrix<scalar_t>& Fref) {
+  double err = 0., nrm = 0.;
+  for (std::size_t j=0; j<F.cols(); j++)
+    for (std::size_t i=j; i<F.rows(); i++) {
+      err += std::norm(F(i,j) - Fref(i,j));
+      nrm += std::norm(Fref(i,j));
+    }
+  return std::sqrt(err / nrm);
+}
+
+/*
+ * The task parallel Bunch-Kaufman LDLt (sytrf_omp_task), used by
+ * DenseMatrix::LDLt inside a parallel region, should give the same
+ * pivots as LAPACK xSYTRF, and (up to rounding) the same factors.
+ */
+template<typename scalar_t> int check_LDLt(int n) {
+  using real_t = typename RealType<scalar_t>::value_type;
+  std::mt19937 gen(n);
+  // symmetric (not Hermitian), indefinite
+  DenseMatrix<scalar_t> A(n, n);
+  for (int j=0; j<n; j++)
+    for (int i=j; i<n; i++)
+      A(i,j) = A(j,i) = random_value<scalar_t>(gen);
+  DenseMatrix<scalar_t> F(A), Fref(A);
+  std::vector<int> piv, pivref(n);
+  blas::sytrf('L', n, Fref.data(), Fref.ld(), pivref.data());
+#pragma omp parallel
+#pragma omp single nowait
+  piv = F.LDLt();
+  auto err = lower_difference(F, Fref);
+  int npiv2 = 0;
+  for (int i=0; i<n; i++) if (pivref[i] < 0) npiv2++;
+  cout << "# LDLt, n = " << n << ", 2x2 pivots = " << npiv2 / 2
+       << ", ||L-Lref||_F/||Lref||_F = " << err << endl;
+  if (piv != pivref) {
+    cout << "ERROR: LDLt pivots differ from LAPACK sytrf!!" << endl;
+    return 1;
+  }
+  if (err > ERROR_TOLERANCE * n * blas::lamch<real_t>('E')) {
+    cout << "ERROR: LDLt factors differ from LAPACK sytrf!!" << endl;
+    return 1;
+  }
+  // solve with the task parallel factors
+  DenseMatrix<scalar_t> x(n, 1), b(n, 1);
+  x.random();
+  gemm(Trans::N, Trans::N, scalar_t(1.), A, x, scalar_t(0.), b);
+  F.solve_LDLt_in_place(b, piv);
+  b.scaled_add(scalar_t(-1.), x);
+  auto serr = b.normF() / x.normF();
+  cout << "# LDLt solve, ||x-xref||_F/||xref||_F = " << serr << endl;
+  if (serr > 1e-8) {
+    cout << "ERROR: LDLt solve error too big!!" << endl;
+    return 1;
+  }
+  return 0;
+}
+
+/*
+ * The pivot aware companions of LDLt, trsm_LDLt followed by
+ * syrk_LDLt, compute the Schur complement C - B^T A^{-1} B. Compare
+ * with an explicit update using LAPACK xSYTRS for A^{-1} B.
+ */
+template<typename scalar_t> int check_LDLt_update(int n, int m) {
+  std::mt19937 gen(n+m);
+  DenseMatrix<scalar_t> A(n, n), B(n, m), C(m, m);
+  for (int j=0; j<n; j++)
+    for (int i=j; i<n; i++)
+      A(i,j) = A(j,i) = random_value<scalar_t>(gen);
+  for (int j=0; j<m; j++)
+    for (int i=0; i<n; i++)
+      B(i,j) = random_value<scalar_t>(gen);
+  for (int j=0; j<m; j++)
+    for (int i=j; i<m; i++)
+      C(i,j) = C(j,i) = random_value<scalar_t>(gen);
+  // reference: Cref = C - B^T (A^{-1} B)
+  DenseMatrix<scalar_t> Fref(A), AiB(B), Cref(C);
+  std::vector<int> pivref(n);
+  blas::sytrf('L', n, Fref.data(), Fref.ld(), pivref.data());
+  blas::sytrs('L', n, m, Fref.data(), Fref.ld(), pivref.data(),
+              AiB.data(), AiB.ld());
+  gemm(Trans::T, Trans::N, scalar_t(-1.), B, AiB, scalar_t(1.), Cref);
+  DenseMatrix<scalar_t> F(A), X(B);
+  std::vector<int> piv;
+#pragma omp parallel
+#pragma omp single nowait
+  {
+    piv = F.LDLt();
+    trsm_LDLt(F, piv, X);
+    syrk_LDLt(F, piv, X, C);
+  }
+  auto err = lower_difference(C, Cref);
+  cout << "# LDLt update, n = " << n << ", m = " << m
+       << ", ||S-Sref||_F/||Sref||_F = " << err << endl;
+  // the reference goes through a full solve with A, so allow for the
+  // condition number of the (random, indefinite) A
+  if (err > 1e-8) {
+    cout << "ERROR: LDLt Schur update differs from LAPACK!!" << endl;
+    return 1;
+  }
+  return 0;
+}
+
+/*
+ * The tiled Cholesky (potrf_omp_task), used by DenseMatrix::Cholesky
+ * inside a parallel region, should match LAPACK xPOTRF.
+ */
+template<typename scalar_t> int check_Cholesky(int n) {
+  using real_t = typename RealType<scalar_t>::value_type;
+  std::mt19937 gen(n);
+  DenseMatrix<scalar_t> B(n, n), A(n, n);
+  for (int j=0; j<n; j++)
+    for (int i=0; i<n; i++)
+      B(i,j) = random_value<scalar_t>(gen);
+  // Hermitian positive definite
+  gemm(Trans::N, Trans::C, scalar_t(1.), B, B, scalar_t(0.), A);
+  for (int i=0; i<n; i++) A(i,i) += scalar_t(n);
+  DenseMatrix<scalar_t> F(A), Fref(A);
+  int info = blas::potrf('L', n, Fref.data(), Fref.ld()), infot = 0;
+#pragma omp parallel
+#pragma omp single nowait
+  infot = F.Cholesky();
+  auto err = lower_difference(F, Fref);
+  cout << "# Cholesky, n = " << n
+       << ", ||L-Lref||_F/||Lref||_F = " << err << endl;
+  if (info || infot) {
+    cout << "ERROR: Cholesky failed!!" << endl;
+    return 1;
+  }
+  if (err > ERROR_TOLERANCE * n * blas::lamch<real_t>('E')) {
+    cout << "ERROR: Cholesky factor differs from LAPACK potrf!!" << endl;
+    return 1;
+  }
+  return 0;
+}
+
+
+int main(int argc, char* argv[]) {
+  // the task parallel code is only used for n > 512
+  int n = 700;
+  if (argc > 1) n = stoi(argv[1]);
+  cout << "# task recursion cutoff level = "
+       << params::task_recursion_cutoff_level << endl;
+  int ierr = 0;
+  ierr += check_LDLt<double>(n);
+  ierr += check_LDLt<std::complex<double>>(n);
+  // m > 256 to use more than one column block in syrk_LDLt
+  ierr += check_LDLt_update<double>(n, 300);
+  ierr += check_LDLt_update<std::complex<double>>(n, 300);
+  ierr += check_Cholesky<double>(n);
+  ierr += check_Cholesky<std::complex<double>>(n);
+  return ierr;
+}
@@ -0,0 +1,193 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+#include <iostream>
+#include <random>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+using namespace std;
+
+#include "kernel/KernelRegression.hpp"
+#include "clustering/Clustering.hpp"
+using namespace strumpack;
+using namespace strumpack::kernel;
+
+/*
+ * Random points, with some (near) duplicates, so that the blocked
+ * evaluation sees (almost) zero distances, which is where
+ * ||x||^2 + ||y||^2 - 2 x^T y suffers most from cancellation.
+ */
+template<typename scalar_t> DenseMatrix<scalar_t>
+random_points(int d, int n, mt19937& gen) {
+  normal_distribution<double> nd(0., 1.);
+  DenseMatrix<scalar_t> X(d, n);
+  for (int j=0; j<n; j++)
+    for (int k=0; k<d; k++)
+      X(k, j) = nd(gen) + ((j % 2) ? 2. : -2.);
+  const auto eps = numeric_limits<scalar_t>::epsilon();
+  for (int j=1; j<n/10; j++)
+    for (int k=0; k<d; k++)
+      X(k, 10*j) = X(k, 10*j-1) *
+        (scalar_t(1.) + ((j % 2) ? scalar_t(0.) : scalar_t(4.) * eps));
+  return X;
+}
+
+/*
+ * Compare the blocked evaluation of K(I,J) with the element-wise
+ * eval(i,j), for random, non-contiguous, unsorted I and J, with
+ * repeated indices and with I and J overlapping, so that the
+ * regularization on the diagonal is also checked.
+ */
+template<typename scalar_t> int
+check_eval_block(Kernel<scalar_t>& K, const string& name, mt19937& gen) {
+  const std::size_t n = K.n();
+  const auto eps = numeric_limits<scalar_t>::epsilon();
+  uniform_int_distribution<std::size_t> ui(0, n-1);
+  int ierr = 0;
+  double maxerr = 0.;
+  for (std::size_t m : {1, 7, 64, 150}) {
+    vector<std::size_t> I(m), J(m/2+1);
+    for (auto& i : I) i = ui(gen);
+    for (std::size_t j=0; j<J.size(); j++)
+      J[j] = (j % 3) ? ui(gen) : I[(7*j) % m];
+    // near duplicates are stored next to each other
+    if (m > 1) { I[0] = 9; I[1] = 10; J[0] = 10; }
+    DenseMatrix<scalar_t> B(I.size(), J.size());
+    K(I, J, B);
+    for (std::size_t j=0; j<J.size(); j++)
+      for (std::size_t i=0; i<I.size(); i++) {
+        auto e = K.eval(I[i], J[j]);
+        auto err = std::abs(B(i, j) - e) / std::max(scalar_t(1.), std::abs(e));
+        maxerr = std::max(maxerr, double(err));
+        if (!(err <= 100 * eps)) ierr++;
+      }
+  }
+  cout << "# " << name << " kernel, precision " << sizeof(scalar_t)
+       << ", max |K(I,J) - eval|/max(1,|eval|) = " << maxerr << endl;
+  if (ierr)
+    cout << "# ERROR: " << name << " kernel, blocked evaluation differs in "
+         << ierr << " entries" << endl;
+  return ierr;
+}
+
+template<typename scalar_t> int test_eval_block(int n) {
+  const int d = 5;
+  mt19937 gen(1);
+  auto X = random_points<scalar_t>(d, n, gen);
+  int ierr = 0;
+  const scalar_t h = 1.5, lambda = 2.;
+  for (auto kt : {KernelType::GAUSS, KernelType::LAPLACE}) {
+    auto K = create_kernel<scalar_t>(kt, X, h, lambda);
+    ierr += check_eval_block(*K, get_name(kt), gen);
+  }
+  for (int p : {1, 3, d}) {
+    auto K = create_kernel<scalar_t>(KernelType::ANOVA, X, h, lambda, p);
+    ierr += check_eval_block(*K, "ANOVA(p=" + to_string(p) + ")", gen);
+  }
+  {
+    DenseMatrix<scalar_t> A(n, n);
+    A.random();
+    DenseKernel<scalar_t> K(X, A, lambda);
+    ierr += check_eval_block(K, get_name(KernelType::DENSE), gen);
+  }
+  return ierr;
+}
+
+/*
+ * Compare the tree code prediction with the exact prediction, for a
+ * range of tolerances. The error on each prediction should be below
+ * tol * ||w||_1, up to roundoff.
+ */
+template<typename scalar_t> int
+check_tree_code(Kernel<scalar_t>& K, const string& name,
+                const DenseMatrix<scalar_t>& test,
+                const DenseMatrix<scalar_t>& w) {
+  using real_t = typename RealType<scalar_t>::value_type;
+  const auto eps = numeric_limits<real_t>::epsilon();
+  real_t w1 = 0.;
+  for (std::size_t i=0; i<w.rows(); i++) w1 += std::abs(w(i, 0));
+  auto p = K.predict(test, w);
+  int ierr = 0;
+  for (real_t tol : {0., 1e-10, 1e-6, 1e-3, 1e-2, 1e-1}) {
+    auto ptc = K.predict(test, w, tol);
+    real_t maxerr = 0.;
+    for (std::size_t c=0; c<p.size(); c++)
+      maxerr = std::max(maxerr, real_t(std::abs(ptc[c] - p[c])));
+    const real_t bound = (tol + 100 * eps) * w1;
+    cout << "# " << name << " kernel, precision " << sizeof(scalar_t)
+         << ", tol = " << tol << ", max |p_tc - p| = " << maxerr
+         << " <= " << bound << endl;
+    if (!(maxerr <= bound)) {
+      cout << "# ERROR: " << name << " kernel, tree code prediction error"
+           << " above tol * ||w||_1" << endl;
+      ierr++;
+    }
+  }
+  return ierr;
+}
+
+template<typename scalar_t> int test_tree_code(int n) {
+  const int d = 3, m = 300;
+  mt19937 gen(2);
+  auto X = random_points<scalar_t>(d, n, gen);
+  auto T = random_points<scalar_t>(d, m, gen);
+  DenseMatrix<scalar_t> w(n, 1);
+  w.random();
+  // cluster the points, as in the HSS construction, so that the
+  // tree code has a useful cluster tree
+  std::vector<int> perm;
+  auto t = binary_tree_clustering
+    (ClusteringAlgorithm::TWO_MEANS, X, perm, 32);
+  int ierr = 0;
+  const scalar_t lambda = 1.;
+  for (auto kt : {KernelType::GAUSS, KernelType::LAPLACE,
+                  KernelType::ANOVA})
+    for (scalar_t h : {.5, 2.}) {
+      auto K = create_kernel<scalar_t>(kt, X, h, lambda, 2);
+      K->tree() = t;
+      ostringstream name;
+      name << get_name(kt) << "(h=" << h << ")";
+      ierr += check_tree_code(*K, name.str(), T, w);
+    }
+  return ierr;
+}
+
+int main(int argc, char* argv[]) {
+  int n = 500;
+  if (argc > 1) n = stoi(argv[1]);
+  int ierr = 0;
+  ierr += test_eval_block<double>(n);
+  ierr += test_eval_block<float>(n);
+  ierr += test_tree_code<double>(4*n);
+  ierr += test_tree_code<float>(4*n);
+  return ierr;
+}
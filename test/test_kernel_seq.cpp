@@ -0,0 +1,187 @@
+/*
+ * STRUMPACK -- STRUctured Matrices PACKage, Copyright (c) 2014, The
+ * Regents of the University of California, through Lawrence Berkeley
+ * National Laboratory (subject to receipt of any required approvals
+ * from the U.S. Dept. of Energy).  All rights reserved.
+ *
+ * If you have questions about your rights to use or distribute this
+ * software, please contact Berkeley Lab's Technology Transfer
+ * Department at TTD@lbl.gov.
+ *
+ * NOTICE. This software is owned by the U.S. Department of Energy. As
+ * such, the U.S. Government has been granted for itself and others
+ * acting on its behalf a paid-up, nonexclusive, irrevocable,
+ * worldwide license in the Software to reproduce, prepare derivative
+ * works, and perform publicly and display publicly.  Beginning five
+ * (5) years after the date permission to assert copyright is obtained
+ * from the U.S. Department of Energy, and subject to any subsequent
+ * five (5) year renewals, the U.S. Government is granted for itself
+ * and others acting on its behalf a paid-up, nonexclusive,
+ * irrevocable, worldwide license in the Software to reproduce,
+ * prepare derivative works, distribute copies to the public, perform
+ * publicly and display publicly, and to permit others to do so.
+ *
+ * Developers: Pieter Ghysels, Francois-Henry Rouet, Xiaoye S. Li.
+ *             (Lawrence Berkeley National Lab, Computational Research
+ *             Division).
+ *
+ */
+#include <iostream>
+#include <random>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cmath>
+using namespace std;
+
+#include "kernel/Kernel.h"
+
+/*
+ * Overloads to call the double/float C interface from a template.
+ */
+STRUMPACKKernel create_kernel(int n, int d, double* X, double h,
+                              double lambda) {
+  return STRUMPACK_create_kernel_double(n, d, X, h, lambda, 1, 0);
+}
+STRUMPACKKernel create_kernel(int n, int d, float* X, float h,
+                              float lambda) {
+  return STRUMPACK_create_kernel_float(n, d, X, h, lambda, 1, 0);
+}
+void destroy_kernel(STRUMPACKKernel K, double) {
+  STRUMPACK_destroy_kernel_double(K);
+}
+void destroy_kernel(STRUMPACKKernel K, float) {
+  STRUMPACK_destroy_kernel_float(K);
+}
+void fit_HSS(STRUMPACKKernel K, double* y, int argc, char* argv[]) {
+  STRUMPACK_kernel_fit_HSS_double(K, y, argc, argv);
+}
+void fit_HSS(STRUMPACKKernel K, float* y, int argc, char* argv[]) {
+  STRUMPACK_kernel_fit_HSS_float(K, y, argc, argv);
+}
+void solve_HSS(STRUMPACKKernel K, double* y) {
+  STRUMPACK_kernel_solve_HSS_double(K, y);
+}
+void solve_HSS(STRUMPACKKernel K, float* y) {
+  STRUMPACK_kernel_solve_HSS_float(K, y);
+}
+int save(STRUMPACKKernel K, const char* fname, double) {
+  return STRUMPACK_kernel_save_double(K, fname);
+}
+int save(STRUMPACKKernel K, const char* fname, float) {
+  return STRUMPACK_kernel_save_float(K, fname);
+}
+STRUMPACKKernel load(const char* fname, double) {
+  return STRUMPACK_kernel_load_double(fname);
+}
+STRUMPACKKernel load(const char* fname, float) {
+  return STRUMPACK_kernel_load_float(fname);
+}
+void predict(STRUMPACKKernel K, int m, double* X, double* p) {
+  STRUMPACK_kernel_predict_double(K, m, X, p);
+}
+void predict(STRUMPACKKernel K, int m, float* X, float* p) {
+  STRUMPACK_kernel_predict_float(K, m, X, p);
+}
+
+template<typename scalar_t> double
+rel_diff(const vector<scalar_t>& a, const vector<scalar_t>& b) {
+  double err = 0., nrm = 0.;
+  for (size_t i=0; i<a.size(); i++) {
+    err += (a[i] - b[i]) * (a[i] - b[i]);
+    nrm += b[i] * b[i];
+  }
+  return sqrt(err / nrm);
+}
+
+/*
+ * Fit a kernel ridge regression model on two clusters of points,
+ * save it, load it again, and check that the loaded model gives the
+ * same predictions, and that STRUMPACK_kernel_solve_HSS with new
+ * labels gives the same weights for the original and the loaded
+ * model.
+ */
+template<typename scalar_t> int
+check_save_load(int n, int argc, char* argv[]) {
+  const int d = 4, m = 200;
+  const double tol = sizeof(scalar_t) == 8 ? 1e-10 : 1e-4;
+  const string fname = "kernel_model_" + to_string(sizeof(scalar_t))
+    + ".bin";
+  mt19937 gen(1);
+  normal_distribution<double> nd(0., 1.);
+  vector<scalar_t> X(d*n), T(d*m), y(n), y2(n);
+  for (int i=0; i<n; i++) {
+    y[i] = (i % 2) ? 1 : -1;
+    y2[i] = nd(gen);
+    for (int k=0; k<d; k++) X[k+i*d] = nd(gen) + y[i];
+  }
+  for (int i=0; i<m; i++)
+    for (int k=0; k<d; k++) T[k+i*d] = nd(gen) + ((i % 2) ? 1 : -1);
+
+  auto K = create_kernel(n, d, X.data(), scalar_t(1.), scalar_t(4.));
+  fit_HSS(K, y.data(), argc, argv);
+  vector<scalar_t> p0(m), p1(m), q0(m), q1(m), r0(m);
+  predict(K, m, T.data(), p0.data());
+  int ierr = 0;
+  if (save(K, fname.c_str(), scalar_t(0.))) {
+    cout << "# ERROR: saving " << fname << " failed" << endl;
+    destroy_kernel(K, scalar_t(0.));
+    return 1;
+  }
+  auto L = load(fname.c_str(), scalar_t(0.));
+  if (!L) {
+    cout << "# ERROR: loading " << fname << " failed" << endl;
+    destroy_kernel(K, scalar_t(0.));
+    return 1;
+  }
+  predict(L, m, T.data(), p1.data());
+  auto err_load = rel_diff(p1, p0);
+  cout << "# precision " << sizeof(scalar_t)
+       << ", ||p_load - p||/||p|| = " << err_load << endl;
+  if (!(err_load <= tol)) ierr++;
+
+  // new labels, reusing the factored HSS matrix
+  auto y2K = y2, y2L = y2;
+  solve_HSS(K, y2K.data());
+  solve_HSS(L, y2L.data());
+  predict(K, m, T.data(), q0.data());
+  predict(L, m, T.data(), q1.data());
+  auto err_solve = rel_diff(q1, q0);
+  cout << "# precision " << sizeof(scalar_t)
+       << ", ||q_load - q||/||q|| = " << err_solve << endl;
+  if (!(err_solve <= tol)) ierr++;
+
+  // solving with the original labels gives the original weights
+  auto yL = y;
+  solve_HSS(L, yL.data());
+  predict(L, m, T.data(), r0.data());
+  auto err_resolve = rel_diff(r0, p0);
+  cout << "# precision " << sizeof(scalar_t)
+       << ", ||r_load - p||/||p|| = " << err_resolve << endl;
+  if (!(err_resolve <= tol)) ierr++;
+
+  // fitting the loaded model again copies the mapped training data
+  fit_HSS(L, y.data(), argc, argv);
+  predict(L, m, T.data(), r0.data());
+  int agree = 0;
+  for (int i=0; i<m; i++)
+    if ((r0[i] < 0) == (p0[i] < 0)) agree++;
+  cout << "# precision " << sizeof(scalar_t)
+       << ", refit agrees on " << agree << "/" << m << " labels" << endl;
+  if (agree < 0.95 * m) ierr++;
+
+  destroy_kernel(L, scalar_t(0.));
+  destroy_kernel(K, scalar_t(0.));
+  remove(fname.c_str());
+  if (ierr) cout << "# ERROR: kernel save/load check failed" << endl;
+  return ierr;
+}
+
+int main(int argc, char* argv[]) {
+  int n = 2000;
+  if (argc > 1) n = stoi(argv[1]);
+  int ierr = 0;
+  ierr += check_save_load<double>(n, argc-1, argv+1);
+  ierr += check_save_load<float>(n, argc-1, argv+1);
+  return ierr;
+}
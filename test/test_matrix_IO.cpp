@@ -176,6 +176,27 @@ int run(int argc, char* argv[]) {
     std::cout << "||H-H2||_F = " << H2dense.norm() << std::endl;
   }
 
+  {
+    // files without the format version, as written by older
+    // versions, start with the matrix size after the strumpack
+    // version, and should be rejected
+    int v[3];
+    get_version(v, v+1, v+2);
+    {
+      ofstream f("H_old.bin", ios::out | ios::trunc | ios::binary);
+      f.write((const char*)v, sizeof(v));
+      std::size_t rows = H.rows(), cols = H.cols();
+      f.write((const char*)&rows, sizeof(rows));
+      f.write((const char*)&cols, sizeof(cols));
+    }
+    ifstream f("H_old.bin", ios::in | ios::binary);
+    auto H3 = HSSMatrix<double>::read_from(f);
+    if (f.good() || H3.rows() != 0) {
+      cout << "ERROR: file in old format was not rejected!!" << endl;
+      return 1;
+    }
+  }
+
   cout << "# exiting" << endl;
   return 0;
 }